@@ -0,0 +1,443 @@
+/*
+ * CRC.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: CRC.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRC16_HAVE_CLMUL  1
+#else
+#define CRC16_HAVE_CLMUL  0
+#endif
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  CRC-16/MODBUS Polynomial x^16 + x^15 + x^2 + 1.
+#define CRC16_POLY           (0x18005UL)
+//!-  Same Polynomial, Bit-Reflected and without x^16.
+#define CRC16_POLY_REFLECTED (0xA001)
+
+//!-  Below this Length the Folding Setup costs more than it saves.
+#define CLMUL_MIN_LENGTH     (32)
+
+/*
+ *!-  The Tables are built by the Compiler. The CRC is linear: the
+ *!-  Entry of a Byte is the XOR of the Entries of its set Bits, so
+ *!-  a Table is spanned by 8 Basis Entries. The Basis of Slice 0
+ *!-  is 8 Bit Steps of the Polynomial; Slice k's follows from
+ *!-  Slice k-1's as one more zero Byte. Enumerators name every
+ *!-  Basis Entry, so no Expression has to expand its Predecessors.
+ */
+#define CRC16_BIT(C)     (((C) >> 1) ^ (((C) & 1) ? CRC16_POLY_REFLECTED : 0))
+#define CRC16_BITS8(C)   CRC16_BIT(CRC16_BIT(CRC16_BIT(CRC16_BIT(              \
+                         CRC16_BIT(CRC16_BIT(CRC16_BIT(CRC16_BIT(C))))))))
+
+//!-  CRC16_SPAN() combines the Basis of Slice "K" by the Bits of "V".
+#define CRC16_SPAN(K, V)                                                    \
+    ((((V) & 0x01) ? CRC16_BASIS_##K##_0 : 0) ^                             \
+     (((V) & 0x02) ? CRC16_BASIS_##K##_1 : 0) ^                             \
+     (((V) & 0x04) ? CRC16_BASIS_##K##_2 : 0) ^                             \
+     (((V) & 0x08) ? CRC16_BASIS_##K##_3 : 0) ^                             \
+     (((V) & 0x10) ? CRC16_BASIS_##K##_4 : 0) ^                             \
+     (((V) & 0x20) ? CRC16_BASIS_##K##_5 : 0) ^                             \
+     (((V) & 0x40) ? CRC16_BASIS_##K##_6 : 0) ^                             \
+     (((V) & 0x80) ? CRC16_BASIS_##K##_7 : 0))
+
+//!-  CRC16_ZERO() feeds one zero Byte to the Register "C".
+#define CRC16_ZERO(C)    (((C) >> 8) ^ CRC16_SPAN(0, (C) & 0xFF))
+
+#define CRC16_BASIS(K, P)                                                   \
+    CRC16_BASIS_##K##_0 = CRC16_ZERO(CRC16_BASIS_##P##_0),                  \
+    CRC16_BASIS_##K##_1 = CRC16_ZERO(CRC16_BASIS_##P##_1),                  \
+    CRC16_BASIS_##K##_2 = CRC16_ZERO(CRC16_BASIS_##P##_2),                  \
+    CRC16_BASIS_##K##_3 = CRC16_ZERO(CRC16_BASIS_##P##_3),                  \
+    CRC16_BASIS_##K##_4 = CRC16_ZERO(CRC16_BASIS_##P##_4),                  \
+    CRC16_BASIS_##K##_5 = CRC16_ZERO(CRC16_BASIS_##P##_5),                  \
+    CRC16_BASIS_##K##_6 = CRC16_ZERO(CRC16_BASIS_##P##_6),                  \
+    CRC16_BASIS_##K##_7 = CRC16_ZERO(CRC16_BASIS_##P##_7)
+
+enum {
+    CRC16_BASIS_0_0 = CRC16_BITS8(0x01),
+    CRC16_BASIS_0_1 = CRC16_BITS8(0x02),
+    CRC16_BASIS_0_2 = CRC16_BITS8(0x04),
+    CRC16_BASIS_0_3 = CRC16_BITS8(0x08),
+    CRC16_BASIS_0_4 = CRC16_BITS8(0x10),
+    CRC16_BASIS_0_5 = CRC16_BITS8(0x20),
+    CRC16_BASIS_0_6 = CRC16_BITS8(0x40),
+    CRC16_BASIS_0_7 = CRC16_BITS8(0x80),
+    CRC16_BASIS(1, 0),
+    CRC16_BASIS(2, 1),
+    CRC16_BASIS(3, 2),
+    CRC16_BASIS(4, 3),
+    CRC16_BASIS(5, 4),
+    CRC16_BASIS(6, 5),
+    CRC16_BASIS(7, 6),
+};
+
+//!-  CRC16_EACH() applies "X(K, Byte)" to every Byte Value in Order.
+#define CRC16_EACH4(X, K, I)                                                \
+    X(K, (I)) X(K, (I) + 1) X(K, (I) + 2) X(K, (I) + 3)
+#define CRC16_EACH16(X, K, I)                                               \
+    CRC16_EACH4(X, K, (I))      CRC16_EACH4(X, K, (I) + 4)                  \
+    CRC16_EACH4(X, K, (I) + 8)  CRC16_EACH4(X, K, (I) + 12)
+#define CRC16_EACH64(X, K, I)                                               \
+    CRC16_EACH16(X, K, (I))      CRC16_EACH16(X, K, (I) + 16)               \
+    CRC16_EACH16(X, K, (I) + 32) CRC16_EACH16(X, K, (I) + 48)
+#define CRC16_EACH(X, K)                                                    \
+    CRC16_EACH64(X, K, 0)   CRC16_EACH64(X, K, 64)                          \
+    CRC16_EACH64(X, K, 128) CRC16_EACH64(X, K, 192)
+
+#define CRC16_ENTRY(K, I)      (uint16_t) CRC16_SPAN(K, I),
+#define CRC16_ENTRY_HI(K, I)   (uint8_t) (CRC16_SPAN(K, I) & 0xFF),
+#define CRC16_ENTRY_LO(K, I)   (uint8_t) (CRC16_SPAN(K, I) >> 8),
+
+//!-  Known Entries of the Reference Table, checked at Compile Time.
+_Static_assert(CRC16_SPAN(0, 0x01) == 0xC0C1, "CRC16 Table Entry 0x01");
+_Static_assert(CRC16_SPAN(0, 0x80) == 0xA001, "CRC16 Table Entry 0x80");
+_Static_assert(CRC16_SPAN(0, 0xFF) == 0x4040, "CRC16 Table Entry 0xFF");
+_Static_assert(CRC16_SPAN(1, 0x01) == CRC16_ZERO(0xC0C1), "CRC16 Slice 1");
+
+typedef uint16_t (*CRC16_Update_Fn)(
+        uint16_t const State,
+        const uint8_t *Data,
+        uint32_t Length);
+
+static uint16_t CRC16_Update_Table(
+        uint16_t const State,
+        const uint8_t *Data,
+        uint32_t Length);
+
+static uint16_t CRC16_Update_Slice8(
+        uint16_t const State,
+        const uint8_t *Data,
+        uint32_t Length);
+
+static uint64_t CRC16_Fold_Constant(
+        uint32_t const Power);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+const uint16_t CRC16_Slice_Table[CRC16_SLICES][256] = {
+    { CRC16_EACH(CRC16_ENTRY, 0) },
+    { CRC16_EACH(CRC16_ENTRY, 1) },
+    { CRC16_EACH(CRC16_ENTRY, 2) },
+    { CRC16_EACH(CRC16_ENTRY, 3) },
+    { CRC16_EACH(CRC16_ENTRY, 4) },
+    { CRC16_EACH(CRC16_ENTRY, 5) },
+    { CRC16_EACH(CRC16_ENTRY, 6) },
+    { CRC16_EACH(CRC16_ENTRY, 7) },
+};
+
+const uint8_t auchCRCHi[256] = { CRC16_EACH(CRC16_ENTRY_HI, 0) };
+const uint8_t auchCRCLo[256] = { CRC16_EACH(CRC16_ENTRY_LO, 0) };
+
+static CRC16_Update_Fn  CRC16_Active_Fn = CRC16_Update_Slice8;
+static CRC16_Engine     CRC16_Active = CRC16_ENGINE_SLICE8;
+static Bool             CRC16_Clmul_Supported = FALSE;
+
+/*
+ *!-  Folding Constants (x^n mod P, Bit-Reflected into 64 Bits).
+ *!-  Fold_128: one 128Bit Accumulator.
+ *!-  Fold_512: four Accumulators, 64 Bytes per Step.
+ */
+static uint64_t Fold_128_Hi;
+static uint64_t Fold_128_Lo;
+static uint64_t Fold_512_Hi;
+static uint64_t Fold_512_Lo;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  CRC16_Update_Table() is the Byte-at-a-Time Reference Path.
+static uint16_t CRC16_Update_Table(
+        uint16_t const State,
+        const uint8_t *Data,
+        uint32_t Length) {
+
+    uint16_t CRC = State;
+
+    while (Length--) {
+        CRC = (uint16_t) ((CRC >> 8) ^
+                          CRC16_Slice_Table[0][(CRC ^ *Data++) & 0x00FF]);
+    }
+    return CRC;
+}
+
+/*
+ *!-  CRC16_Update_Slice8() consumes 8 Bytes per Step.
+ *!-  The 8 Table Lookups are independent of each other, so
+ *!-  they overlap instead of forming one long Dependency Chain.
+ */
+static uint16_t CRC16_Update_Slice8(
+        uint16_t const State,
+        const uint8_t *Data,
+        uint32_t Length) {
+
+    uint16_t CRC = State;
+    uint64_t Word = 0;
+
+    while (Length >= 8) {
+        memcpy(&Word, Data, sizeof(Word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        Word = __builtin_bswap64(Word);
+#endif
+        Word ^= CRC;
+        CRC = (uint16_t) (CRC16_Slice_Table[7][(Word      ) & 0xFF] ^
+                          CRC16_Slice_Table[6][(Word >>  8) & 0xFF] ^
+                          CRC16_Slice_Table[5][(Word >> 16) & 0xFF] ^
+                          CRC16_Slice_Table[4][(Word >> 24) & 0xFF] ^
+                          CRC16_Slice_Table[3][(Word >> 32) & 0xFF] ^
+                          CRC16_Slice_Table[2][(Word >> 40) & 0xFF] ^
+                          CRC16_Slice_Table[1][(Word >> 48) & 0xFF] ^
+                          CRC16_Slice_Table[0][(Word >> 56)       ]);
+        Data += 8;
+        Length -= 8;
+    }
+    return CRC16_Update_Table(CRC, Data, Length);
+}
+
+/*
+ *!-  CRC16_Fold_Constant() returns x^Power mod P, Bit-Reflected
+ *!-  into a 64Bit Lane (Coefficient of x^k in Bit 63-k) as
+ *!-  PCLMULQDQ expects for a Reflected CRC.
+ */
+static uint64_t CRC16_Fold_Constant(
+        uint32_t const Power) {
+
+    uint32_t Remainder = 1;
+    uint32_t Index = 0;
+    uint64_t Reflected = 0;
+
+    for (Index = 0; Index < Power; Index++) {
+        Remainder <<= 1;
+        if (Remainder & 0x10000UL) {
+            Remainder ^= CRC16_POLY;
+        }
+    }
+    for (Index = 0; Index < 16; Index++) {
+        if (Remainder & (1UL << Index)) {
+            Reflected |= (1ULL << (63 - Index));
+        }
+    }
+    return Reflected;
+}
+
+#if CRC16_HAVE_CLMUL
+
+/*
+ *!-  CRC16_Fold() multiplies a 128Bit Accumulator by x^n mod P.
+ *!-  Constants holds (x^(n+63) mod P) for the Low Lane and
+ *!-  (x^(n-1) mod P) for the High Lane.
+ */
+__attribute__((target("pclmul,sse2")))
+static inline __m128i CRC16_Fold(
+        __m128i const Accumulator,
+        __m128i const Constants) {
+
+    return _mm_xor_si128(
+               _mm_clmulepi64_si128(Accumulator, Constants, 0x00),
+               _mm_clmulepi64_si128(Accumulator, Constants, 0x11));
+}
+
+/*
+ *!-  CRC16_Update_Clmul() folds the Message 64 Bytes (four
+ *!-  Accumulators) and then 16 Bytes at a Time with Carry-less
+ *!-  Multiplication. The remaining 128Bit Value has the same CRC
+ *!-  as the Message consumed so far, so it is finished together
+ *!-  with the Tail on the Slicing Path.
+ */
+__attribute__((target("pclmul,sse2")))
+static uint16_t CRC16_Update_Clmul(
+        uint16_t const State,
+        const uint8_t *Data,
+        uint32_t Length) {
+
+    __m128i Fold_128;
+    __m128i Fold_512;
+    __m128i Acc0;
+    __m128i Acc1;
+    __m128i Acc2;
+    __m128i Acc3;
+    uint8_t Residue[16];
+    uint16_t Crc = State;
+
+    //!-  Shorter Messages do not pay for the Folding Setup.
+    if (Length >= CLMUL_MIN_LENGTH) {
+        Fold_128 = _mm_set_epi64x((long long) Fold_128_Hi,
+                                  (long long) Fold_128_Lo);
+        Fold_512 = _mm_set_epi64x((long long) Fold_512_Hi,
+                                  (long long) Fold_512_Lo);
+
+        //!-  The Initial State is XORed into the first two Bytes.
+        Acc0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) Data),
+                             _mm_cvtsi32_si128(State));
+        Data += 16;
+        Length -= 16;
+
+        if (Length >= 112) {
+            Acc1 = _mm_loadu_si128((const __m128i *) (Data));
+            Acc2 = _mm_loadu_si128((const __m128i *) (Data + 16));
+            Acc3 = _mm_loadu_si128((const __m128i *) (Data + 32));
+            Data += 48;
+            Length -= 48;
+
+            while (Length >= 64) {
+                Acc0 = _mm_xor_si128(CRC16_Fold(Acc0, Fold_512),
+                           _mm_loadu_si128((const __m128i *) (Data)));
+                Acc1 = _mm_xor_si128(CRC16_Fold(Acc1, Fold_512),
+                           _mm_loadu_si128((const __m128i *) (Data + 16)));
+                Acc2 = _mm_xor_si128(CRC16_Fold(Acc2, Fold_512),
+                           _mm_loadu_si128((const __m128i *) (Data + 32)));
+                Acc3 = _mm_xor_si128(CRC16_Fold(Acc3, Fold_512),
+                           _mm_loadu_si128((const __m128i *) (Data + 48)));
+                Data += 64;
+                Length -= 64;
+            }
+
+            //!-  Merge the four Accumulators into one.
+            Acc0 = _mm_xor_si128(CRC16_Fold(Acc0, Fold_128), Acc1);
+            Acc0 = _mm_xor_si128(CRC16_Fold(Acc0, Fold_128), Acc2);
+            Acc0 = _mm_xor_si128(CRC16_Fold(Acc0, Fold_128), Acc3);
+        }
+
+        while (Length >= 16) {
+            Acc0 = _mm_xor_si128(CRC16_Fold(Acc0, Fold_128),
+                       _mm_loadu_si128((const __m128i *) Data));
+            Data += 16;
+            Length -= 16;
+        }
+
+        _mm_storeu_si128((__m128i *) Residue, Acc0);
+        Crc = CRC16_Update_Slice8(0, Residue, sizeof(Residue));
+    }
+    return CRC16_Update_Slice8(Crc, Data, Length);
+}
+
+#endif /* CRC16_HAVE_CLMUL */
+
+/*
+ *!-  CRC16_Constructor() makes sure the Folding Constants and the
+ *!-  Engine are set before any Translation Unit calls the Module.
+ */
+__attribute__((constructor))
+static void CRC16_Constructor(
+        void) {
+
+    CRC16_Init();
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  CRC16_Init() computes the Folding Constants, then selects the
+ *!-  fastest Engine the CPU supports. The Slicing Tables (Slice k
+ *!-  holds the CRC of a Byte followed by k zeros) are built in.
+ */
+void CRC16_Init(
+        void) {
+
+    Fold_128_Lo = CRC16_Fold_Constant(128 + 63);
+    Fold_128_Hi = CRC16_Fold_Constant(128 - 1);
+    Fold_512_Lo = CRC16_Fold_Constant(512 + 63);
+    Fold_512_Hi = CRC16_Fold_Constant(512 - 1);
+
+#if CRC16_HAVE_CLMUL
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") &&
+        __builtin_cpu_supports("sse2")) {
+        CRC16_Clmul_Supported = TRUE;
+    }
+#endif
+
+    if (CRC16_Select(CRC16_ENGINE_CLMUL) == FALSE) {
+        (void) CRC16_Select(CRC16_ENGINE_SLICE8);
+    }
+}
+
+/*
+ *!-  CRC16_Select() forces an Engine, e.g. for Benchmarks.
+ *!-  Returns FALSE if the CPU does not support it.
+ */
+Bool CRC16_Select(
+        CRC16_Engine const Engine) {
+
+    Bool Check_Ok = TRUE;
+
+    switch (Engine) {
+        case CRC16_ENGINE_TABLE:
+            CRC16_Active_Fn = CRC16_Update_Table;
+            break;
+        case CRC16_ENGINE_SLICE8:
+            CRC16_Active_Fn = CRC16_Update_Slice8;
+            break;
+#if CRC16_HAVE_CLMUL
+        case CRC16_ENGINE_CLMUL:
+            if (CRC16_Clmul_Supported == TRUE) {
+                CRC16_Active_Fn = CRC16_Update_Clmul;
+            }
+            else {
+                Check_Ok = FALSE;
+            }
+            break;
+#endif
+        default:
+            Check_Ok = FALSE;
+            break;
+    }
+
+    if (Check_Ok == TRUE) {
+        CRC16_Active = Engine;
+    }
+    return Check_Ok;
+}
+
+//!-  CRC16_Active_Engine() reports the Engine in use.
+CRC16_Engine CRC16_Active_Engine(
+        void) {
+
+    return CRC16_Active;
+}
+
+/*
+ *!-  CRC16_Update() continues a CRC over "Length" more Bytes.
+ *!-  Start with CRC16_INITIAL_STATE; Chunks can be fed as they
+ *!-  arrive and give the same Result as one Call over the Whole.
+ */
+uint16_t CRC16_Update(
+        uint16_t const State,
+        const uint8_t *Data,
+        uint32_t Length) {
+
+    return CRC16_Active_Fn(State, Data, Length);
+}
+
+/*
+ *!-  Calculate_CRC16() to calculate the CRC of the Message Frame.
+ *!-  unsigned char *MsgBuffer: Message to Calculate CRC Upon.
+ *!-  unsigned uint16_t DataLength: Quantity of Bytes in Message.
+ *!-  The MSB of the Result is the first CRC Byte on the Wire.
+ */
+uint16_t Calculate_CRC16(
+        uint8_t *MsgBuffer,
+        uint16_t DataLength) {
+
+    return CRC16_Frame_Value(
+               CRC16_Update(CRC16_INITIAL_STATE, MsgBuffer, DataLength));
+}
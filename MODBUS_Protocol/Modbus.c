@@ -10,159 +10,367 @@
 *****************************************************************************/
 
 //!-  Headers
+#include <stdlib.h>
+#include <string.h>
 #include "Modbus.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Bits.h"
+#include "Modbus_Swap.h"
+#include "Modbus_Dispatch.h"
+#include "Modbus_Changes.h"
+#include "Modbus_Fifo.h"
+#include "Modbus_File.h"
 
 /****************************************************************************
 !-  LOCAL DEFINITIONS
 *****************************************************************************/
 
-void Clear_AllData(
-        void);
-
-void Clear_Frame(
-        Modbus_Packet *const PacketPtr);
+//!-  Bytes of one Table rounded up to whole Cache Lines.
+#define TABLE_BYTES(Count, Type)                                    \
+    ((((Count) * sizeof(Type)) + MODBUS_CACHE_LINE - 1) &           \
+     ~((size_t) MODBUS_CACHE_LINE - 1))
 
-void Unpack16bits_8bits(
-        const uint16_t u16Value,
-        uint8_t *const u8Byte1Ptr,
-        uint8_t *const u8Byte0Ptr);
-
-uint16_t Pack8bits_16bits(
-        const uint8_t u8Byte1,
-        const uint8_t u8Byte0);
-
-Bool Set_Device_ID(
-        Modbus_Packet *const UsrPacket,
-        uint8_t const UsrDevID);
+#define UNIT_HEADER_BYTES  TABLE_BYTES(1, Modbus_Data)
 
-Bool Validate_Function_Code(
-        uint8_t const FunctionCode);
-
-Bool Validate_Starting_Address(
-        uint8_t  const FunctionCode,
-        uint16_t const StartAddress);
-
-Bool Validate_Registers_Quantity(
-        uint8_t  const FunctionCode,
-        uint16_t const StartAddress,
-        uint16_t const RegisterNo);
+/*
+ *!-  DEVICE_LIMIT() checks a Table of the configured Device against
+ *!-  its Limits while compiling, so Modbus_Init() cannot fail on a
+ *!-  bad Configuration at Run Time.
+ */
+#define DEVICE_LIMIT(Table, Numbers, Max_Numbers)                           \
+    _Static_assert((Numbers) <= (Max_Numbers),                              \
+                   #Numbers " exceeds " #Max_Numbers);                      \
+    _Static_assert((Max_Numbers) <= MAX_UNIT_ITEMS,                         \
+                   #Max_Numbers " exceeds the Address Space");
 
-Bool Set_StartAddress(
-        Modbus_Packet *const UsrPacket,
-        uint16_t const UsrStartAddress,
-        uint8_t  const FunctionCode);
+MODBUS_DEVICE_MAP(DEVICE_LIMIT)
 
-Bool Set_Register_Quantity(
-        Modbus_Packet const *UsrPacket,
-        uint16_t const UsrRegQuantity,
-        uint8_t  const FunctionCode,
-        uint16_t const StartAddress);
+void Clear_AllData(
+        Modbus_Data *const Unit,
+        size_t const Bytes);
+
+Register_Page **Page_Table(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table);
+
+Bool Page_Valid(
+        const Register_Page *const Page,
+        uint16_t const Offset,
+        uint16_t const Count);
+
+//!-  Directions of a Register Copy, see Registers_Copy().
+typedef enum {
+    COPY_TO_WIRE,
+    COPY_FROM_WIRE,
+    COPY_TO_HOST,
+    COPY_FROM_HOST,
+} Register_Copy;
+
+void Pages_Write_Lock(
+        Register_Page **const Pages,
+        uint32_t const First,
+        uint32_t const Last);
+
+void Pages_Write_Unlock(
+        Register_Page **const Pages,
+        uint32_t const First,
+        uint32_t const Last);
+
+void Pages_Read_Begin(
+        Register_Page **const Pages,
+        uint32_t const First,
+        uint32_t const Last,
+        uint32_t *const Sequences);
+
+Bool Pages_Read_Retry(
+        Register_Page **const Pages,
+        uint32_t const First,
+        uint32_t const Last,
+        const uint32_t *const Sequences);
+
+void Registers_Span_Copy(
+        Register_Page **const Pages,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint8_t *const Buffer,
+        Register_Copy const Copy);
+
+Bool Registers_Copy(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint8_t *const Buffer,
+        Register_Copy const Copy);
 
 /****************************************************************************
 !-  LOCAL VARIABLES
 *****************************************************************************/
 
+Modbus_Data  *MODBUS_UNITS[MODBUS_UNIT_SLOTS];
+
 /****************************************************************************
 !-  LOCAL FUNCTIONS
 *****************************************************************************/
 
-//!-  Clear_AllData() to clear all Values in Database.
+/*
+ *!-  Clear_AllData() to clear all Values in the Database of a Unit.
+ *!-  It runs on the Thread that adds the Unit, so with first-touch
+ *!-  NUMA Placement the Pages land on that Thread's Node.
+ */
 void Clear_AllData(
-        void) {
+        Modbus_Data *const Unit,
+        size_t const Bytes) {
 
-    uint16_t Index = 0;
-    uint8_t const CleanValue = 0;
-    if (COILS_NUMBERS > MIN_COILS_NUMBERS) {
-        for (Index = 0; Index <= COILS_ADDR; Index++) {
-            MODBUS_DATABASE->Coils[Index] = CleanValue;
-        }
+    memset(Unit, 0, Bytes);
+}
+
+//!-  Page_Table() returns the Page Table of a Register Table, or NULL.
+Register_Page **Page_Table(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table) {
+
+    Register_Page **Pages = NULL;
+
+    if (Table == TABLE_HOLDING_REGISTERS) {
+        Pages = (Register_Page **) Unit->HPages;
     }
-    if (DISCRETE_INPUTS_NUMBERS > MIN_DISCRETE_INPUTS_NUMBERS) {
-        for (Index = 0; Index <= DISCRETE_INPUTS_ADDR; Index++) {
-            MODBUS_DATABASE->DInputs[Index] = CleanValue;
-        }
+    else if (Table == TABLE_INPUT_REGISTERS) {
+        Pages = (Register_Page **) Unit->IPages;
+    }
+    else {
+        Pages = NULL;
     }
-    if (INPUT_REGISTERS_NUMBERS > MIN_INPUT_REGISTERS_NUMBERS) {
-        for (Index = 0; Index <= INPUT_REGISTERS_ADDR; Index++) {
-            MODBUS_DATABASE->IRegisters[Index] = CleanValue;
+    return Pages;
+}
+
+//!-  Page_Valid() checks the Validity Bits of "Count" Registers.
+Bool Page_Valid(
+        const Register_Page *const Page,
+        uint16_t const Offset,
+        uint16_t const Count) {
+
+    uint32_t Bit = Offset;
+    uint32_t const End = (uint32_t) Offset + Count;
+    uint32_t Span = 0;
+    uint64_t Mask = 0;
+    Bool Check_Ok = TRUE;
+
+    while ((Bit < End) && (Check_Ok == TRUE)) {
+        Span = BITS_PER_WORD - (Bit % BITS_PER_WORD);
+        if (Span > (End - Bit)) {
+            Span = End - Bit;
+        }
+        Mask = (Span == BITS_PER_WORD) ? ~0ULL :
+               (((1ULL << Span) - 1) << (Bit % BITS_PER_WORD));
+        if ((Page->Valid[Bit / BITS_PER_WORD] & Mask) != Mask) {
+            Check_Ok = FALSE;
         }
+        Bit += Span;
     }
-    if (HOLDING_REGISTERS_NUMBERS > MIN_HOLDING_REGISTERS_NUMBERS) {
-        for (Index = 0; Index <= HOLDING_REGISTERS_ADDR; Index++) {
-            MODBUS_DATABASE->HRegisters[Index] = CleanValue;
+    return Check_Ok;
+}
+
+/*
+ *!-  Pages_Write_Lock() enters the Write Side of the Sequence Lock
+ *!-  of Pages "First" .. "Last": each Sequence goes from even to
+ *!-  odd. Pages are taken in ascending Order, so two Writers with
+ *!-  overlapping Ranges cannot deadlock; Readers never hold them.
+ */
+void Pages_Write_Lock(
+        Register_Page **const Pages,
+        uint32_t const First,
+        uint32_t const Last) {
+
+    uint32_t Page = 0;
+    uint32_t Sequence = 0;
+
+    for (Page = First; Page <= Last; Page++) {
+        for (;;) {
+            Sequence = __atomic_load_n(&Pages[Page]->Sequence,
+                                       __ATOMIC_RELAXED);
+            if (((Sequence & 1U) == 0) &&
+                (__atomic_compare_exchange_n(&Pages[Page]->Sequence,
+                                             &Sequence, Sequence + 1, FALSE,
+                                             __ATOMIC_ACQUIRE,
+                                             __ATOMIC_RELAXED) == TRUE)) {
+                break;
+            }
+            MODBUS_CPU_PAUSE();
         }
     }
+    //!-  The odd Sequences are visible before any Register changes.
+    __atomic_thread_fence(__ATOMIC_RELEASE);
 }
 
-//!-  Clear_Frame() to Clear entire Packet Frame.
-void Clear_Frame(
-        Modbus_Packet *const PacketPtr) {
-
-    PacketPtr->Device_ID = 0;
-    PacketPtr->Function_Code = 0;
-    PacketPtr->Address_Hi = 0;
-    PacketPtr->Address_Low = 0;
-    PacketPtr->Registers_Quantity_Hi = 0;
-    PacketPtr->Registers_Quantity_Low = 0;
-    PacketPtr->Byte_Count = 0;
-    PacketPtr->Data->Coils = 0;
-    PacketPtr->Data->DInputs = 0;
-    PacketPtr->Data->IRegisters = 0;
-    PacketPtr->Data->HRegisters = 0;
-    PacketPtr->CRC_Hi = 0;
-    PacketPtr->CRC_Low = 0;
+//!-  Pages_Write_Unlock() publishes the Update: Sequences turn even.
+void Pages_Write_Unlock(
+        Register_Page **const Pages,
+        uint32_t const First,
+        uint32_t const Last) {
+
+    uint32_t Page = 0;
+
+    for (Page = First; Page <= Last; Page++) {
+        __atomic_store_n(&Pages[Page]->Sequence,
+                         Pages[Page]->Sequence + 1, __ATOMIC_RELEASE);
+    }
 }
 
 /*
- *!-  Unpack16bits_8bits() to unpack an Uint16 into two Uint8 values.
- *!-  u16Value: 16-bit value to be unpacked into 8-bit parts.
- *!-  u8Byte1Ptr: Pointer to 8-bit destination for MSB.
- *!-  u8Byte0Ptr: Pointer to 8-bit destination for LSB.
+ *!-  Pages_Read_Begin() records the even Sequence of every Page
+ *!-  of a Read, waiting out a Write in Progress. It never stores
+ *!-  to the Page, so Readers on many Cores share its Cache Line.
  */
-void Unpack16bits_8bits(
-        const uint16_t u16Value,
-        uint8_t *const u8Byte1Ptr,
-        uint8_t *const u8Byte0Ptr) {
+void Pages_Read_Begin(
+        Register_Page **const Pages,
+        uint32_t const First,
+        uint32_t const Last,
+        uint32_t *const Sequences) {
+
+    uint32_t Page = 0;
+
+    for (Page = First; Page <= Last; Page++) {
+        while (((Sequences[Page - First] =
+                 __atomic_load_n(&Pages[Page]->Sequence,
+                                 __ATOMIC_ACQUIRE)) & 1U) != 0) {
+            MODBUS_CPU_PAUSE();
+        }
+    }
+}
 
-    if ( u8Byte1Ptr != NULL ) {
-        (*u8Byte1Ptr) = (uint8_t) ((u16Value >> 8) & (uint16_t)0x00FF);
+//!-  Pages_Read_Retry() tells if a Writer ran during the Read.
+Bool Pages_Read_Retry(
+        Register_Page **const Pages,
+        uint32_t const First,
+        uint32_t const Last,
+        const uint32_t *const Sequences) {
+
+    uint32_t Page = 0;
+    Bool Retry = FALSE;
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    for (Page = First; (Page <= Last) && (Retry == FALSE); Page++) {
+        Retry = (Bool) (__atomic_load_n(&Pages[Page]->Sequence,
+                                        __ATOMIC_RELAXED) !=
+                        Sequences[Page - First]);
     }
-    if ( u8Byte0Ptr != NULL ) {
-        (*u8Byte0Ptr) = (uint8_t) ((u16Value) & (uint16_t)0x00FF);
+    return Retry;
+}
+
+//!-  Registers_Span_Copy() copies a validated Range Page by Page.
+void Registers_Span_Copy(
+        Register_Page **const Pages,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint8_t *const Buffer,
+        Register_Copy const Copy) {
+
+    uint32_t Address = Start;
+    uint32_t const End = (uint32_t) Start + Count;
+    uint32_t Span = 0;
+    uint8_t *Data = Buffer;
+    uint16_t *Slot = NULL;
+
+    while (Address < End) {
+        Span = REGISTER_PAGE_SIZE - (Address & REGISTER_PAGE_MASK);
+        if (Span > (End - Address)) {
+            Span = End - Address;
+        }
+        Slot = &Pages[Address >> REGISTER_PAGE_SHIFT]->
+                   Registers[Address & REGISTER_PAGE_MASK];
+        switch (Copy) {
+            case COPY_TO_WIRE:
+                Registers_To_Wire(Data, Slot, Span);
+                break;
+            case COPY_FROM_WIRE:
+                Registers_From_Wire(Slot, Data, Span);
+                break;
+            case COPY_TO_HOST:
+                memcpy(Data, Slot, Span * sizeof(uint16_t));
+                break;
+            case COPY_FROM_HOST:
+            default:
+                memcpy(Slot, Data, Span * sizeof(uint16_t));
+                break;
+        }
+        Data += Span * sizeof(uint16_t);
+        Address += Span;
     }
 }
 
 /*
- *!-  Pack8bits_16bits() to pack two Uint8 values into one Uint16 value.
- *!-  u8Byte1: Most Significant Byte.
- *!-  u8Byte0: Least Significant Byte.
+ *!-  Registers_Copy() moves "Count" Registers between a Unit and
+ *!-  "Buffer" under the Sequence Locks of the Pages involved.
+ *!-  A Write is atomic for every Reader; a Read retries until it
+ *!-  saw no Write, so it is a consistent Snapshot of the Range.
  */
-uint16_t Pack8bits_16bits(
-        const uint8_t u8Byte1,
-        const uint8_t u8Byte0) {
-    uint16_t u16Value = 0;
+Bool Registers_Copy(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint8_t *const Buffer,
+        Register_Copy const Copy) {
 
-    u16Value = ( ((uint16_t) u8Byte1) << 8) |
-               ((uint16_t) u8Byte0);
+    Bool Check_Ok = FALSE;
+    Register_Page **Pages = NULL;
+    uint32_t const First = (uint32_t) Start >> REGISTER_PAGE_SHIFT;
+    uint32_t const Last = ((uint32_t) Start + Count - 1) >> REGISTER_PAGE_SHIFT;
+    uint32_t Sequences[REGISTER_PAGES];
+
+    if ((Table == TABLE_INPUT_REGISTERS) ||
+        (Table == TABLE_HOLDING_REGISTERS)) {
+        Check_Ok = (Bool) ((Count != 0) &&
+                           (Modbus_Valid_Range(Unit, Table, Start,
+                                               Count) == TRUE));
+    }
+    if (Check_Ok == FALSE) {
+        //!-  Nothing to copy.
+    }
+    else if ((Copy == COPY_FROM_WIRE) || (Copy == COPY_FROM_HOST)) {
+        Pages = Page_Table(Unit, Table);
+        Pages_Write_Lock(Pages, First, Last);
+        Registers_Span_Copy(Pages, Start, Count, Buffer, Copy);
+        Pages_Write_Unlock(Pages, First, Last);
+        Modbus_Changes_Record(Unit, Table, Start, Count);
+    }
+    else {
+        Pages = Page_Table(Unit, Table);
+        do {
+            Pages_Read_Begin(Pages, First, Last, Sequences);
+            Registers_Span_Copy(Pages, Start, Count, Buffer, Copy);
+        } while (Pages_Read_Retry(Pages, First, Last, Sequences) == TRUE);
+    }
+    return Check_Ok;
+}
 
-    return u16Value;
+//!-  Clear_Frame() to Clear entire Frame Buffer.
+void Clear_Frame(
+        Modbus_Frame *const FramePtr) {
+
+    uint16_t Index = 0;
+    for (Index = 0; Index < MODBUS_MAX_ADU_LENGTH; Index++) {
+        FramePtr->Adu[Index] = 0;
+    }
+    FramePtr->Length = 0;
 }
 
 //!-  Set_Device_ID() to Set the Valid Device ID.
 Bool Set_Device_ID(
-        Modbus_Packet *const UsrPacket,
+        Modbus_Frame *const UsrFrame,
         uint8_t const UsrDevID) {
 
     Bool Is_Valid = FALSE;
 
     //!-  ID/Address are Reserved From 248 to 255
     if ((UsrDevID > 0) && (UsrDevID < 247)) {
-        UsrPacket->Device_ID = UsrDevID;
+        UsrFrame->Adu[FRAME_DEVICE_ID_OFFSET] = UsrDevID;
         Is_Valid = TRUE;
     }
     //!-  ID 0 is Kept Fixed for Master.
     else if (UsrDevID == MASTER) {
-        UsrPacket->Device_ID = MASTER;
+        UsrFrame->Adu[FRAME_DEVICE_ID_OFFSET] = MASTER;
         Is_Valid = TRUE;
     }
     else {
@@ -171,138 +379,9 @@ Bool Set_Device_ID(
     return Is_Valid;
 }
 
-/*
- *!-  Validate_Function_Code() will validate if the
- *!-  Provided Function Code is Valid or Not.
- */
-Bool Validate_Function_Code(
-        uint8_t const FunctionCode) {
-
-    Bool Ckeck_OK = FALSE;
-    switch(FunctionCode) {
-        case Fun_Code01:
-        case Fun_Code02:
-        case Fun_Code03:
-        case Fun_Code04:
-        case Fun_Code05:
-        case Fun_Code06:
-        case Fun_Code07:
-        case Fun_Code15:
-        case Fun_Code16:
-        case Fun_Code20:
-        case Fun_Code21:
-        case Fun_Code22:
-        case Fun_Code23:
-        case Fun_Code24:
-            Ckeck_OK = TRUE;
-            break;
-
-        default:
-            Ckeck_OK = FALSE;
-            break;
-    }
-    return Ckeck_OK;
-}
-
-/*
- *!-  Validate_Starting_Address() will validate if
- *!-  the Starting Address Provided is Valid or Invalid.
- */
-Bool Validate_Starting_Address(
-        uint8_t  const FunctionCode,
-        uint16_t const StartAddress) {
-
-    Bool Ckeck_OK = FALSE;
-    switch(FunctionCode) {
-        case Fun_Code01:
-        case Fun_Code05:
-        case Fun_Code15:
-            if ((StartAddress >= MIN_COILS_ADDRESS) &&
-                (StartAddress <= COILS_ADDR)) {
-                Ckeck_OK = TRUE;
-            }
-            break;
-        case Fun_Code02:
-            if ((StartAddress >= MIN_DISCRETE_INPUTS_ADDRESS) &&
-                (StartAddress <= DISCRETE_INPUTS_ADDR)) {
-                Ckeck_OK = TRUE;
-            }
-            break;
-        case Fun_Code03:
-        case Fun_Code06:
-        case Fun_Code16:
-        case Fun_Code23:
-            if ((StartAddress >= MIN_HOLDING_REGISTERS_ADDRESS) &&
-                (StartAddress <= HOLDING_REGISTERS_ADDR)) {
-                Ckeck_OK = TRUE;
-            }
-            break;
-        case Fun_Code04:
-            if ((StartAddress >= MIN_INPUT_REGISTERS_ADDRESS) &&
-                (StartAddress <= INPUT_REGISTERS_ADDR)) {
-                Ckeck_OK = TRUE;
-            }
-            break;
-        default:
-            Ckeck_OK = FALSE;
-            break;
-    }
-
-    return Ckeck_OK;
-}
-
-/*
- *!-  Validate_Registers_Quantity() will validate if
- *!-  the Quantity of Registers Provided is Valid or Invalid.
- */
-Bool Validate_Registers_Quantity(
-        uint8_t  const FunctionCode,
-        uint16_t const StartAddress,
-        uint16_t const RegisterNo) {
-
-    Bool Ckeck_OK = FALSE;
-    switch(FunctionCode) {
-        case Fun_Code01:
-        case Fun_Code15:
-            if ((RegisterNo >= MIN_COILS_NUMBERS) &&
-                (RegisterNo <= COILS_NUMBERS)     &&
-                (StartAddress + RegisterNo) <= COILS_ADDR) {
-                    Ckeck_OK = TRUE;
-            }
-            break;
-        case Fun_Code02:
-            if ((RegisterNo >= MIN_DISCRETE_INPUTS_NUMBERS) &&
-                (RegisterNo <= DISCRETE_INPUTS_NUMBERS)     &&
-                (StartAddress + RegisterNo) <= DISCRETE_INPUTS_ADDR) {
-                    Ckeck_OK = TRUE;
-             }
-             break;
-        case Fun_Code03:
-            if ((RegisterNo >= MIN_HOLDING_REGISTERS_NUMBERS) &&
-                (RegisterNo <= HOLDING_REGISTERS_NUMBERS)     &&
-                (StartAddress + RegisterNo) <= HOLDING_REGISTERS_ADDR) {
-                    Ckeck_OK = TRUE;
-            }
-             break;
-        case Fun_Code04:
-        case Fun_Code16:
-            if ((RegisterNo >= MIN_INPUT_REGISTERS_NUMBERS) &&
-                (RegisterNo <= INPUT_REGISTERS_NUMBERS)     &&
-                (StartAddress + RegisterNo) <= INPUT_REGISTERS_ADDR) {
-                    Ckeck_OK = TRUE;
-            }
-             break;
-        default:
-            Ckeck_OK = FALSE;
-            break;
-    }
-
-    return Ckeck_OK;
-}
-
 //!-  Set_Function_Code() to Set the Valid Device ID.
 Bool Set_Function_Code(
-        Modbus_Packet *const UsrPacket,
+        Modbus_Frame *const UsrFrame,
         uint8_t const UsrFunctCode) {
 
     Bool Is_Valid = FALSE;
@@ -310,7 +389,7 @@ Bool Set_Function_Code(
     Is_Valid = Validate_Function_Code(UsrFunctCode);
 
     if (Is_Valid != FALSE) {
-        UsrPacket->Function_Code = UsrFunctCode;
+        UsrFrame->Adu[FRAME_FUNCTION_CODE_OFFSET] = UsrFunctCode;
         Is_Valid = TRUE;
     }
     return Is_Valid;
@@ -318,7 +397,7 @@ Bool Set_Function_Code(
 
 //!-  Set_StartAddress() to Set the Valid Starting Address
 Bool Set_StartAddress(
-        Modbus_Packet *const UsrPacket,
+        Modbus_Frame *const UsrFrame,
         uint16_t const UsrStartAddress,
         uint8_t  const FunctionCode) {
 
@@ -332,16 +411,16 @@ Bool Set_StartAddress(
         //!-  Unpack 16Bit Address into 8Bit-MSB & 8Bit-LSB.
         Unpack16bits_8bits(UsrStartAddress, &Address[1], &Address[0]);
         //!-  Fill MSB in Address_Hi.
-        UsrPacket->Address_Hi = Address[1];
+        UsrFrame->Adu[FRAME_ADDRESS_OFFSET] = Address[1];
         //!-  Fill LSB in Address_Low.
-        UsrPacket->Address_Low = Address[0];
+        UsrFrame->Adu[FRAME_ADDRESS_OFFSET + 1] = Address[0];
     }
     return Is_Valid;
 }
 
 //!-  Set_Register_Quantity() to Set the Valid Starting Address
 Bool Set_Register_Quantity(
-        Modbus_Packet const *UsrPacket,
+        Modbus_Frame *const UsrFrame,
         uint16_t const UsrRegQuantity,
         uint8_t  const FunctionCode,
         uint16_t const StartAddress) {
@@ -356,9 +435,9 @@ Bool Set_Register_Quantity(
         //!-  Unpack 16Bit Address into 8Bit-MSB & 8Bit-LSB.
         Unpack16bits_8bits(UsrRegQuantity, &RegisterNo[1], &RegisterNo[0]);
         //!-  Fill MSB in Registers_Quantity_Hi.
-        UsrPacket->Registers_Quantity_Hi = RegisterNo[1];
+        UsrFrame->Adu[FRAME_QUANTITY_OFFSET] = RegisterNo[1];
         //!-  Fill LSB in Registers_Quantity_Low.
-        UsrPacket->Registers_Quantity_Low = RegisterNo[0];
+        UsrFrame->Adu[FRAME_QUANTITY_OFFSET + 1] = RegisterNo[0];
     }
     return Is_Valid;
 }
@@ -372,7 +451,7 @@ uint8_t Get_Exception_FunctCode(
 
     uint8_t exception = 0;
 
-    exception = ((FunctionCode) || MSB1);
+    exception = ((FunctionCode) | MSB1);
     return exception;
 }
 
@@ -408,79 +487,243 @@ uint8_t Get_Byte_Counts(
 !-  GLOBAL FUNCTIONS
 *****************************************************************************/
 
+/*
+ *!-  Unpack16bits_8bits() to unpack an Uint16 into two Uint8 values.
+ *!-  u16Value: 16-bit value to be unpacked into 8-bit parts.
+ *!-  u8Byte1Ptr: Pointer to 8-bit destination for MSB.
+ *!-  u8Byte0Ptr: Pointer to 8-bit destination for LSB.
+ */
+void Unpack16bits_8bits(
+        const uint16_t u16Value,
+        uint8_t *const u8Byte1Ptr,
+        uint8_t *const u8Byte0Ptr) {
+
+    if ( u8Byte1Ptr != NULL ) {
+        (*u8Byte1Ptr) = (uint8_t) ((u16Value >> 8) & (uint16_t)0x00FF);
+    }
+    if ( u8Byte0Ptr != NULL ) {
+        (*u8Byte0Ptr) = (uint8_t) ((u16Value) & (uint16_t)0x00FF);
+    }
+}
+
+/*
+ *!-  Pack8bits_16bits() to pack two Uint8 values into one Uint16 value.
+ *!-  u8Byte1: Most Significant Byte.
+ *!-  u8Byte0: Least Significant Byte.
+ */
+uint16_t Pack8bits_16bits(
+        const uint8_t u8Byte1,
+        const uint8_t u8Byte0) {
+    uint16_t u16Value = 0;
+
+    u16Value = ( ((uint16_t) u8Byte1) << 8) |
+               ((uint16_t) u8Byte0);
+
+    return u16Value;
+}
+
 //!-  Modbus_Init() for Initializing MODBUS Module.
 Bool Modbus_Init(
         void) {
 
     Bool Ckeck_OK = TRUE;
 
-    if (COILS_NUMBERS != MIN_COILS_NUMBERS) {
-        if (COILS_NUMBERS > MAX_COILS_NUMBERS) {
-            Ckeck_OK = FALSE;
-        }
+    //!-  The configured Device (see DEVICE_LIMIT) is the Default Unit.
+    (void) Modbus_Remove_Unit(MODBUS_DEFAULT_UNIT);
+    if (Modbus_Add_Unit(MODBUS_DEFAULT_UNIT,
+                        COILS_NUMBERS, DISCRETE_INPUTS_NUMBERS,
+                        INPUT_REGISTERS_NUMBERS,
+                        HOLDING_REGISTERS_NUMBERS) == NULL) {
+        Ckeck_OK = FALSE;
     }
+    return Ckeck_OK;
+}
 
-    if (DISCRETE_INPUTS_NUMBERS != MIN_DISCRETE_INPUTS_NUMBERS) {
-        if (DISCRETE_INPUTS_NUMBERS > MAX_DISCRETE_INPUTS_NUMBERS) {
-            Ckeck_OK = FALSE;
-        }
+/*
+ *!-  Modbus_Add_Unit() hosts a Unit with its own, zeroed Database.
+ *!-  The Bit Tables get the given Sizes (0 to MAX_UNIT_ITEMS); the
+ *!-  Registers 0 .. Number - 1 of each Register Table are mapped,
+ *!-  more Blocks can be added with Modbus_Map_Registers().
+ *!-  Returns the Database, or NULL if the Device_ID is invalid,
+ *!-  already hosted, or the Memory is not available.
+ */
+Modbus_Data *Modbus_Add_Unit(
+        uint8_t  const Device_ID,
+        uint32_t const Coils_Number,
+        uint32_t const DInputs_Number,
+        uint32_t const IRegisters_Number,
+        uint32_t const HRegisters_Number) {
+
+    Modbus_Data *Unit = NULL;
+    uint8_t *Base = NULL;
+    size_t const Coils_Bytes = TABLE_BYTES(
+        (Coils_Number + BITS_PER_WORD - 1) / BITS_PER_WORD, Coils);
+    size_t const DInputs_Bytes = TABLE_BYTES(
+        (DInputs_Number + BITS_PER_WORD - 1) / BITS_PER_WORD, Discrete_Inputs);
+    size_t const Bytes = UNIT_HEADER_BYTES + Coils_Bytes + DInputs_Bytes;
+
+    if ((Device_ID >= MIN_DEVICE_ID) && (Device_ID <= MAX_DEVICE_ID) &&
+        (MODBUS_UNITS[Device_ID] == NULL) &&
+        (Coils_Number <= MAX_UNIT_ITEMS) &&
+        (DInputs_Number <= MAX_UNIT_ITEMS) &&
+        (IRegisters_Number <= MAX_UNIT_ITEMS) &&
+        (HRegisters_Number <= MAX_UNIT_ITEMS)) {
+        Base = aligned_alloc(MODBUS_CACHE_LINE, Bytes);
     }
 
-    if (INPUT_REGISTERS_NUMBERS != MIN_INPUT_REGISTERS_NUMBERS) {
-        if (INPUT_REGISTERS_NUMBERS > MAX_INPUT_REGISTERS_NUMBERS) {
-            Ckeck_OK = FALSE;
+    if (Base != NULL) {
+        Unit = (Modbus_Data *) Base;
+        Clear_AllData(Unit, Bytes);
+        Unit->Device_ID = Device_ID;
+        Unit->Numbers[TABLE_COILS] = Coils_Number;
+        Unit->Numbers[TABLE_DISCRETE_INPUTS] = DInputs_Number;
+
+        Base += UNIT_HEADER_BYTES;
+        Unit->Coils = (Coils *) Base;
+        Base += Coils_Bytes;
+        Unit->DInputs = (Discrete_Inputs *) Base;
+
+        MODBUS_UNITS[Device_ID] = Unit;
+        if ((Modbus_Map_Registers(Unit, TABLE_INPUT_REGISTERS,
+                                  0, IRegisters_Number) == FALSE) ||
+            (Modbus_Map_Registers(Unit, TABLE_HOLDING_REGISTERS,
+                                  0, HRegisters_Number) == FALSE)) {
+            (void) Modbus_Remove_Unit(Device_ID);
+            Unit = NULL;
         }
     }
+    return Unit;
+}
 
-    if (HOLDING_REGISTERS_NUMBERS != MIN_HOLDING_REGISTERS_NUMBERS) {
-        if (HOLDING_REGISTERS_NUMBERS > MAX_HOLDING_REGISTERS_NUMBERS) {
-            Ckeck_OK = FALSE;
+/*
+ *!-  Modbus_Remove_Unit() stops hosting a Unit and frees its
+ *!-  Database; of a Shared Unit only the Header, the Process
+ *!-  Image keeps the Values. It must not race with Requests
+ *!-  being served.
+ */
+Bool Modbus_Remove_Unit(
+        uint8_t const Device_ID) {
+
+    Bool Check_Ok = FALSE;
+    Modbus_Data *const Unit = MODBUS_UNITS[Device_ID];
+    uint32_t Index = 0;
+
+    if (Unit != NULL) {
+        for (Index = 0; (Index < REGISTER_PAGES) &&
+                        (Unit->Shared == FALSE); Index++) {
+            free(Unit->IPages[Index]);
+            free(Unit->HPages[Index]);
         }
+        Modbus_Untrack_Changes(Unit);
+        Modbus_Unmap_Files(Unit);
+        Modbus_Remove_Fifos(Unit);
+        free(Unit);
+        MODBUS_UNITS[Device_ID] = NULL;
+        Check_Ok = TRUE;
     }
-
-    Clear_AllData();
-    return Ckeck_OK;
+    return Check_Ok;
 }
 
 /*
- *!-  Calculate_CRC16() to calculate the CRC of the Message Frame.
- *!-  unsigned char *MsgBuffer: Message to Calculate CRC Upon.
- *!-  unsigned uint16_t DataLength: Quantity of Bytes in Message.
+ *!-  Modbus_Map_Registers() makes the Input/Holding Registers
+ *!-  Start .. Start + Count - 1 of a Unit exist (reading 0 until
+ *!-  written), allocating their Pages on Demand. Registers that
+ *!-  are already mapped keep their Value. Units of a Process Image
+ *!-  are mapped with Modbus_Image_Map_Registers() instead.
  */
-uint16_t Calculate_CRC16(
-        uint8_t *MsgBuffer,
-        uint16_t DataLength) {
+Bool Modbus_Map_Registers(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint32_t const Count) {
 
-    //!-  High Byte of CRC initialized
-    unsigned char CRCHi = 0xFF;
-    //!-  Low Byte of CRC initialized
-    unsigned char CRCLo = 0xFF;
-    //!-  Will index into CRC lookup table
-    unsigned  uIndex;
+    Bool Check_Ok = FALSE;
+    Register_Page **const Pages = Page_Table(Unit, Table);
+    Register_Page *Page = NULL;
+    uint32_t Address = Start;
+    uint32_t const End = (uint32_t) Start + Count;
+    uint64_t Bit = 0;
+
+    if ((Pages != NULL) && (End <= MAX_UNIT_ITEMS) &&
+        (Unit->Shared == FALSE)) {
+        Check_Ok = TRUE;
+    }
+    while ((Check_Ok == TRUE) && (Address < End)) {
+        Page = Pages[Address >> REGISTER_PAGE_SHIFT];
+        if (Page == NULL) {
+            Page = aligned_alloc(MODBUS_CACHE_LINE, sizeof(Register_Page));
+            if (Page == NULL) {
+                Check_Ok = FALSE;
+                break;
+            }
+            memset(Page, 0, sizeof(Register_Page));
+            Pages[Address >> REGISTER_PAGE_SHIFT] = Page;
+        }
+        Bit = 1ULL << (Address % BITS_PER_WORD);
+        if ((Page->Valid[(Address & REGISTER_PAGE_MASK) / BITS_PER_WORD] &
+             Bit) == 0) {
+            Page->Valid[(Address & REGISTER_PAGE_MASK) / BITS_PER_WORD] |= Bit;
+            Unit->Numbers[Table]++;
+        }
+        Address++;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Valid_Range() tells if all "Count" Items from Address
+ *!-  "Start" exist in a Table of the Unit. For Registers this is
+ *!-  the Page Lookup itself: a missing Page or a clear Validity
+ *!-  Bit makes the Range invalid.
+ */
+Bool Modbus_Valid_Range(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count) {
 
-    //!-  Pass through message buffer
-    while(DataLength --) {
-        //!-  Calculate the CRC
-        uIndex = (CRCHi ^ *MsgBuffer++);
-        CRCHi = (CRCLo ^ auchCRCHi[uIndex]);
-        CRCLo = auchCRCLo[uIndex];
+    Bool Check_Ok = FALSE;
+    Register_Page **const Pages = (Unit != NULL) ?
+                                  Page_Table(Unit, Table) : NULL;
+    const Register_Page *Page = NULL;
+    uint32_t Address = Start;
+    uint32_t const End = (uint32_t) Start + Count;
+    uint32_t Span = 0;
+
+    if (Unit == NULL) {
+        Check_Ok = FALSE;
+    }
+    else if (Pages == NULL) {
+        Check_Ok = (Bool) ((Table < MODBUS_TABLES) &&
+                           (End <= Unit->Numbers[Table]));
     }
-    return (CRCHi << 8 | CRCLo);
+    else {
+        Check_Ok = (Bool) (End <= MAX_UNIT_ITEMS);
+        while ((Check_Ok == TRUE) && (Address < End)) {
+            Span = REGISTER_PAGE_SIZE - (Address & REGISTER_PAGE_MASK);
+            if (Span > (End - Address)) {
+                Span = End - Address;
+            }
+            Page = Pages[Address >> REGISTER_PAGE_SHIFT];
+            Check_Ok = (Bool) ((Page != NULL) &&
+                               (Page_Valid(Page, Address & REGISTER_PAGE_MASK,
+                                           (uint16_t) Span) == TRUE));
+            Address += Span;
+        }
+    }
+    return Check_Ok;
 }
 
-//!-  Set_Single_Coil() for writing a single Coil.
+//!-  Set_Single_Coil() for writing a single Coil of the Default Unit.
 Bool Set_Single_Coil(
         uint8_t const Coil_Number,
         uint8_t const Value) {
 
-    Bool Check_Ok = FALSE;
-    uint8_t Index = 0;
-    Index = Coil_Number - 1;
-    if (Index <= COILS_ADDR) {
-        MODBUS_DATABASE->Coils[Index] = Value;
-        Check_Ok = TRUE;
-    }
-    return Check_Ok;
+    uint8_t const Bit = (Value != OFF) ? ON : OFF;
+
+    return (Bool) ((Coil_Number != ABSENT) &&
+                   (Write_Bits(MODBUS_UNITS[MODBUS_DEFAULT_UNIT], TABLE_COILS,
+                               (uint16_t) (Coil_Number - 1), 1, &Bit) == TRUE));
 }
 
 //!-  Set_Single_Discrete_Input() for writing a single Discrete Input.
@@ -488,14 +731,12 @@ Bool Set_Single_Discrete_Input(
         uint8_t const DInput_Number,
         uint8_t const Value) {
 
-    Bool Check_Ok = FALSE;
-    uint8_t Index = 0;
-    Index = DInput_Number - 1;
-    if (Index <= DISCRETE_INPUTS_ADDR) {
-        MODBUS_DATABASE->DInputs[Index] = Value;
-        Check_Ok = TRUE;
-    }
-    return Check_Ok;
+    uint8_t const Bit = (Value != OFF) ? ON : OFF;
+
+    return (Bool) ((DInput_Number != ABSENT) &&
+                   (Write_Bits(MODBUS_UNITS[MODBUS_DEFAULT_UNIT],
+                               TABLE_DISCRETE_INPUTS,
+                               (uint16_t) (DInput_Number - 1), 1, &Bit) == TRUE));
 }
 
 //!-  Set_Single_Input_Register() for writing a single Input Register.
@@ -504,11 +745,11 @@ Bool Set_Single_Input_Register(
         uint16_t const Value) {
 
     Bool Check_Ok = FALSE;
-    uint16_t Index = 0;
-    Index = InputReg_Number - 1;
-    if (Index <= DISCRETE_INPUTS_ADDR) {
-        MODBUS_DATABASE->IRegisters[Index] = Value;
-        Check_Ok = TRUE;
+
+    if (InputReg_Number != ABSENT) {
+        Check_Ok = Modbus_Publish_Registers(MODBUS_UNITS[MODBUS_DEFAULT_UNIT],
+                                            TABLE_INPUT_REGISTERS,
+                                            (uint16_t) (InputReg_Number - 1), 1, &Value);
     }
     return Check_Ok;
 }
@@ -519,25 +760,24 @@ Bool Set_Single_Holding_Register(
         uint16_t const Value) {
 
     Bool Check_Ok = FALSE;
-    uint16_t Index = 0;
-    Index = HoldingReg_Number - 1;
-    if (Index <= DISCRETE_INPUTS_ADDR) {
-        MODBUS_DATABASE->HRegisters[Index] = Value;
-        Check_Ok = TRUE;
+
+    if (HoldingReg_Number != ABSENT) {
+        Check_Ok = Modbus_Publish_Registers(MODBUS_UNITS[MODBUS_DEFAULT_UNIT],
+                                            TABLE_HOLDING_REGISTERS,
+                                            (uint16_t) (HoldingReg_Number - 1), 1, &Value);
     }
     return Check_Ok;
 }
 
-//!-  Get_Single_Coil() to obtain a single Coil.
+//!-  Get_Single_Coil() to obtain a single Coil of the Default Unit.
 uint8_t Get_Single_Coil(
         uint8_t const Coil_Number) {
 
     uint8_t Value = 0;
-    uint8_t Index = 0;
-    if ((Coil_Number != ABSENT) &&
-        (Coil_Number <= COILS_NUMBERS)) {
-        Index = Coil_Number - 1;
-        Value = MODBUS_DATABASE->Coils[Index];
+
+    if (Coil_Number != ABSENT) {
+        (void) Read_Bits(MODBUS_UNITS[MODBUS_DEFAULT_UNIT], TABLE_COILS,
+                         (uint16_t) (Coil_Number - 1), 1, &Value);
     }
     return Value;
 }
@@ -547,11 +787,11 @@ uint8_t Get_Single_Discrete_Input(
         uint8_t const DInput_Number) {
 
     uint8_t Value = 0;
-    uint8_t Index = 0;
-    if ((DInput_Number != ABSENT) &&
-        (DInput_Number <= DISCRETE_INPUTS_NUMBERS)) {
-        Index = DInput_Number - 1;
-        Value = MODBUS_DATABASE->DInputs[Index];
+
+    if (DInput_Number != ABSENT) {
+        (void) Read_Bits(MODBUS_UNITS[MODBUS_DEFAULT_UNIT],
+                         TABLE_DISCRETE_INPUTS,
+                         (uint16_t) (DInput_Number - 1), 1, &Value);
     }
     return Value;
 }
@@ -561,11 +801,11 @@ uint16_t Get_Single_Input_Register(
         uint16_t const InputReg_Number) {
 
     uint16_t Value = 0;
-    uint16_t Index = 0;
-    if ((InputReg_Number != ABSENT) &&
-        (InputReg_Number <= INPUT_REGISTERS_NUMBERS)) {
-        Index = InputReg_Number - 1;
-        Value = MODBUS_DATABASE->IRegisters[Index];
+
+    if (InputReg_Number != ABSENT) {
+        (void) Modbus_Snapshot_Registers(MODBUS_UNITS[MODBUS_DEFAULT_UNIT],
+                                         TABLE_INPUT_REGISTERS,
+                                         (uint16_t) (InputReg_Number - 1), 1, &Value);
     }
     return Value;
 }
@@ -575,29 +815,280 @@ uint16_t Get_Single_Holding_Register(
         uint16_t const HoldingReg_Number) {
 
     uint16_t Value = 0;
-    uint16_t Index = 0;
-    if ((HoldingReg_Number != ABSENT) &&
-        (HoldingReg_Number <= HOLDING_REGISTERS_NUMBERS)) {
-        Index = HoldingReg_Number - 1;
-        Value = MODBUS_DATABASE->HRegisters[Index];
+
+    if (HoldingReg_Number != ABSENT) {
+        (void) Modbus_Snapshot_Registers(MODBUS_UNITS[MODBUS_DEFAULT_UNIT],
+                                         TABLE_HOLDING_REGISTERS,
+                                         (uint16_t) (HoldingReg_Number - 1), 1, &Value);
     }
     return Value;
 }
 
-Bool Modbus_Request(
-        uint8_t const Device_ID,
-        uint8_t const ReqFunctionCode) {
+/*
+ *!-  Read_Bits() packs "Count" Coils/Discrete Inputs of a Unit
+ *!-  starting at Address "Start" into "OutBytes" in Wire Order, as
+ *!-  used by the FC01/FC02 Response Payload. The Range is checked once.
+ */
+Bool Read_Bits(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint8_t *const OutBytes) {
 
     Bool Check_Ok = FALSE;
+    uint32_t const End = (uint32_t) Start + Count;
 
+    if (Unit == NULL) {
+        Check_Ok = FALSE;
+    }
+    else if ((Table == TABLE_COILS) &&
+             (End <= Unit->Numbers[TABLE_COILS])) {
+        Bits_Extract(Unit->Coils, Start, Count, OutBytes);
+        Check_Ok = TRUE;
+    }
+    else if ((Table == TABLE_DISCRETE_INPUTS) &&
+             (End <= Unit->Numbers[TABLE_DISCRETE_INPUTS])) {
+        Bits_Extract(Unit->DInputs, Start, Count, OutBytes);
+        Check_Ok = TRUE;
+    }
+    else {
+        Check_Ok = FALSE;
+    }
     return Check_Ok;
 }
 
-Bool Modbus_Response(
-        uint8_t const Device_ID,
-        uint8_t const RspFunctionCode) {
+/*
+ *!-  Write_Bits() stores "Count" Bits from "InBytes" (Wire Order,
+ *!-  as in an FC15 Request Payload) starting at Address "Start"
+ *!-  and records the Write for Change Tracking.
+ */
+Bool Write_Bits(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        const uint8_t *const InBytes) {
 
     Bool Check_Ok = FALSE;
+    uint32_t const End = (uint32_t) Start + Count;
+
+    if (Unit == NULL) {
+        Check_Ok = FALSE;
+    }
+    else if ((Table == TABLE_COILS) &&
+             (End <= Unit->Numbers[TABLE_COILS])) {
+        Bits_Insert(Unit->Coils, Start, Count, InBytes);
+        Check_Ok = TRUE;
+    }
+    else if ((Table == TABLE_DISCRETE_INPUTS) &&
+             (End <= Unit->Numbers[TABLE_DISCRETE_INPUTS])) {
+        Bits_Insert(Unit->DInputs, Start, Count, InBytes);
+        Check_Ok = TRUE;
+    }
+    else {
+        Check_Ok = FALSE;
+    }
+    if (Check_Ok == TRUE) {
+        Modbus_Changes_Record(Unit, Table, Start, Count);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Read_Registers() copies "Count" Input/Holding Registers of a
+ *!-  Unit starting at Address "Start" to "BeOut" in Big-Endian Wire
+ *!-  Order, as used by the FC03/FC04 Response Payload. The Range is
+ *!-  validated first, then read as one consistent Snapshot.
+ */
+Bool Read_Registers(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint8_t *const BeOut) {
+
+    return Registers_Copy(Unit, Table, Start, Count, BeOut, COPY_TO_WIRE);
+}
+
+/*
+ *!-  Write_Registers() stores "Count" Big-Endian Registers from
+ *!-  "BeIn" (as in an FC16/FC23 Request Payload) starting at
+ *!-  Address "Start". Nothing is written unless all exist, and
+ *!-  no Reader sees the Range half written.
+ */
+Bool Write_Registers(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        const uint8_t *const BeIn) {
+
+    return Registers_Copy(Unit, Table, Start, Count, (uint8_t *) BeIn,
+                          COPY_FROM_WIRE);
+}
+
+/*
+ *!-  Mask_Write_Register() serves FC22 on Holding Register
+ *!-  "Address": (Current AND And_Mask) OR (Or_Mask AND NOT And_Mask).
+ *!-  The Register is read and written under its Page's Write Lock,
+ *!-  so no other Write lands in between, as it would between the
+ *!-  Read and the Write of a Master doing it in two Requests.
+ */
+Bool Mask_Write_Register(
+        Modbus_Data *const Unit,
+        uint16_t const Address,
+        uint16_t const And_Mask,
+        uint16_t const Or_Mask) {
+
+    Bool Check_Ok = Modbus_Valid_Range(Unit, TABLE_HOLDING_REGISTERS,
+                                       Address, 1);
+    uint32_t const Page = (uint32_t) Address >> REGISTER_PAGE_SHIFT;
+    Register_Page **Pages = NULL;
+    uint16_t *Slot = NULL;
+
+    if (Check_Ok == TRUE) {
+        Pages = Page_Table(Unit, TABLE_HOLDING_REGISTERS);
+        Slot = &Pages[Page]->Registers[Address & REGISTER_PAGE_MASK];
+        Pages_Write_Lock(Pages, Page, Page);
+        *Slot = (uint16_t) ((*Slot & And_Mask) | (Or_Mask & ~And_Mask));
+        Pages_Write_Unlock(Pages, Page, Page);
+        Modbus_Changes_Record(Unit, TABLE_HOLDING_REGISTERS, Address, 1);
+    }
+    return Check_Ok;
+}
 
+/*
+ *!-  Read_Write_Registers() serves FC23: it stores "Write_Count"
+ *!-  Holding Registers from "BeIn", then reads "Read_Count" of them
+ *!-  to "BeOut", both in Wire Order, as one Transaction. The Pages
+ *!-  of both Ranges are write-locked (in ascending Order, merged
+ *!-  when they touch) for its whole Duration, so no other Write
+ *!-  comes between, and Readers see the Write all or nothing.
+ *!-  Nothing is done unless both Ranges exist.
+ */
+Bool Read_Write_Registers(
+        Modbus_Data *const Unit,
+        uint16_t const Write_Start,
+        uint16_t const Write_Count,
+        const uint8_t *const BeIn,
+        uint16_t const Read_Start,
+        uint16_t const Read_Count,
+        uint8_t *const BeOut) {
+
+    Bool Check_Ok = FALSE;
+    Register_Page **Pages = NULL;
+    uint32_t Spans[2][2] = {
+        { (uint32_t) Write_Start >> REGISTER_PAGE_SHIFT,
+          ((uint32_t) Write_Start + Write_Count - 1) >> REGISTER_PAGE_SHIFT },
+        { (uint32_t) Read_Start >> REGISTER_PAGE_SHIFT,
+          ((uint32_t) Read_Start + Read_Count - 1) >> REGISTER_PAGE_SHIFT },
+    };
+    uint32_t Span_Count = 2;
+    uint32_t Span = 0;
+    uint32_t Swap = 0;
+
+    Check_Ok = (Bool) ((Write_Count != 0) && (Read_Count != 0) &&
+                       (Modbus_Valid_Range(Unit, TABLE_HOLDING_REGISTERS,
+                                           Write_Start, Write_Count) == TRUE) &&
+                       (Modbus_Valid_Range(Unit, TABLE_HOLDING_REGISTERS,
+                                           Read_Start, Read_Count) == TRUE));
+    if (Check_Ok == TRUE) {
+        if (Spans[1][0] < Spans[0][0]) {
+            for (Span = 0; Span < 2; Span++) {
+                Swap = Spans[0][Span];
+                Spans[0][Span] = Spans[1][Span];
+                Spans[1][Span] = Swap;
+            }
+        }
+        if (Spans[1][0] <= (Spans[0][1] + 1)) {
+            if (Spans[1][1] > Spans[0][1]) {
+                Spans[0][1] = Spans[1][1];
+            }
+            Span_Count = 1;
+        }
+
+        Pages = Page_Table(Unit, TABLE_HOLDING_REGISTERS);
+        for (Span = 0; Span < Span_Count; Span++) {
+            Pages_Write_Lock(Pages, Spans[Span][0], Spans[Span][1]);
+        }
+        Registers_Span_Copy(Pages, Write_Start, Write_Count, (uint8_t *) BeIn,
+                            COPY_FROM_WIRE);
+        Registers_Span_Copy(Pages, Read_Start, Read_Count, BeOut, COPY_TO_WIRE);
+        for (Span = 0; Span < Span_Count; Span++) {
+            Pages_Write_Unlock(Pages, Spans[Span][0], Spans[Span][1]);
+        }
+        Modbus_Changes_Record(Unit, TABLE_HOLDING_REGISTERS, Write_Start,
+                              Write_Count);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Snapshot_Registers() copies "Count" Registers in Host
+ *!-  Order to "Values" as one consistent Snapshot, e.g. both Words
+ *!-  of a 32-bit Float. It never blocks a Writer: it only retries
+ *!-  when one published in the Meantime.
+ */
+Bool Modbus_Snapshot_Registers(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint16_t *const Values) {
+
+    return Registers_Copy(Unit, Table, Start, Count, (uint8_t *) Values,
+                          COPY_TO_HOST);
+}
+
+/*
+ *!-  Modbus_Publish_Registers() stores "Count" Host-Order Registers
+ *!-  from "Values" as one atomic Update for every Reader, Modbus
+ *!-  Requests and Modbus_Snapshot_Registers() alike.
+ */
+Bool Modbus_Publish_Registers(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        const uint16_t *const Values) {
+
+    return Registers_Copy(Unit, Table, Start, Count, (uint8_t *) Values,
+                          COPY_FROM_HOST);
+}
+
+/*
+ *!-  Modbus_Request() builds a Master Request (without CRC) for the
+ *!-  Read (FC01..FC04) and Write Single (FC05/FC06) Function Codes.
+ *!-  "Argument" is the Quantity of a Read or the Value of a Write.
+ */
+Bool Modbus_Request(
+        Modbus_Frame *const Request,
+        uint8_t  const Device_ID,
+        uint8_t  const ReqFunctionCode,
+        uint16_t const Address,
+        uint16_t const Argument) {
+
+    Bool Check_Ok = FALSE;
+
+    switch (ReqFunctionCode) {
+        case Fun_Code01:
+        case Fun_Code02:
+        case Fun_Code03:
+        case Fun_Code04:
+            Check_Ok = Frame_Build_Read_Request(
+                           Request, Device_ID, ReqFunctionCode,
+                           Address, Argument);
+            break;
+        case Fun_Code05:
+        case Fun_Code06:
+            Check_Ok = Frame_Build_Write_Single(
+                           Request, Device_ID, ReqFunctionCode,
+                           Address, Argument);
+            break;
+        default:
+            Check_Ok = FALSE;
+            break;
+    }
     return Check_Ok;
 }
@@ -20,7 +20,9 @@
 !-  GLOBAL DEFINITIONS
 *****************************************************************************/
 
-#define NULL  __null
+#ifndef NULL
+#define NULL  ((void *)0)
+#endif
 
 #define TRUE   1
 #define FALSE  0
@@ -28,7 +30,11 @@
 #define OFF    0
 #define ABSENT 0
 
-#define MASTER  0
+#define MASTER     0
+#define BROADCAST  0
+
+//!-  Unit ID addressing a Modbus TCP Server itself.
+#define TCP_SERVER_UNIT  0xFF
 
 #define MSB1  0x80
 
@@ -41,25 +47,121 @@
 #define MINREGISTERQUANTITY  0x0001
 #define MAXREGISTERQUANTITY  0x07D0
 
+#define MAXREADREGQUANTITY    0x007D
+#define MAXWRITECOILQUANTITY  0x07B0
+#define MAXWRITEREGQUANTITY   0x007B
+//!-  FC23 Write Quantity; its Read Quantity is MAXREADREGQUANTITY.
+#define MAXRWWRITEREGQUANTITY 0x0079
+
+#define COIL_ON   0xFF00
+#define COIL_OFF  0x0000
+
+//!-  Unit IDs a Slave answers to (248 to 255 are Reserved).
+#define MIN_DEVICE_ID  1
+#define MAX_DEVICE_ID  246
+
+//!-  Unit Table: one Slot per possible Device_ID.
+#define MODBUS_UNIT_SLOTS  256
+//!-  Unit the single-Device Functions (Set_Single_*, ...) work on.
+#define MODBUS_DEFAULT_UNIT  1
+//!-  Largest Table of a Unit: the whole 16-bit Address Space.
+#define MAX_UNIT_ITEMS  (65536UL)
+
+#define MODBUS_TABLES      4
+#define MODBUS_CACHE_LINE  64
+
+//!-  Spin-Wait Hint for the Sequence and Layout Locks.
+#if defined(__x86_64__) || defined(__i386__)
+#define MODBUS_CPU_PAUSE()  __builtin_ia32_pause()
+#else
+#define MODBUS_CPU_PAUSE()  do { } while (0)
+#endif
+
+/*
+ *!-  Registers are stored in Pages of REGISTER_PAGE_SIZE, found
+ *!-  through a Page Table indexed by (Address >> REGISTER_PAGE_SHIFT).
+ */
+#define REGISTER_PAGE_SHIFT  8
+#define REGISTER_PAGE_SIZE   (1U << REGISTER_PAGE_SHIFT)
+#define REGISTER_PAGE_MASK   (REGISTER_PAGE_SIZE - 1)
+#define REGISTER_PAGES       (MAX_UNIT_ITEMS / REGISTER_PAGE_SIZE)
+
 /****************************************************************************
 !-  GLOBAL TYPE DEFINITIONS
 *****************************************************************************/
 
+/*
+ *!-  "Modbus_Table" ENUM names the four Tables of
+ *!-  the Database for the Bulk Access Functions.
+ */
+typedef enum {
+    TABLE_COILS             = 0,
+    TABLE_DISCRETE_INPUTS   = 1,
+    TABLE_INPUT_REGISTERS   = 2,
+    TABLE_HOLDING_REGISTERS = 3,
+} Modbus_Table;
+
+/*
+ *!-  "Register_Page" holds REGISTER_PAGE_SIZE Registers.
+ *!-  Valid:
+ *!-  One Bit per Register (LSB-first per Word); only Registers
+ *!-  with their Bit set exist on the Device, all others answer
+ *!-  ILLEGAL_DATA_ADDRESS.
+ *!-  Sequence:
+ *!-  Sequence Lock of the Registers, odd while a Writer updates
+ *!-  them. Readers copy and retry if it moved, so they never
+ *!-  block a Writer and never see a Multi-Register Value torn.
+ */
+typedef struct {
+    uint64_t  Valid[REGISTER_PAGE_SIZE / BITS_PER_WORD];
+    uint32_t  Sequence;
+    uint16_t  Registers[REGISTER_PAGE_SIZE];
+} __attribute__((aligned(MODBUS_CACHE_LINE))) Register_Page;
+
 /*
  *!-  "Modbus_Data" STRUCTURE has All
- *!-  the DATATYPES Supported by MODBUS Protocol.
- *!-  The Values in Member can be set as per
- *!-  the Device Requirements.
+ *!-  the DATATYPES Supported by MODBUS Protocol
+ *!-  for one Unit (Device_ID) hosted by this Process.
+ *!-  Numbers:
+ *!-  Size of the Bit Tables and Number of mapped Registers,
+ *!-  indexed by Modbus_Table.
+ *!-  Coils/DInputs hold one Bit per Coil/Input: Address N
+ *!-  is Bit (N % 64) of Word (N / 64). They are sized by
+ *!-  Modbus_Add_Unit() and share its Allocation.
+ *!-  IPages/HPages:
+ *!-  Page Tables of the Input/Holding Registers. A Page is
+ *!-  allocated only once a Register in it is mapped with
+ *!-  Modbus_Map_Registers(), so Memory follows the populated
+ *!-  Registers, not the Span of the Address Space.
+ *!-  Shared:
+ *!-  TRUE when the Tables live in a Process Image (see
+ *!-  Modbus_Image.h); only this Header belongs to the Unit.
+ *!-  Changes:
+ *!-  Write Tracking (see Modbus_Changes.h), NULL when off.
+ *!-  Files:
+ *!-  FC20/FC21 Files (see Modbus_File.h), NULL when none.
+ *!-  Fifos:
+ *!-  FC24 FIFOs (see Modbus_Fifo.h), NULL when none.
  */
 typedef struct {
-    Coils              Coils      [COILS_NUMBERS] ;
-    Discrete_Inputs    DInputs    [DISCRETE_INPUTS_NUMBERS];
-    Input_Registers    IRegisters [INPUT_REGISTERS_NUMBERS];
-    Holding_Registers  HRegisters [HOLDING_REGISTERS_NUMBERS];
+    uint8_t             Device_ID;
+    Bool                Shared;
+    uint32_t            Numbers[MODBUS_TABLES];
+    Coils              *Coils;
+    Discrete_Inputs    *DInputs;
+    Register_Page      *IPages[REGISTER_PAGES];
+    Register_Page      *HPages[REGISTER_PAGES];
+    struct Modbus_Changes *Changes;
+    struct Modbus_Files   *Files;
+    struct Modbus_Fifos   *Fifos;
 } Modbus_Data;
 
-//!-  "MODBUS_DATABASE" as a Virtual Storage Device.
-static Modbus_Data  MODBUS_DATABASE;
+/*
+ *!-  "MODBUS_UNITS" maps every Device_ID to its Database, or
+ *!-  NULL when the Unit is not hosted. One dense Table, so the
+ *!-  Lookup per Request is a single Load.
+ */
+extern Modbus_Data  *MODBUS_UNITS[MODBUS_UNIT_SLOTS];
 
 /*
  *!-  "Function_Code" ENUM is used to Enumerate Some of the
@@ -104,7 +206,14 @@ typedef enum {
     TARGET_DEVICE_FAILED_TO_RESPOND = 0x0B,
 } Modbus_Exception_Code;
 
+//!-  Status of a Request that was served without Exception.
+#define MODBUS_NO_EXCEPTION  (0x00)
+
 /*
+ *!-  Byte Offsets of the Fields inside a Frame.
+ *!-  A Frame starts at the Device_ID (Unit ID) Byte, so the
+ *!-  same Offsets hold for an RTU ADU and for the Unit ID + PDU
+ *!-  carried behind an MBAP Header.
  *!-  Device_ID:
  *!-  Valid slave device addresses are in
  *!-  the range of 0 – 247 decimal. Address 0 is used for
@@ -114,24 +223,69 @@ typedef enum {
  *!-  Registers_Quantity:
  *!-  The Number of Registers to Read (2 bytes).
  *!-  Byte_Count:
- *!-  The Number of Bytes of DATA in the response (1 byte).
- *!-  Holding_Register:
- *!-  A Sequence of Bytes that contains the values of Holding Registers
- *!-  (2 bytes per register).
- *!-
+ *!-  The Number of Bytes of DATA in the request/response (1 byte).
+ *!-  Payload:
+ *!-  A Sequence of Bytes that contains the values of Registers
+ *!-  (2 bytes per register, Big-Endian) or packed Coils.
+ */
+#define FRAME_DEVICE_ID_OFFSET       0
+#define FRAME_FUNCTION_CODE_OFFSET   1
+#define FRAME_ADDRESS_OFFSET         2
+#define FRAME_QUANTITY_OFFSET        4
+#define FRAME_VALUE_OFFSET           4
+#define FRAME_REQ_BYTE_COUNT_OFFSET  6
+#define FRAME_REQ_PAYLOAD_OFFSET     7
+#define FRAME_RSP_BYTE_COUNT_OFFSET  2
+#define FRAME_RSP_PAYLOAD_OFFSET     3
+#define FRAME_EXCEPTION_CODE_OFFSET  2
+
+#define FRAME_HEADER_LENGTH          2
+#define FRAME_REQ_HEADER_LENGTH      6
+#define FRAME_CRC_LENGTH             2
+
+/*
+ *!-  FC22 carries an AND and an OR Mask behind the Address; FC23
+ *!-  its Write Range and Payload behind the Read Range.
+ */
+#define FRAME_AND_MASK_OFFSET        4
+#define FRAME_OR_MASK_OFFSET         6
+#define FRAME_MASK_WRITE_LENGTH      8
+#define FRAME_RW_ADDRESS_OFFSET      6
+#define FRAME_RW_QUANTITY_OFFSET     8
+#define FRAME_RW_BYTE_COUNT_OFFSET   10
+#define FRAME_RW_PAYLOAD_OFFSET      11
+
+/*
+ *!-  "Modbus_Frame" is a View over a Caller-owned Buffer of
+ *!-  MODBUS_MAX_ADU_LENGTH Bytes. Requests and Responses are
+ *!-  Parsed and Built in place; No Field is copied out of
+ *!-  the Buffer.
+ *!-  Adu:
+ *!-  Start of the Frame (the Device_ID Byte).
+ *!-  Length:
+ *!-  Number of valid Bytes from Adu, including the CRC
+ *!-  once the Frame is Sealed.
  */
 typedef struct {
-    uint8_t      Device_ID;
-    uint8_t      Function_Code;
-    uint8_t      Address_Hi;
-    uint8_t      Address_Low;
-    uint8_t      Registers_Quantity_Hi;
-    uint8_t      Registers_Quantity_Low;
-    uint8_t      Byte_Count;
-    Modbus_Data  Data;
-    uint8_t      CRC_Hi;
-    uint8_t      CRC_Low;
-} Modbus_Packet;
+    uint8_t   *Adu;
+    uint16_t   Length;
+} Modbus_Frame;
+
+/*
+ *!-  "Modbus_Client_Callback" is called once per Request by the
+ *!-  Master Transports (Modbus_TCP.h, Modbus_RTU.h).
+ *!-  Response:
+ *!-  The Answer (Unit ID + PDU without CRC, pointing into the
+ *!-  Rx Buffer; only valid during the Call), NULL on Timeout or
+ *!-  Disconnect.
+ *!-  Status:
+ *!-  MODBUS_NO_EXCEPTION, the Exception Code of an Exception
+ *!-  Response, or TARGET_DEVICE_FAILED_TO_RESPOND.
+ */
+typedef void (*Modbus_Client_Callback)(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
 
 /****************************************************************************
 !-  GLOBAL FUNCTIONS
@@ -140,6 +294,37 @@ typedef struct {
 Bool Modbus_Init(
         void);
 
+void Unpack16bits_8bits(
+        const uint16_t u16Value,
+        uint8_t *const u8Byte1Ptr,
+        uint8_t *const u8Byte0Ptr);
+
+uint16_t Pack8bits_16bits(
+        const uint8_t u8Byte1,
+        const uint8_t u8Byte0);
+
+Modbus_Data *Modbus_Add_Unit(
+        uint8_t  const Device_ID,
+        uint32_t const Coils_Number,
+        uint32_t const DInputs_Number,
+        uint32_t const IRegisters_Number,
+        uint32_t const HRegisters_Number);
+
+Bool Modbus_Remove_Unit(
+        uint8_t const Device_ID);
+
+Bool Modbus_Map_Registers(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint32_t const Count);
+
+Bool Modbus_Valid_Range(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count);
+
 Bool Set_Single_Coil(
         uint8_t const Coil_Number,
         uint8_t const Value);
@@ -168,4 +353,61 @@ uint16_t Get_Single_Input_Register(
 uint16_t Get_Single_Holding_Register(
         uint16_t const HoldingReg_Number);
 
+Bool Read_Bits(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint8_t *const OutBytes);
+
+Bool Write_Bits(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        const uint8_t *const InBytes);
+
+Bool Read_Registers(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint8_t *const BeOut);
+
+Bool Write_Registers(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        const uint8_t *const BeIn);
+
+Bool Mask_Write_Register(
+        Modbus_Data *const Unit,
+        uint16_t const Address,
+        uint16_t const And_Mask,
+        uint16_t const Or_Mask);
+
+Bool Read_Write_Registers(
+        Modbus_Data *const Unit,
+        uint16_t const Write_Start,
+        uint16_t const Write_Count,
+        const uint8_t *const BeIn,
+        uint16_t const Read_Start,
+        uint16_t const Read_Count,
+        uint8_t *const BeOut);
+
+Bool Modbus_Snapshot_Registers(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        uint16_t *const Values);
+
+Bool Modbus_Publish_Registers(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count,
+        const uint16_t *const Values);
+
 #endif /* __MODBUS_H_ */
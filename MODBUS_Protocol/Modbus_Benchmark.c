@@ -0,0 +1,870 @@
+/*
+ * Modbus_Benchmark.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Benchmark.c
+ ****************************************************************************/
+
+//!-  Headers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Modbus.h"
+#include "Modbus_Clock.h"
+#include "Modbus_Dispatch.h"
+#include "Modbus_Fifo.h"
+#include "Modbus_Frame.h"
+#include "Modbus_RTU.h"
+#include "Modbus_Tags.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define BENCH_BUFFER_LENGTH  (4096)
+
+/*
+ *!-  Every Benchmark runs Batches of doubling Size until one takes
+ *!-  BENCH_MIN_NS, and reports that Batch. BENCH_QUICK_NS is used
+ *!-  with "-q", for Smoke Runs.
+ */
+#define BENCH_MIN_NS         (200ULL * NS_PER_MS)
+#define BENCH_QUICK_NS       (5ULL * NS_PER_MS)
+
+//!-  Unit the Database and Round-Trip Benchmarks run against.
+#define BENCH_UNIT           (2)
+#define BENCH_UNIT_BITS      (2048)
+#define BENCH_UNIT_REGISTERS (1024)
+
+/*
+ *!-  "Bench_Body" runs "Rounds" Operations of a Benchmark.
+ *!-  Returns FALSE if an Operation gave a wrong Result.
+ */
+typedef Bool (*Bench_Body)(
+        void *const Context,
+        uint64_t const Rounds);
+
+//!-  "Bench_Length" parametrises the Buffer Benchmarks.
+typedef struct {
+    uint32_t      Length;
+    CRC16_Engine  Engine;
+} Bench_Length;
+
+/*
+ *!-  "Bench_Trip" is a sealed RTU Request with the Length of the
+ *!-  Response it must get, for Bench_Round_Trip().
+ */
+typedef struct {
+    uint8_t   Request[MODBUS_MAX_ADU_LENGTH];
+    uint16_t  Request_Length;
+    uint16_t  Response_Length;
+} Bench_Trip;
+
+uint16_t Legacy_CRC16(
+        uint8_t *MsgBuffer,
+        uint32_t DataLength);
+
+Bool Bench_Run(
+        const char *const Name,
+        uint32_t const Size,
+        uint64_t const Bytes_Per_Op,
+        Bench_Body const Body,
+        void *const Context);
+
+Bool Bench_CRC16_Verify(
+        void);
+
+Bool Bench_CRC16_Legacy(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_CRC16_Engine(
+        void *const Context,
+        uint64_t const Rounds);
+
+void Bench_RTU_Count(
+        void *const Context,
+        const Modbus_Frame *const Frame);
+
+Bool Bench_RTU_Parser(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Pack(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Unpack(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Tags_Scalar(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Tags_Decode(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Tags_Encode(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Fifo(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Validate_Function_Code(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Validate_Starting_Address(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Validate_Registers_Quantity(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Registers_Single(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Registers_Bulk(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Registers_Write_Single(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Registers_Write_Bulk(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Bits_Single(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Bits_Bulk(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Round_Trip(
+        void *const Context,
+        uint64_t const Rounds);
+
+Bool Bench_Build_Round_Trips(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static uint8_t Bench_Buffer[BENCH_BUFFER_LENGTH];
+
+//!-  Frame Sizes to Measure: short Requests, full ADUs, Captures.
+static const uint32_t Bench_Lengths[] = { 8, 64, 256, 4096 };
+
+static const char *const Engine_Names[] = { "table", "slice8", "clmul" };
+
+//!-  Benchmarks whose Name does not start with this are skipped.
+static const char *Bench_Filter = "";
+static uint64_t Bench_Min_ns = BENCH_MIN_NS;
+static Bool Bench_First = TRUE;
+
+static Modbus_Data *Bench_Unit;
+
+static Bench_Trip Bench_Trip_FC03;
+static Bench_Trip Bench_Trip_FC16;
+static Bench_Trip Bench_Trip_FC01;
+
+//!-  Floats the Tag Benchmarks decode, by Bench_Tags_Scalar() and
+//!-  by Modbus_Decode_Array(), to compare.
+static float Bench_Floats[MAXREADREGQUANTITY / 2];
+static float Bench_Floats_Scalar[MAXREADREGQUANTITY / 2];
+
+//!-  Keeps the Compiler from dropping the measured Work.
+static volatile uint32_t Bench_Sink;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Legacy_CRC16() is the original Byte-at-a-Time Implementation
+ *!-  over the auchCRCHi/auchCRCLo Tables, kept as the Baseline.
+ */
+uint16_t Legacy_CRC16(
+        uint8_t *MsgBuffer,
+        uint32_t DataLength) {
+
+    unsigned char CRCHi = 0xFF;
+    unsigned char CRCLo = 0xFF;
+    unsigned  uIndex;
+
+    while(DataLength --) {
+        uIndex = (CRCHi ^ *MsgBuffer++);
+        CRCHi = (CRCLo ^ auchCRCHi[uIndex]);
+        CRCLo = auchCRCLo[uIndex];
+    }
+    return (CRCHi << 8 | CRCLo);
+}
+
+/*
+ *!-  Bench_Run() times "Body" and prints one JSON Result: the
+ *!-  Cost per Operation and, for "Bytes_Per_Op" other than 0,
+ *!-  the Throughput. "Size" is the Parameter the Name leaves out
+ *!-  (Bytes, Registers, ...). Returns FALSE if the Body failed.
+ */
+Bool Bench_Run(
+        const char *const Name,
+        uint32_t const Size,
+        uint64_t const Bytes_Per_Op,
+        Bench_Body const Body,
+        void *const Context) {
+
+    Bool Check_Ok = TRUE;
+    uint64_t Rounds = 1;
+    uint64_t Start = 0;
+    uint64_t Elapsed = 0;
+
+    if (strncmp(Name, Bench_Filter, strlen(Bench_Filter)) != 0) {
+        return TRUE;
+    }
+
+    //!-  One Warm-up Round, which also checks the Results.
+    Check_Ok = Body(Context, 1);
+    while (Check_Ok == TRUE) {
+        Start = Modbus_Now_ns();
+        Check_Ok = Body(Context, Rounds);
+        Elapsed = Modbus_Now_ns() - Start;
+        if ((Elapsed >= Bench_Min_ns) || (Rounds >= (1ULL << 40))) {
+            break;
+        }
+        Rounds *= 2;
+    }
+    if (Elapsed == 0) {
+        Elapsed = 1;
+    }
+
+    printf("%s    {\"name\": \"%s\", \"size\": %u, \"ops\": %llu, "
+           "\"ns_per_op\": %.3f, \"mb_per_s\": %.1f, \"ok\": %s}",
+           (Bench_First == TRUE) ? "" : ",\n", Name, Size,
+           (unsigned long long) Rounds, (double) Elapsed / (double) Rounds,
+           (double) (Rounds * Bytes_Per_Op) * 1000.0 / (double) Elapsed,
+           (Check_Ok == TRUE) ? "true" : "false");
+    Bench_First = FALSE;
+    return Check_Ok;
+}
+
+//!-  Bench_CRC16_Verify() checks every Engine against the Legacy Tables.
+Bool Bench_CRC16_Verify(
+        void) {
+
+    Bool Check_Ok = TRUE;
+    CRC16_Engine Default = CRC16_Active_Engine();
+    uint32_t Length = 0;
+    uint32_t Engine = 0;
+
+    for (Engine = CRC16_ENGINE_TABLE; Engine <= CRC16_ENGINE_CLMUL; Engine++) {
+        if (CRC16_Select((CRC16_Engine) Engine) == FALSE) {
+            continue;
+        }
+        for (Length = 0; Length <= BENCH_BUFFER_LENGTH; Length++) {
+            if (Calculate_CRC16(Bench_Buffer, (uint16_t) Length) !=
+                Legacy_CRC16(Bench_Buffer, Length)) {
+                fprintf(stderr, "crc16 %s mismatch at length %u\n",
+                        Engine_Names[Engine], Length);
+                Check_Ok = FALSE;
+                break;
+            }
+        }
+    }
+    (void) CRC16_Select(Default);
+    return Check_Ok;
+}
+
+//!-  Bench_CRC16_Legacy() runs the Baseline CRC.
+Bool Bench_CRC16_Legacy(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    uint64_t Round = 0;
+    uint16_t CRC = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        Bench_Buffer[0] = (uint8_t) Round;
+        CRC ^= Legacy_CRC16(Bench_Buffer, Bench->Length);
+    }
+    Bench_Sink = CRC;
+    return TRUE;
+}
+
+//!-  Bench_CRC16_Engine() runs Calculate_CRC16() on the selected Engine.
+Bool Bench_CRC16_Engine(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    uint64_t Round = 0;
+    uint16_t CRC = 0;
+
+    (void) CRC16_Select(Bench->Engine);
+    for (Round = 0; Round < Rounds; Round++) {
+        Bench_Buffer[0] = (uint8_t) Round;
+        CRC ^= Calculate_CRC16(Bench_Buffer, (uint16_t) Bench->Length);
+    }
+    Bench_Sink = CRC;
+    return TRUE;
+}
+
+//!-  Bench_RTU_Count() counts the Frames the Parser delivers.
+void Bench_RTU_Count(
+        void *const Context,
+        const Modbus_Frame *const Frame) {
+
+    (void) Frame;
+    (*(uint64_t *) Context)++;
+}
+
+/*
+ *!-  Bench_RTU_Parser() feeds a Stream of back-to-back FC03
+ *!-  Responses (125 Registers) to the RTU Parser in 4096 Byte
+ *!-  Chunks; every Frame must come out.
+ */
+Bool Bench_RTU_Parser(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    static Modbus_RTU_Parser Parser;
+    static uint8_t Stream[BENCH_BUFFER_LENGTH];
+    Bench_Length *const Bench = Context;
+    Modbus_Frame Frame;
+    uint64_t Frames = 0;
+    uint64_t Expected = 0;
+    uint64_t Round = 0;
+    uint32_t Length = 0;
+    uint32_t Index = 0;
+
+    //!-  As many whole Frames as fit into the Chunk.
+    while ((Length + MODBUS_MAX_ADU_LENGTH) <= BENCH_BUFFER_LENGTH) {
+        Frame_Attach(&Frame, &Stream[Length], 0);
+        Stream[Length + FRAME_DEVICE_ID_OFFSET] = 1;
+        Stream[Length + FRAME_FUNCTION_CODE_OFFSET] = Fun_Code03;
+        Stream[Length + FRAME_RSP_BYTE_COUNT_OFFSET] = 2 * MAXREADREGQUANTITY;
+        for (Index = 0; Index < (2 * MAXREADREGQUANTITY); Index++) {
+            Stream[Length + FRAME_RSP_PAYLOAD_OFFSET + Index] =
+                Bench_Buffer[Index + Length];
+        }
+        Frame.Length = FRAME_RSP_PAYLOAD_OFFSET + (2 * MAXREADREGQUANTITY);
+        (void) Frame_Seal(&Frame);
+        Length += Frame.Length;
+        Expected++;
+    }
+    Bench->Length = Length;
+
+    Modbus_RTU_Parser_Init(&Parser, 115200, RTU_PARSE_RESPONSES,
+                           Bench_RTU_Count, &Frames);
+    for (Round = 0; Round < Rounds; Round++) {
+        (void) Modbus_RTU_Feed(&Parser, Stream, Length, Round);
+    }
+    return (Bool) (Frames == (Expected * Rounds));
+}
+
+//!-  Bench_Pack() packs a Buffer of Byte Pairs into Words.
+Bool Bench_Pack(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    uint64_t Round = 0;
+    uint32_t Index = 0;
+    uint16_t Sum = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        for (Index = 0; Index < Bench->Length; Index += 2) {
+            Sum = (uint16_t) (Sum + Pack8bits_16bits(Bench_Buffer[Index],
+                                                     Bench_Buffer[Index + 1]));
+        }
+    }
+    Bench_Sink = Sum;
+    return (Bool) (Pack8bits_16bits(0x12, 0x34) == 0x1234);
+}
+
+//!-  Bench_Unpack() unpacks Words into a Buffer of Byte Pairs.
+Bool Bench_Unpack(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    static uint8_t Output[BENCH_BUFFER_LENGTH];
+    uint64_t Round = 0;
+    uint32_t Index = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        for (Index = 0; Index < Bench->Length; Index += 2) {
+            Unpack16bits_8bits((uint16_t) (Round + Index), &Output[Index],
+                               &Output[Index + 1]);
+        }
+    }
+    Bench_Sink = Output[0];
+    Unpack16bits_8bits(0x1234, &Output[0], &Output[1]);
+    return (Bool) ((Output[0] == 0x12) && (Output[1] == 0x34));
+}
+
+/*
+ *!-  Bench_Tags_Scalar() decodes CDAB Floats from Bench_Buffer one
+ *!-  at a Time with Shifts, the Baseline for Bench_Tags_Decode().
+ */
+Bool Bench_Tags_Scalar(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    const uint8_t *Bytes = NULL;
+    uint64_t Round = 0;
+    uint32_t Index = 0;
+    uint32_t Raw = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        for (Index = 0; Index < Bench->Length; Index++) {
+            Bytes = &Bench_Buffer[(Round & 0xFF) + 4 * Index];
+            Raw = ((uint32_t) Bytes[2] << 24) | ((uint32_t) Bytes[3] << 16) |
+                  ((uint32_t) Bytes[0] << 8) | Bytes[1];
+            memcpy(&Bench_Floats_Scalar[Index], &Raw, sizeof(Raw));
+        }
+        Bench_Sink += Raw;
+    }
+    return TRUE;
+}
+
+/*
+ *!-  Bench_Tags_Decode() decodes the same Floats in one Pass. The
+ *!-  last Round must agree with Bench_Tags_Scalar() Bit for Bit.
+ */
+Bool Bench_Tags_Decode(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    uint64_t Round = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        Modbus_Decode_Array(Bench_Floats, &Bench_Buffer[Round & 0xFF],
+                            Bench->Length, TAG_FLOAT32, WORD_ORDER_CDAB);
+        Bench_Sink += ((const uint8_t *) Bench_Floats)[0];
+    }
+    (void) Bench_Tags_Scalar(Context, 1);
+    Modbus_Decode_Array(Bench_Floats, Bench_Buffer, Bench->Length,
+                        TAG_FLOAT32, WORD_ORDER_CDAB);
+    return (Bool) (memcmp(Bench_Floats, Bench_Floats_Scalar,
+                          Bench->Length * sizeof(float)) == 0);
+}
+
+//!-  Bench_Tags_Encode() encodes the Floats back into a FC16 Payload.
+Bool Bench_Tags_Encode(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    static uint8_t Payload[2 * MAXREADREGQUANTITY];
+    uint64_t Round = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        Bench_Floats[Round % Bench->Length] = (float) Round;
+        Modbus_Encode_Array(Payload, Bench_Floats, Bench->Length,
+                            TAG_FLOAT32, WORD_ORDER_CDAB);
+        Bench_Sink += Payload[0];
+    }
+    Modbus_Decode_Array(Bench_Floats, Bench_Buffer, Bench->Length,
+                        TAG_FLOAT32, WORD_ORDER_CDAB);
+    Modbus_Encode_Array(Payload, Bench_Floats, Bench->Length,
+                        TAG_FLOAT32, WORD_ORDER_CDAB);
+    return (Bool) (memcmp(Payload, Bench_Buffer, 4 * Bench->Length) == 0);
+}
+
+/*
+ *!-  Bench_Fifo() pushes a full FC24 Window of Samples into the
+ *!-  FIFO at Address 0 and drains it with an FC24 Request.
+ */
+Bool Bench_Fifo(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    Modbus_Fifo *const Fifo = Modbus_Find_Fifo(Bench_Unit, 0);
+    uint8_t Request_Buffer[FIFO_REQUEST_LENGTH];
+    uint8_t Response_Buffer[MODBUS_MAX_PDU_LENGTH + 1];
+    uint16_t Samples[FIFO_MAX_COUNT];
+    Modbus_Frame Request;
+    Modbus_Frame Response;
+    uint64_t Round = 0;
+    uint32_t Index = 0;
+
+    Frame_Attach(&Request, Request_Buffer, 0);
+    Frame_Attach(&Response, Response_Buffer, 0);
+    (void) Frame_Build_Read_Fifo(&Request, BENCH_UNIT, 0);
+    for (Round = 0; Round < Rounds; Round++) {
+        for (Index = 0; Index < Bench->Length; Index++) {
+            Samples[Index] = (uint16_t) (Round + Index);
+        }
+        (void) Modbus_Fifo_Push(Fifo, Samples, Bench->Length);
+        (void) Modbus_Response(&Request, &Response);
+        Bench_Sink += Response_Buffer[FIFO_PAYLOAD_OFFSET];
+    }
+    return (Bool) ((Response.Length ==
+                    (FIFO_PAYLOAD_OFFSET + (2 * Bench->Length))) &&
+                   (Frame_Register(&Response_Buffer[FIFO_PAYLOAD_OFFSET],
+                                   Bench->Length - 1) ==
+                    (uint16_t) (Rounds + Bench->Length - 2)));
+}
+
+//!-  Bench_Validate_Function_Code() checks every Function Code.
+Bool Bench_Validate_Function_Code(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    uint64_t Round = 0;
+    uint32_t Valid = 0;
+
+    (void) Context;
+    for (Round = 0; Round < Rounds; Round++) {
+        Valid += Validate_Function_Code((uint8_t) (Round & MAX_FUNCTION_CODE));
+    }
+    Bench_Sink = Valid;
+    return (Bool) ((Validate_Function_Code(Fun_Code03) == TRUE) &&
+                   (Validate_Function_Code(0x7E) == FALSE));
+}
+
+//!-  Bench_Validate_Starting_Address() checks Holding Register Addresses.
+Bool Bench_Validate_Starting_Address(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    uint64_t Round = 0;
+    uint32_t Valid = 0;
+
+    (void) Context;
+    for (Round = 0; Round < Rounds; Round++) {
+        Valid += Validate_Starting_Address(Fun_Code03, (uint16_t) Round);
+    }
+    Bench_Sink = Valid;
+    return Validate_Starting_Address(Fun_Code03, 0);
+}
+
+//!-  Bench_Validate_Registers_Quantity() checks Holding Register Ranges.
+Bool Bench_Validate_Registers_Quantity(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    uint64_t Round = 0;
+    uint32_t Valid = 0;
+
+    (void) Context;
+    for (Round = 0; Round < Rounds; Round++) {
+        Valid += Validate_Registers_Quantity(Fun_Code03, 0,
+                                             (uint16_t) ((Round & 0x7F) + 1));
+    }
+    Bench_Sink = Valid;
+    return (Bool) ((Validate_Registers_Quantity(Fun_Code03, 0, 1) == TRUE) &&
+                   (Validate_Registers_Quantity(Fun_Code03, 0, 0) == FALSE));
+}
+
+//!-  Bench_Registers_Single() reads a Block one Register at a Time.
+Bool Bench_Registers_Single(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    Bool Check_Ok = TRUE;
+    uint64_t Round = 0;
+    uint32_t Index = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        for (Index = 0; Index < Bench->Length; Index++) {
+            Check_Ok &= Read_Registers(Bench_Unit, TABLE_HOLDING_REGISTERS,
+                                       (uint16_t) Index, 1,
+                                       &Bench_Buffer[2 * Index]);
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Bench_Registers_Bulk() reads the same Block in one Call.
+Bool Bench_Registers_Bulk(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    Bool Check_Ok = TRUE;
+    uint64_t Round = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        Check_Ok &= Read_Registers(Bench_Unit, TABLE_HOLDING_REGISTERS, 0,
+                                   (uint16_t) Bench->Length, Bench_Buffer);
+    }
+    return Check_Ok;
+}
+
+//!-  Bench_Registers_Write_Single() writes a Block one Register at a Time.
+Bool Bench_Registers_Write_Single(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    Bool Check_Ok = TRUE;
+    uint64_t Round = 0;
+    uint32_t Index = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        for (Index = 0; Index < Bench->Length; Index++) {
+            Check_Ok &= Write_Registers(Bench_Unit, TABLE_HOLDING_REGISTERS,
+                                        (uint16_t) Index, 1,
+                                        &Bench_Buffer[2 * Index]);
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Bench_Registers_Write_Bulk() writes the same Block in one Call.
+Bool Bench_Registers_Write_Bulk(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    Bool Check_Ok = TRUE;
+    uint64_t Round = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        Check_Ok &= Write_Registers(Bench_Unit, TABLE_HOLDING_REGISTERS, 0,
+                                    (uint16_t) Bench->Length, Bench_Buffer);
+    }
+    return Check_Ok;
+}
+
+//!-  Bench_Bits_Single() reads Coils one at a Time.
+Bool Bench_Bits_Single(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    Bool Check_Ok = TRUE;
+    uint64_t Round = 0;
+    uint32_t Index = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        for (Index = 0; Index < Bench->Length; Index++) {
+            Check_Ok &= Read_Bits(Bench_Unit, TABLE_COILS, (uint16_t) Index, 1,
+                                  &Bench_Buffer[Index / 8]);
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Bench_Bits_Bulk() reads the same Coils in one Call.
+Bool Bench_Bits_Bulk(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    const Bench_Length *const Bench = Context;
+    Bool Check_Ok = TRUE;
+    uint64_t Round = 0;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        Check_Ok &= Read_Bits(Bench_Unit, TABLE_COILS, 0,
+                              (uint16_t) Bench->Length, Bench_Buffer);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Bench_Round_Trip() runs a sealed RTU Request through a Slave
+ *!-  and back: CRC Check, Dispatch, Response sealed, and on the
+ *!-  Master Side the Response CRC checked again.
+ */
+Bool Bench_Round_Trip(
+        void *const Context,
+        uint64_t const Rounds) {
+
+    Bench_Trip *const Trip = Context;
+    static uint8_t Reply[MODBUS_MAX_ADU_LENGTH];
+    Bool Check_Ok = TRUE;
+    uint64_t Round = 0;
+    Modbus_Frame Request;
+    Modbus_Frame Response;
+
+    for (Round = 0; Round < Rounds; Round++) {
+        Check_Ok &= Frame_Parse(&Request, Trip->Request,
+                                Trip->Request_Length);
+        Request.Length = (uint16_t) (Request.Length - FRAME_CRC_LENGTH);
+        Frame_Attach(&Response, Reply, 0);
+        Check_Ok &= Modbus_Response(&Request, &Response);
+        Check_Ok &= Frame_Seal(&Response);
+        Check_Ok &= Frame_Parse(&Response, Reply, Response.Length);
+        Check_Ok &= (Bool) ((Response.Length == Trip->Response_Length) &&
+                            (Frame_Is_Exception(&Response) == FALSE));
+    }
+    return Check_Ok;
+}
+
+//!-  Bench_Build_Round_Trips() seals the Requests of the Round Trips.
+Bool Bench_Build_Round_Trips(
+        void) {
+
+    Bool Check_Ok = TRUE;
+    Modbus_Frame Frame;
+
+    Frame_Attach(&Frame, Bench_Trip_FC03.Request, 0);
+    Check_Ok &= Frame_Build_Read_Request(&Frame, BENCH_UNIT, Fun_Code03, 0,
+                                         MAXREADREGQUANTITY);
+    Check_Ok &= Frame_Seal(&Frame);
+    Bench_Trip_FC03.Request_Length = Frame.Length;
+    Bench_Trip_FC03.Response_Length = FRAME_RSP_PAYLOAD_OFFSET +
+                                      (2 * MAXREADREGQUANTITY) + FRAME_CRC_LENGTH;
+
+    Frame_Attach(&Frame, Bench_Trip_FC16.Request, 0);
+    Check_Ok &= Frame_Build_Write_Multiple(&Frame, BENCH_UNIT, Fun_Code16, 0,
+                                           MAXWRITEREGQUANTITY);
+    memcpy(Frame_Req_Payload(&Frame), Bench_Buffer, 2 * MAXWRITEREGQUANTITY);
+    Check_Ok &= Frame_Seal(&Frame);
+    Bench_Trip_FC16.Request_Length = Frame.Length;
+    Bench_Trip_FC16.Response_Length = FRAME_REQ_HEADER_LENGTH + FRAME_CRC_LENGTH;
+
+    Frame_Attach(&Frame, Bench_Trip_FC01.Request, 0);
+    Check_Ok &= Frame_Build_Read_Request(&Frame, BENCH_UNIT, Fun_Code01, 0,
+                                         MAXREGISTERQUANTITY);
+    Check_Ok &= Frame_Seal(&Frame);
+    Bench_Trip_FC01.Request_Length = Frame.Length;
+    Bench_Trip_FC01.Response_Length = FRAME_RSP_PAYLOAD_OFFSET +
+                                      (MAXREGISTERQUANTITY / 8) +
+                                      FRAME_CRC_LENGTH;
+    return Check_Ok;
+}
+
+/*
+ *!-  Usage: Modbus_Benchmark [-q] [filter]
+ *!-  Runs the Micro-Benchmarks of the Protocol Core whose Name
+ *!-  starts with "filter" and prints the Results as one JSON
+ *!-  Document on stdout, for Regression Tracking. "-q" runs every
+ *!-  Benchmark only briefly, as a Smoke Test. Exits non-zero if
+ *!-  any Benchmark computed a wrong Result.
+ */
+int main(int argc, char *argv[]) {
+
+    Bool Ckeck_OK = FALSE;
+    int Arg = 1;
+    uint32_t Index = 0;
+    uint32_t Engine = 0;
+    uint32_t Size = 0;
+    CRC16_Engine const Default = CRC16_Active_Engine();
+    Bench_Length Bench;
+    char Name[64];
+
+    if ((argc > Arg) && (strcmp(argv[Arg], "-q") == 0)) {
+        Bench_Min_ns = BENCH_QUICK_NS;
+        Arg++;
+    }
+    if (argc > Arg) {
+        Bench_Filter = argv[Arg];
+    }
+
+    srand(1);
+    for (Index = 0; Index < BENCH_BUFFER_LENGTH; Index++) {
+        Bench_Buffer[Index] = (uint8_t) rand();
+    }
+    Ckeck_OK = Modbus_Init();
+    if (Ckeck_OK == TRUE) {
+        Bench_Unit = Modbus_Add_Unit(BENCH_UNIT, BENCH_UNIT_BITS, BENCH_UNIT_BITS,
+                                     BENCH_UNIT_REGISTERS, BENCH_UNIT_REGISTERS);
+        Ckeck_OK = (Bool) ((Bench_Unit != NULL) &&
+                           (Modbus_Add_Fifo(Bench_Unit, 0,
+                                            FIFO_MAX_COUNT) == TRUE) &&
+                           (Bench_Build_Round_Trips() == TRUE));
+    }
+    if (Ckeck_OK == FALSE) {
+        fprintf(stderr, "Modbus_Benchmark: cannot set up the database\n");
+        return 1;
+    }
+    Ckeck_OK = Bench_CRC16_Verify();
+
+    printf("{\n  \"suite\": \"Modbus_Benchmark\",\n"
+           "  \"crc16_engine\": \"%s\",\n  \"results\": [\n",
+           Engine_Names[Default]);
+
+    for (Size = 0; Size < (sizeof(Bench_Lengths) / sizeof(Bench_Lengths[0])); Size++) {
+        Bench.Length = Bench_Lengths[Size];
+        Ckeck_OK &= Bench_Run("crc16/legacy", Bench.Length, Bench.Length,
+                              Bench_CRC16_Legacy, &Bench);
+        for (Engine = CRC16_ENGINE_TABLE; Engine <= CRC16_ENGINE_CLMUL; Engine++) {
+            Bench.Engine = (CRC16_Engine) Engine;
+            if (CRC16_Select(Bench.Engine) == TRUE) {
+                snprintf(Name, sizeof(Name), "crc16/%s", Engine_Names[Engine]);
+                Ckeck_OK &= Bench_Run(Name, Bench.Length, Bench.Length,
+                                      Bench_CRC16_Engine, &Bench);
+            }
+        }
+    }
+    (void) CRC16_Select(Default);
+
+    //!-  The Parser Stream Length is only known once it is built.
+    Bench.Length = 0;
+    (void) Bench_RTU_Parser(&Bench, 0);
+    Ckeck_OK &= Bench_Run("rtu/parser", Bench.Length, Bench.Length,
+                          Bench_RTU_Parser, &Bench);
+
+    Bench.Length = 2 * MAXREADREGQUANTITY;
+    Ckeck_OK &= Bench_Run("bits/pack", Bench.Length, Bench.Length,
+                          Bench_Pack, &Bench);
+    Ckeck_OK &= Bench_Run("bits/unpack", Bench.Length, Bench.Length,
+                          Bench_Unpack, &Bench);
+
+    Bench.Length = MAXREADREGQUANTITY / 2;
+    Ckeck_OK &= Bench_Run("tags/decode_float32_scalar", Bench.Length,
+                          4 * Bench.Length, Bench_Tags_Scalar, &Bench);
+    Ckeck_OK &= Bench_Run("tags/decode_float32_cdab", Bench.Length,
+                          4 * Bench.Length, Bench_Tags_Decode, &Bench);
+    Ckeck_OK &= Bench_Run("tags/encode_float32_cdab", Bench.Length,
+                          4 * Bench.Length, Bench_Tags_Encode, &Bench);
+
+    Bench.Length = FIFO_MAX_COUNT;
+    Ckeck_OK &= Bench_Run("fifo/push_drain_fc24", Bench.Length,
+                          2 * Bench.Length, Bench_Fifo, &Bench);
+
+    Ckeck_OK &= Bench_Run("validate/function_code", 1, 0,
+                          Bench_Validate_Function_Code, NULL);
+    Ckeck_OK &= Bench_Run("validate/starting_address", 1, 0,
+                          Bench_Validate_Starting_Address, NULL);
+    Ckeck_OK &= Bench_Run("validate/registers_quantity", 1, 0,
+                          Bench_Validate_Registers_Quantity, NULL);
+
+    Bench.Length = MAXREADREGQUANTITY;
+    Ckeck_OK &= Bench_Run("db/read_registers_single", Bench.Length,
+                          2 * Bench.Length, Bench_Registers_Single, &Bench);
+    Ckeck_OK &= Bench_Run("db/read_registers_bulk", Bench.Length,
+                          2 * Bench.Length, Bench_Registers_Bulk, &Bench);
+    Ckeck_OK &= Bench_Run("db/write_registers_single", Bench.Length,
+                          2 * Bench.Length, Bench_Registers_Write_Single, &Bench);
+    Ckeck_OK &= Bench_Run("db/write_registers_bulk", Bench.Length,
+                          2 * Bench.Length, Bench_Registers_Write_Bulk, &Bench);
+    Bench.Length = MAXREGISTERQUANTITY;
+    Ckeck_OK &= Bench_Run("db/read_coils_single", Bench.Length,
+                          Bench.Length / 8, Bench_Bits_Single, &Bench);
+    Ckeck_OK &= Bench_Run("db/read_coils_bulk", Bench.Length,
+                          Bench.Length / 8, Bench_Bits_Bulk, &Bench);
+
+    Ckeck_OK &= Bench_Run("roundtrip/fc03", MAXREADREGQUANTITY, 0,
+                          Bench_Round_Trip, &Bench_Trip_FC03);
+    Ckeck_OK &= Bench_Run("roundtrip/fc16", MAXWRITEREGQUANTITY, 0,
+                          Bench_Round_Trip, &Bench_Trip_FC16);
+    Ckeck_OK &= Bench_Run("roundtrip/fc01", MAXREGISTERQUANTITY, 0,
+                          Bench_Round_Trip, &Bench_Trip_FC01);
+
+    printf("\n  ],\n  \"ok\": %s\n}\n", (Ckeck_OK == TRUE) ? "true" : "false");
+    return (Ckeck_OK == TRUE) ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/*
+ * Modbus_Bits.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Bits.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus_Bits.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define WORD_BITS   (64U)
+#define WORD_BYTES  (8U)
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BITS_HOST_IS_LE  1
+#else
+#define BITS_HOST_IS_LE  0
+#endif
+
+uint64_t Bits_Load_LE(
+        const uint8_t *const BytePtr,
+        uint32_t const ByteCount);
+
+void Bits_Store_LE(
+        uint8_t *const BytePtr,
+        uint64_t const Value,
+        uint32_t const ByteCount);
+
+uint64_t Bits_Window(
+        const uint64_t *const Words,
+        uint32_t const BitPos,
+        uint32_t const Count);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Bits_Load_LE() reads up to 8 Bytes as a Little-Endian Word.
+uint64_t Bits_Load_LE(
+        const uint8_t *const BytePtr,
+        uint32_t const ByteCount) {
+
+    uint64_t Value = 0;
+    uint32_t Index = 0;
+
+    if (ByteCount == WORD_BYTES) {
+        memcpy(&Value, BytePtr, WORD_BYTES);
+#if !BITS_HOST_IS_LE
+        Value = __builtin_bswap64(Value);
+#endif
+    }
+    else {
+        for (Index = 0; Index < ByteCount; Index++) {
+            Value |= ((uint64_t) BytePtr[Index]) << (8 * Index);
+        }
+    }
+    return Value;
+}
+
+//!-  Bits_Store_LE() writes the low "ByteCount" Bytes of a Word.
+void Bits_Store_LE(
+        uint8_t *const BytePtr,
+        uint64_t const Value,
+        uint32_t const ByteCount) {
+
+    uint64_t Swapped = Value;
+    uint32_t Index = 0;
+
+    if (ByteCount == WORD_BYTES) {
+#if !BITS_HOST_IS_LE
+        Swapped = __builtin_bswap64(Swapped);
+#endif
+        memcpy(BytePtr, &Swapped, WORD_BYTES);
+    }
+    else {
+        for (Index = 0; Index < ByteCount; Index++) {
+            BytePtr[Index] = (uint8_t) (Value >> (8 * Index));
+        }
+    }
+}
+
+/*
+ *!-  Bits_Window() returns "Count" (1..64) Bits starting at
+ *!-  "BitPos" as one Word, funnel-shifting across the Word
+ *!-  Boundary. The next Word is only read when it is needed.
+ */
+uint64_t Bits_Window(
+        const uint64_t *const Words,
+        uint32_t const BitPos,
+        uint32_t const Count) {
+
+    uint32_t const Word = BitPos / WORD_BITS;
+    uint32_t const Shift = BitPos % WORD_BITS;
+    uint64_t Value = Words[Word] >> Shift;
+
+    if ((Shift != 0) && ((Shift + Count) > WORD_BITS)) {
+        Value |= Words[Word + 1] << (WORD_BITS - Shift);
+    }
+    if (Count < WORD_BITS) {
+        Value &= ((1ULL << Count) - 1);
+    }
+    return Value;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+void Bits_Extract(
+        const uint64_t *const Words,
+        uint32_t const Start,
+        uint32_t const Count,
+        uint8_t *const OutBytes) {
+
+    uint32_t Done = 0;
+    uint32_t Chunk = 0;
+    uint32_t Misaligned = 1;
+
+#if BITS_HOST_IS_LE
+    //!-  Byte-aligned Start: the Wire Bytes are the Storage Bytes.
+    Misaligned = Start % 8;
+#endif
+    if ((Misaligned == 0) && (Count != 0)) {
+        memcpy(OutBytes, ((const uint8_t *) Words) + (Start / 8),
+               (Count + 7) / 8);
+        if ((Count % 8) != 0) {
+            OutBytes[Count / 8] &= (uint8_t) ((1U << (Count % 8)) - 1);
+        }
+    }
+    else {
+        while (Done < Count) {
+            Chunk = Count - Done;
+            if (Chunk > WORD_BITS) {
+                Chunk = WORD_BITS;
+            }
+            Bits_Store_LE(&OutBytes[Done / 8],
+                          Bits_Window(Words, Start + Done, Chunk),
+                          (Chunk + 7) / 8);
+            Done += Chunk;
+        }
+    }
+}
+
+void Bits_Insert(
+        uint64_t *const Words,
+        uint32_t const Start,
+        uint32_t const Count,
+        const uint8_t *const InBytes) {
+
+    uint32_t Done = 0;
+    uint32_t Chunk = 0;
+    uint32_t Word = 0;
+    uint32_t Shift = 0;
+    uint64_t Value = 0;
+    uint64_t Mask = 0;
+
+    while (Done < Count) {
+        Chunk = Count - Done;
+        if (Chunk > WORD_BITS) {
+            Chunk = WORD_BITS;
+        }
+        Mask = (Chunk == WORD_BITS) ? ~0ULL : ((1ULL << Chunk) - 1);
+        Value = Bits_Load_LE(&InBytes[Done / 8], (Chunk + 7) / 8) & Mask;
+        Word = (Start + Done) / WORD_BITS;
+        Shift = (Start + Done) % WORD_BITS;
+
+        if ((Shift == 0) && (Chunk == WORD_BITS)) {
+            Words[Word] = Value;
+        }
+        else {
+            Words[Word] = (Words[Word] & ~(Mask << Shift)) | (Value << Shift);
+            if ((Shift + Chunk) > WORD_BITS) {
+                Words[Word + 1] =
+                    (Words[Word + 1] & ~(Mask >> (WORD_BITS - Shift))) |
+                    (Value >> (WORD_BITS - Shift));
+            }
+        }
+        Done += Chunk;
+    }
+}
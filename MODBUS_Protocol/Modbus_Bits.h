@@ -0,0 +1,45 @@
+/*
+ * Modbus_Bits.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Bits.h
+*****************************************************************************/
+
+#ifndef __MODBUS_BITS_H_
+#define __MODBUS_BITS_H_
+
+//!-  Headers
+#include <stdint.h>
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Bits_Extract() copies "Count" Bits starting at Bit "Start"
+ *!-  of a Word Array into Bytes in Modbus Order (first Bit in
+ *!-  the LSB of the first Byte). Unused high Bits of the last
+ *!-  Byte are cleared. "OutBytes" needs (Count + 7) / 8 Bytes.
+ */
+void Bits_Extract(
+        const uint64_t *const Words,
+        uint32_t const Start,
+        uint32_t const Count,
+        uint8_t *const OutBytes);
+
+/*
+ *!-  Bits_Insert() is the Reverse: "Count" Bits from Bytes in
+ *!-  Modbus Order are stored at Bit "Start" of a Word Array.
+ *!-  Bits outside the Range are left untouched.
+ */
+void Bits_Insert(
+        uint64_t *const Words,
+        uint32_t const Start,
+        uint32_t const Count,
+        const uint8_t *const InBytes);
+
+#endif /* __MODBUS_BITS_H_ */
@@ -0,0 +1,390 @@
+/*
+ * Modbus_Cache.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Cache.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus_Frame.h"
+#include "Modbus_Cache.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Fibonacci Hashing Multiplier.
+#define CACHE_HASH_MULTIPLIER    (0x9E3779B1u)
+
+Bool Cache_Read_Table(
+        uint8_t const Function_Code,
+        Modbus_Table *const Table);
+
+Bool Cache_Write_Range(
+        const Modbus_Frame *const Request,
+        Modbus_Table *const Table,
+        uint16_t *const Start,
+        uint16_t *const Quantity);
+
+Bool Cache_Overlaps(
+        uint32_t const Start_A,
+        uint32_t const Quantity_A,
+        uint32_t const Start_B,
+        uint32_t const Quantity_B);
+
+uint64_t Cache_TTL(
+        const Modbus_Cache *const Cache,
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Quantity);
+
+uint32_t Cache_Set(
+        uint8_t const Unit_ID,
+        uint8_t const Function_Code,
+        uint16_t const Start,
+        uint16_t const Quantity);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Cache_Read_Table() gives the Table an FC01..FC04 Read reads.
+Bool Cache_Read_Table(
+        uint8_t const Function_Code,
+        Modbus_Table *const Table) {
+
+    Bool Check_Ok = TRUE;
+
+    switch (Function_Code) {
+        case Fun_Code01:
+            *Table = TABLE_COILS;
+            break;
+        case Fun_Code02:
+            *Table = TABLE_DISCRETE_INPUTS;
+            break;
+        case Fun_Code03:
+            *Table = TABLE_HOLDING_REGISTERS;
+            break;
+        case Fun_Code04:
+            *Table = TABLE_INPUT_REGISTERS;
+            break;
+        default:
+            Check_Ok = FALSE;
+            break;
+    }
+    return Check_Ok;
+}
+
+//!-  Cache_Write_Range() gives the Items a Write Request changes.
+Bool Cache_Write_Range(
+        const Modbus_Frame *const Request,
+        Modbus_Table *const Table,
+        uint16_t *const Start,
+        uint16_t *const Quantity) {
+
+    Bool Check_Ok = (Bool) (Request->Length >= FRAME_REQ_HEADER_LENGTH);
+
+    *Table = TABLE_HOLDING_REGISTERS;
+    *Start = Frame_Address(Request);
+    *Quantity = 1;
+    switch ((Check_Ok == TRUE) ? Frame_Function_Code(Request) : 0) {
+        case Fun_Code05:
+            *Table = TABLE_COILS;
+            break;
+        case Fun_Code15:
+            *Table = TABLE_COILS;
+            *Quantity = Frame_Quantity(Request);
+            break;
+        case Fun_Code06:
+        case Fun_Code22:
+            break;
+        case Fun_Code16:
+            *Quantity = Frame_Quantity(Request);
+            break;
+        case Fun_Code23:
+            Check_Ok = (Bool) (Request->Length >= FRAME_RW_BYTE_COUNT_OFFSET);
+            if (Check_Ok == TRUE) {
+                *Start = Frame_RW_Address(Request);
+                *Quantity = Frame_RW_Quantity(Request);
+            }
+            break;
+        default:
+            Check_Ok = FALSE;
+            break;
+    }
+    return Check_Ok;
+}
+
+//!-  Cache_Overlaps() tells whether two Item Ranges share an Item.
+Bool Cache_Overlaps(
+        uint32_t const Start_A,
+        uint32_t const Quantity_A,
+        uint32_t const Start_B,
+        uint32_t const Quantity_B) {
+
+    return (Bool) ((Start_A < (Start_B + Quantity_B)) &&
+                   (Start_B < (Start_A + Quantity_A)));
+}
+
+/*
+ *!-  Cache_TTL() gives the TTL of a Read: the shortest of the
+ *!-  Rules it touches, the Default if it touches none.
+ */
+uint64_t Cache_TTL(
+        const Modbus_Cache *const Cache,
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Quantity) {
+
+    const Modbus_Cache_Rule *Rule = NULL;
+    uint64_t TTL_ns = Cache->Default_TTL_ns;
+    Bool Covered = FALSE;
+    uint32_t Index = 0;
+
+    for (Index = 0; Index < Cache->Rules; Index++) {
+        Rule = &Cache->Rule[Index];
+        if (((Rule->Unit_ID == BROADCAST) || (Rule->Unit_ID == Unit_ID)) &&
+            (Rule->Table == Table) &&
+            (Cache_Overlaps(Rule->First, (uint32_t) (Rule->Last - Rule->First) + 1,
+                            Start, Quantity) == TRUE) &&
+            ((Covered == FALSE) || (Rule->TTL_ns < TTL_ns))) {
+            TTL_ns = Rule->TTL_ns;
+            Covered = TRUE;
+        }
+    }
+    return TTL_ns;
+}
+
+//!-  Cache_Set() picks the Set of a Key.
+uint32_t Cache_Set(
+        uint8_t const Unit_ID,
+        uint8_t const Function_Code,
+        uint16_t const Start,
+        uint16_t const Quantity) {
+
+    uint32_t const Key = ((uint32_t) Unit_ID << 24) ^
+                         ((uint32_t) Function_Code << 16) ^
+                         ((uint32_t) Start) ^
+                         ((uint32_t) Quantity * CACHE_HASH_MULTIPLIER);
+
+    return ((Key * CACHE_HASH_MULTIPLIER) >> 16) % MODBUS_CACHE_SETS;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Modbus_Cache_Init() empties the Cache and drops its Rules.
+void Modbus_Cache_Init(
+        Modbus_Cache *const Cache,
+        uint64_t const Default_TTL_ns) {
+
+    memset(Cache, 0, sizeof(*Cache));
+    Cache->Default_TTL_ns = Default_TTL_ns;
+}
+
+/*
+ *!-  Modbus_Cache_Set_TTL() gives Items "First" .. "Last" of a
+ *!-  Table of "Unit_ID" (BROADCAST: of every Unit) their own TTL.
+ *!-  A Read touching several Ranges lives as long as the
+ *!-  shortest. Returns FALSE when the Rules are used up.
+ */
+Bool Modbus_Cache_Set_TTL(
+        Modbus_Cache *const Cache,
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const First,
+        uint16_t const Last,
+        uint64_t const TTL_ns) {
+
+    Bool Check_Ok = FALSE;
+    Modbus_Cache_Rule *Rule = NULL;
+
+    if ((Cache->Rules < MODBUS_CACHE_RULES) && (First <= Last) &&
+        (Table <= TABLE_HOLDING_REGISTERS)) {
+        Rule = &Cache->Rule[Cache->Rules];
+        Rule->Unit_ID = Unit_ID;
+        Rule->Table = Table;
+        Rule->First = First;
+        Rule->Last = Last;
+        Rule->TTL_ns = TTL_ns;
+        Cache->Rules++;
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Cache_Lookup() looks up a Request (Unit ID + PDU) and
+ *!-  sets "Entry" for all but CACHE_BYPASS:
+ *!-  CACHE_HIT: a live Response is in the Entry.
+ *!-  CACHE_PENDING: the same Read is in Flight; queue the Request
+ *!-  on the Entry's Waiters and answer it on its Completion.
+ *!-  CACHE_MISS: forward the Request and report its Response with
+ *!-  Modbus_Cache_Complete(); others now coalesce onto it.
+ *!-  Writes, Broadcasts and other Functions are bypassed, as are
+ *!-  Reads whose Set is all in Flight and Reads a Write made Stale
+ *!-  while in Flight.
+ */
+Modbus_Cache_Result Modbus_Cache_Lookup(
+        Modbus_Cache *const Cache,
+        const Modbus_Frame *const Request,
+        uint64_t const Now_ns,
+        Modbus_Cache_Entry **const Entry) {
+
+    Modbus_Cache_Result Result = CACHE_BYPASS;
+    Modbus_Cache_Entry *Set = NULL;
+    Modbus_Cache_Entry *Found = NULL;
+    Modbus_Cache_Entry *Victim = NULL;
+    Modbus_Table Table = TABLE_COILS;
+    uint8_t Unit_ID = 0;
+    uint8_t Function_Code = 0;
+    uint16_t Start = 0;
+    uint16_t Quantity = 0;
+    uint32_t Way = 0;
+
+    *Entry = NULL;
+    if ((Request->Length == FRAME_REQ_HEADER_LENGTH) &&
+        (Frame_Device_ID(Request) != BROADCAST) &&
+        (Cache_Read_Table(Frame_Function_Code(Request), &Table) == TRUE)) {
+        Unit_ID = Frame_Device_ID(Request);
+        Function_Code = Frame_Function_Code(Request);
+        Start = Frame_Address(Request);
+        Quantity = Frame_Quantity(Request);
+        Set = &Cache->Entry[Cache_Set(Unit_ID, Function_Code, Start,
+                                      Quantity) * MODBUS_CACHE_WAYS];
+
+        for (Way = 0; (Way < MODBUS_CACHE_WAYS) && (Found == NULL); Way++) {
+            if ((Set[Way].State != CACHE_EMPTY) &&
+                (Set[Way].Unit_ID == Unit_ID) &&
+                (Set[Way].Function_Code == Function_Code) &&
+                (Set[Way].Start == Start) && (Set[Way].Quantity == Quantity)) {
+                Found = &Set[Way];
+            }
+            else if ((Set[Way].State != CACHE_FETCH) &&
+                     ((Victim == NULL) || (Set[Way].State == CACHE_EMPTY) ||
+                      ((Victim->State != CACHE_EMPTY) &&
+                       (Set[Way].Used_ns < Victim->Used_ns)))) {
+                Victim = &Set[Way];
+            }
+        }
+
+        if ((Found != NULL) && (Found->State == CACHE_VALID) &&
+            (Now_ns < Found->Expires_ns)) {
+            Found->Used_ns = Now_ns;
+            Cache->Stats.Hits++;
+            *Entry = Found;
+            Result = CACHE_HIT;
+        }
+        //!-  A Stale Read in Flight may answer from before a Write.
+        else if ((Found != NULL) && (Found->State == CACHE_FETCH)) {
+            if (Found->Stale == FALSE) {
+                Cache->Stats.Coalesced++;
+                *Entry = Found;
+                Result = CACHE_PENDING;
+            }
+        }
+        else {
+            if (Found != NULL) {
+                Victim = Found;
+            }
+            if (Victim != NULL) {
+                Victim->State = CACHE_FETCH;
+                Victim->Stale = FALSE;
+                Victim->Unit_ID = Unit_ID;
+                Victim->Function_Code = Function_Code;
+                Victim->Start = Start;
+                Victim->Quantity = Quantity;
+                Victim->Length = 0;
+                Victim->TTL_ns = Cache_TTL(Cache, Unit_ID, Table, Start,
+                                           Quantity);
+                Victim->Used_ns = Now_ns;
+                Victim->Waiters = NULL;
+                Cache->Stats.Misses++;
+                *Entry = Victim;
+                Result = CACHE_MISS;
+            }
+        }
+    }
+
+    if (Result == CACHE_BYPASS) {
+        Cache->Stats.Bypassed++;
+    }
+    return Result;
+}
+
+/*
+ *!-  Modbus_Cache_Complete() ends the Fetch of a CACHE_MISS Entry
+ *!-  with its Response (Unit ID + PDU), NULL if none came. Normal
+ *!-  Responses are kept for the Entry's TTL; Exceptions and Stale
+ *!-  Responses are not. Take the Waiters off the Entry first.
+ */
+void Modbus_Cache_Complete(
+        Modbus_Cache *const Cache,
+        Modbus_Cache_Entry *const Entry,
+        const Modbus_Frame *const Response,
+        uint64_t const Now_ns) {
+
+    (void) Cache;
+    Entry->Waiters = NULL;
+    if ((Response != NULL) && (Entry->Stale == FALSE) && (Entry->TTL_ns != 0) &&
+        (Frame_Is_Exception(Response) == FALSE) &&
+        (Response->Length <= MODBUS_MAX_ADU_LENGTH)) {
+        memcpy(Entry->Response, Response->Adu, Response->Length);
+        Entry->Length = Response->Length;
+        Entry->Expires_ns = Now_ns + Entry->TTL_ns;
+        Entry->State = CACHE_VALID;
+    }
+    else {
+        Entry->State = CACHE_EMPTY;
+    }
+}
+
+/*
+ *!-  Modbus_Cache_Invalidate() drops the Responses a Write Request
+ *!-  (FC05/06/15/16/22/23) overlaps, for all Units if broadcast.
+ *!-  Overlapping Reads in Flight are not kept when they complete.
+ *!-  Returns the Number of Entries hit; 0 for anything but Writes.
+ */
+uint32_t Modbus_Cache_Invalidate(
+        Modbus_Cache *const Cache,
+        const Modbus_Frame *const Request) {
+
+    Modbus_Cache_Entry *Entry = NULL;
+    Modbus_Table Write_Table = TABLE_COILS;
+    Modbus_Table Table = TABLE_COILS;
+    uint8_t const Unit_ID = Frame_Device_ID(Request);
+    uint16_t Start = 0;
+    uint16_t Quantity = 0;
+    uint32_t Count = 0;
+    uint32_t Index = 0;
+
+    if (Cache_Write_Range(Request, &Write_Table, &Start, &Quantity) == TRUE) {
+        for (Index = 0; Index < MODBUS_CACHE_ENTRIES; Index++) {
+            Entry = &Cache->Entry[Index];
+            if ((Entry->State != CACHE_EMPTY) &&
+                ((Unit_ID == BROADCAST) || (Entry->Unit_ID == Unit_ID)) &&
+                (Cache_Read_Table(Entry->Function_Code, &Table) == TRUE) &&
+                (Table == Write_Table) &&
+                (Cache_Overlaps(Entry->Start, Entry->Quantity,
+                                Start, Quantity) == TRUE)) {
+                if (Entry->State == CACHE_VALID) {
+                    Entry->State = CACHE_EMPTY;
+                }
+                else {
+                    Entry->Stale = TRUE;
+                }
+                Count++;
+            }
+        }
+        Cache->Stats.Invalidated += Count;
+    }
+    return Count;
+}
@@ -0,0 +1,137 @@
+/*
+ * Modbus_Cache.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Cache.h
+*****************************************************************************/
+
+#ifndef __MODBUS_CACHE_H_
+#define __MODBUS_CACHE_H_
+
+//!-  Headers
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Entries of a Cache, a Multiple of MODBUS_CACHE_WAYS.
+#define MODBUS_CACHE_ENTRIES    (1024)
+//!-  Entries a Key may occupy; the least recently used one goes.
+#define MODBUS_CACHE_WAYS       (4)
+#define MODBUS_CACHE_SETS       (MODBUS_CACHE_ENTRIES / MODBUS_CACHE_WAYS)
+//!-  TTL Rules of a Cache.
+#define MODBUS_CACHE_RULES      (64)
+
+//!-  Result of Modbus_Cache_Lookup().
+typedef enum {
+    CACHE_BYPASS  = 0,  //!-  Not a cacheable Read: forward it.
+    CACHE_HIT     = 1,  //!-  Answer with the Entry's Response.
+    CACHE_PENDING = 2,  //!-  Same Read in Flight: wait on the Entry.
+    CACHE_MISS    = 3,  //!-  Forward it, then Modbus_Cache_Complete().
+} Modbus_Cache_Result;
+
+//!-  State of a Cache Entry.
+typedef enum {
+    CACHE_EMPTY   = 0,
+    CACHE_FETCH   = 1,  //!-  Read in Flight, Response to come.
+    CACHE_VALID   = 2,  //!-  Response held until Expires_ns.
+} Modbus_Cache_State;
+
+/*
+ *!-  "Modbus_Cache_Entry" is the Response to one Read: Unit ID,
+ *!-  Function Code and Range are the Key; Response holds Unit ID
+ *!-  + PDU. Waiters belongs to the Caller, for the Requests
+ *!-  coalesced onto a Read in Flight. A Write overlapping a Read
+ *!-  in Flight marks it Stale: its Response is then passed on,
+ *!-  but not kept.
+ */
+typedef struct {
+    Modbus_Cache_State  State;
+    Bool                Stale;
+    uint8_t             Unit_ID;
+    uint8_t             Function_Code;
+    uint16_t            Start;
+    uint16_t            Quantity;
+    uint16_t            Length;
+    uint64_t            TTL_ns;
+    uint64_t            Expires_ns;
+    uint64_t            Used_ns;
+    void               *Waiters;
+    uint8_t             Response[MODBUS_MAX_ADU_LENGTH];
+} Modbus_Cache_Entry;
+
+/*
+ *!-  "Modbus_Cache_Rule" sets the TTL of a Range: Reads touching
+ *!-  it live "TTL_ns" at most (0: not kept at all). Unit_ID
+ *!-  BROADCAST stands for all Units.
+ */
+typedef struct {
+    uint8_t       Unit_ID;
+    Modbus_Table  Table;
+    uint16_t      First;
+    uint16_t      Last;
+    uint64_t      TTL_ns;
+} Modbus_Cache_Rule;
+
+//!-  "Modbus_Cache_Stats" counts what the Cache saved.
+typedef struct {
+    uint64_t  Hits;
+    uint64_t  Misses;
+    uint64_t  Coalesced;
+    uint64_t  Bypassed;
+    uint64_t  Invalidated;
+} Modbus_Cache_Stats;
+
+/*
+ *!-  "Modbus_Cache" keeps the Responses to FC01..FC04 Reads of
+ *!-  the Slaves behind a Gateway or Master, in Sets of
+ *!-  MODBUS_CACHE_WAYS Entries chosen by a Hash of the Key.
+ *!-  Default_TTL_ns:
+ *!-  TTL of Reads no Rule covers; 0 only coalesces Reads in Flight.
+ */
+typedef struct {
+    uint64_t            Default_TTL_ns;
+    uint32_t            Rules;
+    Modbus_Cache_Rule   Rule[MODBUS_CACHE_RULES];
+    Modbus_Cache_Stats  Stats;
+    Modbus_Cache_Entry  Entry[MODBUS_CACHE_ENTRIES];
+} Modbus_Cache;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+void Modbus_Cache_Init(
+        Modbus_Cache *const Cache,
+        uint64_t const Default_TTL_ns);
+
+Bool Modbus_Cache_Set_TTL(
+        Modbus_Cache *const Cache,
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const First,
+        uint16_t const Last,
+        uint64_t const TTL_ns);
+
+Modbus_Cache_Result Modbus_Cache_Lookup(
+        Modbus_Cache *const Cache,
+        const Modbus_Frame *const Request,
+        uint64_t const Now_ns,
+        Modbus_Cache_Entry **const Entry);
+
+void Modbus_Cache_Complete(
+        Modbus_Cache *const Cache,
+        Modbus_Cache_Entry *const Entry,
+        const Modbus_Frame *const Response,
+        uint64_t const Now_ns);
+
+uint32_t Modbus_Cache_Invalidate(
+        Modbus_Cache *const Cache,
+        const Modbus_Frame *const Request);
+
+#endif /* __MODBUS_CACHE_H_ */
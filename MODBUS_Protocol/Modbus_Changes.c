@@ -0,0 +1,406 @@
+/*
+ * Modbus_Changes.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Changes.c
+*****************************************************************************/
+
+//!-  Headers
+#include <stdlib.h>
+#include <string.h>
+#include "Modbus.h"
+#include "Modbus_Changes.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  A Log Range packs Table, Start and Count of one Write.
+#define CHANGE_RANGE(Table, Start, Count)                           \
+    (((uint64_t) (Table) << 32) | ((uint64_t) (Start) << 16) |      \
+     (uint64_t) (Count))
+#define CHANGE_RANGE_TABLE(Range)  ((Modbus_Table) ((Range) >> 32))
+#define CHANGE_RANGE_START(Range)  ((uint16_t) ((Range) >> 16))
+#define CHANGE_RANGE_COUNT(Range)  ((uint16_t) (Range))
+
+void Changes_Mark(
+        Modbus_Changes *const Changes,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count);
+
+void Changes_Log(
+        Modbus_Changes *const Changes,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count);
+
+void Changes_Deliver(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint32_t const Start,
+        uint32_t const End);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Changes_Mark() sets the Dirty Bits of a Range bottom-up with
+ *!-  Release RMWs, so a Drain that clears top-down with Acquire
+ *!-  Exchanges never loses one: RMWs act on the latest Value, and
+ *!-  a Top Bit the Drain takes carries the Summary and Item Bits
+ *!-  set before it; one set after it waits for the next Drain.
+ *!-  The upper Levels are never skipped on a Load, which may see
+ *!-  a Bit the Drain has just cleared, only on the Item RMW: if it
+ *!-  finds the Range all dirty already, no Drain has taken those
+ *!-  Bits yet, and whoever set them sets the upper Levels after
+ *!-  them, so hot Registers cost one RMW.
+ */
+void Changes_Mark(
+        Modbus_Changes *const Changes,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count) {
+
+    uint32_t Bit = Start;
+    uint32_t const End = (uint32_t) Start + Count;
+    uint32_t Span = 0;
+    uint32_t Word = 0;
+    uint64_t Mask = 0;
+    uint64_t Dirty = 0;
+
+    while (Bit < End) {
+        Span = BITS_PER_WORD - (Bit % BITS_PER_WORD);
+        if (Span > (End - Bit)) {
+            Span = End - Bit;
+        }
+        Mask = (Span == BITS_PER_WORD) ? ~0ULL :
+               (((1ULL << Span) - 1) << (Bit % BITS_PER_WORD));
+        Word = Bit / BITS_PER_WORD;
+
+        Dirty = __atomic_fetch_or(&Changes->Bits[Table][Word], Mask,
+                                  __ATOMIC_RELEASE);
+        if ((Dirty & Mask) != Mask) {
+            (void) __atomic_fetch_or(
+                &Changes->Summary[Table][Word / BITS_PER_WORD],
+                1ULL << (Word % BITS_PER_WORD), __ATOMIC_RELEASE);
+            (void) __atomic_fetch_or(&Changes->Top[Table],
+                                     1ULL << (Word / BITS_PER_WORD),
+                                     __ATOMIC_RELEASE);
+        }
+        Bit += Span;
+    }
+}
+
+/*
+ *!-  Changes_Log() appends a Write to the Log. Each Writer owns the
+ *!-  Slot of the Generation it drew; the Slot's Generation is zero
+ *!-  while its Range is being replaced.
+ */
+void Changes_Log(
+        Modbus_Changes *const Changes,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count) {
+
+    uint64_t const Generation = __atomic_add_fetch(&Changes->Generation, 1,
+                                                   __ATOMIC_RELAXED);
+    Change_Entry *const Entry =
+        &Changes->Log[Generation & (MODBUS_CHANGE_LOG - 1)];
+
+    __atomic_store_n(&Entry->Generation, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&Entry->Range, CHANGE_RANGE(Table, Start, Count),
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&Entry->Generation, Generation, __ATOMIC_RELEASE);
+}
+
+//!-  Changes_Deliver() calls every Subscription overlapping a Run.
+void Changes_Deliver(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint32_t const Start,
+        uint32_t const End) {
+
+    const Modbus_Changes *const Changes = Unit->Changes;
+    const Modbus_Subscription *Subscription = NULL;
+    uint32_t Index = 0;
+    uint32_t First = 0;
+    uint32_t Last = 0;
+
+    for (Index = 0; Index < Changes->Subscriptions; Index++) {
+        Subscription = &Changes->Subscription[Index];
+        First = (Start > Subscription->Start) ? Start : Subscription->Start;
+        Last = (End < Subscription->End) ? End : Subscription->End;
+        if ((Subscription->Table == Table) && (First < Last)) {
+            Subscription->Callback(Subscription->Context, Unit, Table,
+                                   (uint16_t) First, (uint16_t) (Last - First));
+        }
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_Track_Changes() starts tracking the Writes to a Unit,
+ *!-  from Requests and from the Set_Single_* / Publish Functions.
+ *!-  Untracked Units pay nothing. Writes by other Processes to a
+ *!-  Shared Unit are not seen, the Tracking is Process-local.
+ */
+Bool Modbus_Track_Changes(
+        Modbus_Data *const Unit) {
+
+    Bool Check_Ok = FALSE;
+    Modbus_Changes *Changes = NULL;
+
+    if ((Unit != NULL) && (Unit->Changes != NULL)) {
+        Check_Ok = TRUE;
+    }
+    else if (Unit != NULL) {
+        Changes = aligned_alloc(MODBUS_CACHE_LINE, sizeof(Modbus_Changes));
+        if (Changes != NULL) {
+            memset(Changes, 0, sizeof(Modbus_Changes));
+            __atomic_store_n(&Unit->Changes, Changes, __ATOMIC_RELEASE);
+            Check_Ok = TRUE;
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Modbus_Untrack_Changes() drops the Tracking and Subscriptions.
+void Modbus_Untrack_Changes(
+        Modbus_Data *const Unit) {
+
+    if (Unit != NULL) {
+        free(Unit->Changes);
+        Unit->Changes = NULL;
+    }
+}
+
+/*
+ *!-  Modbus_Changes_Record() notes that "Count" Items from "Start"
+ *!-  were written. The Database calls it after every Write; it
+ *!-  costs O(Count / 64) and may run on several Threads at once.
+ */
+void Modbus_Changes_Record(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count) {
+
+    Modbus_Changes *const Changes = (Unit != NULL) ?
+        __atomic_load_n(&Unit->Changes, __ATOMIC_ACQUIRE) : NULL;
+
+    if ((Changes != NULL) && (Count != 0) && (Table < MODBUS_TABLES)) {
+        Changes_Mark(Changes, Table, Start, Count);
+        Changes_Log(Changes, Table, Start, Count);
+    }
+}
+
+/*
+ *!-  Modbus_Subscribe() adds a Callback for Writes to "Count" Items
+ *!-  of a Table from "Start". Tracking is started if needed.
+ */
+Bool Modbus_Subscribe(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint32_t const Count,
+        Modbus_Change_Callback const Callback,
+        void *const Context) {
+
+    Bool Check_Ok = FALSE;
+    Modbus_Subscription *Subscription = NULL;
+
+    if ((Callback != NULL) && (Table < MODBUS_TABLES) && (Count != 0) &&
+        (((uint32_t) Start + Count) <= MAX_UNIT_ITEMS)) {
+        Check_Ok = Modbus_Track_Changes(Unit);
+    }
+    if ((Check_Ok == TRUE) &&
+        (Unit->Changes->Subscriptions < MODBUS_SUBSCRIPTIONS)) {
+        Subscription = &Unit->Changes->Subscription[
+                           Unit->Changes->Subscriptions++];
+        Subscription->Table = Table;
+        Subscription->Start = Start;
+        Subscription->End = (uint32_t) Start + Count;
+        Subscription->Callback = Callback;
+        Subscription->Context = Context;
+    }
+    else {
+        Check_Ok = FALSE;
+    }
+    return Check_Ok;
+}
+
+//!-  Modbus_Unsubscribe() removes all Subscriptions of a Callback.
+Bool Modbus_Unsubscribe(
+        Modbus_Data *const Unit,
+        Modbus_Change_Callback const Callback,
+        void *const Context) {
+
+    Bool Check_Ok = FALSE;
+    Modbus_Changes *const Changes = (Unit != NULL) ? Unit->Changes : NULL;
+    uint32_t Index = 0;
+
+    while ((Changes != NULL) && (Index < Changes->Subscriptions)) {
+        if ((Changes->Subscription[Index].Callback == Callback) &&
+            (Changes->Subscription[Index].Context == Context)) {
+            Changes->Subscription[Index] =
+                Changes->Subscription[--Changes->Subscriptions];
+            Check_Ok = TRUE;
+        }
+        else {
+            Index++;
+        }
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Notify_Changes() drains the Dirty Bitmaps of a Unit
+ *!-  and calls the Subscriptions once per Run of changed Items,
+ *!-  however often they were written. Only dirty Words are
+ *!-  visited, so the Cost follows the Writes, not the Table Size.
+ *!-  Returns the Number of Runs; one Thread drains at a Time, the
+ *!-  same that adds and removes Subscriptions. It clears top-down
+ *!-  with Acquire Exchanges, which pair with the Release RMWs of
+ *!-  Changes_Mark().
+ */
+uint32_t Modbus_Notify_Changes(
+        Modbus_Data *const Unit) {
+
+    Modbus_Changes *const Changes = (Unit != NULL) ? Unit->Changes : NULL;
+    uint32_t Runs = 0;
+    uint32_t Table = 0;
+    uint32_t Word = 0;
+    uint32_t Bit = 0;
+    uint32_t Run_Start = 0;
+    uint32_t Run_End = 0;
+    uint32_t Low = 0;
+    uint32_t Length = 0;
+    uint64_t Top = 0;
+    uint64_t Summary = 0;
+    uint64_t Bits = 0;
+
+    for (Table = 0; (Changes != NULL) && (Table < MODBUS_TABLES); Table++) {
+        Run_Start = 0;
+        Run_End = 0;
+        Top = __atomic_exchange_n(&Changes->Top[Table], 0, __ATOMIC_ACQUIRE);
+        while (Top != 0) {
+            Word = (uint32_t) __builtin_ctzll(Top) * BITS_PER_WORD;
+            Top &= Top - 1;
+            Summary = __atomic_exchange_n(
+                &Changes->Summary[Table][Word / BITS_PER_WORD], 0,
+                __ATOMIC_ACQUIRE);
+            while (Summary != 0) {
+                Bits = __atomic_exchange_n(
+                    &Changes->Bits[Table][Word + __builtin_ctzll(Summary)],
+                    0, __ATOMIC_ACQUIRE);
+                Bit = (Word + (uint32_t) __builtin_ctzll(Summary)) *
+                      BITS_PER_WORD;
+                Summary &= Summary - 1;
+                while (Bits != 0) {
+                    //!-  Next Run of set Bits inside this Word.
+                    Low = (uint32_t) __builtin_ctzll(Bits);
+                    Length = (~(Bits >> Low) == 0) ? (BITS_PER_WORD - Low) :
+                             (uint32_t) __builtin_ctzll(~(Bits >> Low));
+                    if (Bit + Low != Run_End) {
+                        if (Run_End != Run_Start) {
+                            Changes_Deliver(Unit, (Modbus_Table) Table,
+                                            Run_Start, Run_End);
+                            Runs++;
+                        }
+                        Run_Start = Bit + Low;
+                    }
+                    Run_End = Bit + Low + Length;
+                    Bits = (Low + Length < BITS_PER_WORD) ?
+                           (Bits & ~(((1ULL << Length) - 1) << Low)) : 0;
+                }
+            }
+        }
+        if (Run_End != Run_Start) {
+            Changes_Deliver(Unit, (Modbus_Table) Table, Run_Start, Run_End);
+            Runs++;
+        }
+    }
+    return Runs;
+}
+
+//!-  Modbus_Changes_Generation() returns the Number of Writes so far.
+uint64_t Modbus_Changes_Generation(
+        const Modbus_Data *const Unit) {
+
+    const Modbus_Changes *const Changes = (Unit != NULL) ?
+        __atomic_load_n(&Unit->Changes, __ATOMIC_ACQUIRE) : NULL;
+
+    return (Changes != NULL) ?
+           __atomic_load_n(&Changes->Generation, __ATOMIC_ACQUIRE) : 0;
+}
+
+/*
+ *!-  Modbus_Changes_Since() copies up to "*Count" Writes made after
+ *!-  Generation "*Generation" to "Changes", sets "*Count" to the
+ *!-  Number copied and advances "*Generation" past them. Any Number
+ *!-  of Consumers may drain this way, each with its own Generation.
+ *!-  Returns FALSE if Writes were lost because the Log wrapped:
+ *!-  the Consumer rescans and restarts from
+ *!-  Modbus_Changes_Generation().
+ */
+Bool Modbus_Changes_Since(
+        const Modbus_Data *const Unit,
+        uint64_t *const Generation,
+        Modbus_Change *const Changes,
+        uint32_t *const Count) {
+
+    Bool Check_Ok = TRUE;
+    const Modbus_Changes *const Log = (Unit != NULL) ?
+        __atomic_load_n(&Unit->Changes, __ATOMIC_ACQUIRE) : NULL;
+    const Change_Entry *Entry = NULL;
+    uint64_t const Current = Modbus_Changes_Generation(Unit);
+    uint64_t Next = *Generation + 1;
+    uint64_t Stamp = 0;
+    uint64_t Range = 0;
+    uint32_t Copied = 0;
+
+    if ((Log != NULL) && ((Current - *Generation) > MODBUS_CHANGE_LOG)) {
+        Check_Ok = FALSE;
+    }
+    while ((Check_Ok == TRUE) && (Log != NULL) && (Next <= Current) &&
+           (Copied < *Count)) {
+        Entry = &Log->Log[Next & (MODBUS_CHANGE_LOG - 1)];
+        Stamp = __atomic_load_n(&Entry->Generation, __ATOMIC_ACQUIRE);
+        Range = __atomic_load_n(&Entry->Range, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&Entry->Generation, __ATOMIC_RELAXED) != Stamp) {
+            //!-  Being rewritten: read it again.
+            continue;
+        }
+        if (Stamp > Next) {
+            Check_Ok = FALSE;
+        }
+        else if (Stamp < Next) {
+            //!-  Its Writer has not finished yet: stop before it.
+            break;
+        }
+        else {
+            Changes[Copied].Generation = Next;
+            Changes[Copied].Table = CHANGE_RANGE_TABLE(Range);
+            Changes[Copied].Start = CHANGE_RANGE_START(Range);
+            Changes[Copied].Count = CHANGE_RANGE_COUNT(Range);
+            Copied++;
+            Next++;
+        }
+    }
+    *Count = Copied;
+    if (Check_Ok == TRUE) {
+        *Generation = Next - 1;
+    }
+    return Check_Ok;
+}
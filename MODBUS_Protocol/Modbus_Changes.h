@@ -0,0 +1,132 @@
+/*
+ * Modbus_Changes.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Changes.h
+*****************************************************************************/
+
+#ifndef __MODBUS_CHANGES_H_
+#define __MODBUS_CHANGES_H_
+
+//!-  Headers
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Writes remembered for Modbus_Changes_Since(), a Power of 2.
+#define MODBUS_CHANGE_LOG       (1024)
+//!-  Range Subscriptions per Unit.
+#define MODBUS_SUBSCRIPTIONS    (32)
+
+/*
+ *!-  Levels of the Dirty Bitmap of a Table: one Bit per Item,
+ *!-  one Summary Bit per Word of Item Bits, one Top Bit per
+ *!-  Summary Word. A Drain only visits Words with Bits set.
+ */
+#define CHANGE_BIT_WORDS      (MAX_UNIT_ITEMS / BITS_PER_WORD)
+#define CHANGE_SUMMARY_WORDS  (CHANGE_BIT_WORDS / BITS_PER_WORD)
+
+/****************************************************************************
+!-  GLOBAL TYPE DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  "Modbus_Change_Callback" is called by Modbus_Notify_Changes()
+ *!-  once per Run of changed Items inside a subscribed Range.
+ */
+typedef void (*Modbus_Change_Callback)(
+        void *const Context,
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count);
+
+//!-  "Modbus_Change" is one Write reported by Modbus_Changes_Since().
+typedef struct {
+    uint64_t      Generation;
+    Modbus_Table  Table;
+    uint16_t      Start;
+    uint16_t      Count;
+} Modbus_Change;
+
+//!-  "Modbus_Subscription" is a Range of a Table and its Callback.
+typedef struct {
+    Modbus_Table            Table;
+    uint32_t                Start;
+    uint32_t                End;
+    Modbus_Change_Callback  Callback;
+    void                   *Context;
+} Modbus_Subscription;
+
+//!-  "Change_Entry" is one Slot of the Write Log.
+typedef struct {
+    uint64_t  Generation;
+    uint64_t  Range;
+} Change_Entry;
+
+/*
+ *!-  "Modbus_Changes" tracks the Writes to one Unit.
+ *!-  Generation:
+ *!-  Number of Writes so far; Write N is kept in Log[N % Size]
+ *!-  until MODBUS_CHANGE_LOG later Writes overwrite it.
+ *!-  Top/Summary/Bits:
+ *!-  Dirty Bitmap per Table, cleared by Modbus_Notify_Changes().
+ */
+typedef struct Modbus_Changes {
+    uint64_t             Generation;
+    Change_Entry         Log[MODBUS_CHANGE_LOG];
+    uint32_t             Subscriptions;
+    Modbus_Subscription  Subscription[MODBUS_SUBSCRIPTIONS];
+    uint64_t             Top[MODBUS_TABLES];
+    uint64_t             Summary[MODBUS_TABLES][CHANGE_SUMMARY_WORDS];
+    uint64_t             Bits[MODBUS_TABLES][CHANGE_BIT_WORDS];
+} __attribute__((aligned(MODBUS_CACHE_LINE))) Modbus_Changes;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+Bool Modbus_Track_Changes(
+        Modbus_Data *const Unit);
+
+void Modbus_Untrack_Changes(
+        Modbus_Data *const Unit);
+
+void Modbus_Changes_Record(
+        const Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count);
+
+Bool Modbus_Subscribe(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint32_t const Count,
+        Modbus_Change_Callback const Callback,
+        void *const Context);
+
+Bool Modbus_Unsubscribe(
+        Modbus_Data *const Unit,
+        Modbus_Change_Callback const Callback,
+        void *const Context);
+
+uint32_t Modbus_Notify_Changes(
+        Modbus_Data *const Unit);
+
+uint64_t Modbus_Changes_Generation(
+        const Modbus_Data *const Unit);
+
+Bool Modbus_Changes_Since(
+        const Modbus_Data *const Unit,
+        uint64_t *const Generation,
+        Modbus_Change *const Changes,
+        uint32_t *const Count);
+
+#endif /* __MODBUS_CHANGES_H_ */
@@ -0,0 +1,41 @@
+/*
+ * Modbus_Clock.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Clock.h
+*****************************************************************************/
+
+#ifndef __MODBUS_CLOCK_H_
+#define __MODBUS_CLOCK_H_
+
+//!-  Headers
+#include <stdint.h>
+#include <time.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+#define NS_PER_US  (1000ULL)
+#define NS_PER_MS  (1000000ULL)
+#define NS_PER_S   (1000000000ULL)
+
+/****************************************************************************
+!-  GLOBAL INLINE FUNCTIONS
+*****************************************************************************/
+
+//!-  Modbus_Now_ns() reads the Monotonic Clock in Nanoseconds.
+static inline uint64_t Modbus_Now_ns(
+        void) {
+
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return ((uint64_t) Now.tv_sec * NS_PER_S) + (uint64_t) Now.tv_nsec;
+}
+
+#endif /* __MODBUS_CLOCK_H_ */
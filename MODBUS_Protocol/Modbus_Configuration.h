@@ -18,9 +18,13 @@
 //!-  Defining Unsigned Character as "Bool"
 typedef unsigned char  Bool;
 
-//!-  The DataTypes defined in the MODBUS Protocol.
-typedef uint8_t   Coils;
-typedef uint8_t   Discrete_Inputs;
+/*
+ *!-  The DataTypes defined in the MODBUS Protocol.
+ *!-  Coils & Discrete Inputs are stored Bit-Packed,
+ *!-  BITS_PER_WORD of them per Storage Word.
+ */
+typedef uint64_t  Coils;
+typedef uint64_t  Discrete_Inputs;
 typedef uint16_t  Input_Registers;
 typedef uint16_t  Holding_Registers;
 
@@ -58,6 +62,22 @@ typedef uint16_t  Holding_Registers;
 #define INPUT_REGISTERS_NUMBERS    (0)
 #define HOLDING_REGISTERS_NUMBERS  (1)
 
+/*
+ *!-  "MODBUS_DEVICE_MAP" lists the Tables of the configured Device,
+ *!-  X(Table, Numbers, Max_Numbers), in Modbus_Table Order. The
+ *!-  Limit Checks and the Master-side Range Table are generated
+ *!-  from it, so a Table added here is checked everywhere.
+ */
+#define MODBUS_DEVICE_MAP(X)                                                \
+    X(TABLE_COILS,             COILS_NUMBERS,                               \
+      MAX_COILS_NUMBERS)                                                    \
+    X(TABLE_DISCRETE_INPUTS,   DISCRETE_INPUTS_NUMBERS,                     \
+      MAX_DISCRETE_INPUTS_NUMBERS)                                          \
+    X(TABLE_INPUT_REGISTERS,   INPUT_REGISTERS_NUMBERS,                     \
+      MAX_INPUT_REGISTERS_NUMBERS)                                          \
+    X(TABLE_HOLDING_REGISTERS, HOLDING_REGISTERS_NUMBERS,                   \
+      MAX_HOLDING_REGISTERS_NUMBERS)
+
 #define COILS_ADDR              \
                 (COILS_NUMBERS - 1)
 #define DISCRETE_INPUTS_ADDR    \
@@ -67,4 +87,12 @@ typedef uint16_t  Holding_Registers;
 #define HOLDING_REGISTERS_ADDR  \
                 (HOLDING_REGISTERS_NUMBERS - 1)
 
+//!-  Storage Words needed for the Bit-Packed Tables.
+#define BITS_PER_WORD  (64)
+
+#define COILS_WORDS              \
+                ((COILS_NUMBERS + BITS_PER_WORD - 1) / BITS_PER_WORD)
+#define DISCRETE_INPUTS_WORDS    \
+                ((DISCRETE_INPUTS_NUMBERS + BITS_PER_WORD - 1) / BITS_PER_WORD)
+
 #endif /* __MODBUS_CONFIGURATION_H_ */
@@ -0,0 +1,864 @@
+/*
+ * Modbus_Dispatch.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Dispatch.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus_Frame.h"
+#include "Modbus_Dispatch.h"
+#include "Modbus_Fifo.h"
+#include "Modbus_File.h"
+#include "Modbus_Metrics.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Table Index for Function Codes without an Address Range.
+#define TABLE_NONE    (4)
+#define TABLE_SLOTS   (5)
+
+#define FUNCTION_CODES  (256)
+
+/*
+ *!-  "Function_Descriptor" describes one Function Code.
+ *!-  Handler:
+ *!-  Serves the Request; Illegal Function if unsupported.
+ *!-  Table:
+ *!-  The Modbus_Table addressed by the Code, or TABLE_NONE.
+ *!-  Max_Quantity:
+ *!-  Protocol Limit of Items per Request.
+ */
+typedef struct {
+    Modbus_Handler  Handler;
+    uint8_t         Table;
+    uint16_t        Max_Quantity;
+} Function_Descriptor;
+
+/*
+ *!-  "DISPATCH_FUNCTIONS" lists the built-in Function Codes,
+ *!-  X(Code, Handler, Table, Max_Quantity). The Compiler builds the
+ *!-  Dispatch Table from it; Codes not listed answer Illegal Function.
+ */
+#define DISPATCH_FUNCTIONS(X)                                               \
+    X(Fun_Code01, Handle_Read_Bits,                                         \
+      TABLE_COILS,             MAXREGISTERQUANTITY)                         \
+    X(Fun_Code02, Handle_Read_Bits,                                         \
+      TABLE_DISCRETE_INPUTS,   MAXREGISTERQUANTITY)                         \
+    X(Fun_Code03, Handle_Read_Registers,                                    \
+      TABLE_HOLDING_REGISTERS, MAXREADREGQUANTITY)                          \
+    X(Fun_Code04, Handle_Read_Registers,                                    \
+      TABLE_INPUT_REGISTERS,   MAXREADREGQUANTITY)                          \
+    X(Fun_Code05, Handle_Write_Single_Coil,                                 \
+      TABLE_COILS,             1)                                           \
+    X(Fun_Code06, Handle_Write_Single_Register,                             \
+      TABLE_HOLDING_REGISTERS, 1)                                           \
+    X(Fun_Code07, Handle_Read_Exception_Status,                             \
+      TABLE_NONE,              0)                                           \
+    X(Fun_Code15, Handle_Write_Multiple_Coils,                              \
+      TABLE_COILS,             MAXWRITECOILQUANTITY)                        \
+    X(Fun_Code16, Handle_Write_Multiple_Registers,                          \
+      TABLE_HOLDING_REGISTERS, MAXWRITEREGQUANTITY)                         \
+    X(Fun_Code20, Handle_Read_File_Record,                                  \
+      TABLE_NONE,              0)                                           \
+    X(Fun_Code21, Handle_Write_File_Record,                                 \
+      TABLE_NONE,              0)                                           \
+    X(Fun_Code22, Handle_Mask_Write_Register,                               \
+      TABLE_HOLDING_REGISTERS, 1)                                           \
+    X(Fun_Code23, Handle_Read_Write_Registers,                              \
+      TABLE_HOLDING_REGISTERS, MAXREADREGQUANTITY)                          \
+    X(Fun_Code24, Handle_Read_Fifo_Queue,                                   \
+      TABLE_NONE,              0)
+
+#define DISPATCH_ENTRY(Code, Handler, Table, Max_Quantity)                  \
+    [Code] = { Handler, Table, Max_Quantity },
+
+#define DISPATCH_NUMBERS(Table, Numbers, Max_Numbers)                       \
+    [Table] = (Numbers),
+
+//!-  The Quantity Limits must let every Response fit one PDU.
+_Static_assert((2 + ((MAXREGISTERQUANTITY + 7) / 8)) <= MODBUS_MAX_PDU_LENGTH,
+               "FC01/FC02 Response exceeds the PDU");
+_Static_assert((2 + (MAXREADREGQUANTITY * 2)) <= MODBUS_MAX_PDU_LENGTH,
+               "FC03/FC04 Response exceeds the PDU");
+_Static_assert((6 + ((MAXWRITECOILQUANTITY + 7) / 8)) <= MODBUS_MAX_PDU_LENGTH,
+               "FC15 Request exceeds the PDU");
+_Static_assert((6 + (MAXWRITEREGQUANTITY * 2)) <= MODBUS_MAX_PDU_LENGTH,
+               "FC16 Request exceeds the PDU");
+_Static_assert((10 + (MAXRWWRITEREGQUANTITY * 2)) <= MODBUS_MAX_PDU_LENGTH,
+               "FC23 Request exceeds the PDU");
+_Static_assert((2 + FILE_MAX_READ_LENGTH) <= MODBUS_MAX_PDU_LENGTH,
+               "FC20 Response exceeds the PDU");
+_Static_assert((2 + FILE_MAX_WRITE_LENGTH) <= MODBUS_MAX_PDU_LENGTH,
+               "FC21 Request exceeds the PDU");
+_Static_assert((FIFO_PAYLOAD_OFFSET - 1 + (FIFO_MAX_COUNT * 2)) <=
+               MODBUS_MAX_PDU_LENGTH, "FC24 Response exceeds the PDU");
+
+void Dispatch_Set(
+        uint8_t const FunctionCode,
+        Modbus_Handler const Handler,
+        uint8_t const Table,
+        uint16_t const Max_Quantity);
+
+void Dispatch_Unit(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Range_Exception(
+        const Modbus_Data *const Unit,
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress,
+        uint16_t const Quantity);
+
+uint8_t Handle_Illegal_Function(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Read_Bits(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Read_Registers(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Write_Single_Coil(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Write_Single_Register(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Read_Exception_Status(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Write_Multiple_Coils(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Write_Multiple_Registers(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Read_File_Record(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Write_File_Record(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Mask_Write_Register(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Read_Write_Registers(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint8_t Handle_Read_Fifo_Queue(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+/*
+ *!-  One Entry per Function Code, indexed directly by the Code.
+ *!-  Listed Codes override the Illegal Function Default.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverride-init"
+static Function_Descriptor  Dispatch_Table[FUNCTION_CODES] = {
+    [0 ... FUNCTION_CODES - 1] = { Handle_Illegal_Function, TABLE_NONE, 0 },
+    DISPATCH_FUNCTIONS(DISPATCH_ENTRY)
+};
+#pragma GCC diagnostic pop
+
+/*
+ *!-  Configured Size of every Table; TABLE_NONE has no Addresses.
+ *!-  Used to validate Master Requests, which have no Unit.
+ */
+static const uint32_t  Table_Numbers[TABLE_SLOTS] = {
+    MODBUS_DEVICE_MAP(DISPATCH_NUMBERS)
+    [TABLE_NONE] = 0,
+};
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+void Dispatch_Set(
+        uint8_t const FunctionCode,
+        Modbus_Handler const Handler,
+        uint8_t const Table,
+        uint16_t const Max_Quantity) {
+
+    Dispatch_Table[FunctionCode].Handler = Handler;
+    Dispatch_Table[FunctionCode].Table = Table;
+    Dispatch_Table[FunctionCode].Max_Quantity = Max_Quantity;
+}
+
+/*
+ *!-  Range_Exception() checks Quantity and Address Range of a
+ *!-  Request in the Order the Protocol asks for:
+ *!-  Quantity first (ILLEGAL_DATA_VALUE), then the Range
+ *!-  (ILLEGAL_DATA_ADDRESS).
+ *!-  Unit:
+ *!-  Database the Request addresses; NULL checks against the
+ *!-  configured Table Sizes (Master Requests).
+ */
+uint8_t Range_Exception(
+        const Modbus_Data *const Unit,
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress,
+        uint16_t const Quantity) {
+
+    const Function_Descriptor *const Desc = &Dispatch_Table[FunctionCode];
+    uint8_t Exception = MODBUS_NO_EXCEPTION;
+
+    if ((Quantity < MINREGISTERQUANTITY) ||
+        (Quantity > Desc->Max_Quantity)) {
+        Exception = ILLEGAL_DATA_VALUE;
+    }
+    else if (Desc->Table >= MODBUS_TABLES) {
+        Exception = ILLEGAL_DATA_ADDRESS;
+    }
+    else if (Unit == NULL) {
+        if (((uint32_t) StartAddress + Quantity) > Table_Numbers[Desc->Table]) {
+            Exception = ILLEGAL_DATA_ADDRESS;
+        }
+    }
+    else if (Modbus_Valid_Range(Unit, (Modbus_Table) Desc->Table,
+                                StartAddress, Quantity) == FALSE) {
+        Exception = ILLEGAL_DATA_ADDRESS;
+    }
+    return Exception;
+}
+
+uint8_t Handle_Illegal_Function(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    (void) Unit;
+    (void) Request;
+    (void) Response;
+    return ILLEGAL_FUNCTION;
+}
+
+//!-  Handle_Read_Bits() serves FC01 (Coils) and FC02 (Discrete Inputs).
+uint8_t Handle_Read_Bits(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint8_t  const FunctionCode = Frame_Function_Code(Request);
+    uint16_t Start = 0;
+    uint16_t Quantity = 0;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FRAME_REQ_HEADER_LENGTH) {
+        Start = Frame_Address(Request);
+        Quantity = Frame_Quantity(Request);
+        Exception = Range_Exception(Unit, FunctionCode,
+                                    Start, Quantity);
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        (void) Frame_Build_Read_Response(Response,
+                   Frame_Device_ID(Request), FunctionCode,
+                   (uint8_t) ((Quantity + 7) / 8));
+        if (Read_Bits(Unit, (Modbus_Table) Dispatch_Table[FunctionCode].Table,
+                      Start, Quantity, Frame_Rsp_Payload(Response)) == FALSE) {
+            Exception = SLAVE_DEVICE_FAILURE;
+        }
+    }
+    return Exception;
+}
+
+//!-  Handle_Read_Registers() serves FC03 (Holding) and FC04 (Input).
+uint8_t Handle_Read_Registers(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint8_t  const FunctionCode = Frame_Function_Code(Request);
+    uint16_t Start = 0;
+    uint16_t Quantity = 0;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FRAME_REQ_HEADER_LENGTH) {
+        Start = Frame_Address(Request);
+        Quantity = Frame_Quantity(Request);
+        Exception = Range_Exception(Unit, FunctionCode,
+                                    Start, Quantity);
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        (void) Frame_Build_Read_Response(Response,
+                   Frame_Device_ID(Request), FunctionCode,
+                   (uint8_t) (Quantity * 2));
+        if (Read_Registers(Unit, (Modbus_Table) Dispatch_Table[FunctionCode].Table,
+                           Start, Quantity, Frame_Rsp_Payload(Response)) == FALSE) {
+            Exception = SLAVE_DEVICE_FAILURE;
+        }
+    }
+    return Exception;
+}
+
+//!-  Handle_Write_Single_Coil() serves FC05; the Response echoes the Request.
+uint8_t Handle_Write_Single_Coil(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint16_t Value = 0;
+    uint8_t  Bit = 0;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FRAME_REQ_HEADER_LENGTH) {
+        Value = Frame_Value(Request);
+        if ((Value == COIL_ON) || (Value == COIL_OFF)) {
+            Exception = Range_Exception(Unit, Fun_Code05,
+                                        Frame_Address(Request), 1);
+        }
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        Bit = (Value == COIL_ON) ? ON : OFF;
+        if (Write_Bits(Unit, TABLE_COILS, Frame_Address(Request), 1, &Bit) == FALSE) {
+            Exception = SLAVE_DEVICE_FAILURE;
+        }
+        else {
+            memcpy(Response->Adu, Request->Adu, FRAME_REQ_HEADER_LENGTH);
+            Response->Length = FRAME_REQ_HEADER_LENGTH;
+        }
+    }
+    return Exception;
+}
+
+//!-  Handle_Write_Single_Register() serves FC06; the Response echoes the Request.
+uint8_t Handle_Write_Single_Register(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FRAME_REQ_HEADER_LENGTH) {
+        Exception = Range_Exception(Unit, Fun_Code06,
+                                    Frame_Address(Request), 1);
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        if (Write_Registers(Unit, TABLE_HOLDING_REGISTERS, Frame_Address(Request), 1,
+                            &Request->Adu[FRAME_VALUE_OFFSET]) == FALSE) {
+            Exception = SLAVE_DEVICE_FAILURE;
+        }
+        else {
+            memcpy(Response->Adu, Request->Adu, FRAME_REQ_HEADER_LENGTH);
+            Response->Length = FRAME_REQ_HEADER_LENGTH;
+        }
+    }
+    return Exception;
+}
+
+/*
+ *!-  Handle_Read_Exception_Status() serves FC07.
+ *!-  No Exception Status Outputs are mapped, so all eight read 0.
+ */
+uint8_t Handle_Read_Exception_Status(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    (void) Unit;
+    (void) Request;
+    Response->Adu[FRAME_HEADER_LENGTH] = 0x00;
+    Response->Length = FRAME_HEADER_LENGTH + 1;
+    return MODBUS_NO_EXCEPTION;
+}
+
+//!-  Handle_Write_Multiple_Coils() serves FC15.
+uint8_t Handle_Write_Multiple_Coils(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint16_t Start = 0;
+    uint16_t Quantity = 0;
+    uint8_t  ByteCount = 0;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FRAME_REQ_PAYLOAD_OFFSET) {
+        Start = Frame_Address(Request);
+        Quantity = Frame_Quantity(Request);
+        ByteCount = Frame_Req_Byte_Count(Request);
+        if ((ByteCount == ((Quantity + 7) / 8)) &&
+            (Request->Length >= (FRAME_REQ_PAYLOAD_OFFSET + ByteCount))) {
+            Exception = Range_Exception(Unit, Fun_Code15,
+                                        Start, Quantity);
+        }
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        if (Write_Bits(Unit, TABLE_COILS, Start, Quantity,
+                       Frame_Req_Payload(Request)) == FALSE) {
+            Exception = SLAVE_DEVICE_FAILURE;
+        }
+        else {
+            memcpy(Response->Adu, Request->Adu, FRAME_REQ_HEADER_LENGTH);
+            Response->Length = FRAME_REQ_HEADER_LENGTH;
+        }
+    }
+    return Exception;
+}
+
+//!-  Handle_Write_Multiple_Registers() serves FC16.
+uint8_t Handle_Write_Multiple_Registers(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint16_t Start = 0;
+    uint16_t Quantity = 0;
+    uint8_t  ByteCount = 0;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FRAME_REQ_PAYLOAD_OFFSET) {
+        Start = Frame_Address(Request);
+        Quantity = Frame_Quantity(Request);
+        ByteCount = Frame_Req_Byte_Count(Request);
+        if ((ByteCount == (Quantity * 2)) &&
+            (Request->Length >= (FRAME_REQ_PAYLOAD_OFFSET + ByteCount))) {
+            Exception = Range_Exception(Unit, Fun_Code16,
+                                        Start, Quantity);
+        }
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        if (Write_Registers(Unit, TABLE_HOLDING_REGISTERS, Start, Quantity,
+                            Frame_Req_Payload(Request)) == FALSE) {
+            Exception = SLAVE_DEVICE_FAILURE;
+        }
+        else {
+            memcpy(Response->Adu, Request->Adu, FRAME_REQ_HEADER_LENGTH);
+            Response->Length = FRAME_REQ_HEADER_LENGTH;
+        }
+    }
+    return Exception;
+}
+
+/*
+ *!-  Handle_Read_File_Record() serves FC20: every Sub-Request is
+ *!-  checked before any is answered, then each Run of Records is
+ *!-  copied from the File Mapping straight into the Response.
+ */
+uint8_t Handle_Read_File_Record(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    const uint8_t *const Subs = &Request->Adu[FRAME_HEADER_LENGTH + 1];
+    const uint8_t *Sub = NULL;
+    uint8_t  ByteCount = 0;
+    uint32_t Offset = 0;
+    uint32_t Length = 0;
+    uint16_t Count = 0;
+    uint8_t *Out = NULL;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length > FRAME_HEADER_LENGTH) {
+        ByteCount = Request->Adu[FRAME_HEADER_LENGTH];
+        if ((ByteCount >= FILE_MIN_READ_LENGTH) &&
+            (ByteCount <= FILE_MAX_READ_LENGTH) &&
+            ((ByteCount % FILE_SUB_REQUEST_LENGTH) == 0) &&
+            (Request->Length >= (FRAME_HEADER_LENGTH + 1 + ByteCount))) {
+            Exception = MODBUS_NO_EXCEPTION;
+        }
+    }
+    for (Offset = 0; (Exception == MODBUS_NO_EXCEPTION) &&
+                     (Offset < ByteCount);
+         Offset += FILE_SUB_REQUEST_LENGTH) {
+        Sub = &Subs[Offset];
+        Count = Frame_Get_U16(&Sub[5]);
+        Length += FILE_SUB_RESPONSE_LENGTH + (uint32_t) Count * 2;
+        if ((Sub[0] != FILE_REFERENCE_TYPE) || (Count == 0) ||
+            (Length > FILE_MAX_READ_LENGTH)) {
+            Exception = ILLEGAL_DATA_VALUE;
+        }
+        else if (Modbus_File_Valid(Unit, Frame_Get_U16(&Sub[1]),
+                                   Frame_Get_U16(&Sub[3]), Count) == FALSE) {
+            Exception = ILLEGAL_DATA_ADDRESS;
+        }
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        (void) Frame_Build_Read_Response(Response, Frame_Device_ID(Request),
+                                         Fun_Code20, (uint8_t) Length);
+        Out = Frame_Rsp_Payload(Response);
+        for (Offset = 0; Offset < ByteCount;
+             Offset += FILE_SUB_REQUEST_LENGTH) {
+            Sub = &Subs[Offset];
+            Count = Frame_Get_U16(&Sub[5]);
+            Out[0] = (uint8_t) (1 + Count * 2);
+            Out[1] = FILE_REFERENCE_TYPE;
+            (void) Read_File_Records(Unit, Frame_Get_U16(&Sub[1]),
+                                     Frame_Get_U16(&Sub[3]), Count,
+                                     &Out[FILE_SUB_RESPONSE_LENGTH]);
+            Out += FILE_SUB_RESPONSE_LENGTH + Count * 2;
+        }
+    }
+    return Exception;
+}
+
+/*
+ *!-  Handle_Write_File_Record() serves FC21; the Response echoes
+ *!-  the Request. Nothing is written unless every Sub-Request is
+ *!-  valid and they fill the Byte Count exactly.
+ */
+uint8_t Handle_Write_File_Record(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    const uint8_t *const Subs = &Request->Adu[FRAME_HEADER_LENGTH + 1];
+    const uint8_t *Sub = NULL;
+    uint8_t  ByteCount = 0;
+    uint32_t Offset = 0;
+    uint16_t Count = 0;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length > FRAME_HEADER_LENGTH) {
+        ByteCount = Request->Adu[FRAME_HEADER_LENGTH];
+        if ((ByteCount >= FILE_MIN_WRITE_LENGTH) &&
+            (ByteCount <= FILE_MAX_WRITE_LENGTH) &&
+            (Request->Length >= (FRAME_HEADER_LENGTH + 1 + ByteCount))) {
+            Exception = MODBUS_NO_EXCEPTION;
+        }
+    }
+    while ((Exception == MODBUS_NO_EXCEPTION) && (Offset < ByteCount)) {
+        Sub = &Subs[Offset];
+        Count = ((Offset + FILE_SUB_REQUEST_LENGTH) <= ByteCount) ?
+                Frame_Get_U16(&Sub[5]) : 0;
+        Offset += FILE_SUB_REQUEST_LENGTH + (uint32_t) Count * 2;
+        if ((Count == 0) || (Offset > ByteCount) ||
+            (Sub[0] != FILE_REFERENCE_TYPE)) {
+            Exception = ILLEGAL_DATA_VALUE;
+        }
+        else if (Modbus_File_Valid(Unit, Frame_Get_U16(&Sub[1]),
+                                   Frame_Get_U16(&Sub[3]), Count) == FALSE) {
+            Exception = ILLEGAL_DATA_ADDRESS;
+        }
+    }
+    for (Offset = 0; (Exception == MODBUS_NO_EXCEPTION) &&
+                     (Offset < ByteCount);
+         Offset += FILE_SUB_REQUEST_LENGTH + (uint32_t) Count * 2) {
+        Sub = &Subs[Offset];
+        Count = Frame_Get_U16(&Sub[5]);
+        (void) Write_File_Records(Unit, Frame_Get_U16(&Sub[1]),
+                                  Frame_Get_U16(&Sub[3]), Count,
+                                  &Sub[FILE_SUB_REQUEST_LENGTH]);
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        memcpy(Response->Adu, Request->Adu,
+               FRAME_HEADER_LENGTH + 1 + ByteCount);
+        Response->Length = (uint16_t) (FRAME_HEADER_LENGTH + 1 + ByteCount);
+    }
+    return Exception;
+}
+
+//!-  Handle_Mask_Write_Register() serves FC22; the Response echoes the Request.
+uint8_t Handle_Mask_Write_Register(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FRAME_MASK_WRITE_LENGTH) {
+        Exception = Range_Exception(Unit, Fun_Code22,
+                                    Frame_Address(Request), 1);
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        if (Mask_Write_Register(Unit, Frame_Address(Request),
+                                Frame_And_Mask(Request),
+                                Frame_Or_Mask(Request)) == FALSE) {
+            Exception = SLAVE_DEVICE_FAILURE;
+        }
+        else {
+            memcpy(Response->Adu, Request->Adu, FRAME_MASK_WRITE_LENGTH);
+            Response->Length = FRAME_MASK_WRITE_LENGTH;
+        }
+    }
+    return Exception;
+}
+
+/*
+ *!-  Handle_Read_Write_Registers() serves FC23: the Write Range is
+ *!-  stored, then the Read Range answered, as one Transaction.
+ *!-  Both Quantities are checked before either Address Range.
+ */
+uint8_t Handle_Read_Write_Registers(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint16_t Read_Start = 0;
+    uint16_t Read_Quantity = 0;
+    uint16_t Write_Start = 0;
+    uint16_t Write_Quantity = 0;
+    uint8_t  ByteCount = 0;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FRAME_RW_PAYLOAD_OFFSET) {
+        Read_Start = Frame_Address(Request);
+        Read_Quantity = Frame_Quantity(Request);
+        Write_Start = Frame_RW_Address(Request);
+        Write_Quantity = Frame_RW_Quantity(Request);
+        ByteCount = Frame_RW_Byte_Count(Request);
+        if ((Write_Quantity >= MINREGISTERQUANTITY) &&
+            (Write_Quantity <= MAXRWWRITEREGQUANTITY) &&
+            (ByteCount == (Write_Quantity * 2)) &&
+            (Request->Length >= (FRAME_RW_PAYLOAD_OFFSET + ByteCount))) {
+            Exception = Range_Exception(Unit, Fun_Code23,
+                                        Read_Start, Read_Quantity);
+        }
+    }
+    if ((Exception == MODBUS_NO_EXCEPTION) &&
+        (Modbus_Valid_Range(Unit, TABLE_HOLDING_REGISTERS,
+                            Write_Start, Write_Quantity) == FALSE)) {
+        Exception = ILLEGAL_DATA_ADDRESS;
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        (void) Frame_Build_Read_Response(Response,
+                   Frame_Device_ID(Request), Fun_Code23,
+                   (uint8_t) (Read_Quantity * 2));
+        if (Read_Write_Registers(Unit, Write_Start, Write_Quantity,
+                                 Frame_RW_Payload(Request), Read_Start,
+                                 Read_Quantity,
+                                 Frame_Rsp_Payload(Response)) == FALSE) {
+            Exception = SLAVE_DEVICE_FAILURE;
+        }
+    }
+    return Exception;
+}
+
+/*
+ *!-  Handle_Read_Fifo_Queue() serves FC24: it drains up to
+ *!-  FIFO_MAX_COUNT of the oldest Entries of the FIFO at the
+ *!-  Pointer Address. A Broadcast is never answered, so it leaves
+ *!-  the FIFO as it is.
+ */
+uint8_t Handle_Read_Fifo_Queue(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    Modbus_Fifo *Fifo = NULL;
+    uint16_t Count = 0;
+    uint8_t  Exception = ILLEGAL_DATA_VALUE;
+
+    if (Request->Length >= FIFO_REQUEST_LENGTH) {
+        Fifo = Modbus_Find_Fifo(Unit, Frame_Address(Request));
+        Exception = (Fifo != NULL) ? MODBUS_NO_EXCEPTION :
+                                     ILLEGAL_DATA_ADDRESS;
+    }
+    if ((Exception == MODBUS_NO_EXCEPTION) &&
+        (Frame_Device_ID(Request) != BROADCAST)) {
+        Count = Modbus_Fifo_Drain(Fifo,
+                                  &Response->Adu[FIFO_PAYLOAD_OFFSET],
+                                  FIFO_MAX_COUNT);
+    }
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        Frame_Put_U16(&Response->Adu[FIFO_BYTE_COUNT_OFFSET],
+                      (uint16_t) (2 + (Count * 2)));
+        Frame_Put_U16(&Response->Adu[FIFO_COUNT_OFFSET], Count);
+        Response->Length = (uint16_t) (FIFO_PAYLOAD_OFFSET + (Count * 2));
+    }
+    return Exception;
+}
+
+/*
+ *!-  Dispatch_Unit() runs the Handler of a Request on one Unit
+ *!-  and turns a returned Exception Code into the Exception Response.
+ *!-  Both are counted in the Thread's Metrics Slot.
+ */
+void Dispatch_Unit(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint8_t const DevID = Frame_Device_ID(Request);
+    uint8_t const FunctionCode = Frame_Function_Code(Request);
+    uint8_t Exception = MODBUS_NO_EXCEPTION;
+
+    Response->Adu[FRAME_DEVICE_ID_OFFSET] = DevID;
+    Response->Adu[FRAME_FUNCTION_CODE_OFFSET] = FunctionCode;
+    Response->Length = FRAME_HEADER_LENGTH;
+
+    Exception = Dispatch_Table[FunctionCode].Handler(Unit, Request, Response);
+    if (Exception != MODBUS_NO_EXCEPTION) {
+        (void) Frame_Build_Exception(Response, DevID, FunctionCode,
+                                     Exception);
+    }
+    Modbus_Metrics_Request(FunctionCode, Exception);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Validate_Function_Code() will validate if the
+ *!-  Provided Function Code is Valid or Not.
+ *!-  A Code is Valid when a Handler serves it.
+ */
+Bool Validate_Function_Code(
+        uint8_t const FunctionCode) {
+
+    return (Bool) (Dispatch_Table[FunctionCode].Handler !=
+                   Handle_Illegal_Function);
+}
+
+/*
+ *!-  Validate_Starting_Address() will validate if
+ *!-  the Starting Address Provided is Valid or Invalid.
+ */
+Bool Validate_Starting_Address(
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress) {
+
+    return (Bool) (StartAddress <
+                   Table_Numbers[Dispatch_Table[FunctionCode].Table]);
+}
+
+/*
+ *!-  Validate_Registers_Quantity() will validate if
+ *!-  the Quantity of Registers Provided is Valid or Invalid.
+ */
+Bool Validate_Registers_Quantity(
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress,
+        uint16_t const RegisterNo) {
+
+    return (Bool) (Range_Exception(NULL, FunctionCode,
+                                   StartAddress, RegisterNo) ==
+                   MODBUS_NO_EXCEPTION);
+}
+
+/*
+ *!-  Modbus_Register_Handler() installs a Handler for a Function
+ *!-  Code, e.g. a Vendor-specific one, or replaces a built-in one.
+ *!-  Passing NULL makes the Code answer Illegal Function again.
+ */
+Bool Modbus_Register_Handler(
+        uint8_t const FunctionCode,
+        Modbus_Handler const Handler) {
+
+    Bool Check_Ok = FALSE;
+
+    if ((FunctionCode != 0) && (FunctionCode <= MAX_FUNCTION_CODE)) {
+        Dispatch_Set(FunctionCode,
+                     (Handler != NULL) ? Handler : Handle_Illegal_Function,
+                     TABLE_NONE, 0);
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Response() serves one Request on the Unit it addresses.
+ *!-  Request:
+ *!-  Received Frame without CRC.
+ *!-  Response:
+ *!-  Caller-owned Frame the Answer (or Exception) is built
+ *!-  in, without CRC; RTU calls Frame_Seal() on it.
+ *!-  Returns TRUE if the Response has to be sent. Requests to
+ *!-  Units not hosted here are ignored, as on a shared Bus;
+ *!-  Broadcast Requests are executed on every hosted Unit but
+ *!-  never answered.
+ */
+Bool Modbus_Response(
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    Bool Check_Ok = FALSE;
+    uint16_t DevID = 0;
+    Modbus_Data *Unit = NULL;
+
+    Response->Length = 0;
+    if (Request->Length >= FRAME_HEADER_LENGTH) {
+        DevID = Frame_Device_ID(Request);
+        if (DevID == BROADCAST) {
+            for (DevID = MIN_DEVICE_ID; DevID <= MAX_DEVICE_ID; DevID++) {
+                if (MODBUS_UNITS[DevID] != NULL) {
+                    Dispatch_Unit(MODBUS_UNITS[DevID], Request, Response);
+                }
+            }
+            Response->Length = 0;
+        }
+        else {
+            Unit = MODBUS_UNITS[DevID];
+            if (Unit != NULL) {
+                Dispatch_Unit(Unit, Request, Response);
+                Check_Ok = TRUE;
+            }
+        }
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_TCP_Response() serves one Request received over Modbus
+ *!-  TCP, where every Request is answered. Unit 0 and Unit 0xFF
+ *!-  address this Server itself and are served by the Default
+ *!-  Unit; there is no Broadcast. A Unit not hosted here gets a
+ *!-  GATEWAY_PATH_UNAVAILABLE Exception. Returns FALSE only for a
+ *!-  Request too short to answer.
+ */
+Bool Modbus_TCP_Response(
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    Bool Check_Ok = FALSE;
+    uint8_t DevID = 0;
+    Modbus_Data *Unit = NULL;
+
+    Response->Length = 0;
+    if (Request->Length >= FRAME_HEADER_LENGTH) {
+        DevID = Frame_Device_ID(Request);
+        Unit = ((DevID == BROADCAST) || (DevID == TCP_SERVER_UNIT)) ?
+               MODBUS_UNITS[MODBUS_DEFAULT_UNIT] : MODBUS_UNITS[DevID];
+        if (Unit != NULL) {
+            Dispatch_Unit(Unit, Request, Response);
+        }
+        else {
+            (void) Frame_Build_Exception(Response, DevID,
+                                         Frame_Function_Code(Request),
+                                         GATEWAY_PATH_UNAVAILABLE);
+            Modbus_Metrics_Request(Frame_Function_Code(Request),
+                                   GATEWAY_PATH_UNAVAILABLE);
+        }
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
@@ -0,0 +1,70 @@
+/*
+ * Modbus_Dispatch.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Dispatch.h
+*****************************************************************************/
+
+#ifndef __MODBUS_DISPATCH_H_
+#define __MODBUS_DISPATCH_H_
+
+//!-  Headers
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Function Codes with the MSB set are Exception Responses.
+#define MAX_FUNCTION_CODE    (0x7F)
+
+/*
+ *!-  "Modbus_Handler" serves one Function Code.
+ *!-  Unit:
+ *!-  Database of the addressed Unit.
+ *!-  Request:
+ *!-  Received Frame without CRC (Device_ID + PDU).
+ *!-  Response:
+ *!-  Frame to build the Answer in; it must not share
+ *!-  its Buffer with the Request. The Device_ID and
+ *!-  Function_Code are already filled in.
+ *!-  Returns MODBUS_NO_EXCEPTION or a Modbus_Exception_Code.
+ */
+typedef uint8_t (*Modbus_Handler)(
+        Modbus_Data *const Unit,
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+Bool Validate_Function_Code(
+        uint8_t const FunctionCode);
+
+Bool Validate_Starting_Address(
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress);
+
+Bool Validate_Registers_Quantity(
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress,
+        uint16_t const RegisterNo);
+
+Bool Modbus_Register_Handler(
+        uint8_t const FunctionCode,
+        Modbus_Handler const Handler);
+
+Bool Modbus_Response(
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+Bool Modbus_TCP_Response(
+        const Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+#endif /* __MODBUS_DISPATCH_H_ */
@@ -0,0 +1,258 @@
+/*
+ * Modbus_Fifo.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Fifo.c
+*****************************************************************************/
+
+//!-  Headers
+#include <stdlib.h>
+#include <string.h>
+#include "Modbus_Fifo.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Swap.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Smallest Ring: one full FC24 Window plus the Slot that tells full.
+#define FIFO_MIN_DEPTH  (FIFO_MAX_COUNT + 1)
+
+void Fifo_Store(
+        Modbus_Fifo *const Fifo,
+        uint32_t const Slot,
+        const uint16_t *const Values,
+        uint32_t const Count);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Fifo_Store() converts "Count" Values into the Ring from "Slot"
+ *!-  on, without wrapping, and mirrors those of the first
+ *!-  FIFO_MAX_COUNT Slots past the End of the Ring.
+ */
+void Fifo_Store(
+        Modbus_Fifo *const Fifo,
+        uint32_t const Slot,
+        const uint16_t *const Values,
+        uint32_t const Count) {
+
+    uint32_t const Depth = Fifo->Mask + 1;
+    uint32_t Mirrored = 0;
+
+    if (Count != 0) {
+        Registers_To_Wire(&Fifo->Ring[Slot * 2], Values, Count);
+    }
+    if ((Count != 0) && (Slot < FIFO_MAX_COUNT)) {
+        Mirrored = FIFO_MAX_COUNT - Slot;
+        if (Mirrored > Count) {
+            Mirrored = Count;
+        }
+        memcpy(&Fifo->Ring[(Depth + Slot) * 2], &Fifo->Ring[Slot * 2],
+               (size_t) Mirrored * 2);
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_Add_Fifo() adds a FIFO at Pointer Address "Address" of
+ *!-  a Unit, holding "Depth" Entries rounded up to a Power of Two
+ *!-  (at least FIFO_MIN_DEPTH). FIFOs are added before the Unit is
+ *!-  served.
+ */
+Bool Modbus_Add_Fifo(
+        Modbus_Data *const Unit,
+        uint16_t const Address,
+        uint32_t const Depth) {
+
+    Bool Check_Ok = FALSE;
+    Modbus_Fifos *Fifos = NULL;
+    Modbus_Fifo *Fifo = NULL;
+    uint32_t Slots = FIFO_MIN_DEPTH;
+    uint32_t Index = 0;
+
+    if ((Unit != NULL) && (Depth != 0) && (Depth <= FIFO_MAX_DEPTH) &&
+        (Modbus_Find_Fifo(Unit, Address) == NULL)) {
+        Fifos = Unit->Fifos;
+        if (Fifos == NULL) {
+            Fifos = calloc(1, sizeof(Modbus_Fifos));
+        }
+        Unit->Fifos = Fifos;
+        Check_Ok = (Bool) ((Fifos != NULL) &&
+                           (Fifos->Count < MODBUS_MAX_FIFOS));
+    }
+    while ((Check_Ok == TRUE) && (Slots < Depth)) {
+        Slots *= 2;
+    }
+    if (Check_Ok == TRUE) {
+        Fifo = aligned_alloc(MODBUS_CACHE_LINE, sizeof(Modbus_Fifo));
+        Check_Ok = (Bool) (Fifo != NULL);
+    }
+    if (Check_Ok == TRUE) {
+        memset(Fifo, 0, sizeof(Modbus_Fifo));
+        Fifo->Address = Address;
+        Fifo->Mask = Slots - 1;
+        Fifo->Ring = calloc((size_t) Slots + FIFO_MAX_COUNT, 2);
+        Check_Ok = (Bool) (Fifo->Ring != NULL);
+    }
+    if (Check_Ok == TRUE) {
+        for (Index = Fifos->Count;
+             (Index > 0) && (Fifos->Fifo[Index - 1]->Address > Address);
+             Index--) {
+            Fifos->Fifo[Index] = Fifos->Fifo[Index - 1];
+        }
+        Fifos->Fifo[Index] = Fifo;
+        Fifos->Count++;
+    }
+    else {
+        free(Fifo);
+    }
+    return Check_Ok;
+}
+
+//!-  Modbus_Remove_Fifos() frees all FIFOs of a Unit.
+void Modbus_Remove_Fifos(
+        Modbus_Data *const Unit) {
+
+    Modbus_Fifos *const Fifos = (Unit != NULL) ? Unit->Fifos : NULL;
+    uint32_t Index = 0;
+
+    if (Fifos != NULL) {
+        for (Index = 0; Index < Fifos->Count; Index++) {
+            free(Fifos->Fifo[Index]->Ring);
+            free(Fifos->Fifo[Index]);
+        }
+        free(Fifos);
+        Unit->Fifos = NULL;
+    }
+}
+
+//!-  Modbus_Find_Fifo() looks a FIFO of a Unit up, or gives NULL.
+Modbus_Fifo *Modbus_Find_Fifo(
+        const Modbus_Data *const Unit,
+        uint16_t const Address) {
+
+    Modbus_Fifos *const Fifos = (Unit != NULL) ? Unit->Fifos : NULL;
+    uint32_t Low = 0;
+    uint32_t High = (Fifos != NULL) ? Fifos->Count : 0;
+    uint32_t Middle = 0;
+
+    while (Low < High) {
+        Middle = (Low + High) / 2;
+        if (Fifos->Fifo[Middle]->Address < Address) {
+            Low = Middle + 1;
+        }
+        else {
+            High = Middle;
+        }
+    }
+    return ((Fifos != NULL) && (Low < Fifos->Count) &&
+            (Fifos->Fifo[Low]->Address == Address)) ?
+           Fifos->Fifo[Low] : NULL;
+}
+
+/*
+ *!-  Modbus_Fifo_Push() appends "Count" Values, from the one
+ *!-  Producer Thread of the FIFO. It is wait-free: what does not
+ *!-  fit is dropped and counted, never waited for. Returns how
+ *!-  many Values were queued.
+ */
+uint32_t Modbus_Fifo_Push(
+        Modbus_Fifo *const Fifo,
+        const uint16_t *const Values,
+        uint32_t const Count) {
+
+    uint32_t const Depth = Fifo->Mask + 1;
+    uint64_t const Head = __atomic_load_n(&Fifo->Head, __ATOMIC_RELAXED);
+    uint64_t Room = Depth - (Head - Fifo->Tail_Seen);
+    uint32_t Pushed = Count;
+    uint32_t Slot = (uint32_t) (Head & Fifo->Mask);
+    uint32_t Run = Depth - Slot;
+
+    if (Room < Count) {
+        Fifo->Tail_Seen = __atomic_load_n(&Fifo->Tail, __ATOMIC_ACQUIRE);
+        Room = Depth - (Head - Fifo->Tail_Seen);
+    }
+    if (Room < Count) {
+        Pushed = (uint32_t) Room;
+        __atomic_store_n(&Fifo->Overflows,
+                         __atomic_load_n(&Fifo->Overflows,
+                                         __ATOMIC_RELAXED) + 1,
+                         __ATOMIC_RELAXED);
+        __atomic_store_n(&Fifo->Dropped,
+                         __atomic_load_n(&Fifo->Dropped,
+                                         __ATOMIC_RELAXED) + Count - Pushed,
+                         __ATOMIC_RELAXED);
+    }
+    if (Run > Pushed) {
+        Run = Pushed;
+    }
+    Fifo_Store(Fifo, Slot, Values, Run);
+    Fifo_Store(Fifo, 0, &Values[Run], Pushed - Run);
+    __atomic_store_n(&Fifo->Head, Head + Pushed, __ATOMIC_RELEASE);
+    return Pushed;
+}
+
+/*
+ *!-  Modbus_Fifo_Drain() moves the oldest Entries, up to "Max" and
+ *!-  FIFO_MAX_COUNT, to "BeOut" in Wire Order with one Copy, from
+ *!-  the one Consumer Thread of the FIFO. Returns how many.
+ */
+uint16_t Modbus_Fifo_Drain(
+        Modbus_Fifo *const Fifo,
+        uint8_t *const BeOut,
+        uint16_t const Max) {
+
+    uint64_t const Tail = __atomic_load_n(&Fifo->Tail, __ATOMIC_RELAXED);
+    uint64_t const Queued = __atomic_load_n(&Fifo->Head, __ATOMIC_ACQUIRE) -
+                            Tail;
+    uint16_t Count = (Max < FIFO_MAX_COUNT) ? Max : FIFO_MAX_COUNT;
+
+    if (Queued < Count) {
+        Count = (uint16_t) Queued;
+    }
+    memcpy(BeOut, &Fifo->Ring[(Tail & Fifo->Mask) * 2], (size_t) Count * 2);
+    __atomic_store_n(&Fifo->Tail, Tail + Count, __ATOMIC_RELEASE);
+    return Count;
+}
+
+/*
+ *!-  Modbus_Fifo_Read_Counters() takes a Snapshot of the Counters,
+ *!-  from any Thread.
+ */
+void Modbus_Fifo_Read_Counters(
+        const Modbus_Fifo *const Fifo,
+        Modbus_Fifo_Counters *const Counters) {
+
+    Counters->Drained = __atomic_load_n(&Fifo->Tail, __ATOMIC_ACQUIRE);
+    Counters->Pushed = __atomic_load_n(&Fifo->Head, __ATOMIC_ACQUIRE);
+    Counters->Queued = Counters->Pushed - Counters->Drained;
+    Counters->Overflows = __atomic_load_n(&Fifo->Overflows, __ATOMIC_RELAXED);
+    Counters->Dropped = __atomic_load_n(&Fifo->Dropped, __ATOMIC_RELAXED);
+}
+
+//!-  Frame_Build_Read_Fifo() builds an FC24 Request (no CRC).
+Bool Frame_Build_Read_Fifo(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint16_t const Address) {
+
+    Bool const Check_Ok = Set_Device_ID(Frame, DevID);
+
+    if (Check_Ok == TRUE) {
+        Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = Fun_Code24;
+        Frame_Put_U16(&Frame->Adu[FRAME_ADDRESS_OFFSET], Address);
+        Frame->Length = FIFO_REQUEST_LENGTH;
+    }
+    return Check_Ok;
+}
@@ -0,0 +1,116 @@
+/*
+ * Modbus_Fifo.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Fifo.h
+*****************************************************************************/
+
+#ifndef __MODBUS_FIFO_H_
+#define __MODBUS_FIFO_H_
+
+//!-  Headers
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  A Modbus FIFO (FC24) is addressed by its FIFO Pointer Address.
+ *!-  One FC24 Response carries up to FIFO_MAX_COUNT Entries; the
+ *!-  Ring behind it holds up to FIFO_MAX_DEPTH. Every Unit hosts
+ *!-  up to MODBUS_MAX_FIFOS of them.
+ */
+#define MODBUS_MAX_FIFOS          (32)
+#define FIFO_MAX_COUNT            (31)
+#define FIFO_MAX_DEPTH            (65536)
+
+//!-  FC24 Request, and Response Header: Byte Count, FIFO Count.
+#define FIFO_REQUEST_LENGTH       (4)
+#define FIFO_BYTE_COUNT_OFFSET    (2)
+#define FIFO_COUNT_OFFSET         (4)
+#define FIFO_PAYLOAD_OFFSET       (6)
+
+/*
+ *!-  "Modbus_Fifo" is a Single-Producer / Single-Consumer Ring of
+ *!-  Registers in Wire Order: one Device Thread pushes Samples,
+ *!-  the Server drains them with FC24, neither takes a Lock. The
+ *!-  first FIFO_MAX_COUNT Entries are mirrored past the End of the
+ *!-  Ring, so any FC24 Window is one contiguous Copy.
+ *!-  Head, Tail:
+ *!-  Entries pushed and drained so far; the Ring holds Head - Tail.
+ *!-  Each Side owns its Cache Line, and the Producer keeps the
+ *!-  last Tail it saw so it only reloads Tail when it seems full.
+ *!-  Overflows, Dropped:
+ *!-  Pushes that found the Ring full, and the Entries they lost.
+ */
+typedef struct {
+    uint16_t   Address;
+    uint32_t   Mask;
+    uint8_t   *Ring;
+    uint64_t   Head __attribute__((aligned(MODBUS_CACHE_LINE)));
+    uint64_t   Tail_Seen;
+    uint64_t   Overflows;
+    uint64_t   Dropped;
+    uint64_t   Tail __attribute__((aligned(MODBUS_CACHE_LINE)));
+} __attribute__((aligned(MODBUS_CACHE_LINE))) Modbus_Fifo;
+
+/*
+ *!-  "Modbus_Fifos" are the FIFOs of a Unit, sorted by Address.
+ *!-  They are added before the Unit is served and stay where they
+ *!-  are, so Producers may keep the Pointer Modbus_Find_Fifo() gave.
+ */
+typedef struct Modbus_Fifos {
+    uint32_t      Count;
+    Modbus_Fifo  *Fifo[MODBUS_MAX_FIFOS];
+} Modbus_Fifos;
+
+//!-  "Modbus_Fifo_Counters" is a Snapshot of the Counters of a FIFO.
+typedef struct {
+    uint64_t   Pushed;
+    uint64_t   Drained;
+    uint64_t   Queued;
+    uint64_t   Overflows;
+    uint64_t   Dropped;
+} Modbus_Fifo_Counters;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+Bool Modbus_Add_Fifo(
+        Modbus_Data *const Unit,
+        uint16_t const Address,
+        uint32_t const Depth);
+
+void Modbus_Remove_Fifos(
+        Modbus_Data *const Unit);
+
+Modbus_Fifo *Modbus_Find_Fifo(
+        const Modbus_Data *const Unit,
+        uint16_t const Address);
+
+uint32_t Modbus_Fifo_Push(
+        Modbus_Fifo *const Fifo,
+        const uint16_t *const Values,
+        uint32_t const Count);
+
+uint16_t Modbus_Fifo_Drain(
+        Modbus_Fifo *const Fifo,
+        uint8_t *const BeOut,
+        uint16_t const Max);
+
+void Modbus_Fifo_Read_Counters(
+        const Modbus_Fifo *const Fifo,
+        Modbus_Fifo_Counters *const Counters);
+
+Bool Frame_Build_Read_Fifo(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint16_t const Address);
+
+#endif /* __MODBUS_FIFO_H_ */
@@ -0,0 +1,408 @@
+/*
+ * Modbus_File.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_File.c
+*****************************************************************************/
+
+//!-  Headers
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Modbus_Frame.h"
+#include "Modbus_File.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  "File_Chunk" is one FC20 Read of a Download in Flight: the
+ *!-  Records it asked for.
+ */
+typedef struct {
+    Bool                    In_Use;
+    uint16_t                Record;
+    uint16_t                Count;
+    struct File_Download   *Download;
+} File_Chunk;
+
+/*
+ *!-  "File_Download" is the State of Modbus_File_Download().
+ *!-  Next_Record:
+ *!-  First Record not asked for yet.
+ *!-  Received:
+ *!-  Records stored in "BeOut" so far.
+ */
+typedef struct File_Download {
+    uint8_t      Unit_ID;
+    uint16_t     Number;
+    uint16_t     Records;
+    uint16_t     Next_Record;
+    uint32_t     Received;
+    uint8_t     *BeOut;
+    uint8_t      Status;
+    File_Chunk   Chunks[TCP_CLIENT_MAX_WINDOW];
+} File_Download;
+
+Modbus_File *File_Find(
+        const Modbus_Data *const Unit,
+        uint16_t const Number);
+
+void File_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+Bool File_Submit(
+        Modbus_TCP_Client *const Client,
+        File_Download *const Download);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  File_Find() looks a File of a Unit up by Number, or gives NULL.
+Modbus_File *File_Find(
+        const Modbus_Data *const Unit,
+        uint16_t const Number) {
+
+    Modbus_Files *const Files = Unit->Files;
+    uint32_t Low = 0;
+    uint32_t High = (Files != NULL) ? Files->Count : 0;
+    uint32_t Middle = 0;
+
+    while (Low < High) {
+        Middle = (Low + High) / 2;
+        if (Files->File[Middle].Number < Number) {
+            Low = Middle + 1;
+        }
+        else {
+            High = Middle;
+        }
+    }
+    return ((Files != NULL) && (Low < Files->Count) &&
+            (Files->File[Low].Number == Number)) ? &Files->File[Low] : NULL;
+}
+
+/*
+ *!-  File_Response() stores the Records of a completed Chunk, or
+ *!-  notes why it failed; no further Chunks are asked for then.
+ */
+void File_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    File_Chunk *const Chunk = Context;
+    File_Download *const Download = Chunk->Download;
+    uint16_t const Bytes = (uint16_t) (Chunk->Count * 2);
+
+    if ((Status == MODBUS_NO_EXCEPTION) && (Response != NULL) &&
+        (Response->Length >= (FRAME_RSP_PAYLOAD_OFFSET +
+                              FILE_SUB_RESPONSE_LENGTH + Bytes)) &&
+        (Response->Adu[FRAME_RSP_PAYLOAD_OFFSET] == (Bytes + 1)) &&
+        (Response->Adu[FRAME_RSP_PAYLOAD_OFFSET + 1] == FILE_REFERENCE_TYPE)) {
+        memcpy(&Download->BeOut[Chunk->Record * 2],
+               &Response->Adu[FRAME_RSP_PAYLOAD_OFFSET +
+                              FILE_SUB_RESPONSE_LENGTH], Bytes);
+        Download->Received += Chunk->Count;
+    }
+    else if (Download->Status == MODBUS_NO_EXCEPTION) {
+        Download->Status = (Status != MODBUS_NO_EXCEPTION) ?
+                           Status : SLAVE_DEVICE_FAILURE;
+    }
+    Chunk->In_Use = FALSE;
+}
+
+/*
+ *!-  File_Submit() asks for the next Chunk of Records, if any is
+ *!-  left and the Window has Room. Returns FALSE otherwise.
+ */
+Bool File_Submit(
+        Modbus_TCP_Client *const Client,
+        File_Download *const Download) {
+
+    Bool Check_Ok = FALSE;
+    File_Chunk *Chunk = NULL;
+    uint8_t Buffer[MODBUS_MAX_PDU_LENGTH + 1];
+    Modbus_Frame Request;
+    uint32_t Index = 0;
+
+    for (Index = 0; (Index < TCP_CLIENT_MAX_WINDOW) && (Chunk == NULL);
+         Index++) {
+        if (Download->Chunks[Index].In_Use == FALSE) {
+            Chunk = &Download->Chunks[Index];
+        }
+    }
+    if ((Chunk != NULL) && (Download->Status == MODBUS_NO_EXCEPTION) &&
+        (Download->Next_Record < Download->Records)) {
+        Chunk->Record = Download->Next_Record;
+        Chunk->Count = (uint16_t) (Download->Records - Download->Next_Record);
+        if (Chunk->Count > FILE_MAX_READ_RECORDS) {
+            Chunk->Count = FILE_MAX_READ_RECORDS;
+        }
+        Chunk->Download = Download;
+        Frame_Attach(&Request, Buffer, 0);
+        Check_Ok = (Bool) ((Frame_Build_Read_File(&Request, Download->Unit_ID,
+                                                  Download->Number,
+                                                  Chunk->Record,
+                                                  Chunk->Count) == TRUE) &&
+                           (Modbus_TCP_Client_Submit(Client, &Request,
+                                                     File_Response,
+                                                     Chunk) == TRUE));
+    }
+    if (Check_Ok == TRUE) {
+        Chunk->In_Use = TRUE;
+        Download->Next_Record = (uint16_t) (Download->Next_Record +
+                                            Chunk->Count);
+    }
+    return Check_Ok;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_Map_File() maps File "Number" of a Unit, with "Records"
+ *!-  Records, onto the Host File at "Path". The Host File is created
+ *!-  or grown as needed, never shrunk, and keeps the Records across
+ *!-  Restarts. Files are mapped before the Unit is served.
+ */
+Bool Modbus_Map_File(
+        Modbus_Data *const Unit,
+        uint16_t const Number,
+        const char *const Path,
+        uint16_t const Records) {
+
+    Bool Check_Ok = FALSE;
+    Modbus_Files *Files = NULL;
+    Modbus_File File = { Number, Records, 0, -1, NULL };
+    size_t const Bytes = (size_t) Records * 2;
+    struct stat Status;
+    uint32_t Index = 0;
+
+    if ((Unit != NULL) && (Number != 0) && (Records != 0) &&
+        (Records <= FILE_MAX_RECORDS) && (File_Find(Unit, Number) == NULL)) {
+        Files = Unit->Files;
+        if (Files == NULL) {
+            Files = calloc(1, sizeof(Modbus_Files));
+        }
+        Unit->Files = Files;
+        Check_Ok = (Bool) ((Files != NULL) &&
+                           (Files->Count < MODBUS_MAX_FILES));
+    }
+    if (Check_Ok == TRUE) {
+        File.Fd = open(Path, O_RDWR | O_CREAT | O_CLOEXEC, 0660);
+        Check_Ok = (Bool) ((File.Fd >= 0) && (fstat(File.Fd, &Status) == 0));
+    }
+    if ((Check_Ok == TRUE) && ((size_t) Status.st_size < Bytes)) {
+        Check_Ok = (Bool) (ftruncate(File.Fd, (off_t) Bytes) == 0);
+    }
+    if (Check_Ok == TRUE) {
+        File.Base = mmap(NULL, Bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         File.Fd, 0);
+        if (File.Base == MAP_FAILED) {
+            File.Base = NULL;
+            Check_Ok = FALSE;
+        }
+    }
+    if (Check_Ok == TRUE) {
+        for (Index = Files->Count;
+             (Index > 0) && (Files->File[Index - 1].Number > Number);
+             Index--) {
+            Files->File[Index] = Files->File[Index - 1];
+        }
+        Files->File[Index] = File;
+        Files->Count++;
+    }
+    else if (File.Fd >= 0) {
+        close(File.Fd);
+    }
+    return Check_Ok;
+}
+
+//!-  Modbus_Unmap_Files() unmaps all Files of a Unit.
+void Modbus_Unmap_Files(
+        Modbus_Data *const Unit) {
+
+    Modbus_Files *const Files = (Unit != NULL) ? Unit->Files : NULL;
+    uint32_t Index = 0;
+
+    if (Files != NULL) {
+        for (Index = 0; Index < Files->Count; Index++) {
+            (void) munmap(Files->File[Index].Base,
+                          (size_t) Files->File[Index].Records * 2);
+            close(Files->File[Index].Fd);
+        }
+        free(Files);
+        Unit->Files = NULL;
+    }
+}
+
+/*
+ *!-  Modbus_File_Valid() tells if Records "Record" .. "Record" +
+ *!-  "Count" - 1 of File "Number" exist on a Unit.
+ */
+Bool Modbus_File_Valid(
+        const Modbus_Data *const Unit,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count) {
+
+    const Modbus_File *const File = File_Find(Unit, Number);
+
+    return (Bool) ((File != NULL) && (Count != 0) &&
+                   (((uint32_t) Record + Count) <= File->Records));
+}
+
+/*
+ *!-  Read_File_Records() copies "Count" Records of a File to
+ *!-  "BeOut" in Wire Order, as one consistent Snapshot: it retries
+ *!-  if an FC21 Write ran meanwhile.
+ */
+Bool Read_File_Records(
+        const Modbus_Data *const Unit,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count,
+        uint8_t *const BeOut) {
+
+    Modbus_File *const File = File_Find(Unit, Number);
+    Bool const Check_Ok = Modbus_File_Valid(Unit, Number, Record, Count);
+    uint32_t Sequence = 0;
+
+    while (Check_Ok == TRUE) {
+        while (((Sequence = __atomic_load_n(&File->Sequence,
+                                            __ATOMIC_ACQUIRE)) & 1U) != 0) {
+            MODBUS_CPU_PAUSE();
+        }
+        memcpy(BeOut, &File->Base[Record * 2], (size_t) Count * 2);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&File->Sequence, __ATOMIC_RELAXED) == Sequence) {
+            break;
+        }
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Write_File_Records() stores "Count" Records from "BeIn" (as
+ *!-  in an FC21 Sub-Request) into a File; no Reader sees them half
+ *!-  written. The Kernel writes them back to the Host File.
+ */
+Bool Write_File_Records(
+        Modbus_Data *const Unit,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count,
+        const uint8_t *const BeIn) {
+
+    Modbus_File *const File = File_Find(Unit, Number);
+    Bool const Check_Ok = Modbus_File_Valid(Unit, Number, Record, Count);
+    uint32_t Sequence = 0;
+
+    if (Check_Ok == TRUE) {
+        for (;;) {
+            Sequence = __atomic_load_n(&File->Sequence, __ATOMIC_RELAXED);
+            if (((Sequence & 1U) == 0) &&
+                (__atomic_compare_exchange_n(&File->Sequence, &Sequence,
+                                             Sequence + 1, FALSE,
+                                             __ATOMIC_ACQUIRE,
+                                             __ATOMIC_RELAXED) == TRUE)) {
+                break;
+            }
+            MODBUS_CPU_PAUSE();
+        }
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(&File->Base[Record * 2], BeIn, (size_t) Count * 2);
+        __atomic_store_n(&File->Sequence, Sequence + 2, __ATOMIC_RELEASE);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Frame_Build_Read_File() builds an FC20 Request (no CRC) with
+ *!-  one Sub-Request, for "Count" Records of File "Number".
+ */
+Bool Frame_Build_Read_File(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count) {
+
+    Bool Check_Ok = FALSE;
+    uint8_t *const Sub = &Frame->Adu[FRAME_HEADER_LENGTH + 1];
+
+    if ((Number != 0) && (Record < FILE_MAX_RECORDS) && (Count != 0) &&
+        (Count <= FILE_MAX_READ_RECORDS)) {
+        Check_Ok = Set_Device_ID(Frame, DevID);
+    }
+    if (Check_Ok == TRUE) {
+        Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = Fun_Code20;
+        Frame->Adu[FRAME_HEADER_LENGTH] = FILE_SUB_REQUEST_LENGTH;
+        Sub[0] = FILE_REFERENCE_TYPE;
+        Frame_Put_U16(&Sub[1], Number);
+        Frame_Put_U16(&Sub[3], Record);
+        Frame_Put_U16(&Sub[5], Count);
+        Frame->Length = FRAME_HEADER_LENGTH + 1 + FILE_SUB_REQUEST_LENGTH;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_File_Download() reads Records 0 .. "Records" - 1 of
+ *!-  File "Number" of a Unit into "BeOut" (2 * Records Bytes, Wire
+ *!-  Order). FC20 Reads of FILE_MAX_READ_RECORDS are pipelined up
+ *!-  to the Client's Window, so the Link stays busy instead of
+ *!-  idling a Round Trip per Read. Returns TRUE once all Records
+ *!-  arrived; else "Status" tells why it stopped (an Exception
+ *!-  Code or TARGET_DEVICE_FAILED_TO_RESPOND).
+ */
+Bool Modbus_File_Download(
+        Modbus_TCP_Client *const Client,
+        uint8_t  const Unit_ID,
+        uint16_t const Number,
+        uint16_t const Records,
+        uint8_t *const BeOut,
+        uint8_t *const Status) {
+
+    File_Download Download;
+
+    memset(&Download, 0, sizeof(Download));
+    Download.Unit_ID = Unit_ID;
+    Download.Number = Number;
+    Download.Records = Records;
+    Download.BeOut = BeOut;
+
+    while ((Download.Received < Records) &&
+           (Download.Status == MODBUS_NO_EXCEPTION)) {
+        while (File_Submit(Client, &Download) == TRUE) {
+        }
+        if (Modbus_TCP_Client_Poll(Client, TCP_CLIENT_TIMEOUT_MS) < 0) {
+            Download.Status = TARGET_DEVICE_FAILED_TO_RESPOND;
+        }
+        else if ((Download.Status == MODBUS_NO_EXCEPTION) &&
+                 (Download.Received < Records) &&
+                 (Download.Next_Record >= Records) &&
+                 (Client->In_Flight == 0)) {
+            //!-  Every Chunk was answered, some not with Records.
+            Download.Status = SLAVE_DEVICE_FAILURE;
+        }
+    }
+    //!-  Chunks in Flight point into this Frame; let them finish.
+    while ((Client->In_Flight > 0) &&
+           (Modbus_TCP_Client_Poll(Client, TCP_CLIENT_TIMEOUT_MS) >= 0)) {
+    }
+    *Status = Download.Status;
+    return (Bool) (Download.Received == Records);
+}
@@ -0,0 +1,123 @@
+/*
+ * Modbus_File.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_File.h
+*****************************************************************************/
+
+#ifndef __MODBUS_FILE_H_
+#define __MODBUS_FILE_H_
+
+//!-  Headers
+#include <Modbus.h>
+#include <Modbus_TCP.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  A Modbus File (FC20/FC21) is numbered 1 .. 65535 and holds up
+ *!-  to FILE_MAX_RECORDS Records of one Register each; a Sub-Request
+ *!-  addresses a Run of Records. Every Unit maps up to
+ *!-  MODBUS_MAX_FILES of them.
+ */
+#define MODBUS_MAX_FILES          (64)
+#define FILE_MAX_RECORDS          (10000)
+#define FILE_REFERENCE_TYPE       (6)
+
+/*
+ *!-  PDU Limits: the Byte Count of an FC20 Request and the Data
+ *!-  Length of its Response, and the Byte Count of an FC21 Request.
+ *!-  A Sub-Request takes FILE_SUB_REQUEST_LENGTH Bytes (FC21: plus
+ *!-  its Data), a Sub-Response 2 Bytes plus its Data.
+ */
+#define FILE_MIN_READ_LENGTH      (0x07)
+#define FILE_MAX_READ_LENGTH      (0xF5)
+#define FILE_MIN_WRITE_LENGTH     (0x09)
+#define FILE_MAX_WRITE_LENGTH     (0xFB)
+#define FILE_SUB_REQUEST_LENGTH   (7)
+#define FILE_SUB_RESPONSE_LENGTH  (2)
+
+//!-  Most Records one FC20 Sub-Request can read.
+#define FILE_MAX_READ_RECORDS     \
+                ((FILE_MAX_READ_LENGTH - FILE_SUB_RESPONSE_LENGTH) / 2)
+
+/*
+ *!-  "Modbus_File" is a Modbus File mapped onto a Host File, which
+ *!-  holds its Records in Wire Order, so Requests are served with
+ *!-  one Copy between the Mapping and the Frame.
+ *!-  Sequence:
+ *!-  Sequence Lock of the Records, odd while FC21 writes them.
+ */
+typedef struct {
+    uint16_t   Number;
+    uint16_t   Records;
+    uint32_t   Sequence;
+    int        Fd;
+    uint8_t   *Base;
+} Modbus_File;
+
+/*
+ *!-  "Modbus_Files" are the Files of a Unit, sorted by Number.
+ *!-  They are mapped before the Unit is served and not changed
+ *!-  while it is.
+ */
+typedef struct Modbus_Files {
+    uint32_t     Count;
+    Modbus_File  File[MODBUS_MAX_FILES];
+} Modbus_Files;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+Bool Modbus_Map_File(
+        Modbus_Data *const Unit,
+        uint16_t const Number,
+        const char *const Path,
+        uint16_t const Records);
+
+void Modbus_Unmap_Files(
+        Modbus_Data *const Unit);
+
+Bool Modbus_File_Valid(
+        const Modbus_Data *const Unit,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count);
+
+Bool Read_File_Records(
+        const Modbus_Data *const Unit,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count,
+        uint8_t *const BeOut);
+
+Bool Write_File_Records(
+        Modbus_Data *const Unit,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count,
+        const uint8_t *const BeIn);
+
+Bool Frame_Build_Read_File(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count);
+
+Bool Modbus_File_Download(
+        Modbus_TCP_Client *const Client,
+        uint8_t  const Unit_ID,
+        uint16_t const Number,
+        uint16_t const Records,
+        uint8_t *const BeOut,
+        uint8_t *const Status);
+
+#endif /* __MODBUS_FILE_H_ */
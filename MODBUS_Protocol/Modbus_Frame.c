@@ -0,0 +1,347 @@
+/*
+ * Modbus_Frame.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Frame.c
+*****************************************************************************/
+
+//!-  Headers
+#include "Modbus_Frame.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define ADDRESS_SPACE  (0x10000UL)
+
+Bool Validate_Request_Range(
+        uint16_t const StartAddress,
+        uint16_t const Quantity,
+        uint16_t const MaxQuantity);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Validate_Request_Range() checks a Quantity against the
+ *!-  Protocol Limit of the Function Code and makes sure the
+ *!-  Range does not run past the 16Bit Address Space.
+ */
+Bool Validate_Request_Range(
+        uint16_t const StartAddress,
+        uint16_t const Quantity,
+        uint16_t const MaxQuantity) {
+
+    Bool Check_Ok = FALSE;
+
+    if ((Quantity >= MINREGISTERQUANTITY) &&
+        (Quantity <= MaxQuantity) &&
+        (((uint32_t) StartAddress + Quantity) <= ADDRESS_SPACE)) {
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Frame_Attach() wraps a Caller-owned Buffer as a Frame.
+ *!-  Nothing is copied; the Buffer must stay alive as long
+ *!-  as the Frame is used.
+ */
+void Frame_Attach(
+        Modbus_Frame *const Frame,
+        uint8_t *const Buffer,
+        uint16_t const Length) {
+
+    Frame->Adu = Buffer;
+    Frame->Length = Length;
+}
+
+/*
+ *!-  Frame_Parse() attaches a received RTU ADU and checks its
+ *!-  Length and CRC. The Fields are then read through the
+ *!-  Frame_* Views directly from "Buffer".
+ */
+Bool Frame_Parse(
+        Modbus_Frame *const Frame,
+        uint8_t *const Buffer,
+        uint16_t const Length) {
+
+    Bool Check_Ok = FALSE;
+
+    Frame_Attach(Frame, Buffer, Length);
+    if ((Length >= FRAME_MIN_LENGTH) &&
+        (Length <= MODBUS_MAX_ADU_LENGTH)) {
+        Check_Ok = Frame_Check_CRC(Frame);
+    }
+    return Check_Ok;
+}
+
+//!-  Frame_Check_CRC() compares the trailing CRC with the Frame Contents.
+Bool Frame_Check_CRC(
+        const Modbus_Frame *const Frame) {
+
+    Bool Check_Ok = FALSE;
+    uint16_t DataLength = 0;
+    uint16_t CRC = 0;
+
+    if (Frame->Length >= FRAME_MIN_LENGTH) {
+        DataLength = Frame->Length - FRAME_CRC_LENGTH;
+        CRC = Calculate_CRC16(Frame->Adu, DataLength);
+        if (CRC == Frame_Get_U16(&Frame->Adu[DataLength])) {
+            Check_Ok = TRUE;
+        }
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Frame_Seal() appends the CRC behind the current Length.
+ *!-  CRC Hi is the first Byte on the Wire.
+ */
+Bool Frame_Seal(
+        Modbus_Frame *const Frame) {
+
+    Bool Check_Ok = FALSE;
+    uint16_t CRC = 0;
+
+    if ((Frame->Length >= FRAME_HEADER_LENGTH) &&
+        ((Frame->Length + FRAME_CRC_LENGTH) <= MODBUS_MAX_ADU_LENGTH)) {
+        CRC = Calculate_CRC16(Frame->Adu, Frame->Length);
+        Frame_Put_U16(&Frame->Adu[Frame->Length], CRC);
+        Frame->Length += FRAME_CRC_LENGTH;
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Frame_Build_Read_Request() builds an FC01/FC02/FC03/FC04
+ *!-  Request in place. The Frame is left without CRC, so it can
+ *!-  go behind an MBAP Header as is; RTU calls Frame_Seal().
+ */
+Bool Frame_Build_Read_Request(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress,
+        uint16_t const Quantity) {
+
+    Bool Check_Ok = FALSE;
+
+    switch (FunctionCode) {
+        case Fun_Code01:
+        case Fun_Code02:
+            Check_Ok = Validate_Request_Range(
+                           StartAddress, Quantity, MAXREGISTERQUANTITY);
+            break;
+        case Fun_Code03:
+        case Fun_Code04:
+            Check_Ok = Validate_Request_Range(
+                           StartAddress, Quantity, MAXREADREGQUANTITY);
+            break;
+        default:
+            Check_Ok = FALSE;
+            break;
+    }
+
+    if (Check_Ok == TRUE) {
+        Check_Ok = Set_Device_ID(Frame, DevID);
+    }
+    if (Check_Ok == TRUE) {
+        Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = FunctionCode;
+        Frame_Put_U16(&Frame->Adu[FRAME_ADDRESS_OFFSET], StartAddress);
+        Frame_Put_U16(&Frame->Adu[FRAME_QUANTITY_OFFSET], Quantity);
+        Frame->Length = FRAME_REQ_HEADER_LENGTH;
+    }
+    return Check_Ok;
+}
+
+//!-  Frame_Build_Write_Single() builds an FC05/FC06 Request (no CRC).
+Bool Frame_Build_Write_Single(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint8_t  const FunctionCode,
+        uint16_t const Address,
+        uint16_t const Value) {
+
+    Bool Check_Ok = FALSE;
+
+    switch (FunctionCode) {
+        case Fun_Code05:
+            if ((Value == COIL_ON) || (Value == COIL_OFF)) {
+                Check_Ok = TRUE;
+            }
+            break;
+        case Fun_Code06:
+            Check_Ok = TRUE;
+            break;
+        default:
+            Check_Ok = FALSE;
+            break;
+    }
+
+    if (Check_Ok == TRUE) {
+        Check_Ok = Set_Device_ID(Frame, DevID);
+    }
+    if (Check_Ok == TRUE) {
+        Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = FunctionCode;
+        Frame_Put_U16(&Frame->Adu[FRAME_ADDRESS_OFFSET], Address);
+        Frame_Put_U16(&Frame->Adu[FRAME_VALUE_OFFSET], Value);
+        Frame->Length = FRAME_REQ_HEADER_LENGTH;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Frame_Build_Write_Multiple() builds the Header of an
+ *!-  FC15/FC16 Request. The Caller fills Frame_Req_Payload()
+ *!-  in place (and calls Frame_Seal() for RTU).
+ */
+Bool Frame_Build_Write_Multiple(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress,
+        uint16_t const Quantity) {
+
+    Bool Check_Ok = FALSE;
+    uint8_t ByteCount = 0;
+
+    switch (FunctionCode) {
+        case Fun_Code15:
+            Check_Ok = Validate_Request_Range(
+                           StartAddress, Quantity, MAXWRITECOILQUANTITY);
+            ByteCount = (uint8_t) ((Quantity + 7) / 8);
+            break;
+        case Fun_Code16:
+            Check_Ok = Validate_Request_Range(
+                           StartAddress, Quantity, MAXWRITEREGQUANTITY);
+            ByteCount = (uint8_t) (Quantity * 2);
+            break;
+        default:
+            Check_Ok = FALSE;
+            break;
+    }
+
+    if (Check_Ok == TRUE) {
+        Check_Ok = Set_Device_ID(Frame, DevID);
+    }
+    if (Check_Ok == TRUE) {
+        Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = FunctionCode;
+        Frame_Put_U16(&Frame->Adu[FRAME_ADDRESS_OFFSET], StartAddress);
+        Frame_Put_U16(&Frame->Adu[FRAME_QUANTITY_OFFSET], Quantity);
+        Frame->Adu[FRAME_REQ_BYTE_COUNT_OFFSET] = ByteCount;
+        Frame->Length = FRAME_REQ_PAYLOAD_OFFSET + ByteCount;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Frame_Build_Mask_Write() builds an FC22 Request (no CRC): the
+ *!-  Slave sets Register "Address" to
+ *!-  (Current AND And_Mask) OR (Or_Mask AND NOT And_Mask).
+ */
+Bool Frame_Build_Mask_Write(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint16_t const Address,
+        uint16_t const And_Mask,
+        uint16_t const Or_Mask) {
+
+    Bool Check_Ok = Set_Device_ID(Frame, DevID);
+
+    if (Check_Ok == TRUE) {
+        Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = Fun_Code22;
+        Frame_Put_U16(&Frame->Adu[FRAME_ADDRESS_OFFSET], Address);
+        Frame_Put_U16(&Frame->Adu[FRAME_AND_MASK_OFFSET], And_Mask);
+        Frame_Put_U16(&Frame->Adu[FRAME_OR_MASK_OFFSET], Or_Mask);
+        Frame->Length = FRAME_MASK_WRITE_LENGTH;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Frame_Build_Read_Write() builds the Header of an FC23 Request.
+ *!-  The Caller fills Frame_RW_Payload() in place (and calls
+ *!-  Frame_Seal() for RTU). The Slave writes before it reads.
+ */
+Bool Frame_Build_Read_Write(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint16_t const Read_Address,
+        uint16_t const Read_Quantity,
+        uint16_t const Write_Address,
+        uint16_t const Write_Quantity) {
+
+    Bool Check_Ok = FALSE;
+    uint8_t const ByteCount = (uint8_t) (Write_Quantity * 2);
+
+    if ((Validate_Request_Range(Read_Address, Read_Quantity,
+                                MAXREADREGQUANTITY) == TRUE) &&
+        (Validate_Request_Range(Write_Address, Write_Quantity,
+                                MAXRWWRITEREGQUANTITY) == TRUE)) {
+        Check_Ok = Set_Device_ID(Frame, DevID);
+    }
+    if (Check_Ok == TRUE) {
+        Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = Fun_Code23;
+        Frame_Put_U16(&Frame->Adu[FRAME_ADDRESS_OFFSET], Read_Address);
+        Frame_Put_U16(&Frame->Adu[FRAME_QUANTITY_OFFSET], Read_Quantity);
+        Frame_Put_U16(&Frame->Adu[FRAME_RW_ADDRESS_OFFSET], Write_Address);
+        Frame_Put_U16(&Frame->Adu[FRAME_RW_QUANTITY_OFFSET], Write_Quantity);
+        Frame->Adu[FRAME_RW_BYTE_COUNT_OFFSET] = ByteCount;
+        Frame->Length = FRAME_RW_PAYLOAD_OFFSET + ByteCount;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Frame_Build_Read_Response() builds the Header of a Read
+ *!-  Response. The Caller fills Frame_Rsp_Payload() in place
+ *!-  (and calls Frame_Seal() for RTU).
+ */
+Bool Frame_Build_Read_Response(
+        Modbus_Frame *const Frame,
+        uint8_t const DevID,
+        uint8_t const FunctionCode,
+        uint8_t const ByteCount) {
+
+    Bool Check_Ok = FALSE;
+
+    if ((FRAME_RSP_PAYLOAD_OFFSET + ByteCount + FRAME_CRC_LENGTH) <=
+         MODBUS_MAX_ADU_LENGTH) {
+        Frame->Adu[FRAME_DEVICE_ID_OFFSET] = DevID;
+        Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = FunctionCode;
+        Frame->Adu[FRAME_RSP_BYTE_COUNT_OFFSET] = ByteCount;
+        Frame->Length = FRAME_RSP_PAYLOAD_OFFSET + ByteCount;
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+//!-  Frame_Build_Exception() builds an Exception Response (no CRC).
+Bool Frame_Build_Exception(
+        Modbus_Frame *const Frame,
+        uint8_t const DevID,
+        uint8_t const FunctionCode,
+        uint8_t const ExceptionCode) {
+
+    Frame->Adu[FRAME_DEVICE_ID_OFFSET] = DevID;
+    Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] = (uint8_t) (FunctionCode | MSB1);
+    Frame->Adu[FRAME_EXCEPTION_CODE_OFFSET] = ExceptionCode;
+    Frame->Length = FRAME_EXCEPTION_CODE_OFFSET + 1;
+
+    return TRUE;
+}
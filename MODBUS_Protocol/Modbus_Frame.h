@@ -0,0 +1,278 @@
+/*
+ * Modbus_Frame.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Frame.h
+*****************************************************************************/
+
+#ifndef __MODBUS_FRAME_H_
+#define __MODBUS_FRAME_H_
+
+//!-  Headers
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Smallest valid RTU ADU: Device_ID + Function_Code + CRC.
+#define FRAME_MIN_LENGTH  (FRAME_HEADER_LENGTH + FRAME_CRC_LENGTH)
+
+/****************************************************************************
+!-  GLOBAL INLINE FUNCTIONS
+*****************************************************************************/
+
+//!-  Frame_Get_U16() reads a Big-Endian 16Bit Field in place.
+static inline uint16_t Frame_Get_U16(
+        const uint8_t *const BytePtr) {
+
+    return (uint16_t) ((((uint16_t) BytePtr[0]) << 8) |
+                       ((uint16_t) BytePtr[1]));
+}
+
+//!-  Frame_Put_U16() writes a Big-Endian 16Bit Field in place.
+static inline void Frame_Put_U16(
+        uint8_t *const BytePtr,
+        uint16_t const Value) {
+
+    BytePtr[0] = (uint8_t) (Value >> 8);
+    BytePtr[1] = (uint8_t) (Value & 0x00FF);
+}
+
+/*
+ *!-  Typed Views of the Header Fields.
+ *!-  Each View reads straight from the Frame Buffer.
+ */
+static inline uint8_t Frame_Device_ID(
+        const Modbus_Frame *const Frame) {
+
+    return Frame->Adu[FRAME_DEVICE_ID_OFFSET];
+}
+
+static inline uint8_t Frame_Function_Code(
+        const Modbus_Frame *const Frame) {
+
+    return Frame->Adu[FRAME_FUNCTION_CODE_OFFSET];
+}
+
+static inline uint16_t Frame_Address(
+        const Modbus_Frame *const Frame) {
+
+    return Frame_Get_U16(&Frame->Adu[FRAME_ADDRESS_OFFSET]);
+}
+
+static inline uint16_t Frame_Quantity(
+        const Modbus_Frame *const Frame) {
+
+    return Frame_Get_U16(&Frame->Adu[FRAME_QUANTITY_OFFSET]);
+}
+
+//!-  Frame_Value() is the Output/Register Value of FC05/FC06.
+static inline uint16_t Frame_Value(
+        const Modbus_Frame *const Frame) {
+
+    return Frame_Get_U16(&Frame->Adu[FRAME_VALUE_OFFSET]);
+}
+
+static inline uint8_t Frame_Req_Byte_Count(
+        const Modbus_Frame *const Frame) {
+
+    return Frame->Adu[FRAME_REQ_BYTE_COUNT_OFFSET];
+}
+
+static inline uint8_t Frame_Rsp_Byte_Count(
+        const Modbus_Frame *const Frame) {
+
+    return Frame->Adu[FRAME_RSP_BYTE_COUNT_OFFSET];
+}
+
+static inline uint8_t Frame_Exception_Code(
+        const Modbus_Frame *const Frame) {
+
+    return Frame->Adu[FRAME_EXCEPTION_CODE_OFFSET];
+}
+
+//!-  Frame_Is_Exception() checks the MSB of the Function Code.
+static inline Bool Frame_Is_Exception(
+        const Modbus_Frame *const Frame) {
+
+    return (Bool) ((Frame->Adu[FRAME_FUNCTION_CODE_OFFSET] & MSB1) != 0);
+}
+
+//!-  FC22 Views: the Masks the Register is combined with.
+static inline uint16_t Frame_And_Mask(
+        const Modbus_Frame *const Frame) {
+
+    return Frame_Get_U16(&Frame->Adu[FRAME_AND_MASK_OFFSET]);
+}
+
+static inline uint16_t Frame_Or_Mask(
+        const Modbus_Frame *const Frame) {
+
+    return Frame_Get_U16(&Frame->Adu[FRAME_OR_MASK_OFFSET]);
+}
+
+/*
+ *!-  FC23 Views: Frame_Address() and Frame_Quantity() give the
+ *!-  Read Range, these the Write Range and its Data.
+ */
+static inline uint16_t Frame_RW_Address(
+        const Modbus_Frame *const Frame) {
+
+    return Frame_Get_U16(&Frame->Adu[FRAME_RW_ADDRESS_OFFSET]);
+}
+
+static inline uint16_t Frame_RW_Quantity(
+        const Modbus_Frame *const Frame) {
+
+    return Frame_Get_U16(&Frame->Adu[FRAME_RW_QUANTITY_OFFSET]);
+}
+
+static inline uint8_t Frame_RW_Byte_Count(
+        const Modbus_Frame *const Frame) {
+
+    return Frame->Adu[FRAME_RW_BYTE_COUNT_OFFSET];
+}
+
+static inline uint8_t *Frame_RW_Payload(
+        const Modbus_Frame *const Frame) {
+
+    return &Frame->Adu[FRAME_RW_PAYLOAD_OFFSET];
+}
+
+/*
+ *!-  Views of the Payload.
+ *!-  Req_Payload: Data of an FC15/FC16 Request.
+ *!-  Rsp_Payload: Data of an FC01..FC04 Response.
+ */
+static inline uint8_t *Frame_Req_Payload(
+        const Modbus_Frame *const Frame) {
+
+    return &Frame->Adu[FRAME_REQ_PAYLOAD_OFFSET];
+}
+
+static inline uint8_t *Frame_Rsp_Payload(
+        const Modbus_Frame *const Frame) {
+
+    return &Frame->Adu[FRAME_RSP_PAYLOAD_OFFSET];
+}
+
+//!-  Frame_Register() reads Register "Index" of a Payload in place.
+static inline uint16_t Frame_Register(
+        const uint8_t *const Payload,
+        uint16_t const Index) {
+
+    return Frame_Get_U16(&Payload[Index * 2]);
+}
+
+//!-  Frame_Set_Register() writes Register "Index" of a Payload in place.
+static inline void Frame_Set_Register(
+        uint8_t *const Payload,
+        uint16_t const Index,
+        uint16_t const Value) {
+
+    Frame_Put_U16(&Payload[Index * 2], Value);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+void Clear_Frame(
+        Modbus_Frame *const FramePtr);
+
+Bool Set_Device_ID(
+        Modbus_Frame *const UsrFrame,
+        uint8_t const UsrDevID);
+
+Bool Set_Function_Code(
+        Modbus_Frame *const UsrFrame,
+        uint8_t const UsrFunctCode);
+
+Bool Set_StartAddress(
+        Modbus_Frame *const UsrFrame,
+        uint16_t const UsrStartAddress,
+        uint8_t  const FunctionCode);
+
+Bool Set_Register_Quantity(
+        Modbus_Frame *const UsrFrame,
+        uint16_t const UsrRegQuantity,
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress);
+
+void Frame_Attach(
+        Modbus_Frame *const Frame,
+        uint8_t *const Buffer,
+        uint16_t const Length);
+
+Bool Frame_Parse(
+        Modbus_Frame *const Frame,
+        uint8_t *const Buffer,
+        uint16_t const Length);
+
+Bool Frame_Check_CRC(
+        const Modbus_Frame *const Frame);
+
+Bool Frame_Seal(
+        Modbus_Frame *const Frame);
+
+Bool Frame_Build_Read_Request(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress,
+        uint16_t const Quantity);
+
+Bool Frame_Build_Write_Single(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint8_t  const FunctionCode,
+        uint16_t const Address,
+        uint16_t const Value);
+
+Bool Frame_Build_Write_Multiple(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint8_t  const FunctionCode,
+        uint16_t const StartAddress,
+        uint16_t const Quantity);
+
+Bool Frame_Build_Mask_Write(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint16_t const Address,
+        uint16_t const And_Mask,
+        uint16_t const Or_Mask);
+
+Bool Frame_Build_Read_Write(
+        Modbus_Frame *const Frame,
+        uint8_t  const DevID,
+        uint16_t const Read_Address,
+        uint16_t const Read_Quantity,
+        uint16_t const Write_Address,
+        uint16_t const Write_Quantity);
+
+Bool Frame_Build_Read_Response(
+        Modbus_Frame *const Frame,
+        uint8_t const DevID,
+        uint8_t const FunctionCode,
+        uint8_t const ByteCount);
+
+Bool Frame_Build_Exception(
+        Modbus_Frame *const Frame,
+        uint8_t const DevID,
+        uint8_t const FunctionCode,
+        uint8_t const ExceptionCode);
+
+Bool Modbus_Request(
+        Modbus_Frame *const Request,
+        uint8_t  const Device_ID,
+        uint8_t  const ReqFunctionCode,
+        uint16_t const Address,
+        uint16_t const Argument);
+
+#endif /* __MODBUS_FRAME_H_ */
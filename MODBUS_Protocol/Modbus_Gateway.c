@@ -0,0 +1,235 @@
+/*
+ * Modbus_Gateway.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Gateway.c
+ ****************************************************************************/
+
+//!-  Headers
+#include <ctype.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Modbus.h"
+#include "Modbus_Gateway.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Argument Prefix of Cache TTLs, see Gateway_Add_TTL().
+#define GATEWAY_TTL  "ttl"
+
+Bool Gateway_Add_Route(
+        const char *const Map);
+
+Bool Gateway_Add_TTL(
+        const char *const Rule);
+
+void Gateway_Stop(
+        int const Signal);
+
+void Gateway_Print_Stats(void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Gateway         Gateway_Main;
+static const char            *Gateway_Spec[GATEWAY_MAX_LINES];
+static uint64_t               Gateway_Started_ns;
+static volatile sig_atomic_t  Gateway_Running = 1;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Gateway_Add_Route() opens the Line of "first[-last]=line"
+ *!-  ("line" as for Modbus_RTU_Port_Open()) and routes the Units
+ *!-  to it. A Line named twice is opened once.
+ */
+Bool Gateway_Add_Route(
+        const char *const Map) {
+
+    Bool Check_Ok = FALSE;
+    unsigned long First = 0;
+    unsigned long Last = 0;
+    char *End = NULL;
+    uint32_t Index = 0;
+    int Line = -1;
+
+    First = strtoul(Map, &End, 0);
+    Last = (*End == '-') ? strtoul(End + 1, &End, 0) : First;
+    if ((*End == '=') && (First >= MIN_DEVICE_ID) && (First <= Last) &&
+        (Last <= MAX_DEVICE_ID)) {
+        for (Index = 0; Index < Gateway_Main.Lines; Index++) {
+            if (strcmp(Gateway_Spec[Index], End + 1) == 0) {
+                Line = (int) Index;
+            }
+        }
+        if (Line < 0) {
+            Line = Modbus_Gateway_Add_Line(&Gateway_Main, End + 1);
+            if (Line >= 0) {
+                Gateway_Spec[Line] = End + 1;
+            }
+        }
+        Check_Ok = Modbus_Gateway_Route(&Gateway_Main, (uint8_t) First,
+                                        (uint8_t) Last, Line);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Gateway_Add_TTL() sets a Cache TTL: "ttl=<ms>" for all Reads,
+ *!-  "ttl:[<unit>:]<c|d|i|h><first>[-<last>]=<ms>" for a Range of
+ *!-  the Coils, Discrete Inputs, Input or Holding Registers of one
+ *!-  Unit or of all, e.g. "ttl:3:h0-99=250" or "ttl:i0-15=0".
+ */
+Bool Gateway_Add_TTL(
+        const char *const Rule) {
+
+    static const char Tables[] = "cdih";
+    Bool Check_Ok = FALSE;
+    const char *Spec = Rule + strlen(GATEWAY_TTL);
+    const char *Table = NULL;
+    unsigned long Unit_ID = BROADCAST;
+    unsigned long First = 0;
+    unsigned long Last = 0;
+    unsigned long TTL_Ms = 0;
+    char *End = NULL;
+
+    if (*Spec == '=') {
+        TTL_Ms = strtoul(Spec + 1, &End, 0);
+        Check_Ok = (Bool) (*End == '\0');
+        if (Check_Ok == TRUE) {
+            Gateway_Main.Cache.Default_TTL_ns = TTL_Ms * NS_PER_MS;
+        }
+    }
+    else if (*Spec == ':') {
+        Spec++;
+        if (isdigit((unsigned char) *Spec) != 0) {
+            Unit_ID = strtoul(Spec, &End, 0);
+            Spec = (*End == ':') ? End + 1 : End;
+        }
+        Table = (*Spec != '\0') ? strchr(Tables, *Spec) : NULL;
+    }
+    if ((Table != NULL) && (Unit_ID <= MAX_DEVICE_ID)) {
+        First = strtoul(Spec + 1, &End, 0);
+        Last = (*End == '-') ? strtoul(End + 1, &End, 0) : First;
+        if ((*End == '=') && (Last < MAX_UNIT_ITEMS)) {
+            TTL_Ms = strtoul(End + 1, &End, 0);
+            Check_Ok = (Bool) ((*End == '\0') &&
+                               (Modbus_Cache_Set_TTL(&Gateway_Main.Cache,
+                                                     (uint8_t) Unit_ID,
+                                                     (Modbus_Table) (Table - Tables),
+                                                     (uint16_t) First,
+                                                     (uint16_t) Last,
+                                                     TTL_Ms * NS_PER_MS) == TRUE));
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Gateway_Stop() ends the Main Loop on SIGINT/SIGTERM.
+void Gateway_Stop(
+        int const Signal) {
+
+    (void) Signal;
+    Gateway_Running = 0;
+}
+
+//!-  Gateway_Print_Stats() reports the Load of every Line.
+void Gateway_Print_Stats(void) {
+
+    double const Elapsed_ns = (double) (Modbus_Now_ns() - Gateway_Started_ns);
+    const Modbus_Cache_Stats *const Cache = &Gateway_Main.Cache.Stats;
+    Gateway_Line *Line = NULL;
+    uint32_t Index = 0;
+
+    printf("gateway: %llu requests served, %llu unavailable\n",
+           (unsigned long long) Gateway_Main.Server.Requests_Served,
+           (unsigned long long) Gateway_Main.Unavailable);
+    printf("cache: %llu hits, %llu misses, %llu coalesced, %llu bypassed, "
+           "%llu invalidated\n",
+           (unsigned long long) Cache->Hits,
+           (unsigned long long) Cache->Misses,
+           (unsigned long long) Cache->Coalesced,
+           (unsigned long long) Cache->Bypassed,
+           (unsigned long long) Cache->Invalidated);
+    for (Index = 0; Index < Gateway_Main.Lines; Index++) {
+        Line = &Gateway_Main.Line[Index];
+        printf("line %u %s: %llu forwarded, %llu timeouts, %.1f%% busy, "
+               "mean queue %.1f us, %s\n",
+               Index, Gateway_Spec[Index],
+               (unsigned long long) Line->Forwarded,
+               (unsigned long long) Line->Timeouts,
+               (double) Line->Busy_ns * 100.0 / Elapsed_ns,
+               (Line->Forwarded != 0) ?
+               (double) Line->Queue_ns / (double) Line->Forwarded / 1e3 : 0.0,
+               (Line->Up == TRUE) ? "up" : "down");
+    }
+}
+
+/*
+ *!-  Usage: Modbus_Gateway [port] first[-last]=line ... [ttl...]
+ *!-  Serves Modbus TCP Clients (default Port 502) from Modbus RTU
+ *!-  Slaves: each "first[-last]=line" sends those Unit IDs to the
+ *!-  Serial Line "Path[,Baud[,Format]]". Units on no Line get
+ *!-  GATEWAY_PATH_UNAVAILABLE. Identical Reads in Flight share
+ *!-  one Transaction; with "ttl" Rules (see Gateway_Add_TTL())
+ *!-  Responses are also reused for that long. Prints the Line
+ *!-  and Cache Statistics on SIGINT/SIGTERM.
+ */
+int main(int argc, char *argv[]) {
+
+    Bool Ckeck_OK = FALSE;
+    uint16_t Port = MODBUS_TCP_PORT;
+    int Arg = 1;
+    struct sigaction Action;
+
+    if ((argc > 1) && (strchr(argv[1], '=') == NULL) &&
+        (isdigit((unsigned char) argv[1][0]) != 0)) {
+        Port = (uint16_t) atoi(argv[1]);
+        Arg = 2;
+    }
+
+    Ckeck_OK = Modbus_Gateway_Open(&Gateway_Main, Port);
+    if (Ckeck_OK == FALSE) {
+        fprintf(stderr, "Modbus_Gateway: cannot serve on port %u\n", Port);
+        return 1;
+    }
+    for (; Arg < argc; Arg++) {
+        if (strncmp(argv[Arg], GATEWAY_TTL, strlen(GATEWAY_TTL)) == 0) {
+            Ckeck_OK = Gateway_Add_TTL(argv[Arg]);
+        }
+        else {
+            Ckeck_OK = Gateway_Add_Route(argv[Arg]);
+        }
+        if (Ckeck_OK == FALSE) {
+            fprintf(stderr, "Modbus_Gateway: cannot use %s\n", argv[Arg]);
+            Modbus_Gateway_Close(&Gateway_Main);
+            return 1;
+        }
+    }
+
+    memset(&Action, 0, sizeof(Action));
+    Action.sa_handler = Gateway_Stop;
+    sigemptyset(&Action.sa_mask);
+    (void) sigaction(SIGINT, &Action, NULL);
+    (void) sigaction(SIGTERM, &Action, NULL);
+
+    Gateway_Started_ns = Modbus_Now_ns();
+    while ((Gateway_Running != 0) &&
+           (Modbus_Gateway_Poll(&Gateway_Main, -1) >= 0)) {
+    }
+
+    Gateway_Print_Stats();
+    Modbus_Gateway_Close(&Gateway_Main);
+    return 0;
+}
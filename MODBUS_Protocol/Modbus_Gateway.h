@@ -0,0 +1,158 @@
+/*
+ * Modbus_Gateway.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Gateway.h
+*****************************************************************************/
+
+#ifndef __MODBUS_GATEWAY_H_
+#define __MODBUS_GATEWAY_H_
+
+//!-  Headers
+#include <Modbus.h>
+#include <Modbus_Cache.h>
+#include <Modbus_RTU.h>
+#include <Modbus_TCP.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Serial Lines behind one Gateway.
+#define GATEWAY_MAX_LINES       (16)
+//!-  Requests queued over all Lines; Memory is reserved up front.
+#define GATEWAY_MAX_REQUESTS    (4096)
+//!-  Requests queued on one Line before new ones are refused.
+#define GATEWAY_LINE_QUEUE      (512)
+//!-  Writes served in a Row while Reads wait.
+#define GATEWAY_WRITE_BURST     (4)
+//!-  Answer Timeout of a Slave on the Line.
+#define GATEWAY_RESPONSE_MS     (250)
+//!-  Requests older than this when their Turn comes are refused;
+//!-  their Client gave up on them (TCP_CLIENT_TIMEOUT_MS).
+#define GATEWAY_QUEUE_MS        (TCP_CLIENT_TIMEOUT_MS)
+//!-  Route of a Unit ID that no Line serves.
+#define GATEWAY_NO_LINE         (0xFF)
+
+/*
+ *!-  "Gateway_Class" orders the Requests of a Line: Writes go
+ *!-  first, but never more than GATEWAY_WRITE_BURST in a Row
+ *!-  while Reads are waiting.
+ */
+typedef enum {
+    GATEWAY_WRITES  = 0,
+    GATEWAY_READS   = 1,
+    GATEWAY_CLASSES = 2,
+} Gateway_Class;
+
+/*
+ *!-  "Gateway_Request" is a TCP Request waiting for its Line.
+ *!-  Conn/Generation/Transaction_ID address the Answer; Adu
+ *!-  holds Unit ID + PDU, with Room for the CRC. Entry is the
+ *!-  Cache Entry the Response fills, with the Requests coalesced
+ *!-  onto this one as its Waiters.
+ */
+typedef struct Gateway_Request {
+    struct Gateway_Request  *Next;
+    TCP_Connection          *Conn;
+    uint32_t                 Generation;
+    uint16_t                 Transaction_ID;
+    uint16_t                 Length;
+    uint64_t                 Queued_ns;
+    Modbus_Cache_Entry      *Entry;
+    uint8_t                  Adu[MODBUS_MAX_ADU_LENGTH];
+} Gateway_Request;
+
+//!-  "Gateway_Queue" is the FIFO of one Client on one Line.
+typedef struct {
+    Gateway_Request  *Head;
+    Gateway_Request  *Tail;
+} Gateway_Queue;
+
+/*
+ *!-  "Gateway_Ring" holds the Clients (Connection Indices) with
+ *!-  Requests of one Class queued; each is served one Request,
+ *!-  then goes to the Back, so busy Clients cannot crowd out
+ *!-  the others.
+ */
+typedef struct {
+    uint16_t  Head;
+    uint16_t  Count;
+    uint16_t  Client[TCP_SERVER_MAX_CONNECTIONS];
+} Gateway_Ring;
+
+/*
+ *!-  "Gateway_Line" is one Serial Line with its Queues.
+ *!-  Active:
+ *!-  Request on the Line right now, NULL when idle.
+ *!-  Busy_ns:
+ *!-  Time with a Request on the Line, for its Utilization.
+ */
+typedef struct {
+    struct Modbus_Gateway  *Gateway;
+    Modbus_RTU_Client       Client;
+    Bool                    Up;
+    uint32_t                Queued;
+    uint32_t                Write_Burst;
+    Gateway_Request        *Active;
+    uint64_t                Started_ns;
+    uint64_t                Busy_ns;
+    uint64_t                Forwarded;
+    uint64_t                Timeouts;
+    uint64_t                Queue_ns;
+    Gateway_Ring            Ring[GATEWAY_CLASSES];
+    Gateway_Queue           Queue[GATEWAY_CLASSES][TCP_SERVER_MAX_CONNECTIONS];
+} Gateway_Line;
+
+/*
+ *!-  "Modbus_Gateway" serves Modbus TCP Clients from RTU Slaves.
+ *!-  Route:
+ *!-  Line of each Unit ID, GATEWAY_NO_LINE if none.
+ *!-  Epoll_Fd:
+ *!-  Waits on the epoll Sets of the Server and of every Line.
+ *!-  Cache:
+ *!-  Answers repeated Reads within their TTL and coalesces Reads
+ *!-  in Flight; set its TTLs before the first Poll.
+ */
+typedef struct Modbus_Gateway {
+    Modbus_TCP_Server   Server;
+    int                 Epoll_Fd;
+    uint32_t            Lines;
+    uint8_t             Route[MODBUS_UNIT_SLOTS];
+    Gateway_Request    *Free_List;
+    Gateway_Request    *Pool;
+    Gateway_Line       *Line;
+    uint64_t            Unavailable;
+    Modbus_Cache        Cache;
+} Modbus_Gateway;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+Bool Modbus_Gateway_Open(
+        Modbus_Gateway *const Gateway,
+        uint16_t const Port);
+
+int Modbus_Gateway_Add_Line(
+        Modbus_Gateway *const Gateway,
+        const char *const Spec);
+
+Bool Modbus_Gateway_Route(
+        Modbus_Gateway *const Gateway,
+        uint8_t const First_ID,
+        uint8_t const Last_ID,
+        int const Line);
+
+int Modbus_Gateway_Poll(
+        Modbus_Gateway *const Gateway,
+        int const TimeoutMs);
+
+void Modbus_Gateway_Close(
+        Modbus_Gateway *const Gateway);
+
+#endif /* __MODBUS_GATEWAY_H_ */
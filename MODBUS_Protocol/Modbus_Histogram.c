@@ -0,0 +1,219 @@
+/*
+ * Modbus_Histogram.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Histogram.c
+*****************************************************************************/
+
+//!-  Headers
+#include <math.h>
+#include <string.h>
+#include "Modbus_Histogram.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+uint32_t Histogram_Index(
+        uint64_t const Value);
+
+uint64_t Histogram_Lowest(
+        uint32_t const Index);
+
+uint64_t Histogram_Highest(
+        uint32_t const Index);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Histogram_Index() gives the Bucket of a Value: the Value
+ *!-  itself below 2^HISTOGRAM_SUB_BITS, else its Power of 2
+ *!-  and its top HISTOGRAM_SUB_BITS Bits.
+ */
+uint32_t Histogram_Index(
+        uint64_t const Value) {
+
+    uint32_t Shift = 0;
+    uint32_t Index = (uint32_t) Value;
+
+    if (Value >= (2 * HISTOGRAM_HALF)) {
+        Shift = (uint32_t) (63 - __builtin_clzll(Value)) -
+                (HISTOGRAM_SUB_BITS - 1);
+        Index = (Shift * HISTOGRAM_HALF) + (uint32_t) (Value >> Shift);
+    }
+    return Index;
+}
+
+//!-  Histogram_Lowest() gives the smallest Value of a Bucket.
+uint64_t Histogram_Lowest(
+        uint32_t const Index) {
+
+    uint32_t Shift = 0;
+    uint64_t Lowest = Index;
+
+    if (Index >= (2 * HISTOGRAM_HALF)) {
+        Shift = (Index / HISTOGRAM_HALF) - 1;
+        Lowest = (uint64_t) (Index - (Shift * HISTOGRAM_HALF)) << Shift;
+    }
+    return Lowest;
+}
+
+//!-  Histogram_Highest() gives the largest Value of a Bucket.
+uint64_t Histogram_Highest(
+        uint32_t const Index) {
+
+    return Histogram_Lowest(Index + 1) - 1;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Modbus_Histogram_Reset() forgets all Values.
+void Modbus_Histogram_Reset(
+        Modbus_Histogram *const Histogram) {
+
+    memset(Histogram, 0, sizeof(*Histogram));
+    Histogram->Min = UINT64_MAX;
+}
+
+//!-  Modbus_Histogram_Record() counts one Value.
+void Modbus_Histogram_Record(
+        Modbus_Histogram *const Histogram,
+        uint64_t const Value) {
+
+    uint64_t const Clamped = (Value > HISTOGRAM_MAX_VALUE) ?
+                             HISTOGRAM_MAX_VALUE : Value;
+
+    Histogram->Buckets[Histogram_Index(Clamped)]++;
+    Histogram->Count++;
+    Histogram->Total += Clamped;
+    if (Clamped < Histogram->Min) {
+        Histogram->Min = Clamped;
+    }
+    if (Clamped > Histogram->Max) {
+        Histogram->Max = Clamped;
+    }
+}
+
+//!-  Modbus_Histogram_Merge() adds the Values of "From" to "Into".
+void Modbus_Histogram_Merge(
+        Modbus_Histogram *const Into,
+        const Modbus_Histogram *const From) {
+
+    uint32_t Index = 0;
+
+    for (Index = 0; Index < HISTOGRAM_BUCKETS; Index++) {
+        Into->Buckets[Index] += From->Buckets[Index];
+    }
+    Into->Count += From->Count;
+    Into->Total += From->Total;
+    if (From->Min < Into->Min) {
+        Into->Min = From->Min;
+    }
+    if (From->Max > Into->Max) {
+        Into->Max = From->Max;
+    }
+}
+
+/*
+ *!-  Modbus_Histogram_Percentile() gives the Value "Percentile"
+ *!-  (0 .. 100) of the Values are at or below: the Top of its
+ *!-  Bucket, as HdrHistogram reports it. 0 if nothing was recorded.
+ */
+uint64_t Modbus_Histogram_Percentile(
+        const Modbus_Histogram *const Histogram,
+        double const Percentile) {
+
+    uint64_t const Target = (uint64_t) ceil((Percentile / 100.0) *
+                                            (double) Histogram->Count);
+    uint64_t Seen = 0;
+    uint64_t Value = (Histogram->Count == 0) ? 0 : Histogram->Min;
+    uint32_t Index = 0;
+
+    //!-  The first Bucket that reaches the Target, with Values beyond.
+    if ((Histogram->Count != 0) && (Target != 0)) {
+        while ((Index < HISTOGRAM_BUCKETS) && (Seen < Target)) {
+            Seen += Histogram->Buckets[Index];
+            Index++;
+        }
+        Value = Histogram_Highest(Index - 1);
+    }
+    return (Value > Histogram->Max) ? Histogram->Max : Value;
+}
+
+/*
+ *!-  Modbus_Histogram_Print() writes the Percentile Distribution
+ *!-  in the Format of HdrHistogram's outputPercentileDistribution,
+ *!-  so its Plotting Tools read it. Values are divided by "Scale"
+ *!-  (e.g. 1000 for ns -> us); "Ticks" Lines are printed per Half
+ *!-  of the remaining Distance to 100%.
+ */
+void Modbus_Histogram_Print(
+        const Modbus_Histogram *const Histogram,
+        FILE *const Out,
+        double const Scale,
+        uint32_t const Ticks) {
+
+    double Next = 0.0;
+    double Reached = 0.0;
+    double Half = 0.0;
+    double Mean = 0.0;
+    double Deviation = 0.0;
+    double Middle = 0.0;
+    uint64_t Seen = 0;
+    uint64_t Value = 0;
+    uint32_t Index = 0;
+    Bool Printed = FALSE;
+
+    fprintf(Out, "%12s %14s %10s %14s\n\n",
+            "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+
+    for (Index = 0; (Index < HISTOGRAM_BUCKETS) && (Seen < Histogram->Count);
+         Index++) {
+        Seen += Histogram->Buckets[Index];
+        Reached = 100.0 * (double) Seen / (double) Histogram->Count;
+        Value = Histogram_Highest(Index);
+        if (Value > Histogram->Max) {
+            Value = Histogram->Max;
+        }
+        //!-  Empty Buckets reach no new Percentile; the last prints once.
+        Printed = (Bool) (Histogram->Buckets[Index] == 0);
+        while ((Printed == FALSE) && (Next <= Reached) && (Next < 100.0)) {
+            fprintf(Out, "%12.3f %2.12f %10llu %14.2f\n",
+                    (double) Value / Scale, Next / 100.0,
+                    (unsigned long long) Seen, 100.0 / (100.0 - Next));
+            Printed = (Bool) (Seen == Histogram->Count);
+            Half = pow(2.0, floor(log2(100.0 / (100.0 - Next))) + 1.0);
+            Next += 100.0 / (Half * (double) Ticks);
+        }
+    }
+    if (Histogram->Count != 0) {
+        fprintf(Out, "%12.3f %2.12f %10llu %14s\n",
+                (double) Histogram->Max / Scale, 1.0,
+                (unsigned long long) Histogram->Count, "inf");
+        Mean = (double) Histogram->Total / (double) Histogram->Count;
+        for (Index = 0; Index < HISTOGRAM_BUCKETS; Index++) {
+            if (Histogram->Buckets[Index] != 0) {
+                Middle = ((double) Histogram_Lowest(Index) +
+                          (double) Histogram_Highest(Index)) / 2.0 - Mean;
+                Deviation += Middle * Middle * (double) Histogram->Buckets[Index];
+            }
+        }
+        Deviation = sqrt(Deviation / (double) Histogram->Count);
+    }
+    fprintf(Out, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n",
+            Mean / Scale, Deviation / Scale);
+    fprintf(Out, "#[Max     = %12.3f, Total count    = %12llu]\n",
+            (double) Histogram->Max / Scale,
+            (unsigned long long) Histogram->Count);
+    fprintf(Out, "#[Buckets = %12u, SubBuckets     = %12u]\n",
+            (unsigned) (HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1),
+            (unsigned) (2 * HISTOGRAM_HALF));
+}
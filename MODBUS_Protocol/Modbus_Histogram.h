@@ -0,0 +1,77 @@
+/*
+ * Modbus_Histogram.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Histogram.h
+*****************************************************************************/
+
+#ifndef __MODBUS_HISTOGRAM_H_
+#define __MODBUS_HISTOGRAM_H_
+
+//!-  Headers
+#include <stdio.h>
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  Log-linear Buckets as in HdrHistogram: Values below
+ *!-  2^HISTOGRAM_SUB_BITS get a Bucket each; above, every Power
+ *!-  of 2 is split into 2^(HISTOGRAM_SUB_BITS - 1) Buckets, so a
+ *!-  Value is kept to within 1/128 (2 significant Digits). Values
+ *!-  up to 2^HISTOGRAM_MAX_BITS (68 s in Nanoseconds) are told
+ *!-  apart; larger ones are counted as that.
+ */
+#define HISTOGRAM_SUB_BITS     (8)
+#define HISTOGRAM_MAX_BITS     (36)
+#define HISTOGRAM_HALF         (1U << (HISTOGRAM_SUB_BITS - 1))
+#define HISTOGRAM_BUCKETS      \
+    ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 2) * HISTOGRAM_HALF)
+#define HISTOGRAM_MAX_VALUE    ((1ULL << HISTOGRAM_MAX_BITS) - 1)
+
+/*
+ *!-  "Modbus_Histogram" records Values (e.g. Latencies in ns)
+ *!-  with constant relative Precision. Recording is a few
+ *!-  Instructions; Histograms of several Threads are merged for
+ *!-  the Report.
+ */
+typedef struct {
+    uint64_t  Count;
+    uint64_t  Min;
+    uint64_t  Max;
+    uint64_t  Total;
+    uint64_t  Buckets[HISTOGRAM_BUCKETS];
+} Modbus_Histogram;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+void Modbus_Histogram_Reset(
+        Modbus_Histogram *const Histogram);
+
+void Modbus_Histogram_Record(
+        Modbus_Histogram *const Histogram,
+        uint64_t const Value);
+
+void Modbus_Histogram_Merge(
+        Modbus_Histogram *const Into,
+        const Modbus_Histogram *const From);
+
+uint64_t Modbus_Histogram_Percentile(
+        const Modbus_Histogram *const Histogram,
+        double const Percentile);
+
+void Modbus_Histogram_Print(
+        const Modbus_Histogram *const Histogram,
+        FILE *const Out,
+        double const Scale,
+        uint32_t const Ticks);
+
+#endif /* __MODBUS_HISTOGRAM_H_ */
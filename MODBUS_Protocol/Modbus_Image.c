@@ -0,0 +1,436 @@
+/*
+ * Modbus_Image.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Image.c
+*****************************************************************************/
+
+//!-  Headers
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Modbus_Image.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Rounds a Size up to whole Cache Lines.
+#define IMAGE_ALIGN(Bytes)                                          \
+    (((uint64_t) (Bytes) + MODBUS_CACHE_LINE - 1) &                 \
+     ~((uint64_t) MODBUS_CACHE_LINE - 1))
+
+#define VIEW_BYTES  IMAGE_ALIGN(sizeof(Modbus_Data))
+
+/*
+ *!-  "Image_Header" starts the Image. All Links inside the Image
+ *!-  are Byte Offsets from its Base (0 = none), so every Process
+ *!-  may map it at a different Address.
+ *!-  Page_Size / Page_Bytes:
+ *!-  Register Page Geometry of the Build that created the Image.
+ *!-  Used_Bytes:
+ *!-  Allocation Watermark; Storage is never given back.
+ *!-  Layout_Lock:
+ *!-  Spin Lock held while Units or Pages are added.
+ *!-  Layout_Generation:
+ *!-  Bumped after every Layout Change, so Attachments know
+ *!-  when their Views need a Refresh.
+ */
+typedef struct {
+    uint32_t  Magic;
+    uint32_t  Version;
+    uint32_t  Page_Size;
+    uint32_t  Page_Bytes;
+    uint64_t  Total_Bytes;
+    uint64_t  Used_Bytes;
+    uint32_t  Layout_Lock;
+    uint32_t  Layout_Generation;
+    uint64_t  Unit_Offset[MODBUS_UNIT_SLOTS];
+} Image_Header;
+
+/*
+ *!-  "Image_Unit" is the Image Copy of one Unit's Layout; the
+ *!-  Process-local Modbus_Data Views are rebuilt from it.
+ */
+typedef struct {
+    uint32_t  Numbers[MODBUS_TABLES];
+    uint64_t  Coils_Offset;
+    uint64_t  DInputs_Offset;
+    uint64_t  IPage_Offset[REGISTER_PAGES];
+    uint64_t  HPage_Offset[REGISTER_PAGES];
+} Image_Unit;
+
+Image_Header *Image_Head(
+        const Modbus_Image *const Image);
+
+void Image_Lock(
+        Image_Header *const Header);
+
+void Image_Unlock(
+        Image_Header *const Header);
+
+uint64_t Image_Allocate(
+        Image_Header *const Header,
+        uint64_t const Bytes);
+
+Bool Image_Attach_Unit(
+        Modbus_Image *const Image,
+        uint8_t const Device_ID);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+Image_Header *Image_Head(
+        const Modbus_Image *const Image) {
+
+    return (Image_Header *) Image->Base;
+}
+
+void Image_Lock(
+        Image_Header *const Header) {
+
+    while (__atomic_exchange_n(&Header->Layout_Lock, 1,
+                               __ATOMIC_ACQUIRE) != 0) {
+        while (__atomic_load_n(&Header->Layout_Lock,
+                               __ATOMIC_RELAXED) != 0) {
+            MODBUS_CPU_PAUSE();
+        }
+    }
+}
+
+void Image_Unlock(
+        Image_Header *const Header) {
+
+    __atomic_store_n(&Header->Layout_Lock, 0, __ATOMIC_RELEASE);
+}
+
+/*
+ *!-  Image_Allocate() takes zeroed, Cache-Line aligned Storage
+ *!-  from the Image; called with the Layout Lock held.
+ *!-  Returns its Offset, or 0 when the Image is full.
+ */
+uint64_t Image_Allocate(
+        Image_Header *const Header,
+        uint64_t const Bytes) {
+
+    uint64_t Offset = 0;
+    uint64_t const Size = IMAGE_ALIGN(Bytes);
+
+    if ((Header->Used_Bytes + Size) <= Header->Total_Bytes) {
+        Offset = Header->Used_Bytes;
+        memset((uint8_t *) Header + Offset, 0, Size);
+        Header->Used_Bytes += Size;
+    }
+    return Offset;
+}
+
+/*
+ *!-  Image_Attach_Unit() builds or updates the Process-local View
+ *!-  of a Unit of the Image. An existing View is updated in place,
+ *!-  so Pointers to it held by the Server stay valid; a Unit hosted
+ *!-  from the Heap under the same Device_ID is replaced.
+ */
+Bool Image_Attach_Unit(
+        Modbus_Image *const Image,
+        uint8_t const Device_ID) {
+
+    Bool Check_Ok = FALSE;
+    Image_Header *const Header = Image_Head(Image);
+    uint64_t const Offset = __atomic_load_n(&Header->Unit_Offset[Device_ID],
+                                            __ATOMIC_ACQUIRE);
+    const Image_Unit *Record = NULL;
+    Modbus_Data *View = MODBUS_UNITS[Device_ID];
+    uint32_t Index = 0;
+
+    if (Offset != 0) {
+        Record = (const Image_Unit *) (Image->Base + Offset);
+        if ((View != NULL) && (View->Shared == FALSE)) {
+            (void) Modbus_Remove_Unit(Device_ID);
+            View = NULL;
+        }
+        if (View == NULL) {
+            View = aligned_alloc(MODBUS_CACHE_LINE, VIEW_BYTES);
+            if (View != NULL) {
+                memset(View, 0, VIEW_BYTES);
+            }
+        }
+        if (View != NULL) {
+            View->Device_ID = Device_ID;
+            View->Shared = TRUE;
+            memcpy(View->Numbers, Record->Numbers, sizeof(View->Numbers));
+            View->Coils = (Coils *) (Image->Base + Record->Coils_Offset);
+            View->DInputs = (Discrete_Inputs *)
+                            (Image->Base + Record->DInputs_Offset);
+            for (Index = 0; Index < REGISTER_PAGES; Index++) {
+                View->IPages[Index] = (Record->IPage_Offset[Index] != 0) ?
+                    (Register_Page *) (Image->Base +
+                                       Record->IPage_Offset[Index]) : NULL;
+                View->HPages[Index] = (Record->HPage_Offset[Index] != 0) ?
+                    (Register_Page *) (Image->Base +
+                                       Record->HPage_Offset[Index]) : NULL;
+            }
+            MODBUS_UNITS[Device_ID] = View;
+            Check_Ok = TRUE;
+        }
+    }
+    return Check_Ok;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_Image_Open() maps the Image at "Path", creating it
+ *!-  with a Capacity of "Bytes" when it does not exist yet, and
+ *!-  hosts all its Units. An existing Image keeps its Size and
+ *!-  Values; one of another Version or Page Geometry is refused.
+ */
+Bool Modbus_Image_Open(
+        Modbus_Image *const Image,
+        const char *const Path,
+        uint64_t const Bytes) {
+
+    Bool Check_Ok = FALSE;
+    Image_Header *Header = NULL;
+    struct stat Status;
+    uint32_t Device_ID = 0;
+
+    memset(Image, 0, sizeof(*Image));
+    Image->Fd = open(Path, O_RDWR | O_CREAT | O_CLOEXEC, 0660);
+    if (Image->Fd >= 0) {
+        //!-  Serialize Creation against other Processes.
+        Check_Ok = (Bool) ((flock(Image->Fd, LOCK_EX) == 0) &&
+                           (fstat(Image->Fd, &Status) == 0));
+    }
+    if ((Check_Ok == TRUE) && (Status.st_size == 0)) {
+        Check_Ok = (Bool) ((Bytes > sizeof(Image_Header)) &&
+                           (ftruncate(Image->Fd, (off_t) Bytes) == 0));
+        Status.st_size = (off_t) Bytes;
+    }
+    if (Check_Ok == TRUE) {
+        //!-  A File too short for the Header would fault once mapped.
+        Check_Ok = (Bool) ((uint64_t) Status.st_size >= sizeof(Image_Header));
+    }
+    if (Check_Ok == TRUE) {
+        Image->Bytes = (uint64_t) Status.st_size;
+        Image->Base = mmap(NULL, Image->Bytes, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, Image->Fd, 0);
+        if (Image->Base == MAP_FAILED) {
+            Image->Base = NULL;
+            Check_Ok = FALSE;
+        }
+    }
+    if (Check_Ok == TRUE) {
+        Header = Image_Head(Image);
+        if (Header->Magic == 0) {
+            Header->Version = MODBUS_IMAGE_VERSION;
+            Header->Page_Size = REGISTER_PAGE_SIZE;
+            Header->Page_Bytes = sizeof(Register_Page);
+            Header->Total_Bytes = Image->Bytes;
+            Header->Used_Bytes = IMAGE_ALIGN(sizeof(Image_Header));
+            __atomic_store_n(&Header->Magic, MODBUS_IMAGE_MAGIC,
+                             __ATOMIC_RELEASE);
+        }
+        Check_Ok = (Bool) ((Header->Magic == MODBUS_IMAGE_MAGIC) &&
+                           (Header->Version == MODBUS_IMAGE_VERSION) &&
+                           (Header->Page_Size == REGISTER_PAGE_SIZE) &&
+                           (Header->Page_Bytes == sizeof(Register_Page)) &&
+                           (Header->Total_Bytes == Image->Bytes));
+    }
+    if (Image->Fd >= 0) {
+        (void) flock(Image->Fd, LOCK_UN);
+    }
+
+    if (Check_Ok == TRUE) {
+        Image->Generation = __atomic_load_n(&Header->Layout_Generation,
+                                            __ATOMIC_ACQUIRE);
+        for (Device_ID = MIN_DEVICE_ID; Device_ID <= MAX_DEVICE_ID;
+             Device_ID++) {
+            if ((Header->Unit_Offset[Device_ID] != 0) &&
+                (Image_Attach_Unit(Image, (uint8_t) Device_ID) == FALSE)) {
+                Check_Ok = FALSE;
+            }
+        }
+    }
+    if (Check_Ok == FALSE) {
+        Modbus_Image_Close(Image);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Image_Add_Unit() creates a Unit with the given Bit
+ *!-  Table Sizes in the Image, unless the Image holds it already
+ *!-  (then its stored Layout and Values are kept), and hosts it.
+ */
+Modbus_Data *Modbus_Image_Add_Unit(
+        Modbus_Image *const Image,
+        uint8_t  const Device_ID,
+        uint32_t const Coils_Number,
+        uint32_t const DInputs_Number) {
+
+    Image_Header *const Header = Image_Head(Image);
+    Image_Unit *Record = NULL;
+    uint64_t Offset = 0;
+    Bool Check_Ok = FALSE;
+
+    if ((Device_ID >= MIN_DEVICE_ID) && (Device_ID <= MAX_DEVICE_ID) &&
+        (Coils_Number <= MAX_UNIT_ITEMS) &&
+        (DInputs_Number <= MAX_UNIT_ITEMS)) {
+        Image_Lock(Header);
+        Check_Ok = TRUE;
+        if (Header->Unit_Offset[Device_ID] == 0) {
+            Offset = Image_Allocate(Header, sizeof(Image_Unit));
+            if (Offset != 0) {
+                Record = (Image_Unit *) (Image->Base + Offset);
+                Record->Numbers[TABLE_COILS] = Coils_Number;
+                Record->Numbers[TABLE_DISCRETE_INPUTS] = DInputs_Number;
+                Record->Coils_Offset = Image_Allocate(Header,
+                    ((Coils_Number + BITS_PER_WORD - 1) / BITS_PER_WORD) *
+                    sizeof(Coils));
+                Record->DInputs_Offset = Image_Allocate(Header,
+                    ((DInputs_Number + BITS_PER_WORD - 1) / BITS_PER_WORD) *
+                    sizeof(Discrete_Inputs));
+            }
+            if ((Offset != 0) &&
+                (Record->Coils_Offset != 0) &&
+                (Record->DInputs_Offset != 0)) {
+                __atomic_store_n(&Header->Unit_Offset[Device_ID], Offset,
+                                 __ATOMIC_RELEASE);
+                __atomic_add_fetch(&Header->Layout_Generation, 1,
+                                   __ATOMIC_RELEASE);
+            }
+            else {
+                Check_Ok = FALSE;
+            }
+        }
+        Image_Unlock(Header);
+    }
+    if (Check_Ok == TRUE) {
+        Check_Ok = Image_Attach_Unit(Image, Device_ID);
+    }
+    return (Check_Ok == TRUE) ? MODBUS_UNITS[Device_ID] : NULL;
+}
+
+/*
+ *!-  Modbus_Image_Map_Registers() maps Registers of a Unit of the
+ *!-  Image like Modbus_Map_Registers(), taking the Pages from the
+ *!-  Image. The Validity Bits live in the Pages, so other Processes
+ *!-  see new Registers at once and new Pages after a Refresh.
+ */
+Bool Modbus_Image_Map_Registers(
+        Modbus_Image *const Image,
+        uint8_t const Device_ID,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint32_t const Count) {
+
+    Bool Check_Ok = FALSE;
+    Image_Header *const Header = Image_Head(Image);
+    Image_Unit *Record = NULL;
+    uint64_t *Page_Offset = NULL;
+    Register_Page *Page = NULL;
+    uint32_t Address = Start;
+    uint32_t const End = (uint32_t) Start + Count;
+    uint32_t Offset = 0;
+    uint64_t Bit = 0;
+
+    Image_Lock(Header);
+    if ((Header->Unit_Offset[Device_ID] != 0) && (End <= MAX_UNIT_ITEMS) &&
+        ((Table == TABLE_INPUT_REGISTERS) ||
+         (Table == TABLE_HOLDING_REGISTERS))) {
+        Record = (Image_Unit *) (Image->Base + Header->Unit_Offset[Device_ID]);
+        Page_Offset = (Table == TABLE_HOLDING_REGISTERS) ?
+                      Record->HPage_Offset : Record->IPage_Offset;
+        Check_Ok = TRUE;
+    }
+    while ((Check_Ok == TRUE) && (Address < End)) {
+        if (Page_Offset[Address >> REGISTER_PAGE_SHIFT] == 0) {
+            Page_Offset[Address >> REGISTER_PAGE_SHIFT] =
+                Image_Allocate(Header, sizeof(Register_Page));
+            if (Page_Offset[Address >> REGISTER_PAGE_SHIFT] == 0) {
+                Check_Ok = FALSE;
+                break;
+            }
+            __atomic_add_fetch(&Header->Layout_Generation, 1,
+                               __ATOMIC_RELEASE);
+        }
+        Page = (Register_Page *) (Image->Base +
+                                  Page_Offset[Address >> REGISTER_PAGE_SHIFT]);
+        Offset = Address & REGISTER_PAGE_MASK;
+        Bit = 1ULL << (Offset % BITS_PER_WORD);
+        if ((Page->Valid[Offset / BITS_PER_WORD] & Bit) == 0) {
+            __atomic_or_fetch(&Page->Valid[Offset / BITS_PER_WORD], Bit,
+                              __ATOMIC_RELEASE);
+            Record->Numbers[Table]++;
+        }
+        Address++;
+    }
+    Image_Unlock(Header);
+
+    if (Record != NULL) {
+        (void) Image_Attach_Unit(Image, Device_ID);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Image_Refresh() rebuilds the Views after another
+ *!-  Process changed the Layout (new Units or Pages). It costs
+ *!-  one Load when nothing changed, so it may run every Poll.
+ *!-  Returns TRUE when the Views were rebuilt.
+ */
+Bool Modbus_Image_Refresh(
+        Modbus_Image *const Image) {
+
+    Bool Check_Ok = FALSE;
+    Image_Header *const Header = Image_Head(Image);
+    uint32_t const Generation = __atomic_load_n(&Header->Layout_Generation,
+                                                __ATOMIC_ACQUIRE);
+    uint32_t Device_ID = 0;
+
+    if (Generation != Image->Generation) {
+        Image->Generation = Generation;
+        for (Device_ID = MIN_DEVICE_ID; Device_ID <= MAX_DEVICE_ID;
+             Device_ID++) {
+            (void) Image_Attach_Unit(Image, (uint8_t) Device_ID);
+        }
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Image_Close() stops hosting the Units of the Image
+ *!-  and unmaps it; the Values stay in the Image.
+ */
+void Modbus_Image_Close(
+        Modbus_Image *const Image) {
+
+    uint32_t Device_ID = 0;
+
+    for (Device_ID = 0; Device_ID < MODBUS_UNIT_SLOTS; Device_ID++) {
+        if ((MODBUS_UNITS[Device_ID] != NULL) &&
+            (MODBUS_UNITS[Device_ID]->Shared == TRUE)) {
+            (void) Modbus_Remove_Unit((uint8_t) Device_ID);
+        }
+    }
+    if (Image->Base != NULL) {
+        (void) munmap(Image->Base, Image->Bytes);
+        Image->Base = NULL;
+    }
+    if (Image->Fd >= 0) {
+        (void) close(Image->Fd);
+        Image->Fd = -1;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Modbus_Image.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Image.h
+*****************************************************************************/
+
+#ifndef __MODBUS_IMAGE_H_
+#define __MODBUS_IMAGE_H_
+
+//!-  Headers
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  A Process Image is a File mapped MAP_SHARED by every Process
+ *!-  that works on the Database (Modbus Server, Control Logic,
+ *!-  Historian). A Path under /dev/shm gives a POSIX shm Segment,
+ *!-  a Path on Disk also keeps the Values across Reboots.
+ *!-  MODBUS_IMAGE_VERSION changes whenever the Layout does; an
+ *!-  Image of another Version or Build is refused.
+ */
+#define MODBUS_IMAGE_MAGIC          (0x4D42494DUL)   //!-  "MBIM"
+#define MODBUS_IMAGE_VERSION        (2)
+#define MODBUS_IMAGE_DEFAULT_BYTES  (64UL * 1024 * 1024)
+
+/*
+ *!-  "Modbus_Image" is one Process' Attachment to an Image.
+ *!-  The Units of the Image are hosted in MODBUS_UNITS as Shared
+ *!-  Units whose Tables point straight into the Mapping, so a
+ *!-  Register Access costs no System Call and no Copy.
+ *!-  Generation:
+ *!-  Layout Generation the Views were built from.
+ */
+typedef struct {
+    int        Fd;
+    uint8_t   *Base;
+    uint64_t   Bytes;
+    uint32_t   Generation;
+} Modbus_Image;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+Bool Modbus_Image_Open(
+        Modbus_Image *const Image,
+        const char *const Path,
+        uint64_t const Bytes);
+
+Modbus_Data *Modbus_Image_Add_Unit(
+        Modbus_Image *const Image,
+        uint8_t  const Device_ID,
+        uint32_t const Coils_Number,
+        uint32_t const DInputs_Number);
+
+Bool Modbus_Image_Map_Registers(
+        Modbus_Image *const Image,
+        uint8_t const Device_ID,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint32_t const Count);
+
+Bool Modbus_Image_Refresh(
+        Modbus_Image *const Image);
+
+void Modbus_Image_Close(
+        Modbus_Image *const Image);
+
+#endif /* __MODBUS_IMAGE_H_ */
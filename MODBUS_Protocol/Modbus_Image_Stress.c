@@ -0,0 +1,431 @@
+/*
+ * Modbus_Image_Stress.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Image_Stress.c
+ ****************************************************************************/
+
+//!-  Headers
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "Modbus.h"
+#include "Modbus_Clock.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Image.h"
+#include "Modbus_TCP.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  The Writer (Control Logic) publishes a Sample in Holding
+ *!-  Registers of Unit STRESS_UNIT with Modbus_Publish_Registers():
+ *!-  STRESS_REG_VERSION   Counts the Samples.
+ *!-  STRESS_REG_STAMP     4 Registers: Write Time in ns, MSW first.
+ *!-  STRESS_REG_CHECK     XOR of Version and Stamp.
+ *!-  STRESS_REG_DONE      Set to 1 after the last Sample.
+ *!-  Readers measure the Time from the Stamp until they see it:
+ *!-  "shm" Readers map the Image, the "tcp" Reader polls a Modbus
+ *!-  Server Process serving the same Image with FC03. A Sample
+ *!-  whose Check does not match was torn.
+ */
+#define STRESS_UNIT          (1)
+#define STRESS_REG_VERSION   (0)
+#define STRESS_REG_STAMP     (1)
+#define STRESS_REG_CHECK     (5)
+#define STRESS_REG_DONE      (6)
+#define STRESS_REGISTERS     (7)
+
+//!-  Image created when no Path is given, under /dev/shm.
+#define STRESS_PATH_TEMPLATE "/dev/shm/modbus_image_stress.XXXXXX"
+#define STRESS_IMAGE_BYTES   (1024UL * 1024UL)
+#define STRESS_READERS       (2)
+#define STRESS_UPDATES       (100000)
+#define STRESS_PERIOD_NS     (20 * NS_PER_US)
+
+int Stress_Compare(
+        const void *Left,
+        const void *Right);
+
+uint16_t Stress_Check(
+        const uint16_t *const Sample);
+
+void Stress_Writer(
+        Modbus_Data *const Unit,
+        uint32_t const Updates);
+
+Bool Stress_Report(
+        const char *const Name,
+        uint64_t *const Samples,
+        uint32_t const Count,
+        uint32_t const Torn);
+
+Bool Stress_Shm_Reader(
+        const char *const Name,
+        const Modbus_Data *const Unit,
+        uint32_t const Updates);
+
+void Stress_Tcp_Callback(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+Bool Stress_Tcp_Reader(
+        uint16_t const Port,
+        uint32_t Updates);
+
+void Stress_Server(
+        Modbus_TCP_Server *const Server);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Image       Stress_Image;
+static Modbus_TCP_Client  Stress_Client;
+
+//!-  State of the TCP Reader, updated from its Callback.
+static uint64_t  *Tcp_Samples;
+static uint32_t   Tcp_Count;
+static uint32_t   Tcp_Torn;
+static uint16_t   Tcp_Last_Version;
+static Bool       Tcp_Done;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+int Stress_Compare(
+        const void *Left,
+        const void *Right) {
+
+    uint64_t const A = *(const uint64_t *) Left;
+    uint64_t const B = *(const uint64_t *) Right;
+
+    return (A > B) - (A < B);
+}
+
+//!-  Stress_Check() gives the Check Register of a Sample.
+uint16_t Stress_Check(
+        const uint16_t *const Sample) {
+
+    uint16_t Check = Sample[STRESS_REG_VERSION];
+    uint32_t Index = 0;
+
+    for (Index = 0; Index < 4; Index++) {
+        Check ^= Sample[STRESS_REG_STAMP + Index];
+    }
+    return Check;
+}
+
+//!-  Stress_Writer() publishes one Sample every STRESS_PERIOD_NS.
+void Stress_Writer(
+        Modbus_Data *const Unit,
+        uint32_t const Updates) {
+
+    uint16_t Sample[STRESS_REGISTERS] = { 0 };
+    uint32_t Update = 0;
+    uint64_t Stamp = 0;
+
+    for (Update = 0; Update < Updates; Update++) {
+        Stamp = Modbus_Now_ns();
+        while (Modbus_Now_ns() < (Stamp + STRESS_PERIOD_NS)) {
+        }
+        Stamp = Modbus_Now_ns();
+        Sample[STRESS_REG_VERSION]++;
+        Sample[STRESS_REG_STAMP + 0] = (uint16_t) (Stamp >> 48);
+        Sample[STRESS_REG_STAMP + 1] = (uint16_t) (Stamp >> 32);
+        Sample[STRESS_REG_STAMP + 2] = (uint16_t) (Stamp >> 16);
+        Sample[STRESS_REG_STAMP + 3] = (uint16_t) Stamp;
+        Sample[STRESS_REG_CHECK] = Stress_Check(Sample);
+        (void) Modbus_Publish_Registers(Unit, TABLE_HOLDING_REGISTERS, 0,
+                                        STRESS_REG_DONE, Sample);
+    }
+    Sample[STRESS_REG_DONE] = 1;
+    (void) Modbus_Publish_Registers(Unit, TABLE_HOLDING_REGISTERS, 0,
+                                    STRESS_REGISTERS, Sample);
+}
+
+/*
+ *!-  Stress_Report() prints the Latency Distribution of a Reader.
+ *!-  Returns FALSE when it saw no Sample or a torn one.
+ */
+Bool Stress_Report(
+        const char *const Name,
+        uint64_t *const Samples,
+        uint32_t const Count,
+        uint32_t const Torn) {
+
+    if (Count == 0) {
+        printf("%-6s no samples\n", Name);
+    }
+    else {
+        qsort(Samples, Count, sizeof(uint64_t), Stress_Compare);
+        printf("%-6s %8u samples  min %7llu  p50 %7llu  p99 %7llu  "
+               "p99.9 %7llu  max %9llu ns\n", Name, Count,
+               (unsigned long long) Samples[0],
+               (unsigned long long) Samples[Count / 2],
+               (unsigned long long) Samples[(uint64_t) Count * 99 / 100],
+               (unsigned long long) Samples[(uint64_t) Count * 999 / 1000],
+               (unsigned long long) Samples[Count - 1]);
+    }
+    if (Torn != 0) {
+        printf("%-6s %8u torn samples\n", Name, Torn);
+    }
+    fflush(stdout);
+    return (Bool) ((Count != 0) && (Torn == 0));
+}
+
+/*
+ *!-  Stress_Shm_Reader() spins on Snapshots of the Sample in the
+ *!-  Image and timestamps every new one it observes.
+ */
+Bool Stress_Shm_Reader(
+        const char *const Name,
+        const Modbus_Data *const Unit,
+        uint32_t const Updates) {
+
+    Bool Check_Ok = FALSE;
+    uint64_t *const Samples = calloc(Updates, sizeof(uint64_t));
+    uint16_t Sample[STRESS_REGISTERS];
+    uint16_t Last_Version = 0;
+    uint32_t Count = 0;
+    uint32_t Torn = 0;
+    uint32_t Index = 0;
+    uint64_t Stamp = 0;
+
+    while ((Samples != NULL) && (Count < Updates)) {
+        (void) Modbus_Snapshot_Registers(Unit, TABLE_HOLDING_REGISTERS, 0,
+                                         STRESS_REGISTERS, Sample);
+        if ((Sample[STRESS_REG_VERSION] != Last_Version) &&
+            (Sample[STRESS_REG_CHECK] != Stress_Check(Sample))) {
+            Torn++;
+            Last_Version = Sample[STRESS_REG_VERSION];
+        }
+        else if (Sample[STRESS_REG_VERSION] != Last_Version) {
+            for (Stamp = 0, Index = 0; Index < 4; Index++) {
+                Stamp = (Stamp << 16) | Sample[STRESS_REG_STAMP + Index];
+            }
+            Samples[Count++] = Modbus_Now_ns() - Stamp;
+            Last_Version = Sample[STRESS_REG_VERSION];
+        }
+        if (Sample[STRESS_REG_DONE] != 0) {
+            break;
+        }
+    }
+    Check_Ok = Stress_Report(Name, Samples, Count, Torn);
+    free(Samples);
+    return Check_Ok;
+}
+
+void Stress_Tcp_Callback(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    uint16_t Sample[STRESS_REGISTERS];
+    uint64_t Stamp = 0;
+    uint32_t Index = 0;
+    uint32_t const *const Updates = Context;
+
+    if ((Status != MODBUS_NO_EXCEPTION) || (Response == NULL)) {
+        Tcp_Done = TRUE;
+    }
+    for (Index = 0; (Tcp_Done == FALSE) && (Index < STRESS_REGISTERS);
+         Index++) {
+        Sample[Index] = Frame_Register(Frame_Rsp_Payload(Response), Index);
+    }
+    if ((Tcp_Done == FALSE) &&
+        (Sample[STRESS_REG_VERSION] != Tcp_Last_Version) &&
+        (Sample[STRESS_REG_CHECK] != Stress_Check(Sample))) {
+        Tcp_Torn++;
+        Tcp_Last_Version = Sample[STRESS_REG_VERSION];
+    }
+    else if ((Tcp_Done == FALSE) &&
+             (Sample[STRESS_REG_VERSION] != Tcp_Last_Version) &&
+             (Tcp_Count < *Updates)) {
+        for (Index = 0; Index < 4; Index++) {
+            Stamp = (Stamp << 16) | Sample[STRESS_REG_STAMP + Index];
+        }
+        Tcp_Samples[Tcp_Count++] = Modbus_Now_ns() - Stamp;
+        Tcp_Last_Version = Sample[STRESS_REG_VERSION];
+    }
+    if ((Tcp_Done == FALSE) && (Sample[STRESS_REG_DONE] != 0)) {
+        Tcp_Done = TRUE;
+    }
+}
+
+/*
+ *!-  Stress_Tcp_Reader() polls the Server back to back with FC03,
+ *!-  so its Latency is the Image Update plus one Round Trip.
+ */
+Bool Stress_Tcp_Reader(
+        uint16_t const Port,
+        uint32_t Updates) {
+
+    Bool Check_Ok = FALSE;
+    uint8_t Buffer[MODBUS_MAX_PDU_LENGTH + 1];
+    Modbus_Frame Request;
+    uint32_t Attempt = 0;
+
+    Tcp_Samples = calloc(Updates, sizeof(uint64_t));
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Read_Request(&Request, STRESS_UNIT, Fun_Code03,
+                                    0, STRESS_REGISTERS);
+
+    //!-  The Server Process may still be starting.
+    while (Modbus_TCP_Client_Connect(&Stress_Client, "127.0.0.1",
+                                     Port, 1) == FALSE) {
+        if (++Attempt > 100) {
+            Tcp_Done = TRUE;
+            break;
+        }
+        usleep(10000);
+    }
+    while ((Tcp_Done == FALSE) && (Tcp_Samples != NULL)) {
+        if (Stress_Client.In_Flight == 0) {
+            (void) Modbus_TCP_Client_Submit(&Stress_Client, &Request,
+                                            Stress_Tcp_Callback, &Updates);
+        }
+        if (Modbus_TCP_Client_Poll(&Stress_Client, 100) < 0) {
+            break;
+        }
+    }
+    Modbus_TCP_Client_Close(&Stress_Client);
+    Check_Ok = Stress_Report("tcp", Tcp_Samples, Tcp_Count, Tcp_Torn);
+    free(Tcp_Samples);
+    return Check_Ok;
+}
+
+/*
+ *!-  Stress_Server() serves the Image like Modbus_Slave does, on
+ *!-  the Server the Parent opened; the Units it hosts were
+ *!-  inherited with the Mapping of the Image.
+ */
+void Stress_Server(
+        Modbus_TCP_Server *const Server) {
+
+    while (Modbus_TCP_Server_Poll(Server, -1) >= 0) {
+    }
+    _exit(1);
+}
+
+/*
+ *!-  Usage: Modbus_Image_Stress [readers] [updates] [port] [image]
+ *!-  Forks a Writer, "readers" shm Readers, a Modbus TCP Server
+ *!-  and a TCP Reader, all sharing one Process Image, and prints
+ *!-  the end-to-end Update Latency seen by every Reader. The
+ *!-  Server listens on "port", by default an ephemeral one; the
+ *!-  Image is created at "image", by default a new File under
+ *!-  /dev/shm. Exits with EXIT_FAILURE when a Reader saw a torn
+ *!-  Sample or none at all, so it runs as a Test.
+ */
+int main(int argc, char *argv[]) {
+
+    static Modbus_TCP_Server Stress_Server_TCP;
+    Bool Ckeck_OK = FALSE;
+    uint32_t Readers = STRESS_READERS;
+    uint32_t Updates = STRESS_UPDATES;
+    uint16_t Port = 0;
+    uint32_t Index = 0;
+    Modbus_Data *Unit = NULL;
+    char Path[256] = STRESS_PATH_TEMPLATE;
+    char Name[16];
+    struct sockaddr_in Address;
+    socklen_t Length = sizeof(Address);
+    pid_t Server = 0;
+    pid_t Child = 0;
+    int Fd = -1;
+    int Status = 0;
+
+    if (argc > 1) {
+        Readers = (uint32_t) atoi(argv[1]);
+    }
+    if (argc > 2) {
+        Updates = (uint32_t) atoi(argv[2]);
+    }
+    if (argc > 3) {
+        Port = (uint16_t) atoi(argv[3]);
+    }
+    if (argc > 4) {
+        (void) snprintf(Path, sizeof(Path), "%s", argv[4]);
+        (void) unlink(Path);
+    }
+    else {
+        Fd = mkstemp(Path);
+    }
+    if (Fd >= 0) {
+        (void) close(Fd);
+    }
+
+    Ckeck_OK = (Bool) ((Modbus_Image_Open(&Stress_Image, Path,
+                                          STRESS_IMAGE_BYTES) == TRUE) &&
+                       (Modbus_Image_Add_Unit(&Stress_Image, STRESS_UNIT,
+                                              0, 0) != NULL) &&
+                       (Modbus_Image_Map_Registers(
+                            &Stress_Image, STRESS_UNIT,
+                            TABLE_HOLDING_REGISTERS, 0,
+                            STRESS_REGISTERS) == TRUE) &&
+                       (Modbus_TCP_Server_Open(&Stress_Server_TCP,
+                                               Port) == TRUE) &&
+                       (getsockname(Stress_Server_TCP.Listen_Fd,
+                                    (struct sockaddr *) &Address,
+                                    &Length) == 0));
+    if (Ckeck_OK == FALSE) {
+        perror("Modbus_Image_Stress");
+        (void) unlink(Path);
+        return EXIT_FAILURE;
+    }
+    Port = ntohs(Address.sin_port);
+    Unit = MODBUS_UNITS[STRESS_UNIT];
+    printf("writer: %u updates, one every %llu ns, image %s, port %u\n",
+           Updates, (unsigned long long) STRESS_PERIOD_NS, Path, Port);
+    fflush(stdout);
+
+    Server = fork();
+    if (Server == 0) {
+        Stress_Server(&Stress_Server_TCP);
+    }
+    for (Index = 0; Index < Readers; Index++) {
+        if (fork() == 0) {
+            snprintf(Name, sizeof(Name), "shm%u", Index);
+            _exit((Stress_Shm_Reader(Name, Unit, Updates) == TRUE) ?
+                  EXIT_SUCCESS : EXIT_FAILURE);
+        }
+    }
+    if (fork() == 0) {
+        _exit((Stress_Tcp_Reader(Port, Updates) == TRUE) ?
+              EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    //!-  Give the Readers and the Server Time to start.
+    usleep(200000);
+    Stress_Writer(Unit, Updates);
+
+    for (Index = 0; Index < (Readers + 1); Index++) {
+        Child = wait(&Status);
+        if (Child == Server) {
+            Index--;
+        }
+        else if ((WIFEXITED(Status) == 0) ||
+                 (WEXITSTATUS(Status) != EXIT_SUCCESS)) {
+            Ckeck_OK = FALSE;
+        }
+    }
+    (void) kill(Server, SIGTERM);
+    (void) waitpid(Server, NULL, 0);
+
+    Modbus_Image_Close(&Stress_Image);
+    (void) unlink(Path);
+    return (Ckeck_OK == TRUE) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
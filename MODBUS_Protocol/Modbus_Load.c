@@ -0,0 +1,739 @@
+/*
+ * Modbus_Load.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Load.c
+ ****************************************************************************/
+
+//!-  Headers
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "Modbus.h"
+#include "Modbus_Clock.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Histogram.h"
+#include "Modbus_RTU.h"
+#include "Modbus_TCP.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define LOAD_DEFAULT_HOST      "127.0.0.1"
+#define LOAD_DEFAULT_MASTERS   (4)
+#define LOAD_DEFAULT_WINDOW    (1)
+#define LOAD_DEFAULT_SECONDS   (10)
+#define LOAD_DEFAULT_MIX       "3:1"
+#define LOAD_DEFAULT_RANGE     "0-999"
+#define LOAD_DEFAULT_QUANTITY  (10)
+#define LOAD_DEFAULT_UNITS     "2"
+#define LOAD_MAX_MASTERS       (1024)
+#define LOAD_MAX_MIX           (8)
+
+//!-  Lines per Half Distance to 100% in the Percentile Distribution.
+#define LOAD_TICKS             (5)
+
+//!-  Longest Wait in one Poll while Requests are in Flight.
+#define LOAD_POLL_MS           (100)
+
+//!-  "Load_Pattern" picks the Start Addresses of the Requests.
+typedef enum {
+    LOAD_UNIFORM    = 0,  //!-  Every Address alike.
+    LOAD_SEQUENTIAL = 1,  //!-  Sweeping the Range, Block after Block.
+    LOAD_ZIPF       = 2,  //!-  Low Addresses hot, Zipf (s = 1).
+} Load_Pattern;
+
+//!-  "Load_Mix" is one Function Code of the Mix and its Weight.
+typedef struct {
+    uint8_t   Function_Code;
+    uint32_t  Weight;
+} Load_Mix;
+
+struct Load_Master;
+
+//!-  "Load_Request" is one Request in Flight and when it was due.
+typedef struct {
+    struct Load_Master  *Master;
+    uint64_t             Start_ns;
+} Load_Request;
+
+/*
+ *!-  "Load_Master" is one simulated Master: a TCP Connection or a
+ *!-  Serial Line, driven by its own Thread, with its own Counters
+ *!-  and Latency Histogram, merged when all are done.
+ */
+typedef struct Load_Master {
+    pthread_t           Thread;
+    uint32_t            Number;
+    const char         *Line;
+    Bool                Failed;
+    uint64_t            Random;
+    uint32_t            Sequence;
+    uint64_t            Next_ns;
+    uint64_t            Submitted;
+    uint64_t            Completed;
+    uint64_t            Exceptions;
+    uint64_t            Timeouts;
+    uint16_t            Free_Count;
+    Load_Request       *Free[TCP_CLIENT_MAX_WINDOW];
+    Load_Request        Requests[TCP_CLIENT_MAX_WINDOW];
+    Modbus_Histogram    Latency;
+    Modbus_TCP_Client   TCP;
+    Modbus_RTU_Client   RTU;
+} Load_Master;
+
+Bool Load_Parse_Range(
+        const char *const Text,
+        uint32_t const Limit,
+        uint32_t *const First,
+        uint32_t *const Last);
+
+Bool Load_Parse_Mix(
+        const char *Text);
+
+Bool Load_Init_Zipf(
+        void);
+
+uint64_t Load_Random(
+        Load_Master *const Master);
+
+uint32_t Load_Address(
+        Load_Master *const Master,
+        uint32_t const Quantity);
+
+Bool Load_Build(
+        Load_Master *const Master,
+        Modbus_Frame *const Request);
+
+void Load_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+Bool Load_Submit(
+        Load_Master *const Master);
+
+int Load_Poll(
+        Load_Master *const Master,
+        int const TimeoutMs);
+
+void *Load_Run(
+        void *const Argument);
+
+void Load_Report(
+        uint64_t const Measured_ns);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+//!-  Test Settings, fixed before the Masters start.
+static const char     *Load_Host = LOAD_DEFAULT_HOST;
+static uint16_t        Load_Port = MODBUS_TCP_PORT;
+static uint32_t        Load_Masters = LOAD_DEFAULT_MASTERS;
+static uint16_t        Load_Window = LOAD_DEFAULT_WINDOW;
+static double          Load_Rate;
+static uint64_t        Load_Interval_ns;
+static Load_Mix        Load_Mixes[LOAD_MAX_MIX];
+static uint32_t        Load_Mix_Count;
+static uint32_t        Load_Mix_Total;
+static Load_Pattern    Load_Addressing = LOAD_UNIFORM;
+static uint32_t        Load_First_Address;
+static uint32_t        Load_Last_Address;
+static uint32_t        Load_Quantity = LOAD_DEFAULT_QUANTITY;
+static uint32_t        Load_First_Unit;
+static uint32_t        Load_Last_Unit;
+static double         *Load_Zipf;
+
+//!-  Test Schedule: Start, End of the Warm-up, End of the Test.
+static uint64_t        Load_Start_ns;
+static uint64_t        Load_Measure_ns;
+static uint64_t        Load_End_ns;
+
+static Load_Master    *Load_Master_Pool;
+static Modbus_Histogram Load_Latency;
+
+static const char *const Load_Pattern_Names[] = { "uniform", "seq", "zipf" };
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Load_Parse_Range() reads "first[-last]", "last" up to "Limit".
+Bool Load_Parse_Range(
+        const char *const Text,
+        uint32_t const Limit,
+        uint32_t *const First,
+        uint32_t *const Last) {
+
+    unsigned long Low = 0;
+    unsigned long High = 0;
+    char *End = NULL;
+
+    Low = strtoul(Text, &End, 0);
+    High = (*End == '-') ? strtoul(End + 1, &End, 0) : Low;
+    *First = (uint32_t) Low;
+    *Last = (uint32_t) High;
+    return (Bool) ((*End == '\0') && (End != Text) && (Low <= High) &&
+                   (High <= Limit));
+}
+
+/*
+ *!-  Load_Parse_Mix() reads the Function Code Mix, "fc:weight,..."
+ *!-  e.g. "3:70,16:20,6:10". FC01..06, FC15 and FC16 are known.
+ */
+Bool Load_Parse_Mix(
+        const char *Text) {
+
+    Bool Check_Ok = TRUE;
+    unsigned long Function_Code = 0;
+    unsigned long Weight = 0;
+    char *End = NULL;
+
+    Load_Mix_Count = 0;
+    Load_Mix_Total = 0;
+    while ((Check_Ok == TRUE) && (*Text != '\0')) {
+        Function_Code = strtoul(Text, &End, 0);
+        Weight = (*End == ':') ? strtoul(End + 1, &End, 0) : 1;
+        Check_Ok = (Bool) ((Load_Mix_Count < LOAD_MAX_MIX) && (Weight > 0) &&
+                           (((Function_Code >= Fun_Code01) &&
+                             (Function_Code <= Fun_Code06)) ||
+                            (Function_Code == Fun_Code15) ||
+                            (Function_Code == Fun_Code16) ||
+                            (Function_Code == Fun_Code22) ||
+                            (Function_Code == Fun_Code23)) &&
+                           ((*End == ',') || (*End == '\0')));
+        if (Check_Ok == TRUE) {
+            Load_Mixes[Load_Mix_Count].Function_Code = (uint8_t) Function_Code;
+            Load_Mixes[Load_Mix_Count].Weight = (uint32_t) Weight;
+            Load_Mix_Count++;
+            Load_Mix_Total += (uint32_t) Weight;
+            Text = (*End == ',') ? End + 1 : End;
+        }
+    }
+    return (Bool) ((Check_Ok == TRUE) && (Load_Mix_Count > 0));
+}
+
+//!-  Load_Init_Zipf() tabulates the Zipf CDF over the Address Range.
+Bool Load_Init_Zipf(
+        void) {
+
+    uint32_t const Span = Load_Last_Address - Load_First_Address + 1;
+    double Sum = 0.0;
+    uint32_t Index = 0;
+
+    Load_Zipf = malloc(Span * sizeof(double));
+    if (Load_Zipf != NULL) {
+        for (Index = 0; Index < Span; Index++) {
+            Sum += 1.0 / (double) (Index + 1);
+            Load_Zipf[Index] = Sum;
+        }
+        for (Index = 0; Index < Span; Index++) {
+            Load_Zipf[Index] /= Sum;
+        }
+    }
+    return (Bool) (Load_Zipf != NULL);
+}
+
+//!-  Load_Random() is the xorshift64* Generator of a Master.
+uint64_t Load_Random(
+        Load_Master *const Master) {
+
+    Master->Random ^= Master->Random >> 12;
+    Master->Random ^= Master->Random << 25;
+    Master->Random ^= Master->Random >> 27;
+    return Master->Random * 0x2545F4914F6CDD1DULL;
+}
+
+//!-  Load_Address() picks the Start Address of a Block of "Quantity".
+uint32_t Load_Address(
+        Load_Master *const Master,
+        uint32_t const Quantity) {
+
+    uint32_t const Span = Load_Last_Address - Load_First_Address + 1;
+    uint32_t const Starts = (Quantity < Span) ? (Span - Quantity + 1) : 1;
+    uint32_t Offset = 0;
+    uint32_t Low = 0;
+    uint32_t High = 0;
+    uint32_t Middle = 0;
+    double Draw = 0.0;
+
+    switch (Load_Addressing) {
+        case LOAD_SEQUENTIAL:
+            Offset = (Master->Sequence * Quantity) % Starts;
+            Master->Sequence++;
+            break;
+        case LOAD_ZIPF:
+            Draw = (double) (Load_Random(Master) >> 11) / 9007199254740992.0;
+            High = Span - 1;
+            while (Low < High) {
+                Middle = (Low + High) / 2;
+                if (Load_Zipf[Middle] > Draw) {
+                    High = Middle;
+                }
+                else {
+                    Low = Middle + 1;
+                }
+            }
+            Offset = Low % Starts;
+            break;
+        default:
+            Offset = (uint32_t) (Load_Random(Master) % Starts);
+            break;
+    }
+    return Load_First_Address + Offset;
+}
+
+/*
+ *!-  Load_Build() builds the next Request of a Master: Function
+ *!-  Code drawn from the Mix, Unit from the Unit Range, Address
+ *!-  from the Pattern, Values at random.
+ */
+Bool Load_Build(
+        Load_Master *const Master,
+        Modbus_Frame *const Request) {
+
+    Bool Check_Ok = FALSE;
+    uint32_t Draw = (uint32_t) (Load_Random(Master) % Load_Mix_Total);
+    uint32_t Index = 0;
+    uint8_t Function_Code = 0;
+    uint8_t Unit_ID = 0;
+    uint32_t Quantity = Load_Quantity;
+    uint32_t Address = 0;
+    uint32_t Byte = 0;
+    uint8_t *Payload = NULL;
+
+    while (Draw >= Load_Mixes[Index].Weight) {
+        Draw -= Load_Mixes[Index].Weight;
+        Index++;
+    }
+    Function_Code = Load_Mixes[Index].Function_Code;
+    Unit_ID = (uint8_t) (Load_First_Unit +
+                         (Load_Random(Master) %
+                          (Load_Last_Unit - Load_First_Unit + 1)));
+
+    switch (Function_Code) {
+        case Fun_Code03:
+        case Fun_Code04:
+            Quantity = (Quantity > MAXREADREGQUANTITY) ? MAXREADREGQUANTITY : Quantity;
+            break;
+        case Fun_Code15:
+            Quantity = (Quantity > MAXWRITECOILQUANTITY) ? MAXWRITECOILQUANTITY : Quantity;
+            break;
+        case Fun_Code16:
+            Quantity = (Quantity > MAXWRITEREGQUANTITY) ? MAXWRITEREGQUANTITY : Quantity;
+            break;
+        case Fun_Code23:
+            Quantity = (Quantity > MAXRWWRITEREGQUANTITY) ? MAXRWWRITEREGQUANTITY : Quantity;
+            break;
+        case Fun_Code05:
+        case Fun_Code06:
+        case Fun_Code22:
+            Quantity = 1;
+            break;
+        default:
+            break;
+    }
+
+    switch (Function_Code) {
+        case Fun_Code05:
+            Check_Ok = Frame_Build_Write_Single(
+                           Request, Unit_ID, Function_Code,
+                           (uint16_t) Load_Address(Master, 1),
+                           ((Load_Random(Master) & 1) != 0) ? COIL_ON : COIL_OFF);
+            break;
+        case Fun_Code06:
+            Check_Ok = Frame_Build_Write_Single(
+                           Request, Unit_ID, Function_Code,
+                           (uint16_t) Load_Address(Master, 1),
+                           (uint16_t) Load_Random(Master));
+            break;
+        case Fun_Code15:
+        case Fun_Code16:
+            Check_Ok = Frame_Build_Write_Multiple(
+                           Request, Unit_ID, Function_Code,
+                           (uint16_t) Load_Address(Master, Quantity),
+                           (uint16_t) Quantity);
+            Payload = Frame_Req_Payload(Request);
+            for (Byte = 0; (Check_Ok == TRUE) &&
+                           (Byte < Frame_Req_Byte_Count(Request)); Byte++) {
+                Payload[Byte] = (uint8_t) Load_Random(Master);
+            }
+            break;
+        case Fun_Code22:
+            Check_Ok = Frame_Build_Mask_Write(
+                           Request, Unit_ID, (uint16_t) Load_Address(Master, 1),
+                           (uint16_t) Load_Random(Master),
+                           (uint16_t) Load_Random(Master));
+            break;
+        case Fun_Code23:
+            //!-  Setpoint and Readback: the Range written is read back.
+            Address = Load_Address(Master, Quantity);
+            Check_Ok = Frame_Build_Read_Write(
+                           Request, Unit_ID, (uint16_t) Address,
+                           (uint16_t) Quantity, (uint16_t) Address,
+                           (uint16_t) Quantity);
+            Payload = Frame_RW_Payload(Request);
+            for (Byte = 0; (Check_Ok == TRUE) &&
+                           (Byte < Frame_RW_Byte_Count(Request)); Byte++) {
+                Payload[Byte] = (uint8_t) Load_Random(Master);
+            }
+            break;
+        default:
+            Check_Ok = Frame_Build_Read_Request(
+                           Request, Unit_ID, Function_Code,
+                           (uint16_t) Load_Address(Master, Quantity),
+                           (uint16_t) Quantity);
+            break;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Load_Response() completes a Request. Its Latency counts from
+ *!-  when it was due, not when it was sent: a Slave that falls
+ *!-  behind the Rate is charged for the Requests it held up.
+ *!-  Requests due during the Warm-up are not recorded.
+ */
+void Load_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    Load_Request *const Pending = Context;
+    Load_Master *const Master = Pending->Master;
+
+    Master->Free[Master->Free_Count] = Pending;
+    Master->Free_Count++;
+    if ((Pending->Start_ns >= Load_Measure_ns) && (Response == NULL) &&
+        (Status == TARGET_DEVICE_FAILED_TO_RESPOND)) {
+        Master->Timeouts++;
+    }
+    else if (Pending->Start_ns >= Load_Measure_ns) {
+        if (Status != MODBUS_NO_EXCEPTION) {
+            Master->Exceptions++;
+        }
+        Master->Completed++;
+        Modbus_Histogram_Record(&Master->Latency,
+                                Modbus_Now_ns() - Pending->Start_ns);
+    }
+}
+
+/*
+ *!-  Load_Submit() sends one Request if the Window and, with a
+ *!-  Rate set, the Schedule allow. Returns FALSE if none went.
+ */
+Bool Load_Submit(
+        Load_Master *const Master) {
+
+    Bool Check_Ok = FALSE;
+    uint64_t const Now_ns = Modbus_Now_ns();
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Load_Request *Pending = NULL;
+    Modbus_Frame Request;
+
+    if ((Master->Free_Count != 0) && (Now_ns < Load_End_ns) &&
+        ((Load_Interval_ns == 0) || (Now_ns >= Master->Next_ns))) {
+        Frame_Attach(&Request, Buffer, 0);
+        Check_Ok = Load_Build(Master, &Request);
+        if (Check_Ok == FALSE) {
+            Master->Failed = TRUE;
+        }
+    }
+    if (Check_Ok == TRUE) {
+        Master->Free_Count--;
+        Pending = Master->Free[Master->Free_Count];
+        Pending->Start_ns = (Load_Interval_ns != 0) ? Master->Next_ns : Now_ns;
+        if (Master->Line != NULL) {
+            Check_Ok = Modbus_RTU_Client_Submit(&Master->RTU, &Request,
+                                                Load_Response, Pending);
+        }
+        else {
+            Check_Ok = Modbus_TCP_Client_Submit(&Master->TCP, &Request,
+                                                Load_Response, Pending);
+        }
+        if (Check_Ok == TRUE) {
+            Master->Submitted++;
+            Master->Next_ns += Load_Interval_ns;
+        }
+        else {
+            Master->Free_Count++;
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Load_Poll() runs the Transport of a Master for up to "TimeoutMs".
+int Load_Poll(
+        Load_Master *const Master,
+        int const TimeoutMs) {
+
+    int Result = 0;
+
+    if (Master->Line != NULL) {
+        Result = Modbus_RTU_Client_Poll(&Master->RTU, TimeoutMs);
+    }
+    else {
+        Result = Modbus_TCP_Client_Poll(&Master->TCP, TimeoutMs);
+    }
+    return Result;
+}
+
+/*
+ *!-  Load_Run() is the Thread of a Master: it keeps the Window
+ *!-  full (closed Loop) or, with a Rate set, sends on Schedule
+ *!-  as far as the Window allows, until the Test ends, then
+ *!-  waits for the Requests in Flight.
+ */
+void *Load_Run(
+        void *const Argument) {
+
+    Load_Master *const Master = Argument;
+    Bool Check_Ok = FALSE;
+    uint64_t Now_ns = 0;
+    uint64_t Wait_ns = 0;
+    uint16_t const Window = (Master->Line != NULL) ? 1 : Load_Window;
+    int TimeoutMs = 0;
+    struct timespec Due;
+
+    if (Master->Line != NULL) {
+        Check_Ok = Modbus_RTU_Client_Open(&Master->RTU, Master->Line);
+    }
+    else {
+        Check_Ok = Modbus_TCP_Client_Connect(&Master->TCP, Load_Host,
+                                             Load_Port, Window);
+    }
+    Master->Failed = (Bool) (Check_Ok == FALSE);
+
+    //!-  Masters with a Rate start staggered across one Interval.
+    Master->Next_ns = Load_Start_ns +
+                      (Load_Interval_ns * Master->Number) / Load_Masters;
+    while ((Master->Failed == FALSE) &&
+           ((Modbus_Now_ns() < Load_End_ns) || (Master->Free_Count < Window))) {
+        while (Load_Submit(Master) == TRUE) {
+        }
+        Now_ns = Modbus_Now_ns();
+        TimeoutMs = LOAD_POLL_MS;
+        Wait_ns = 0;
+        if ((Load_Interval_ns != 0) && (Master->Free_Count != 0) &&
+            (Now_ns < Load_End_ns)) {
+            Wait_ns = (Master->Next_ns > Now_ns) ? (Master->Next_ns - Now_ns) : 0;
+            TimeoutMs = (int) (Wait_ns / NS_PER_MS);
+        }
+        if ((TimeoutMs == 0) && (Master->Free_Count == Window) &&
+            (Wait_ns != 0)) {
+            Due.tv_sec = (time_t) (Master->Next_ns / NS_PER_S);
+            Due.tv_nsec = (long) (Master->Next_ns % NS_PER_S);
+            (void) clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Due, NULL);
+        }
+        /*
+         *!-  Nothing in Flight before the End means the Transport
+         *!-  refused the Request, e.g. its Send Buffer is full:
+         *!-  Polling lets it drain (or report the Connection lost)
+         *!-  instead of spinning on Load_Submit().
+         */
+        else if ((Master->Free_Count < Window) || (Now_ns < Load_End_ns)) {
+            if (Load_Poll(Master, TimeoutMs) < 0) {
+                Master->Failed = TRUE;
+            }
+        }
+    }
+
+    if ((Check_Ok == TRUE) && (Master->Line != NULL)) {
+        Modbus_RTU_Client_Close(&Master->RTU);
+    }
+    else if (Check_Ok == TRUE) {
+        Modbus_TCP_Client_Close(&Master->TCP);
+    }
+    return NULL;
+}
+
+//!-  Load_Report() merges the Masters' Results and prints them.
+void Load_Report(
+        uint64_t const Measured_ns) {
+
+    static const double Percentiles[] = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+    static const char *const Labels[] = { "p50", "p90", "p99", "p99.9", "p99.99" };
+    Load_Master *Master = NULL;
+    uint64_t Completed = 0;
+    uint64_t Exceptions = 0;
+    uint64_t Timeouts = 0;
+    uint32_t Failed = 0;
+    uint32_t Index = 0;
+
+    Modbus_Histogram_Reset(&Load_Latency);
+    for (Index = 0; Index < Load_Masters; Index++) {
+        Master = &Load_Master_Pool[Index];
+        Modbus_Histogram_Merge(&Load_Latency, &Master->Latency);
+        Completed += Master->Completed;
+        Exceptions += Master->Exceptions;
+        Timeouts += Master->Timeouts;
+        Failed += (Master->Failed == TRUE) ? 1 : 0;
+    }
+
+    printf("%llu responses in %.3f s: %.1f req/s, %llu exceptions, "
+           "%llu timeouts, %u masters failed\n",
+           (unsigned long long) Completed, (double) Measured_ns / NS_PER_S,
+           (double) Completed * NS_PER_S / (double) Measured_ns,
+           (unsigned long long) Exceptions, (unsigned long long) Timeouts,
+           Failed);
+    printf("latency (us):");
+    for (Index = 0; Index < (sizeof(Percentiles) / sizeof(Percentiles[0])); Index++) {
+        printf(" %s %.1f", Labels[Index],
+               (double) Modbus_Histogram_Percentile(&Load_Latency,
+                                                    Percentiles[Index]) / NS_PER_US);
+    }
+    printf(" max %.1f\n\n", (double) Load_Latency.Max / NS_PER_US);
+    Modbus_Histogram_Print(&Load_Latency, stdout, (double) NS_PER_US, LOAD_TICKS);
+}
+
+/*
+ *!-  Usage: Modbus_Load [options] [host[:port] | line ...]
+ *!-  Simulates Masters against a Modbus TCP Slave (default
+ *!-  127.0.0.1:502) or, given Serial Lines "Path[,Baud[,Format]]"
+ *!-  (e.g. the pty of "Modbus_Slave pty,115200 5"), one Master per
+ *!-  Line. Prints Throughput and the Latency Distribution.
+ *!-  -c masters   TCP Connections (4)
+ *!-  -w window    Requests in Flight per Connection (1)
+ *!-  -r rate      Total Requests/s; 0: as fast as answered (0)
+ *!-  -d seconds   Measured Duration (10)
+ *!-  -W seconds   Warm-up before it (1)
+ *!-  -m mix       Function Codes and Weights, "fc:w,..." ("3:1")
+ *!-  -a pattern   Addresses: uniform, seq or zipf (uniform)
+ *!-  -R range     Address Range "first-last" (0-999)
+ *!-  -q quantity  Items per FC01..04/15/16/23 Request (10)
+ *!-  -u units     Unit IDs "first[-last]" (2)
+ */
+int main(int argc, char *argv[]) {
+
+    Bool Ckeck_OK = TRUE;
+    const char *Mix = LOAD_DEFAULT_MIX;
+    const char *Range = LOAD_DEFAULT_RANGE;
+    const char *Units = LOAD_DEFAULT_UNITS;
+    uint64_t Seconds_ns = LOAD_DEFAULT_SECONDS * NS_PER_S;
+    uint64_t Warmup_ns = NS_PER_S;
+    char **Lines = NULL;
+    char *Colon = NULL;
+    uint32_t Index = 0;
+    uint32_t Slot = 0;
+    Load_Master *Master = NULL;
+    int Option = 0;
+
+    while ((Option = getopt(argc, argv, "c:w:r:d:W:m:a:R:q:u:")) != -1) {
+        switch (Option) {
+            case 'c': Load_Masters = (uint32_t) atoi(optarg); break;
+            case 'w': Load_Window = (uint16_t) atoi(optarg); break;
+            case 'r': Load_Rate = atof(optarg); break;
+            case 'd': Seconds_ns = (uint64_t) (atof(optarg) * NS_PER_S); break;
+            case 'W': Warmup_ns = (uint64_t) (atof(optarg) * NS_PER_S); break;
+            case 'm': Mix = optarg; break;
+            case 'R': Range = optarg; break;
+            case 'q': Load_Quantity = (uint32_t) atoi(optarg); break;
+            case 'u': Units = optarg; break;
+            case 'a':
+                Ckeck_OK = FALSE;
+                for (Index = LOAD_UNIFORM; Index <= LOAD_ZIPF; Index++) {
+                    if (strcmp(optarg, Load_Pattern_Names[Index]) == 0) {
+                        Load_Addressing = (Load_Pattern) Index;
+                        Ckeck_OK = TRUE;
+                    }
+                }
+                break;
+            default: Ckeck_OK = FALSE; break;
+        }
+    }
+    if ((optind < argc) && (argv[optind][0] == '/')) {
+        Lines = &argv[optind];
+        Load_Masters = (uint32_t) (argc - optind);
+    }
+    else if (optind < argc) {
+        Load_Host = argv[optind];
+        Colon = strchr(argv[optind], ':');
+        if (Colon != NULL) {
+            *Colon = '\0';
+            Load_Port = (uint16_t) atoi(Colon + 1);
+        }
+    }
+
+    Ckeck_OK = (Bool) ((Ckeck_OK == TRUE) && (Load_Parse_Mix(Mix) == TRUE) &&
+                       (Load_Parse_Range(Range, MAX_UNIT_ITEMS - 1,
+                                         &Load_First_Address,
+                                         &Load_Last_Address) == TRUE) &&
+                       (Load_Parse_Range(Units, MAX_DEVICE_ID, &Load_First_Unit,
+                                         &Load_Last_Unit) == TRUE) &&
+                       (Load_Masters > 0) && (Load_Masters <= LOAD_MAX_MASTERS) &&
+                       (Load_Window > 0) && (Load_Window <= TCP_CLIENT_MAX_WINDOW) &&
+                       (Load_Quantity > 0) && (Seconds_ns > 0));
+    if ((Ckeck_OK == TRUE) && (Load_Addressing == LOAD_ZIPF)) {
+        Ckeck_OK = Load_Init_Zipf();
+    }
+    if (Ckeck_OK == FALSE) {
+        fprintf(stderr, "Modbus_Load: bad arguments, see the Usage in "
+                        "Modbus_Load.c\n");
+        return EXIT_FAILURE;
+    }
+
+    Load_Master_Pool = calloc(Load_Masters, sizeof(Load_Master));
+    if (Load_Master_Pool == NULL) {
+        perror("Modbus_Load");
+        return EXIT_FAILURE;
+    }
+    if (Load_Rate > 0.0) {
+        Load_Interval_ns = (uint64_t) ((double) NS_PER_S * Load_Masters / Load_Rate);
+    }
+    printf("%u masters on %s%s%s, window %u, %s, mix %s, %s addresses %s, "
+           "quantity %u, units %s\n",
+           Load_Masters, (Lines != NULL) ? "serial lines" : Load_Host,
+           (Lines != NULL) ? "" : ":",
+           (Lines != NULL) ? "" : (Colon != NULL) ? Colon + 1 : "502",
+           (Lines != NULL) ? 1 : Load_Window,
+           (Load_Rate > 0.0) ? "rate-limited" : "closed loop", Mix,
+           Load_Pattern_Names[Load_Addressing], Range, Load_Quantity, Units);
+    fflush(stdout);
+
+    Load_Start_ns = Modbus_Now_ns();
+    Load_Measure_ns = Load_Start_ns + Warmup_ns;
+    Load_End_ns = Load_Measure_ns + Seconds_ns;
+    for (Index = 0; Index < Load_Masters; Index++) {
+        Master = &Load_Master_Pool[Index];
+        Master->Number = Index;
+        Master->Line = (Lines != NULL) ? Lines[Index] : NULL;
+        Master->Random = 0x9E3779B97F4A7C15ULL * (Index + 1);
+        Modbus_Histogram_Reset(&Master->Latency);
+        for (Slot = 0; Slot < TCP_CLIENT_MAX_WINDOW; Slot++) {
+            Master->Requests[Slot].Master = Master;
+            Master->Free[Slot] = &Master->Requests[Slot];
+        }
+        Master->Free_Count = (Lines != NULL) ? 1 : Load_Window;
+        if (pthread_create(&Master->Thread, NULL, Load_Run, Master) != 0) {
+            Master->Failed = TRUE;
+            Master->Thread = 0;
+        }
+    }
+    for (Index = 0; Index < Load_Masters; Index++) {
+        if (Load_Master_Pool[Index].Thread != 0) {
+            pthread_join(Load_Master_Pool[Index].Thread, NULL);
+        }
+    }
+
+    Load_Report(Seconds_ns);
+    Ckeck_OK = TRUE;
+    for (Index = 0; Index < Load_Masters; Index++) {
+        if ((Load_Master_Pool[Index].Failed == TRUE) ||
+            (Load_Master_Pool[Index].Timeouts != 0)) {
+            Ckeck_OK = FALSE;
+        }
+    }
+    free(Load_Master_Pool);
+    free(Load_Zipf);
+    return (Ckeck_OK == TRUE) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -10,7 +10,14 @@
  ****************************************************************************/
 
 //!-  Headers
+#include <stdio.h>
+#include <stdlib.h>
 #include "Modbus.h"
+#include "Modbus_Clock.h"
+#include "Modbus_File.h"
+#include "Modbus_Frame.h"
+#include "Modbus_RTU.h"
+#include "Modbus_TCP.h"
 
 /****************************************************************************
 !-  LOCAL DEFINITIONS
@@ -20,18 +27,225 @@
 #define FCODE_03 03
 #define SUBFCODE_0 00
 
+#define DEFAULT_HOST      "127.0.0.1"
+#define DEFAULT_WINDOW    (16)
+#define DEFAULT_REQUESTS  (100000)
+
+void Master_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+void Master_Print_Gap(
+        const char *const Name,
+        const Modbus_RTU_Gap *const Gap);
+
+int Master_Download(
+        uint16_t const Number);
+
+int Master_RTU(
+        const char *const Spec,
+        const Modbus_Frame *const Request,
+        uint64_t const Requests);
+
 /****************************************************************************
 !-  LOCAL VARIABLES
 *****************************************************************************/
 
+static Modbus_TCP_Client Client;
+static Modbus_RTU_Client RTU_Client;
+static uint64_t Exceptions;
+static uint8_t File_Records[FILE_MAX_RECORDS * 2];
+
 /****************************************************************************
 !-  LOCAL FUNCTIONS
 *****************************************************************************/
 
-int main() {
+//!-  Master_Response() counts Exception Responses.
+void Master_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
 
-    Bool Ckeck_OK = FALSE;
+    (void) Context;
+    (void) Response;
+    if ((Status != MODBUS_NO_EXCEPTION) &&
+        (Status != TARGET_DEVICE_FAILED_TO_RESPOND)) {
+        Exceptions++;
+    }
+}
+
+//!-  Master_Print_Gap() prints the Turnaround Gaps of the Line.
+void Master_Print_Gap(
+        const char *const Name,
+        const Modbus_RTU_Gap *const Gap) {
 
-    return Ckeck_OK;
+    uint64_t const Count = (Gap->Count != 0) ? Gap->Count : 1;
+
+    printf("%-10s %8llu gaps  min %8.1f us  avg %8.1f us  max %8.1f us\n",
+           Name, (unsigned long long) Gap->Count,
+           (double) Gap->Min_ns / NS_PER_US,
+           (double) Gap->Total_ns / NS_PER_US / (double) Count,
+           (double) Gap->Max_ns / NS_PER_US);
 }
 
+/*
+ *!-  Master_RTU() runs "Requests" back to back on the Serial Line
+ *!-  of "Spec" and prints the Throughput and Turnaround Gaps:
+ *!-  "turnaround" is Response -> next Request (own Pacing, t3.5
+ *!-  at least), "reply" is Request -> Response (the Slave's).
+ */
+int Master_RTU(
+        const char *const Spec,
+        const Modbus_Frame *const Request,
+        uint64_t const Requests) {
+
+    const Modbus_RTU_Port *const Port = &RTU_Client.Port;
+    uint64_t Submitted = 0;
+    uint64_t Start_ns = 0;
+    uint64_t Elapsed_ns = 0;
+
+    if (Modbus_RTU_Client_Open(&RTU_Client, Spec) == FALSE) {
+        perror("Modbus_Master");
+        return EXIT_FAILURE;
+    }
+
+    Start_ns = Modbus_Now_ns();
+    while ((RTU_Client.Completed + RTU_Client.Timeouts) < Requests) {
+        if ((Submitted < Requests) &&
+            (Modbus_RTU_Client_Submit(&RTU_Client, Request,
+                                      Master_Response, NULL) == TRUE)) {
+            Submitted++;
+        }
+        if (Modbus_RTU_Client_Poll(&RTU_Client, RTU_CLIENT_TIMEOUT_MS) < 0) {
+            break;
+        }
+    }
+    Elapsed_ns = Modbus_Now_ns() - Start_ns;
+
+    printf("%llu responses, %llu exceptions, %llu timeouts in %.3f s "
+           "(%.0f req/s, %u baud, t3.5 %.0f us)\n",
+           (unsigned long long) RTU_Client.Completed,
+           (unsigned long long) Exceptions,
+           (unsigned long long) RTU_Client.Timeouts,
+           (double) Elapsed_ns / NS_PER_S,
+           (double) RTU_Client.Completed * NS_PER_S / (double) (Elapsed_ns + 1),
+           Port->Baud, (double) Port->Parser.T35_ns / NS_PER_US);
+    Master_Print_Gap("turnaround", &Port->Turnaround);
+    Master_Print_Gap("reply", &Port->Reply);
+    printf("crc errors %llu, gap errors %llu, noise bytes %llu\n",
+           (unsigned long long) Port->Parser.Stats.CRC_Errors,
+           (unsigned long long) Port->Parser.Stats.Gap_Errors,
+           (unsigned long long) Port->Parser.Stats.Noise_Bytes);
+
+    Modbus_RTU_Client_Close(&RTU_Client);
+    return (RTU_Client.Completed == Requests) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+ *!-  Master_Download() reads all Records of a File from the Default
+ *!-  Unit, "Window" FC20 Requests in Flight, and prints the Rate.
+ */
+int Master_Download(
+        uint16_t const Number) {
+
+    uint8_t Status = MODBUS_NO_EXCEPTION;
+    uint64_t const Start_ns = Modbus_Now_ns();
+    Bool const Check_Ok = Modbus_File_Download(&Client, SLAVE_ID_1, Number,
+                                               FILE_MAX_RECORDS,
+                                               File_Records, &Status);
+    uint64_t const Elapsed_ns = Modbus_Now_ns() - Start_ns;
+
+    if (Check_Ok == TRUE) {
+        printf("file %u: %u records in %.3f s (%.0f records/s, window %u)\n",
+               Number, FILE_MAX_RECORDS, (double) Elapsed_ns / NS_PER_S,
+               (double) FILE_MAX_RECORDS * NS_PER_S /
+               (double) (Elapsed_ns + 1), Client.Window);
+    }
+    else {
+        fprintf(stderr, "Modbus_Master: file %u failed, status %u\n",
+                Number, Status);
+    }
+    Modbus_TCP_Client_Close(&Client);
+    return (Check_Ok == TRUE) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+ *!-  Usage: Modbus_Master [Host] [Port] [Window] [Requests] [File]
+ *!-         Modbus_Master Device[,Baud[,Format]] [Requests]
+ *!-  Keeps "Window" FC03 Reads in Flight and prints the Throughput.
+ *!-  A Device Path (e.g. /dev/ttyUSB0,19200,8E1 or a pty) runs
+ *!-  the Reads over Modbus RTU instead, see Master_RTU(). With a
+ *!-  "File" Number it downloads that File instead, see
+ *!-  Master_Download().
+ */
+int main(int argc, char *argv[]) {
+
+    Bool Ckeck_OK = FALSE;
+    const char *Host = DEFAULT_HOST;
+    uint16_t Port = MODBUS_TCP_PORT;
+    uint16_t Window = DEFAULT_WINDOW;
+    uint64_t Requests = DEFAULT_REQUESTS;
+    uint64_t Submitted = 0;
+    uint64_t Start_ns = 0;
+    uint64_t Elapsed_ns = 0;
+    uint8_t Buffer[MODBUS_MAX_PDU_LENGTH + 1];
+    Modbus_Frame Request;
+
+    if (argc > 1) {
+        Host = argv[1];
+    }
+    if (argc > 2) {
+        Port = (uint16_t) atoi(argv[2]);
+    }
+    if (argc > 3) {
+        Window = (uint16_t) atoi(argv[3]);
+    }
+    if (argc > 4) {
+        Requests = strtoull(argv[4], NULL, 10);
+    }
+
+    Frame_Attach(&Request, Buffer, 0);
+    Ckeck_OK = Modbus_Request(&Request, SLAVE_ID_1, FCODE_03, SUBFCODE_0, 1);
+    if ((Ckeck_OK == TRUE) && (Host[0] == '/')) {
+        if (argc > 2) {
+            Requests = strtoull(argv[2], NULL, 10);
+        }
+        return Master_RTU(Host, &Request, Requests);
+    }
+    if (Ckeck_OK == TRUE) {
+        Ckeck_OK = Modbus_TCP_Client_Connect(&Client, Host, Port, Window);
+    }
+    if (Ckeck_OK == FALSE) {
+        perror("Modbus_Master");
+        return EXIT_FAILURE;
+    }
+    if (argc > 5) {
+        return Master_Download((uint16_t) atoi(argv[5]));
+    }
+
+    Start_ns = Modbus_Now_ns();
+    while ((Client.Completed + Client.Timeouts) < Requests) {
+        while ((Submitted < Requests) &&
+               (Modbus_TCP_Client_Submit(&Client, &Request,
+                                         Master_Response, NULL) == TRUE)) {
+            Submitted++;
+        }
+        if (Modbus_TCP_Client_Poll(&Client, TCP_CLIENT_TIMEOUT_MS) < 0) {
+            break;
+        }
+    }
+    Elapsed_ns = Modbus_Now_ns() - Start_ns;
+
+    printf("%llu responses, %llu exceptions, %llu timeouts in %.3f s "
+           "(%.0f req/s, window %u)\n",
+           (unsigned long long) Client.Completed,
+           (unsigned long long) Exceptions,
+           (unsigned long long) Client.Timeouts,
+           (double) Elapsed_ns / NS_PER_S,
+           (double) Client.Completed * NS_PER_S / (double) (Elapsed_ns + 1),
+           Client.Window);
+
+    Modbus_TCP_Client_Close(&Client);
+    return (Client.Completed == Requests) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
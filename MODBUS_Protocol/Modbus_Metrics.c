@@ -0,0 +1,336 @@
+/*
+ * Modbus_Metrics.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Metrics.c
+*****************************************************************************/
+
+//!-  Headers
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Modbus_Clock.h"
+#include "Modbus_Metrics.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define METRICS_WORDS  (sizeof(Modbus_Metrics) / sizeof(uint64_t))
+
+//!-  Attempts of a Reader before it gives up on a busy Writer.
+#define METRICS_READ_RETRIES  (1000)
+
+/*
+ *!-  "Metrics_Header" starts the exported File; the Metrics follow
+ *!-  on the next Cache Line.
+ *!-  Sequence:
+ *!-  Odd while Modbus_Metrics_Publish() writes.
+ *!-  Published_ns:
+ *!-  Monotonic Clock of the last Publish.
+ */
+typedef struct {
+    uint32_t  Magic;
+    uint32_t  Version;
+    uint32_t  Sequence;
+    uint32_t  Bytes;
+    uint64_t  Published_ns;
+} __attribute__((aligned(MODBUS_CACHE_LINE))) Metrics_Header;
+
+#define METRICS_EXPORT_BYTES  (sizeof(Metrics_Header) + sizeof(Modbus_Metrics))
+
+void Metrics_Copy(
+        uint64_t *const Into,
+        const uint64_t *const From);
+
+void Metrics_Sum(
+        uint64_t *const Into,
+        const uint64_t *const From);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Metrics  Metrics_Slots[METRICS_MAX_SLOTS];
+static uint32_t        Metrics_Claimed;
+
+__thread Modbus_Metrics *Modbus_Metrics_Local;
+
+static const char *const Metrics_Stage_Names[METRICS_STAGES] = {
+    "parse", "dispatch", "encode",
+};
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Metrics_Copy() copies Metrics another Thread may be writing.
+void Metrics_Copy(
+        uint64_t *const Into,
+        const uint64_t *const From) {
+
+    uint32_t Word = 0;
+
+    for (Word = 0; Word < METRICS_WORDS; Word++) {
+        Into[Word] = __atomic_load_n(&From[Word], __ATOMIC_RELAXED);
+    }
+}
+
+//!-  Metrics_Sum() adds Metrics another Thread may be writing.
+void Metrics_Sum(
+        uint64_t *const Into,
+        const uint64_t *const From) {
+
+    uint32_t Word = 0;
+
+    for (Word = 0; Word < METRICS_WORDS; Word++) {
+        Into[Word] += __atomic_load_n(&From[Word], __ATOMIC_RELAXED);
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_Metrics_Claim() gives the Calling Thread a Slot of its
+ *!-  own. Slots are not given back: a Thread's Counts outlive it.
+ */
+Modbus_Metrics *Modbus_Metrics_Claim(
+        void) {
+
+    uint32_t Index = __atomic_fetch_add(&Metrics_Claimed, 1, __ATOMIC_RELAXED);
+
+    if (Index >= METRICS_MAX_SLOTS) {
+        Index = METRICS_MAX_SLOTS - 1;
+    }
+    Modbus_Metrics_Local = &Metrics_Slots[Index];
+    return Modbus_Metrics_Local;
+}
+
+/*
+ *!-  Modbus_Metrics_Snapshot() sums the Slots of all Threads. Each
+ *!-  Counter is read whole, but Counters are read one after the
+ *!-  other while the Threads go on counting.
+ */
+void Modbus_Metrics_Snapshot(
+        Modbus_Metrics *const Snapshot) {
+
+    uint32_t Slots = __atomic_load_n(&Metrics_Claimed, __ATOMIC_RELAXED);
+    uint32_t Index = 0;
+
+    if (Slots > METRICS_MAX_SLOTS) {
+        Slots = METRICS_MAX_SLOTS;
+    }
+    memset(Snapshot, 0, sizeof(*Snapshot));
+    for (Index = 0; Index < Slots; Index++) {
+        Metrics_Sum((uint64_t *) Snapshot,
+                    (const uint64_t *) &Metrics_Slots[Index]);
+    }
+}
+
+/*
+ *!-  Modbus_Metrics_Percentile() gives the Value "Percentile"
+ *!-  (0 .. 100) of a Stage's Latencies are below: the Top of its
+ *!-  Bucket, so within a Factor of 2. 0 if nothing was recorded.
+ */
+uint64_t Modbus_Metrics_Percentile(
+        const Modbus_Metrics_Latency *const Latency,
+        double const Percentile) {
+
+    uint64_t const Target = (uint64_t) ceil((Percentile / 100.0) *
+                                            (double) Latency->Count);
+    uint64_t Seen = Latency->Buckets[0];
+    uint32_t Bucket = 0;
+
+    //!-  The first Bucket that reaches the Target, and holds something.
+    while ((Bucket < (METRICS_LATENCY_BUCKETS - 1)) &&
+           ((Seen < Target) || (Seen == 0))) {
+        Bucket++;
+        Seen += Latency->Buckets[Bucket];
+    }
+    return ((Latency->Count == 0) || (Bucket == 0)) ?
+           0 : ((1ULL << Bucket) - 1);
+}
+
+//!-  Modbus_Metrics_Print() writes Metrics for a Human to read.
+void Modbus_Metrics_Print(
+        const Modbus_Metrics *const Metrics,
+        FILE *const Out) {
+
+    const Modbus_Metrics_Latency *Latency = NULL;
+    uint32_t Index = 0;
+
+    fprintf(Out, "requests:");
+    for (Index = 0; Index < METRICS_FUNCTION_CODES; Index++) {
+        if (Metrics->Requests[Index] != 0) {
+            fprintf(Out, " fc%02u=%llu", Index,
+                    (unsigned long long) Metrics->Requests[Index]);
+        }
+    }
+    fprintf(Out, "\nexceptions:");
+    for (Index = 0; Index < METRICS_EXCEPTION_CODES; Index++) {
+        if (Metrics->Exceptions[Index] != 0) {
+            fprintf(Out, " %02X=%llu", Index,
+                    (unsigned long long) Metrics->Exceptions[Index]);
+        }
+    }
+    fprintf(Out, "\ncrc errors %llu, frame errors %llu\n",
+            (unsigned long long) Metrics->CRC_Errors,
+            (unsigned long long) Metrics->Frame_Errors);
+    for (Index = 0; Index < METRICS_STAGES; Index++) {
+        Latency = &Metrics->Latency[Index];
+        fprintf(Out, "%-8s %12llu x, mean %8.1f ns, p50 < %llu ns, "
+                     "p99 < %llu ns, p99.9 < %llu ns\n",
+                Metrics_Stage_Names[Index], (unsigned long long) Latency->Count,
+                (Latency->Count == 0) ? 0.0 :
+                (double) Latency->Total_ns / (double) Latency->Count,
+                (unsigned long long) Modbus_Metrics_Percentile(Latency, 50.0) + 1,
+                (unsigned long long) Modbus_Metrics_Percentile(Latency, 99.0) + 1,
+                (unsigned long long) Modbus_Metrics_Percentile(Latency, 99.9) + 1);
+    }
+}
+
+/*
+ *!-  Modbus_Metrics_Export_Open() creates (or takes over) the
+ *!-  Metrics File at "Path" and maps it for Publishing.
+ */
+Bool Modbus_Metrics_Export_Open(
+        Modbus_Metrics_Export *const Export,
+        const char *const Path) {
+
+    Bool Check_Ok = FALSE;
+    Metrics_Header *Header = NULL;
+
+    Export->Base = NULL;
+    Export->Fd = open(Path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (Export->Fd >= 0) {
+        Check_Ok = (Bool) (ftruncate(Export->Fd,
+                                     (off_t) METRICS_EXPORT_BYTES) == 0);
+    }
+    if (Check_Ok == TRUE) {
+        Export->Base = mmap(NULL, METRICS_EXPORT_BYTES, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, Export->Fd, 0);
+        if (Export->Base == MAP_FAILED) {
+            Export->Base = NULL;
+            Check_Ok = FALSE;
+        }
+    }
+    if (Check_Ok == TRUE) {
+        Header = (Metrics_Header *) Export->Base;
+        __atomic_store_n(&Header->Magic, 0, __ATOMIC_RELAXED);
+        Header->Version = METRICS_EXPORT_VERSION;
+        Header->Bytes = (uint32_t) sizeof(Modbus_Metrics);
+        Header->Sequence = 0;
+        Modbus_Metrics_Publish(Export);
+        __atomic_store_n(&Header->Magic, METRICS_EXPORT_MAGIC, __ATOMIC_RELEASE);
+    }
+    else {
+        Modbus_Metrics_Export_Close(Export);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Metrics_Publish() copies a Snapshot into the Export.
+ *!-  Call it from one Thread, e.g. the Server's Poll Loop; its
+ *!-  Cost is a Pass over all Slots, none on the Hot Path.
+ */
+void Modbus_Metrics_Publish(
+        Modbus_Metrics_Export *const Export) {
+
+    Metrics_Header *const Header = (Metrics_Header *) Export->Base;
+    uint64_t *const Words = (uint64_t *) &Export->Base[sizeof(Metrics_Header)];
+    uint32_t const Sequence = Header->Sequence;
+    uint32_t Word = 0;
+    Modbus_Metrics Snapshot;
+
+    Modbus_Metrics_Snapshot(&Snapshot);
+    __atomic_store_n(&Header->Sequence, Sequence + 1, __ATOMIC_RELAXED);
+    //!-  The odd Sequence is visible before any Counter changes.
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (Word = 0; Word < METRICS_WORDS; Word++) {
+        __atomic_store_n(&Words[Word], ((const uint64_t *) &Snapshot)[Word],
+                         __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&Header->Published_ns, Modbus_Now_ns(), __ATOMIC_RELAXED);
+    __atomic_store_n(&Header->Sequence, Sequence + 2, __ATOMIC_RELEASE);
+}
+
+/*
+ *!-  Modbus_Metrics_Export_Read() reads the last Snapshot published
+ *!-  at "Path" by another Process, and when it was published.
+ *!-  Returns FALSE if there is no Export of this Version there.
+ */
+Bool Modbus_Metrics_Export_Read(
+        const char *const Path,
+        Modbus_Metrics *const Snapshot,
+        uint64_t *const Published_ns) {
+
+    Bool Check_Ok = FALSE;
+    Bool Valid = FALSE;
+    int Fd = -1;
+    uint8_t *Base = MAP_FAILED;
+    const Metrics_Header *Header = NULL;
+    uint32_t Sequence = 0;
+    uint32_t Attempt = 0;
+    struct stat Status;
+
+    Fd = open(Path, O_RDONLY | O_CLOEXEC);
+    //!-  A File shorter than an Export would fault once mapped.
+    if ((Fd >= 0) && (fstat(Fd, &Status) == 0) &&
+        ((uint64_t) Status.st_size >= METRICS_EXPORT_BYTES)) {
+        Base = mmap(NULL, METRICS_EXPORT_BYTES, PROT_READ, MAP_SHARED, Fd, 0);
+    }
+    if (Fd >= 0) {
+        (void) close(Fd);
+    }
+    if (Base != MAP_FAILED) {
+        Header = (const Metrics_Header *) Base;
+        Valid = (Bool) ((__atomic_load_n(&Header->Magic, __ATOMIC_ACQUIRE) ==
+                         METRICS_EXPORT_MAGIC) &&
+                        (Header->Version == METRICS_EXPORT_VERSION) &&
+                        (Header->Bytes == sizeof(Modbus_Metrics)));
+    }
+    for (Attempt = 0; (Valid == TRUE) && (Check_Ok == FALSE) &&
+                      (Attempt < METRICS_READ_RETRIES); Attempt++) {
+        Sequence = __atomic_load_n(&Header->Sequence, __ATOMIC_ACQUIRE);
+        if ((Sequence & 1U) != 0) {
+            MODBUS_CPU_PAUSE();
+        }
+        else {
+            Metrics_Copy((uint64_t *) Snapshot,
+                         (const uint64_t *) &Base[sizeof(Metrics_Header)]);
+            *Published_ns = __atomic_load_n(&Header->Published_ns,
+                                            __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            Check_Ok = (Bool) (__atomic_load_n(&Header->Sequence,
+                                               __ATOMIC_RELAXED) == Sequence);
+        }
+    }
+    if (Base != MAP_FAILED) {
+        (void) munmap(Base, METRICS_EXPORT_BYTES);
+    }
+    return Check_Ok;
+}
+
+//!-  Modbus_Metrics_Export_Close() unmaps the Export; the File stays.
+void Modbus_Metrics_Export_Close(
+        Modbus_Metrics_Export *const Export) {
+
+    if (Export->Base != NULL) {
+        (void) munmap(Export->Base, METRICS_EXPORT_BYTES);
+        Export->Base = NULL;
+    }
+    if (Export->Fd >= 0) {
+        (void) close(Export->Fd);
+        Export->Fd = -1;
+    }
+}
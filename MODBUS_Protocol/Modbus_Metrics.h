@@ -0,0 +1,190 @@
+/*
+ * Modbus_Metrics.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Metrics.h
+*****************************************************************************/
+
+#ifndef __MODBUS_METRICS_H_
+#define __MODBUS_METRICS_H_
+
+//!-  Headers
+#include <stdio.h>
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  Runtime Metrics are always on. Every Thread that serves
+ *!-  Requests counts into its own Slot, a Cache-Line aligned Block
+ *!-  no other Thread writes, so the Hot Path takes no Lock and no
+ *!-  Read-Modify-Write: a Counter is loaded, incremented and stored
+ *!-  (relaxed Atomics, plain Instructions on every 64-bit Target).
+ *!-  Counters only grow; Readers sum the Slots and take the
+ *!-  Difference of two Snapshots for Rates. Threads beyond
+ *!-  METRICS_MAX_SLOTS share the last Slot, where concurrent
+ *!-  Counts may be lost.
+ */
+#define METRICS_MAX_SLOTS        (64)
+#define METRICS_FUNCTION_CODES   (128)
+#define METRICS_EXCEPTION_CODES  (16)
+
+//!-  Latency Buckets: Bucket "n" holds [2^(n-1), 2^n) ns, 0 holds 0.
+#define METRICS_LATENCY_BUCKETS  (40)
+
+/*
+ *!-  The exported Metrics File, "MBMX", is refused by Readers of
+ *!-  another METRICS_EXPORT_VERSION, which changes with the Layout.
+ */
+#define METRICS_EXPORT_MAGIC     (0x584D424DUL)   //!-  "MBMX"
+#define METRICS_EXPORT_VERSION   (1)
+
+/*
+ *!-  "Modbus_Metrics_Stage" is a Step of serving a Request.
+ *!-  METRICS_PARSE:    Framing of a complete ADU (MBAP Header or
+ *!-                    RTU Frame) up to a Request ready to serve.
+ *!-  METRICS_DISPATCH: Validation, Handler and Exception Building.
+ *!-  METRICS_ENCODE:   Framing the Response (MBAP Header or CRC).
+ */
+typedef enum {
+    METRICS_PARSE    = 0,
+    METRICS_DISPATCH = 1,
+    METRICS_ENCODE   = 2,
+    METRICS_STAGES   = 3,
+} Modbus_Metrics_Stage;
+
+//!-  "Modbus_Metrics_Latency" is the log2 Histogram of one Stage.
+typedef struct {
+    uint64_t  Count;
+    uint64_t  Total_ns;
+    uint64_t  Buckets[METRICS_LATENCY_BUCKETS];
+} Modbus_Metrics_Latency;
+
+/*
+ *!-  "Modbus_Metrics" are the Counters of a Slot, and of the Sum
+ *!-  a Snapshot gives. Only uint64_t Fields, so it is copied
+ *!-  Word by Word.
+ *!-  Requests:     served, by Function Code (without the MSB).
+ *!-  Exceptions:   answered, by Modbus_Exception_Code.
+ *!-  CRC_Errors:   RTU Frames dropped for a bad CRC.
+ *!-  Frame_Errors: RTU Gaps and Overruns, bad MBAP Headers.
+ */
+typedef struct {
+    uint64_t                Requests[METRICS_FUNCTION_CODES];
+    uint64_t                Exceptions[METRICS_EXCEPTION_CODES];
+    uint64_t                CRC_Errors;
+    uint64_t                Frame_Errors;
+    Modbus_Metrics_Latency  Latency[METRICS_STAGES];
+} __attribute__((aligned(MODBUS_CACHE_LINE))) Modbus_Metrics;
+
+/*
+ *!-  "Modbus_Metrics_Export" is a File (a Path under /dev/shm for
+ *!-  a POSIX shm Segment) where Modbus_Metrics_Publish() copies
+ *!-  Snapshots for other Processes, under a Sequence Lock.
+ */
+typedef struct {
+    int        Fd;
+    uint8_t   *Base;
+} Modbus_Metrics_Export;
+
+//!-  The Calling Thread's Slot, claimed on its first Count.
+extern __thread Modbus_Metrics *Modbus_Metrics_Local;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+Modbus_Metrics *Modbus_Metrics_Claim(
+        void);
+
+void Modbus_Metrics_Snapshot(
+        Modbus_Metrics *const Snapshot);
+
+uint64_t Modbus_Metrics_Percentile(
+        const Modbus_Metrics_Latency *const Latency,
+        double const Percentile);
+
+void Modbus_Metrics_Print(
+        const Modbus_Metrics *const Metrics,
+        FILE *const Out);
+
+Bool Modbus_Metrics_Export_Open(
+        Modbus_Metrics_Export *const Export,
+        const char *const Path);
+
+void Modbus_Metrics_Publish(
+        Modbus_Metrics_Export *const Export);
+
+Bool Modbus_Metrics_Export_Read(
+        const char *const Path,
+        Modbus_Metrics *const Snapshot,
+        uint64_t *const Published_ns);
+
+void Modbus_Metrics_Export_Close(
+        Modbus_Metrics_Export *const Export);
+
+/****************************************************************************
+!-  GLOBAL INLINE FUNCTIONS
+*****************************************************************************/
+
+//!-  Modbus_Metrics_Slot() gives the Calling Thread's Slot.
+static inline Modbus_Metrics *Modbus_Metrics_Slot(
+        void) {
+
+    Modbus_Metrics *Slot = Modbus_Metrics_Local;
+
+    if (__builtin_expect(Slot == NULL, 0)) {
+        Slot = Modbus_Metrics_Claim();
+    }
+    return Slot;
+}
+
+//!-  Modbus_Metrics_Add() adds to a Counter only this Thread writes.
+static inline void Modbus_Metrics_Add(
+        uint64_t *const Counter,
+        uint64_t const Amount) {
+
+    __atomic_store_n(Counter, __atomic_load_n(Counter, __ATOMIC_RELAXED) +
+                              Amount, __ATOMIC_RELAXED);
+}
+
+//!-  Modbus_Metrics_Request() counts a served Request and its Exception.
+static inline void Modbus_Metrics_Request(
+        uint8_t const Function_Code,
+        uint8_t const Exception) {
+
+    Modbus_Metrics *const Slot = Modbus_Metrics_Slot();
+
+    Modbus_Metrics_Add(&Slot->Requests[Function_Code &
+                                       (METRICS_FUNCTION_CODES - 1)], 1);
+    if (Exception != MODBUS_NO_EXCEPTION) {
+        Modbus_Metrics_Add(&Slot->Exceptions[Exception &
+                                             (METRICS_EXCEPTION_CODES - 1)], 1);
+    }
+}
+
+//!-  Modbus_Metrics_Stage_Time() records how long a Stage took.
+static inline void Modbus_Metrics_Stage_Time(
+        Modbus_Metrics_Stage const Stage,
+        uint64_t const Elapsed_ns) {
+
+    Modbus_Metrics_Latency *const Latency =
+            &Modbus_Metrics_Slot()->Latency[Stage];
+    uint32_t Bucket = (Elapsed_ns == 0) ?
+                      0 : (uint32_t) (64 - __builtin_clzll(Elapsed_ns));
+
+    if (Bucket >= METRICS_LATENCY_BUCKETS) {
+        Bucket = METRICS_LATENCY_BUCKETS - 1;
+    }
+    Modbus_Metrics_Add(&Latency->Buckets[Bucket], 1);
+    Modbus_Metrics_Add(&Latency->Count, 1);
+    Modbus_Metrics_Add(&Latency->Total_ns, Elapsed_ns);
+}
+
+#endif /* __MODBUS_METRICS_H_ */
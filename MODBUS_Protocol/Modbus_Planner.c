@@ -0,0 +1,456 @@
+/*
+ * Modbus_Planner.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Planner.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus_Frame.h"
+#include "Modbus_Planner.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  Tags and Breaks are ordered by one Key:
+ *!-  Unit_ID (8 bits) | Table (8 bits) | Address (16 bits).
+ *!-  Two Keys are in the same Table when (Key >> 16) is equal.
+ */
+#define KEY_TABLE_SHIFT  (16)
+
+uint32_t Tag_Key(
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const Address);
+
+uint16_t Tag_Search(
+        const Modbus_Planner *const Planner,
+        uint32_t const Key);
+
+uint16_t Break_Search(
+        const Modbus_Planner *const Planner,
+        uint32_t const Key);
+
+Bool Planner_Learn(
+        Modbus_Planner *const Planner,
+        uint32_t const Key,
+        Planner_Break_Kind const Kind,
+        uint32_t const First,
+        uint32_t const Last);
+
+Bool Planner_Forget_Splits(
+        Modbus_Planner *const Planner,
+        uint32_t const Hole);
+
+uint8_t Table_Function_Code(
+        Modbus_Table const Table);
+
+void Planner_Build(
+        Modbus_Planner *const Planner);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+uint32_t Tag_Key(
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const Address) {
+
+    return ((uint32_t) Unit_ID << 24) |
+           ((uint32_t) Table << KEY_TABLE_SHIFT) |
+           (uint32_t) Address;
+}
+
+//!-  Tag_Search() returns the Index of the first Tag with Key >= "Key".
+uint16_t Tag_Search(
+        const Modbus_Planner *const Planner,
+        uint32_t const Key) {
+
+    uint16_t Low = 0;
+    uint16_t High = Planner->Tag_Count;
+    uint16_t Mid = 0;
+
+    while (Low < High) {
+        Mid = (uint16_t) ((Low + High) / 2);
+        if (Tag_Key(Planner->Tags[Mid].Unit_ID, Planner->Tags[Mid].Table,
+                    Planner->Tags[Mid].Address) < Key) {
+            Low = (uint16_t) (Mid + 1);
+        }
+        else {
+            High = Mid;
+        }
+    }
+    return Low;
+}
+
+//!-  Break_Search() returns the Index of the first Break with Key >= "Key".
+uint16_t Break_Search(
+        const Modbus_Planner *const Planner,
+        uint32_t const Key) {
+
+    uint16_t Low = 0;
+    uint16_t High = Planner->Break_Count;
+    uint16_t Mid = 0;
+
+    while (Low < High) {
+        Mid = (uint16_t) ((Low + High) / 2);
+        if (Planner->Breaks[Mid].Key < Key) {
+            Low = (uint16_t) (Mid + 1);
+        }
+        else {
+            High = Mid;
+        }
+    }
+    return Low;
+}
+
+/*
+ *!-  Planner_Learn() records a Break; a Hole replaces a Split
+ *!-  on the same Item, a Split made again covers both Blocks.
+ *!-  Returns FALSE when nothing was learned.
+ */
+Bool Planner_Learn(
+        Modbus_Planner *const Planner,
+        uint32_t const Key,
+        Planner_Break_Kind const Kind,
+        uint32_t const First,
+        uint32_t const Last) {
+
+    Bool Check_Ok = FALSE;
+    uint16_t const Index = Break_Search(Planner, Key);
+    Planner_Break *const Break = &Planner->Breaks[Index];
+
+    if ((Index < Planner->Break_Count) && (Break->Key == Key)) {
+        if (Break->Kind < Kind) {
+            Break->Kind = Kind;
+            Check_Ok = TRUE;
+        }
+        else if (Break->Kind == BREAK_SPLIT) {
+            Break->First = (First < Break->First) ? First : Break->First;
+            Break->Last = (Last > Break->Last) ? Last : Break->Last;
+        }
+    }
+    else if (Planner->Break_Count < PLANNER_MAX_BREAKS) {
+        memmove(Break + 1, Break,
+                (Planner->Break_Count - Index) * sizeof(Planner_Break));
+        Break->Key = Key;
+        Break->Kind = Kind;
+        Break->First = First;
+        Break->Last = Last;
+        Planner->Break_Count++;
+        Check_Ok = TRUE;
+    }
+    else {
+        Check_Ok = FALSE;
+    }
+
+    if (Check_Ok == TRUE) {
+        Planner->Plan_Valid = FALSE;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Planner_Forget_Splits() drops the Splits made while a Block
+ *!-  around "Hole" was bisected, so the Tags on either Side of it
+ *!-  are read in as few Blocks as before. A Split still needed for
+ *!-  another bad Item is learned again on its next Failure.
+ *!-  Returns TRUE when any was dropped.
+ */
+Bool Planner_Forget_Splits(
+        Modbus_Planner *const Planner,
+        uint32_t const Hole) {
+
+    Bool Check_Ok = FALSE;
+    uint16_t Index = 0;
+    uint16_t Kept = 0;
+    const Planner_Break *Break = NULL;
+
+    for (Index = 0; Index < Planner->Break_Count; Index++) {
+        Break = &Planner->Breaks[Index];
+        if ((Break->Kind != BREAK_SPLIT) ||
+            (Break->First > Hole) || (Break->Last < Hole)) {
+            Planner->Breaks[Kept++] = *Break;
+        }
+    }
+    Check_Ok = (Bool) (Kept < Planner->Break_Count);
+    if (Check_Ok == TRUE) {
+        Planner->Break_Count = Kept;
+        Planner->Plan_Valid = FALSE;
+    }
+    return Check_Ok;
+}
+
+uint8_t Table_Function_Code(
+        Modbus_Table const Table) {
+
+    uint8_t FunctionCode = 0;
+
+    switch (Table) {
+        case TABLE_COILS:             FunctionCode = Fun_Code01; break;
+        case TABLE_DISCRETE_INPUTS:   FunctionCode = Fun_Code02; break;
+        case TABLE_INPUT_REGISTERS:   FunctionCode = Fun_Code04; break;
+        case TABLE_HOLDING_REGISTERS: FunctionCode = Fun_Code03; break;
+        default:                      FunctionCode = 0;          break;
+    }
+    return FunctionCode;
+}
+
+/*
+ *!-  Planner_Build() walks the sorted Tags once. A Tag joins the
+ *!-  open Block when it is in the same Table, the Gap to the last
+ *!-  Tag is within the Gap Fill, the Block stays within the Item
+ *!-  Limit and no learned Break lies between the two. The Breaks
+ *!-  are sorted the same way, so they are walked alongside.
+ */
+void Planner_Build(
+        Modbus_Planner *const Planner) {
+
+    uint16_t Index = 0;
+    uint16_t Cursor = 0;
+    uint16_t Gap = 0;
+    uint16_t Limit = 0;
+    uint32_t Key = 0;
+    uint32_t Last_Key = 0;
+    Bool Open = FALSE;
+    Bool Crossed = FALSE;
+    Bool Hole = FALSE;
+    const Modbus_Tag *Tag = NULL;
+    Modbus_Read_Block *Block = NULL;
+
+    Planner->Block_Count = 0;
+    Planner->Skipped_Tags = 0;
+
+    for (Index = 0; Index < Planner->Tag_Count; Index++) {
+        Tag = &Planner->Tags[Index];
+        Key = Tag_Key(Tag->Unit_ID, Tag->Table, Tag->Address);
+
+        //!-  Breaks up to the last Tag were consumed before.
+        Crossed = FALSE;
+        Hole = FALSE;
+        while ((Cursor < Planner->Break_Count) &&
+               (Planner->Breaks[Cursor].Key <= Key)) {
+            Crossed = TRUE;
+            if ((Planner->Breaks[Cursor].Key == Key) &&
+                (Planner->Breaks[Cursor].Kind == BREAK_HOLE)) {
+                Hole = TRUE;
+            }
+            Cursor++;
+        }
+
+        if (Hole == TRUE) {
+            Planner->Skipped_Tags++;
+            Open = FALSE;
+            continue;
+        }
+
+        if ((Tag->Table == TABLE_COILS) ||
+            (Tag->Table == TABLE_DISCRETE_INPUTS)) {
+            Gap = Planner->Gap_Bits;
+            Limit = Planner->Max_Bits;
+        }
+        else {
+            Gap = Planner->Gap_Registers;
+            Limit = Planner->Max_Registers;
+        }
+
+        if ((Open == TRUE) &&
+            (Crossed == FALSE) &&
+            ((Key >> KEY_TABLE_SHIFT) == (Last_Key >> KEY_TABLE_SHIFT)) &&
+            ((Key - Last_Key - 1) <= Gap) &&
+            ((Tag->Address - Block->Start) < Limit)) {
+            Block->Quantity = (uint16_t) (Tag->Address - Block->Start + 1);
+            Block->Tag_Count++;
+        }
+        else {
+            Block = &Planner->Blocks[Planner->Block_Count++];
+            Block->Unit_ID = Tag->Unit_ID;
+            Block->Function_Code = Table_Function_Code(Tag->Table);
+            Block->Start = Tag->Address;
+            Block->Quantity = 1;
+            Block->First_Tag = Index;
+            Block->Tag_Count = 1;
+            Open = TRUE;
+        }
+        Last_Key = Key;
+    }
+
+    Planner->Plans++;
+    Planner->Plan_Valid = TRUE;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Planner_Init() empties the Tag List and forgets all Breaks.
+ *!-  Gap_Registers / Gap_Bits:
+ *!-  Gap Fill for Register / Bit Tables; 0 reads Tags
+ *!-  only together when their Addresses are adjacent.
+ */
+void Planner_Init(
+        Modbus_Planner *const Planner,
+        uint16_t const Gap_Registers,
+        uint16_t const Gap_Bits) {
+
+    Planner->Gap_Registers = Gap_Registers;
+    Planner->Gap_Bits = Gap_Bits;
+    Planner->Max_Registers = MAXREADREGQUANTITY;
+    Planner->Max_Bits = MAXREGISTERQUANTITY;
+    Planner->Plan_Valid = FALSE;
+    Planner->Tag_Count = 0;
+    Planner->Block_Count = 0;
+    Planner->Break_Count = 0;
+    Planner->Skipped_Tags = 0;
+    Planner->Plans = 0;
+}
+
+//!-  Planner_Add_Tag() adds a Tag; Tags already listed are ignored.
+Bool Planner_Add_Tag(
+        Modbus_Planner *const Planner,
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const Address) {
+
+    Bool Check_Ok = FALSE;
+    uint32_t const Key = Tag_Key(Unit_ID, Table, Address);
+    uint16_t const Index = Tag_Search(Planner, Key);
+    Modbus_Tag *Tag = &Planner->Tags[Index];
+
+    if (Table > TABLE_HOLDING_REGISTERS) {
+        Check_Ok = FALSE;
+    }
+    else if ((Index < Planner->Tag_Count) &&
+             (Tag_Key(Tag->Unit_ID, Tag->Table, Tag->Address) == Key)) {
+        Check_Ok = TRUE;
+    }
+    else if (Planner->Tag_Count < PLANNER_MAX_TAGS) {
+        memmove(Tag + 1, Tag,
+                (Planner->Tag_Count - Index) * sizeof(Modbus_Tag));
+        Tag->Unit_ID = Unit_ID;
+        Tag->Table = Table;
+        Tag->Address = Address;
+        Planner->Tag_Count++;
+        Planner->Plan_Valid = FALSE;
+        Check_Ok = TRUE;
+    }
+    else {
+        Check_Ok = FALSE;
+    }
+    return Check_Ok;
+}
+
+//!-  Planner_Remove_Tag() returns FALSE if the Tag was not listed.
+Bool Planner_Remove_Tag(
+        Modbus_Planner *const Planner,
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const Address) {
+
+    Bool Check_Ok = FALSE;
+    uint32_t const Key = Tag_Key(Unit_ID, Table, Address);
+    uint16_t const Index = Tag_Search(Planner, Key);
+    Modbus_Tag *Tag = &Planner->Tags[Index];
+
+    if ((Index < Planner->Tag_Count) &&
+        (Tag_Key(Tag->Unit_ID, Tag->Table, Tag->Address) == Key)) {
+        Planner->Tag_Count--;
+        memmove(Tag, Tag + 1,
+                (Planner->Tag_Count - Index) * sizeof(Modbus_Tag));
+        Planner->Plan_Valid = FALSE;
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+//!-  Planner_Clear_Tags() empties the Tag List; Breaks are kept.
+void Planner_Clear_Tags(
+        Modbus_Planner *const Planner) {
+
+    Planner->Tag_Count = 0;
+    Planner->Plan_Valid = FALSE;
+}
+
+/*
+ *!-  Planner_Plan() returns the Number of Blocks in
+ *!-  Planner->Blocks, building the Plan only if it changed.
+ */
+uint16_t Planner_Plan(
+        Modbus_Planner *const Planner) {
+
+    if (Planner->Plan_Valid == FALSE) {
+        Planner_Build(Planner);
+    }
+    return Planner->Block_Count;
+}
+
+//!-  Planner_Build_Request() builds the Read Request of one Block.
+Bool Planner_Build_Request(
+        const Modbus_Planner *const Planner,
+        uint16_t const Block_Index,
+        Modbus_Frame *const Request) {
+
+    Bool Check_Ok = FALSE;
+    const Modbus_Read_Block *Block = NULL;
+
+    if ((Planner->Plan_Valid == TRUE) &&
+        (Block_Index < Planner->Block_Count)) {
+        Block = &Planner->Blocks[Block_Index];
+        Check_Ok = Modbus_Request(Request, Block->Unit_ID,
+                                  Block->Function_Code,
+                                  Block->Start, Block->Quantity);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Planner_Report_Exception() learns from the Exception Response
+ *!-  to a Block of the current Plan. On ILLEGAL_DATA_ADDRESS a Block
+ *!-  of several Tags is split in half at a Tag, and a single Tag is
+ *!-  marked as a Hole, so a bad Item is isolated within log2(Tags)
+ *!-  Polls while all other Tags keep being read. Once the Hole is
+ *!-  known the Splits made to find it are dropped, and the Blocks
+ *!-  only break around the Hole. Returns TRUE when the Plan changed.
+ */
+Bool Planner_Report_Exception(
+        Modbus_Planner *const Planner,
+        uint16_t const Block_Index,
+        uint8_t const ExceptionCode) {
+
+    Bool Check_Ok = FALSE;
+    const Modbus_Read_Block *Block = NULL;
+    const Modbus_Tag *Tag = NULL;
+    uint32_t First = 0;
+    uint32_t Last = 0;
+
+    if ((ExceptionCode == ILLEGAL_DATA_ADDRESS) &&
+        (Planner->Plan_Valid == TRUE) &&
+        (Block_Index < Planner->Block_Count)) {
+        Block = &Planner->Blocks[Block_Index];
+        Tag = &Planner->Tags[Block->First_Tag];
+        First = Tag_Key(Tag->Unit_ID, Tag->Table, Tag->Address);
+        Tag = &Planner->Tags[Block->First_Tag + Block->Tag_Count - 1];
+        Last = Tag_Key(Tag->Unit_ID, Tag->Table, Tag->Address);
+        if (Block->Tag_Count == 1) {
+            Check_Ok = Planner_Learn(Planner, First, BREAK_HOLE,
+                                     First, Last);
+            Check_Ok |= Planner_Forget_Splits(Planner, First);
+        }
+        else {
+            Tag = &Planner->Tags[Block->First_Tag + (Block->Tag_Count / 2)];
+            Check_Ok = Planner_Learn(Planner,
+                           Tag_Key(Tag->Unit_ID, Tag->Table, Tag->Address),
+                           BREAK_SPLIT, First, Last);
+        }
+    }
+    return Check_Ok;
+}
@@ -0,0 +1,146 @@
+/*
+ * Modbus_Planner.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Planner.h
+*****************************************************************************/
+
+#ifndef __MODBUS_PLANNER_H_
+#define __MODBUS_PLANNER_H_
+
+//!-  Headers
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Capacity of one Poll List; Memory is reserved up front.
+#define PLANNER_MAX_TAGS    (4096)
+#define PLANNER_MAX_BREAKS  (256)
+
+//!-  Default Gap Fill: Unused Items read to save a Round Trip.
+#define PLANNER_GAP_REGISTERS  (8)
+#define PLANNER_GAP_BITS       (128)
+
+/*
+ *!-  "Modbus_Tag" is one Item the Master polls.
+ *!-  Unit_ID:
+ *!-  Slave Device the Item lives on.
+ *!-  Table:
+ *!-  Modbus_Table of the Item.
+ *!-  Address:
+ *!-  Protocol Address inside the Table.
+ */
+typedef struct {
+    uint8_t       Unit_ID;
+    Modbus_Table  Table;
+    uint16_t      Address;
+} Modbus_Tag;
+
+/*
+ *!-  "Modbus_Read_Block" is one Read Request of a Plan.
+ *!-  It covers the Tags First_Tag .. First_Tag + Tag_Count - 1
+ *!-  of the (sorted) Tag List; the Value of Tag "t" is Item
+ *!-  (t.Address - Start) of the Response.
+ */
+typedef struct {
+    uint8_t   Unit_ID;
+    uint8_t   Function_Code;
+    uint16_t  Start;
+    uint16_t  Quantity;
+    uint16_t  First_Tag;
+    uint16_t  Tag_Count;
+} Modbus_Read_Block;
+
+/*
+ *!-  "Planner_Break" is Knowledge learned from ILLEGAL_DATA_ADDRESS.
+ *!-  BREAK_SPLIT:
+ *!-  No Block may span the Items "Key - 1" and "Key".
+ *!-  BREAK_HOLE:
+ *!-  The Item "Key" is never read; Tags on it are skipped.
+ *!-  First / Last:
+ *!-  Keys of the first and last Tag of the failed Block a Split
+ *!-  was made in. Once a Hole inside them is found, the Split has
+ *!-  served its Purpose and is dropped again.
+ */
+typedef enum {
+    BREAK_SPLIT = 0,
+    BREAK_HOLE  = 1,
+} Planner_Break_Kind;
+
+typedef struct {
+    uint32_t            Key;
+    Planner_Break_Kind  Kind;
+    uint32_t            First;
+    uint32_t            Last;
+} Planner_Break;
+
+/*
+ *!-  "Modbus_Planner" turns a Tag List into a minimal Set of
+ *!-  FC01/FC02/FC03/FC04 Block Reads. The Plan is cached and
+ *!-  built again only after the Tag List or the learned Breaks
+ *!-  have changed.
+ *!-  Gap_Registers / Gap_Bits:
+ *!-  Largest Run of unused Items read to join two Tags.
+ *!-  Max_Registers / Max_Bits:
+ *!-  Items per Request; the Protocol Limits by Default.
+ */
+typedef struct {
+    uint16_t           Gap_Registers;
+    uint16_t           Gap_Bits;
+    uint16_t           Max_Registers;
+    uint16_t           Max_Bits;
+    Bool               Plan_Valid;
+    uint16_t           Tag_Count;
+    uint16_t           Block_Count;
+    uint16_t           Break_Count;
+    uint16_t           Skipped_Tags;
+    uint32_t           Plans;
+    Modbus_Tag         Tags[PLANNER_MAX_TAGS];
+    Modbus_Read_Block  Blocks[PLANNER_MAX_TAGS];
+    Planner_Break      Breaks[PLANNER_MAX_BREAKS];
+} Modbus_Planner;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+void Planner_Init(
+        Modbus_Planner *const Planner,
+        uint16_t const Gap_Registers,
+        uint16_t const Gap_Bits);
+
+Bool Planner_Add_Tag(
+        Modbus_Planner *const Planner,
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const Address);
+
+Bool Planner_Remove_Tag(
+        Modbus_Planner *const Planner,
+        uint8_t const Unit_ID,
+        Modbus_Table const Table,
+        uint16_t const Address);
+
+void Planner_Clear_Tags(
+        Modbus_Planner *const Planner);
+
+uint16_t Planner_Plan(
+        Modbus_Planner *const Planner);
+
+Bool Planner_Build_Request(
+        const Modbus_Planner *const Planner,
+        uint16_t const Block_Index,
+        Modbus_Frame *const Request);
+
+Bool Planner_Report_Exception(
+        Modbus_Planner *const Planner,
+        uint16_t const Block_Index,
+        uint8_t const ExceptionCode);
+
+#endif /* __MODBUS_PLANNER_H_ */
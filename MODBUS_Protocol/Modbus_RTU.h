@@ -0,0 +1,299 @@
+/*
+ * Modbus_RTU.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_RTU.h
+*****************************************************************************/
+
+#ifndef __MODBUS_RTU_H_
+#define __MODBUS_RTU_H_
+
+//!-  Headers
+#include <Modbus.h>
+#include <Modbus_Clock.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  Bits per Character on the Line: Start, 8 Data, Parity or
+ *!-  second Stop Bit, Stop.
+ */
+#define RTU_BITS_PER_CHAR       (11)
+
+/*
+ *!-  Above 19200 Baud the Modbus over Serial Line Specification
+ *!-  fixes the Inter-Character and Inter-Frame Timeouts.
+ */
+#define RTU_FIXED_TIMING_BAUD   (19200)
+#define RTU_FIXED_T15_NS        (750 * NS_PER_US)
+#define RTU_FIXED_T35_NS        (1750 * NS_PER_US)
+
+//!-  Modbus_RTU_Frame_Length(): the Length is not yet known.
+#define RTU_LENGTH_UNKNOWN      (0)
+//!-  Modbus_RTU_Frame_Length(): Flag for "need this many Bytes".
+#define RTU_LENGTH_NEED         (0x10000UL)
+
+/*
+ *!-  "Modbus_RTU_Role" tells the Parser which Frames to expect.
+ *!-  Knowing the Direction, it predicts the Length of a Frame
+ *!-  from its Header and completes it as soon as the last Byte
+ *!-  and a good CRC are in, without waiting for t3.5. A Monitor
+ *!-  sees both Directions and relies on the Silence alone.
+ */
+typedef enum {
+    RTU_PARSE_REQUESTS  = 0,  //!-  Slave Side
+    RTU_PARSE_RESPONSES = 1,  //!-  Master Side
+    RTU_PARSE_ANY       = 2,  //!-  Bus Monitor
+} Modbus_RTU_Role;
+
+/*
+ *!-  "Modbus_RTU_Callback" receives every complete ADU whose CRC
+ *!-  checked out, CRC included. The Frame points into the Parser
+ *!-  and is valid until the Callback returns.
+ */
+typedef void (*Modbus_RTU_Callback)(
+        void *const Context,
+        const Modbus_Frame *const Frame);
+
+/*
+ *!-  "Modbus_RTU_Stats" counts what the Parser saw.
+ *!-  Gap_Errors:  Silences between t1.5 and t3.5 inside a Frame.
+ *!-  Resyncs:     Realignments on a Frame Start after Noise.
+ *!-  Noise_Bytes: Bytes dropped for not being part of a Frame.
+ */
+typedef struct {
+    uint64_t  Frames;
+    uint64_t  CRC_Errors;
+    uint64_t  Gap_Errors;
+    uint64_t  Overruns;
+    uint64_t  Resyncs;
+    uint64_t  Noise_Bytes;
+} Modbus_RTU_Stats;
+
+/*
+ *!-  "Modbus_RTU_Parser" frames a received Byte Stream by its
+ *!-  Silent Intervals. It allocates nothing and keeps the CRC
+ *!-  running as Bytes arrive, so a Frame is checked the Moment
+ *!-  its last Byte is in.
+ *!-  Check_At:
+ *!-  Length at which the next Decision is due (Header complete,
+ *!-  predicted End or Buffer full); Bytes before it are only
+ *!-  copied and added to the CRC.
+ *!-  Strict:
+ *!-  Drop Frames with a t1.5 Violation, as the Specification
+ *!-  asks; otherwise they are only counted.
+ *!-  Sliding:
+ *!-  The Frame Start came from a Resync, not from Silence.
+ *!-  Last_ns:
+ *!-  Arrival Time of the last Byte received.
+ *!-  Scan_ns:
+ *!-  Start of the Feed or Poll in Progress, when the Frames it
+ *!-  completes began to be checked.
+ */
+typedef struct {
+    uint8_t              Adu[MODBUS_MAX_ADU_LENGTH];
+    uint16_t             Length;
+    uint16_t             CRC_State;
+    uint16_t             Check_At;
+    Modbus_RTU_Role      Role;
+    Bool                 Strict;
+    Bool                 Damaged;
+    Bool                 Sliding;
+    uint64_t             Last_ns;
+    uint64_t             Scan_ns;
+    uint64_t             Char_ns;
+    uint64_t             T15_ns;
+    uint64_t             T35_ns;
+    Modbus_RTU_Callback  Callback;
+    void                *Context;
+    Modbus_RTU_Stats     Stats;
+} Modbus_RTU_Parser;
+
+/*
+ *!-  Serial Line Settings of a Port: "Path[,Baud[,Format]]",
+ *!-  e.g. "/dev/ttyUSB0,19200,8E1". Format is Data Bits (8),
+ *!-  Parity (N, E, O) and Stop Bits (1, 2); the Default is the
+ *!-  one the Specification mandates, 19200 Baud 8E1.
+ */
+#define RTU_DEFAULT_BAUD        (19200)
+#define RTU_DEFAULT_FORMAT      "8E1"
+#define RTU_PORT_MAX_EVENTS     (4)
+#define RTU_PORT_RX_CHUNK       (512)
+#define RTU_CLIENT_TIMEOUT_MS   (1000)
+
+/*
+ *!-  "Modbus_RTU_Gap" sums up Turnaround Gaps on the Line.
+ */
+typedef struct {
+    uint64_t  Count;
+    uint64_t  Min_ns;
+    uint64_t  Max_ns;
+    uint64_t  Total_ns;
+} Modbus_RTU_Gap;
+
+/*
+ *!-  "Modbus_RTU_Port" drives one Serial Line: non-blocking I/O
+ *!-  on an epoll Set holding the tty and a timerfd. The Timer is
+ *!-  armed on absolute Monotonic Times for the next Event due:
+ *!-  the t3.5 End of a pending Frame, the Moment the Line may be
+ *!-  driven again, or the Wake Time of the Layer above.
+ *!-  Tx_Adu:
+ *!-  The sealed ADU to send; it goes out in one write() once
+ *!-  the Line has been silent for t3.5, never earlier.
+ *!-  Rx_End_ns / Tx_End_ns:
+ *!-  End of the last Frame received, and when the last Byte
+ *!-  written leaves the Wire (estimated from the Baud Rate).
+ *!-  Rx_Last:
+ *!-  The last Frame on the Line was received, not sent.
+ *!-  Turnaround:
+ *!-  Frame received -> own Transmission started.
+ *!-  Reply:
+ *!-  Own Transmission ended -> Peer's Frame started.
+ */
+typedef struct {
+    int                  Fd;
+    int                  Epoll_Fd;
+    int                  Timer_Fd;
+    uint32_t             Baud;
+    uint16_t             Tx_Head;
+    uint16_t             Tx_Length;
+    Bool                 Tx_Started;
+    Bool                 Rx_Last;
+    uint64_t             Timer_ns;
+    uint64_t             Wake_ns;
+    uint64_t             Rx_End_ns;
+    uint64_t             Tx_End_ns;
+    uint64_t             Frames_Sent;
+    Modbus_RTU_Gap       Turnaround;
+    Modbus_RTU_Gap       Reply;
+    Modbus_RTU_Callback  Callback;
+    void                *Context;
+    uint8_t              Tx_Adu[MODBUS_MAX_ADU_LENGTH];
+    Modbus_RTU_Parser    Parser;
+} Modbus_RTU_Port;
+
+/*
+ *!-  "Modbus_RTU_Server" answers the Requests on a Port for the
+ *!-  Units hosted in MODBUS_UNITS; other Device IDs are ignored,
+ *!-  Broadcasts are executed but not answered.
+ */
+typedef struct {
+    Modbus_RTU_Port  Port;
+    uint64_t         Requests_Served;
+} Modbus_RTU_Server;
+
+/*
+ *!-  "Modbus_RTU_Client" is a Master on a Port. A Serial Line
+ *!-  carries one Transaction at a Time, so there is no Window.
+ */
+typedef struct {
+    Modbus_RTU_Port          Port;
+    Bool                     Busy;
+    uint8_t                  Unit_ID;
+    uint8_t                  Function_Code;
+    uint64_t                 Deadline_ns;
+    uint64_t                 Timeout_ns;
+    uint64_t                 Completed;
+    uint64_t                 Timeouts;
+    Modbus_Client_Callback   Callback;
+    void                    *Context;
+} Modbus_RTU_Client;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+void Modbus_RTU_Parser_Init(
+        Modbus_RTU_Parser *const Parser,
+        uint32_t const Baud,
+        Modbus_RTU_Role const Role,
+        Modbus_RTU_Callback const Callback,
+        void *const Context);
+
+void Modbus_RTU_Parser_Reset(
+        Modbus_RTU_Parser *const Parser);
+
+uint32_t Modbus_RTU_Feed(
+        Modbus_RTU_Parser *const Parser,
+        const uint8_t *const Data,
+        uint32_t const Length,
+        uint64_t const Stamp_ns);
+
+uint32_t Modbus_RTU_Poll(
+        Modbus_RTU_Parser *const Parser,
+        uint64_t const Now_ns);
+
+uint64_t Modbus_RTU_Deadline(
+        const Modbus_RTU_Parser *const Parser);
+
+uint32_t Modbus_RTU_Frame_Length(
+        Modbus_RTU_Role const Role,
+        const uint8_t *const Adu,
+        uint32_t const Length);
+
+Bool Modbus_RTU_Port_Open(
+        Modbus_RTU_Port *const Port,
+        const char *const Spec,
+        Modbus_RTU_Role const Role,
+        Modbus_RTU_Callback const Callback,
+        void *const Context);
+
+Bool Modbus_RTU_Port_Attach(
+        Modbus_RTU_Port *const Port,
+        int const Fd,
+        const char *const Line,
+        Modbus_RTU_Role const Role,
+        Modbus_RTU_Callback const Callback,
+        void *const Context);
+
+Bool Modbus_RTU_Port_Send(
+        Modbus_RTU_Port *const Port,
+        const Modbus_Frame *const Adu);
+
+int Modbus_RTU_Port_Poll(
+        Modbus_RTU_Port *const Port,
+        int const TimeoutMs);
+
+void Modbus_RTU_Port_Close(
+        Modbus_RTU_Port *const Port);
+
+Bool Modbus_RTU_Server_Open(
+        Modbus_RTU_Server *const Server,
+        const char *const Spec);
+
+Bool Modbus_RTU_Server_Attach(
+        Modbus_RTU_Server *const Server,
+        int const Fd,
+        const char *const Line);
+
+int Modbus_RTU_Server_Poll(
+        Modbus_RTU_Server *const Server,
+        int const TimeoutMs);
+
+void Modbus_RTU_Server_Close(
+        Modbus_RTU_Server *const Server);
+
+Bool Modbus_RTU_Client_Open(
+        Modbus_RTU_Client *const Client,
+        const char *const Spec);
+
+Bool Modbus_RTU_Client_Submit(
+        Modbus_RTU_Client *const Client,
+        const Modbus_Frame *const Request,
+        Modbus_Client_Callback const Callback,
+        void *const Context);
+
+int Modbus_RTU_Client_Poll(
+        Modbus_RTU_Client *const Client,
+        int const TimeoutMs);
+
+void Modbus_RTU_Client_Close(
+        Modbus_RTU_Client *const Client);
+
+#endif /* __MODBUS_RTU_H_ */
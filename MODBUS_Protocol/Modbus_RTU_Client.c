@@ -0,0 +1,170 @@
+/*
+ * Modbus_RTU_Client.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_RTU_Client.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus_Frame.h"
+#include "Modbus_RTU.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+void RTU_Client_Complete(
+        Modbus_RTU_Client *const Client,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+void RTU_Client_Response(
+        void *const Context,
+        const Modbus_Frame *const Frame);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  RTU_Client_Complete() ends the Transaction and reports the Result.
+void RTU_Client_Complete(
+        Modbus_RTU_Client *const Client,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    Client->Busy = FALSE;
+    Client->Port.Wake_ns = 0;
+    if (Status == TARGET_DEVICE_FAILED_TO_RESPOND) {
+        Client->Timeouts++;
+    }
+    else {
+        Client->Completed++;
+    }
+    if (Client->Callback != NULL) {
+        Client->Callback(Client->Context, Response, Status);
+    }
+}
+
+/*
+ *!-  RTU_Client_Response() matches a Frame from the Line against the
+ *!-  Transaction and completes it. Frames nobody waits for (late
+ *!-  Answers, other Masters) are dropped.
+ */
+void RTU_Client_Response(
+        void *const Context,
+        const Modbus_Frame *const Frame) {
+
+    Modbus_RTU_Client *const Client = Context;
+    uint8_t Status = MODBUS_NO_EXCEPTION;
+    Modbus_Frame Response;
+
+    Frame_Attach(&Response, Frame->Adu, Frame->Length - FRAME_CRC_LENGTH);
+    if ((Client->Busy == TRUE) &&
+        (Client->Unit_ID == Frame_Device_ID(&Response)) &&
+        (Client->Function_Code ==
+         (Frame_Function_Code(&Response) & (uint8_t) ~MSB1))) {
+        if ((Frame_Is_Exception(&Response) == TRUE) &&
+            (Response.Length > FRAME_HEADER_LENGTH)) {
+            Status = Frame_Exception_Code(&Response);
+        }
+        RTU_Client_Complete(Client, &Response, Status);
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Modbus_RTU_Client_Open() opens the tty of "Spec" (see Modbus_RTU.h).
+Bool Modbus_RTU_Client_Open(
+        Modbus_RTU_Client *const Client,
+        const char *const Spec) {
+
+    memset(Client, 0, sizeof(*Client));
+    Client->Timeout_ns = RTU_CLIENT_TIMEOUT_MS * NS_PER_MS;
+    return Modbus_RTU_Port_Open(&Client->Port, Spec, RTU_PARSE_RESPONSES,
+                                RTU_Client_Response, Client);
+}
+
+/*
+ *!-  Modbus_RTU_Client_Submit() sends a Request (Unit ID + PDU,
+ *!-  without CRC) as soon as the Line allows. Returns FALSE while
+ *!-  the last Transaction is open. A Broadcast completes once it
+ *!-  is on the Wire; nobody answers it.
+ */
+Bool Modbus_RTU_Client_Submit(
+        Modbus_RTU_Client *const Client,
+        const Modbus_Frame *const Request,
+        Modbus_Client_Callback const Callback,
+        void *const Context) {
+
+    Bool Check_Ok = FALSE;
+    Modbus_Frame Adu;
+
+    if ((Client->Busy == FALSE) && (Client->Port.Tx_Length == 0) &&
+        (Request->Length >= FRAME_HEADER_LENGTH) &&
+        ((Request->Length + FRAME_CRC_LENGTH) <= MODBUS_MAX_ADU_LENGTH)) {
+        memcpy(Client->Port.Tx_Adu, Request->Adu, Request->Length);
+        Frame_Attach(&Adu, Client->Port.Tx_Adu, Request->Length);
+        (void) Frame_Seal(&Adu);
+
+        Client->Busy = TRUE;
+        Client->Unit_ID = Frame_Device_ID(Request);
+        Client->Function_Code = Frame_Function_Code(Request);
+        Client->Deadline_ns = Modbus_Now_ns() + Client->Timeout_ns;
+        Client->Callback = Callback;
+        Client->Context = Context;
+        Client->Port.Wake_ns = Client->Deadline_ns;
+        Check_Ok = Modbus_RTU_Port_Send(&Client->Port, &Adu);
+        if (Check_Ok == FALSE) {
+            Client->Busy = FALSE;
+            Client->Port.Wake_ns = 0;
+            Client->Port.Tx_Length = 0;
+        }
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_RTU_Client_Poll() runs the Line for up to "TimeoutMs",
+ *!-  completing the Transaction on its Response or Timeout.
+ *!-  Returns -1 once the Line failed (the Transaction is then
+ *!-  failed), else the Number of open Transactions (0 or 1).
+ */
+int Modbus_RTU_Client_Poll(
+        Modbus_RTU_Client *const Client,
+        int const TimeoutMs) {
+
+    int Result = Modbus_RTU_Port_Poll(&Client->Port, TimeoutMs);
+
+    if (Result < 0) {
+        Modbus_RTU_Client_Close(Client);
+    }
+    else if ((Client->Busy == TRUE) && (Client->Unit_ID == BROADCAST) &&
+             (Client->Port.Tx_Length == 0)) {
+        RTU_Client_Complete(Client, NULL, MODBUS_NO_EXCEPTION);
+    }
+    else if ((Client->Busy == TRUE) &&
+             (Modbus_Now_ns() >= Client->Deadline_ns)) {
+        RTU_Client_Complete(Client, NULL, TARGET_DEVICE_FAILED_TO_RESPOND);
+    }
+    if (Result >= 0) {
+        Result = (Client->Busy == TRUE) ? 1 : 0;
+    }
+    return Result;
+}
+
+//!-  Modbus_RTU_Client_Close() releases the Line and fails an open Transaction.
+void Modbus_RTU_Client_Close(
+        Modbus_RTU_Client *const Client) {
+
+    Modbus_RTU_Port_Close(&Client->Port);
+    if (Client->Busy == TRUE) {
+        RTU_Client_Complete(Client, NULL, TARGET_DEVICE_FAILED_TO_RESPOND);
+    }
+}
@@ -0,0 +1,503 @@
+/*
+ * Modbus_RTU_Parser.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_RTU_Parser.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Metrics.h"
+#include "Modbus_RTU.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Highest Unit Address on a Serial Line (248 .. 255 Reserved).
+#define RTU_MAX_ADDRESS  (247)
+
+void RTU_Restart(
+        Modbus_RTU_Parser *const Parser);
+
+void RTU_Emit(
+        Modbus_RTU_Parser *const Parser,
+        uint16_t const Begin,
+        uint16_t const End);
+
+Bool RTU_Plausible(
+        const Modbus_RTU_Parser *const Parser,
+        const uint8_t *const Adu,
+        uint16_t const Length);
+
+Bool RTU_Find(
+        const Modbus_RTU_Parser *const Parser,
+        uint16_t const From,
+        uint16_t *const Begin,
+        uint16_t *const End);
+
+void RTU_Ingest(
+        Modbus_RTU_Parser *const Parser,
+        const uint8_t *const Data,
+        uint32_t const Length);
+
+void RTU_Decide(
+        Modbus_RTU_Parser *const Parser);
+
+void RTU_Slide(
+        Modbus_RTU_Parser *const Parser);
+
+void RTU_End_Frame(
+        Modbus_RTU_Parser *const Parser);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  RTU_Restart() empties the Buffer for the next Frame.
+void RTU_Restart(
+        Modbus_RTU_Parser *const Parser) {
+
+    Parser->Length = 0;
+    Parser->CRC_State = CRC16_INITIAL_STATE;
+    Parser->Damaged = FALSE;
+    Parser->Check_At = (Parser->Role == RTU_PARSE_ANY) ?
+                       MODBUS_MAX_ADU_LENGTH : FRAME_HEADER_LENGTH;
+}
+
+//!-  RTU_Emit() hands Adu[Begin, End) to the Callback.
+void RTU_Emit(
+        Modbus_RTU_Parser *const Parser,
+        uint16_t const Begin,
+        uint16_t const End) {
+
+    Modbus_Frame Frame;
+
+    Parser->Stats.Frames++;
+    Parser->Sliding = FALSE;
+    if (Parser->Callback != NULL) {
+        Frame_Attach(&Frame, &Parser->Adu[Begin], (uint16_t) (End - Begin));
+        Parser->Callback(Parser->Context, &Frame);
+    }
+}
+
+/*
+ *!-  RTU_Plausible() tells if "Length" Bytes with a good CRC can be
+ *!-  a whole Frame: its predicted Length, or for a Monitor a valid
+ *!-  Address and Function Code.
+ */
+Bool RTU_Plausible(
+        const Modbus_RTU_Parser *const Parser,
+        const uint8_t *const Adu,
+        uint16_t const Length) {
+
+    Bool Check_Ok = FALSE;
+
+    if (Parser->Role == RTU_PARSE_ANY) {
+        Check_Ok = (Bool) ((Adu[FRAME_DEVICE_ID_OFFSET] <= RTU_MAX_ADDRESS) &&
+                           ((Adu[FRAME_FUNCTION_CODE_OFFSET] & ~MSB1) != 0));
+    }
+    else {
+        Check_Ok = (Bool) (Modbus_RTU_Frame_Length(Parser->Role, Adu,
+                                                   Length) == Length);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  RTU_Find() looks for the first complete Frame with a good CRC
+ *!-  inside Adu[From, Length). Only run after Noise, so the
+ *!-  quadratic Scan costs nothing on a clean Line.
+ */
+Bool RTU_Find(
+        const Modbus_RTU_Parser *const Parser,
+        uint16_t const From,
+        uint16_t *const Begin,
+        uint16_t *const End) {
+
+    Bool Found = FALSE;
+    uint16_t First = From;
+    uint16_t Last = 0;
+    uint16_t State = 0;
+
+    for (First = From; (Found == FALSE) &&
+                       ((First + FRAME_MIN_LENGTH) <= Parser->Length); First++) {
+        State = CRC16_INITIAL_STATE;
+        for (Last = First; (Found == FALSE) && (Last < Parser->Length); Last++) {
+            State = CRC16_Update_Byte(State, Parser->Adu[Last]);
+            if ((State == 0) && ((Last + 1 - First) >= FRAME_MIN_LENGTH) &&
+                (RTU_Plausible(Parser, &Parser->Adu[First],
+                               (uint16_t) (Last + 1 - First)) == TRUE)) {
+                *Begin = First;
+                *End = (uint16_t) (Last + 1);
+                Found = TRUE;
+            }
+        }
+    }
+    return Found;
+}
+
+/*
+ *!-  RTU_Ingest() appends Bytes to the Frame. Nothing is decided
+ *!-  before Check_At, so each Span up to it is copied and run
+ *!-  through the fastest CRC Engine in one Pass.
+ */
+void RTU_Ingest(
+        Modbus_RTU_Parser *const Parser,
+        const uint8_t *const Data,
+        uint32_t const Length) {
+
+    uint32_t Index = 0;
+    uint32_t Span = 0;
+
+    while (Index < Length) {
+        Span = (uint32_t) (Parser->Check_At - Parser->Length);
+        if (Span > (Length - Index)) {
+            Span = Length - Index;
+        }
+        //!-  May overlap when parsing the Buffer again in place.
+        memmove(&Parser->Adu[Parser->Length], &Data[Index], Span);
+        Parser->CRC_State = CRC16_Update(Parser->CRC_State,
+                                         &Parser->Adu[Parser->Length], Span);
+        Parser->Length = (uint16_t) (Parser->Length + Span);
+        Index += Span;
+        if (Parser->Length == Parser->Check_At) {
+            RTU_Decide(Parser);
+        }
+    }
+}
+
+/*
+ *!-  RTU_Decide() runs when the Frame reached Check_At: it learns
+ *!-  the Length from the Header, completes a Frame whose last Byte
+ *!-  arrived with a good CRC, or handles a full Buffer.
+ */
+void RTU_Decide(
+        Modbus_RTU_Parser *const Parser) {
+
+    uint32_t const Expected = Modbus_RTU_Frame_Length(Parser->Role,
+                                                      Parser->Adu,
+                                                      Parser->Length);
+
+    if ((Expected & RTU_LENGTH_NEED) != 0) {
+        Parser->Check_At = (uint16_t) (Expected & ~RTU_LENGTH_NEED);
+    }
+    else if ((Expected == Parser->Length) && (Parser->CRC_State == 0) &&
+             (Parser->Damaged == FALSE)) {
+        RTU_Emit(Parser, 0, Parser->Length);
+        RTU_Restart(Parser);
+    }
+    else if ((Expected > Parser->Length) &&
+             (Expected <= MODBUS_MAX_ADU_LENGTH)) {
+        Parser->Check_At = (uint16_t) Expected;
+    }
+    else if ((Expected == Parser->Length) && (Parser->Damaged == FALSE)) {
+        //!-  Misframed or hit by Noise: look for the real Frame Start.
+        if (Parser->Sliding == FALSE) {
+            Parser->Stats.CRC_Errors++;
+            Modbus_Metrics_Add(&Modbus_Metrics_Slot()->CRC_Errors, 1);
+        }
+        RTU_Slide(Parser);
+    }
+    else if (Parser->Length >= MODBUS_MAX_ADU_LENGTH) {
+        Parser->Stats.Overruns++;
+        Modbus_Metrics_Add(&Modbus_Metrics_Slot()->Frame_Errors, 1);
+        RTU_Slide(Parser);
+    }
+    else {
+        //!-  Unknown Length or bad CRC: only the Silence can tell.
+        Parser->Check_At = MODBUS_MAX_ADU_LENGTH;
+    }
+}
+
+/*
+ *!-  RTU_Slide() resynchronizes without waiting for Silence, after
+ *!-  a bad CRC at the predicted End or a full Buffer (Line Noise,
+ *!-  or joining a busy Line mid-Frame). It drops Bytes up to the
+ *!-  first Offset holding a whole good Frame, delivered at once,
+ *!-  or the Start of one still arriving, and parses the Rest again.
+ */
+void RTU_Slide(
+        Modbus_RTU_Parser *const Parser) {
+
+    uint16_t First = 1;
+    uint16_t Begin = 0;
+    uint16_t End = 0;
+    uint16_t Keep = Parser->Length;
+    uint16_t Rest = 0;
+    uint32_t Expected = 0;
+
+    for (First = 1; (Parser->Role != RTU_PARSE_ANY) &&
+                    (First < Parser->Length); First++) {
+        Rest = (uint16_t) (Parser->Length - First);
+        Expected = Modbus_RTU_Frame_Length(Parser->Role,
+                                           &Parser->Adu[First], Rest);
+        if (((Expected & RTU_LENGTH_NEED) != 0) ||
+            ((Expected > Rest) && (Expected <= MODBUS_MAX_ADU_LENGTH))) {
+            Keep = First;
+            break;
+        }
+        if ((Expected >= FRAME_MIN_LENGTH) && (Expected <= Rest) &&
+            (CRC16_Update(CRC16_INITIAL_STATE, &Parser->Adu[First],
+                          Expected) == 0)) {
+            RTU_Emit(Parser, First, (uint16_t) (First + Expected));
+            Keep = (uint16_t) (First + Expected);
+            break;
+        }
+    }
+    if ((Parser->Role == RTU_PARSE_ANY) &&
+        (RTU_Find(Parser, 1, &Begin, &End) == TRUE)) {
+        RTU_Emit(Parser, Begin, End);
+        First = Begin;
+        Keep = End;
+    }
+    else if (Parser->Role == RTU_PARSE_ANY) {
+        First = Parser->Length;
+    }
+    if ((First < Parser->Length) && (Parser->Sliding == FALSE)) {
+        Parser->Stats.Resyncs++;
+    }
+    Parser->Stats.Noise_Bytes += (First < Keep) ? First : Keep;
+    Rest = (uint16_t) (Parser->Length - Keep);
+    memmove(Parser->Adu, &Parser->Adu[Keep], Rest);
+    RTU_Restart(Parser);
+    Parser->Sliding = TRUE;
+    //!-  In place: the Write Index never passes the Read Index.
+    RTU_Ingest(Parser, Parser->Adu, Rest);
+}
+
+/*
+ *!-  RTU_End_Frame() closes the Frame after t3.5 of Silence. A Frame
+ *!-  with a bad CRC is searched for Frames hidden behind Noise.
+ */
+void RTU_End_Frame(
+        Modbus_RTU_Parser *const Parser) {
+
+    uint16_t From = 0;
+    uint16_t Begin = 0;
+    uint16_t End = 0;
+
+    if ((Parser->Length >= FRAME_MIN_LENGTH) && (Parser->CRC_State == 0) &&
+        (Parser->Damaged == FALSE)) {
+        RTU_Emit(Parser, 0, Parser->Length);
+    }
+    else if (Parser->Damaged == TRUE) {
+        Parser->Stats.Noise_Bytes += Parser->Length;
+    }
+    else {
+        if ((Parser->Length >= FRAME_MIN_LENGTH) &&
+            (Parser->Sliding == FALSE)) {
+            Parser->Stats.CRC_Errors++;
+            Modbus_Metrics_Add(&Modbus_Metrics_Slot()->CRC_Errors, 1);
+        }
+        while (RTU_Find(Parser, From, &Begin, &End) == TRUE) {
+            Parser->Stats.Noise_Bytes += (uint64_t) (Begin - From);
+            Parser->Stats.Resyncs++;
+            RTU_Emit(Parser, Begin, End);
+            From = End;
+        }
+        Parser->Stats.Noise_Bytes += (uint64_t) (Parser->Length - From);
+    }
+    RTU_Restart(Parser);
+    Parser->Sliding = FALSE;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_RTU_Parser_Init() prepares a Parser for a Line running
+ *!-  at "Baud". t1.5 and t3.5 follow from the Character Time, and
+ *!-  are fixed to 750 us / 1750 us above 19200 Baud.
+ */
+void Modbus_RTU_Parser_Init(
+        Modbus_RTU_Parser *const Parser,
+        uint32_t const Baud,
+        Modbus_RTU_Role const Role,
+        Modbus_RTU_Callback const Callback,
+        void *const Context) {
+
+    memset(Parser, 0, sizeof(*Parser));
+    Parser->Role = Role;
+    Parser->Callback = Callback;
+    Parser->Context = Context;
+    Parser->Char_ns = (Baud != 0) ?
+                      ((RTU_BITS_PER_CHAR * NS_PER_S) / Baud) : 0;
+    if ((Baud == 0) || (Baud > RTU_FIXED_TIMING_BAUD)) {
+        Parser->T15_ns = RTU_FIXED_T15_NS;
+        Parser->T35_ns = RTU_FIXED_T35_NS;
+    }
+    else {
+        Parser->T15_ns = (Parser->Char_ns * 3) / 2;
+        Parser->T35_ns = (Parser->Char_ns * 7) / 2;
+    }
+    RTU_Restart(Parser);
+}
+
+//!-  Modbus_RTU_Parser_Reset() drops a partial Frame, e.g. on Turnaround.
+void Modbus_RTU_Parser_Reset(
+        Modbus_RTU_Parser *const Parser) {
+
+    Parser->Stats.Noise_Bytes += Parser->Length;
+    RTU_Restart(Parser);
+}
+
+/*
+ *!-  Modbus_RTU_Feed() parses "Length" Bytes that were read at
+ *!-  "Stamp_ns" (Modbus_Now_ns() Time Base). The Bytes of one Chunk
+ *!-  are taken as sent back to back, so the Silence before it runs
+ *!-  from the End of the last Byte to the Start of its first one.
+ *!-  Returns the Frames delivered.
+ */
+uint32_t Modbus_RTU_Feed(
+        Modbus_RTU_Parser *const Parser,
+        const uint8_t *const Data,
+        uint32_t const Length,
+        uint64_t const Stamp_ns) {
+
+    uint64_t const Frames = Parser->Stats.Frames;
+    uint64_t const Span = (Length != 0) ?
+                          ((uint64_t) (Length - 1) * Parser->Char_ns) : 0;
+    uint64_t const First = (Stamp_ns > Span) ? (Stamp_ns - Span) : 0;
+    uint64_t const Silence = (First > (Parser->Last_ns + Parser->Char_ns)) ?
+                             (First - Parser->Last_ns - Parser->Char_ns) : 0;
+
+    Parser->Scan_ns = Stamp_ns;
+    if ((Length != 0) && (Parser->Length != 0)) {
+        if (Silence >= Parser->T35_ns) {
+            RTU_End_Frame(Parser);
+        }
+        else if (Silence > Parser->T15_ns) {
+            Parser->Stats.Gap_Errors++;
+            Modbus_Metrics_Add(&Modbus_Metrics_Slot()->Frame_Errors, 1);
+            if (Parser->Strict == TRUE) {
+                Parser->Damaged = TRUE;
+            }
+        }
+    }
+    if (Length != 0) {
+        Parser->Last_ns = Stamp_ns;
+        RTU_Ingest(Parser, Data, Length);
+    }
+    return (uint32_t) (Parser->Stats.Frames - Frames);
+}
+
+/*
+ *!-  Modbus_RTU_Poll() closes a pending Frame once t3.5 of Silence
+ *!-  passed by "Now_ns". Call it when Modbus_RTU_Deadline() is due.
+ */
+uint32_t Modbus_RTU_Poll(
+        Modbus_RTU_Parser *const Parser,
+        uint64_t const Now_ns) {
+
+    uint64_t const Frames = Parser->Stats.Frames;
+
+    Parser->Scan_ns = Now_ns;
+    if ((Parser->Length != 0) &&
+        (Now_ns >= (Parser->Last_ns + Parser->T35_ns))) {
+        RTU_End_Frame(Parser);
+    }
+    return (uint32_t) (Parser->Stats.Frames - Frames);
+}
+
+//!-  Modbus_RTU_Deadline() is when a pending Frame ends, or 0 if none.
+uint64_t Modbus_RTU_Deadline(
+        const Modbus_RTU_Parser *const Parser) {
+
+    return (Parser->Length != 0) ? (Parser->Last_ns + Parser->T35_ns) : 0;
+}
+
+/*
+ *!-  Modbus_RTU_Frame_Length() predicts the whole ADU Length (CRC
+ *!-  included) of a Request or Response from its first "Length"
+ *!-  Bytes. Returns RTU_LENGTH_NEED | n when n Bytes are needed to
+ *!-  tell, or RTU_LENGTH_UNKNOWN for Function Codes whose Length
+ *!-  only the Silence reveals.
+ */
+uint32_t Modbus_RTU_Frame_Length(
+        Modbus_RTU_Role const Role,
+        const uint8_t *const Adu,
+        uint32_t const Length) {
+
+    uint32_t Expected = RTU_LENGTH_UNKNOWN;
+    uint8_t const FunctionCode = (Length >= FRAME_HEADER_LENGTH) ?
+                                 Adu[FRAME_FUNCTION_CODE_OFFSET] : 0;
+
+    if (Role == RTU_PARSE_ANY) {
+        Expected = RTU_LENGTH_UNKNOWN;
+    }
+    else if (Length < FRAME_HEADER_LENGTH) {
+        Expected = RTU_LENGTH_NEED | FRAME_HEADER_LENGTH;
+    }
+    else if (Role == RTU_PARSE_REQUESTS) {
+        switch (FunctionCode) {
+            case 0x01: case 0x02: case 0x03: case 0x04:
+            case 0x05: case 0x06: case 0x08:
+                Expected = 8;
+                break;
+            case 0x07: case 0x0B: case 0x0C: case 0x11:
+                Expected = 4;
+                break;
+            case 0x0F: case 0x10:
+                Expected = (Length > FRAME_REQ_BYTE_COUNT_OFFSET) ?
+                           (9U + Adu[FRAME_REQ_BYTE_COUNT_OFFSET]) :
+                           (RTU_LENGTH_NEED | (FRAME_REQ_BYTE_COUNT_OFFSET + 1));
+                break;
+            case 0x14: case 0x15:
+                Expected = (Length > 2) ? (5U + Adu[2]) :
+                                          (RTU_LENGTH_NEED | 3);
+                break;
+            case 0x16:
+                Expected = 10;
+                break;
+            case 0x17:
+                Expected = (Length > 10) ? (13U + Adu[10]) :
+                                           (RTU_LENGTH_NEED | 11);
+                break;
+            case 0x18:
+                Expected = 6;
+                break;
+            default:
+                Expected = RTU_LENGTH_UNKNOWN;
+                break;
+        }
+    }
+    else if ((FunctionCode & MSB1) != 0) {
+        Expected = 5;
+    }
+    else {
+        switch (FunctionCode) {
+            case 0x01: case 0x02: case 0x03: case 0x04:
+            case 0x0C: case 0x11: case 0x14: case 0x15: case 0x17:
+                Expected = (Length > FRAME_RSP_BYTE_COUNT_OFFSET) ?
+                           (5U + Adu[FRAME_RSP_BYTE_COUNT_OFFSET]) :
+                           (RTU_LENGTH_NEED | (FRAME_RSP_BYTE_COUNT_OFFSET + 1));
+                break;
+            case 0x05: case 0x06: case 0x08: case 0x0B:
+            case 0x0F: case 0x10:
+                Expected = 8;
+                break;
+            case 0x07:
+                Expected = 5;
+                break;
+            case 0x16:
+                Expected = 10;
+                break;
+            case 0x18:
+                Expected = (Length > 3) ? (6U + Frame_Get_U16(&Adu[2])) :
+                                          (RTU_LENGTH_NEED | 4);
+                break;
+            default:
+                Expected = RTU_LENGTH_UNKNOWN;
+                break;
+        }
+    }
+    return Expected;
+}
@@ -0,0 +1,567 @@
+/*
+ * Modbus_RTU_Port.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_RTU_Port.c
+*****************************************************************************/
+
+//!-  Headers
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <linux/major.h>
+#include <linux/serial.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/timerfd.h>
+#include "Modbus_Frame.h"
+#include "Modbus_RTU.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  epoll Tags of the two Descriptors of a Port.
+#define PORT_TAG_LINE   (1)
+#define PORT_TAG_TIMER  (2)
+
+#define RTU_PORT_SPEEDS \
+                (sizeof(RTU_Port_Speeds) / sizeof(RTU_Port_Speeds[0]))
+
+//!-  "RTU_Port_Speed" maps a Baud Rate to its termios Constant.
+typedef struct {
+    uint32_t  Baud;
+    speed_t   Speed;
+} RTU_Port_Speed;
+
+Bool RTU_Port_Is_Pty(
+        int const Fd);
+
+Bool RTU_Port_Configure(
+        int const Fd,
+        const char *const Line,
+        uint32_t *const Baud);
+
+void RTU_Port_Gap_Record(
+        Modbus_RTU_Gap *const Gap,
+        uint64_t const Gap_ns);
+
+void RTU_Port_Frame(
+        void *const Context,
+        const Modbus_Frame *const Frame);
+
+uint64_t RTU_Port_Quiet(
+        const Modbus_RTU_Port *const Port);
+
+void RTU_Port_Arm(
+        Modbus_RTU_Port *const Port);
+
+Bool RTU_Port_Flush(
+        Modbus_RTU_Port *const Port);
+
+Bool RTU_Port_Transmit(
+        Modbus_RTU_Port *const Port,
+        uint64_t const Now_ns);
+
+Bool RTU_Port_Receive(
+        Modbus_RTU_Port *const Port);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static const RTU_Port_Speed RTU_Port_Speeds[] = {
+    {   1200, B1200   }, {   2400, B2400   }, {   4800, B4800   },
+    {   9600, B9600   }, {  19200, B19200  }, {  38400, B38400  },
+    {  57600, B57600  }, { 115200, B115200 }, { 230400, B230400 },
+    { 460800, B460800 }, { 921600, B921600 },
+};
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  RTU_Port_Is_Pty() tells if "Fd" is a Pseudo-Terminal: a Master
+ *!-  answers TIOCGPTN, a Slave is a Device of a Unix98 pty Major.
+ */
+Bool RTU_Port_Is_Pty(
+        int const Fd) {
+
+    unsigned int Number = 0;
+    struct stat Status;
+
+    return (Bool) ((ioctl(Fd, TIOCGPTN, &Number) == 0) ||
+                   ((fstat(Fd, &Status) == 0) && S_ISCHR(Status.st_mode) &&
+                    (major(Status.st_rdev) >= UNIX98_PTY_SLAVE_MAJOR) &&
+                    (major(Status.st_rdev) <
+                     (UNIX98_PTY_SLAVE_MAJOR + UNIX98_PTY_MAJOR_COUNT))));
+}
+
+/*
+ *!-  RTU_Port_Configure() puts the tty in raw non-canonical Mode with
+ *!-  the Settings "Baud[,Format]" of "Line" (NULL: Defaults).
+ *!-  VMIN = VTIME = 0, so read() returns what is there and the
+ *!-  Parser, not the Driver, decides where Frames end.
+ */
+Bool RTU_Port_Configure(
+        int const Fd,
+        const char *const Line,
+        uint32_t *const Baud) {
+
+    Bool Check_Ok = FALSE;
+    const char *Format = RTU_DEFAULT_FORMAT;
+    char *End = NULL;
+    uint32_t Index = RTU_PORT_SPEEDS;
+    struct termios Tio;
+    struct serial_struct Serial;
+
+    *Baud = RTU_DEFAULT_BAUD;
+    if ((Line != NULL) && (*Line != '\0')) {
+        *Baud = (uint32_t) strtoul(Line, &End, 10);
+        if (*End == ',') {
+            Format = End + 1;
+        }
+        else if (*End != '\0') {
+            Format = NULL;
+        }
+    }
+
+    if ((Format != NULL) && (strlen(Format) == 3) && (Format[0] == '8') &&
+        ((Format[1] == 'N') || (Format[1] == 'E') || (Format[1] == 'O')) &&
+        ((Format[2] == '1') || (Format[2] == '2')) &&
+        (tcgetattr(Fd, &Tio) == 0)) {
+        for (Index = 0; Index < RTU_PORT_SPEEDS; Index++) {
+            if (RTU_Port_Speeds[Index].Baud == *Baud) {
+                break;
+            }
+        }
+        if (Index < RTU_PORT_SPEEDS) {
+            cfmakeraw(&Tio);
+            Tio.c_cflag &= (tcflag_t) ~(CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+            Tio.c_cflag |= CS8 | CLOCAL | CREAD;
+            if (Format[1] != 'N') {
+                Tio.c_cflag |= PARENB;
+                Tio.c_iflag |= INPCK;
+            }
+            if (Format[1] == 'O') {
+                Tio.c_cflag |= PARODD;
+            }
+            if (Format[2] == '2') {
+                Tio.c_cflag |= CSTOPB;
+            }
+            Tio.c_cc[VMIN] = 0;
+            Tio.c_cc[VTIME] = 0;
+            Check_Ok = (Bool) (
+                (cfsetspeed(&Tio, RTU_Port_Speeds[Index].Speed) == 0) &&
+                (tcsetattr(Fd, TCSANOW, &Tio) == 0));
+        }
+        /*
+         *!-  A pty has no Parity and drops PARENB; asked for it
+         *!-  again, the Kernel refuses the Request. The Line is fine
+         *!-  as long as it holds the Speed and raw 8-Bit Mode. A
+         *!-  real UART that refuses the Settings fails.
+         */
+        if ((Check_Ok == FALSE) && (Index < RTU_PORT_SPEEDS) &&
+            (RTU_Port_Is_Pty(Fd) == TRUE) && (tcgetattr(Fd, &Tio) == 0)) {
+            Check_Ok = (Bool) (
+                (cfgetospeed(&Tio) == RTU_Port_Speeds[Index].Speed) &&
+                ((Tio.c_cflag & CSIZE) == CS8) &&
+                ((Tio.c_lflag & (ICANON | ECHO)) == 0));
+        }
+    }
+
+    //!-  UARTs that support it hand over every Byte at once.
+    if ((Check_Ok == TRUE) && (ioctl(Fd, TIOCGSERIAL, &Serial) == 0)) {
+        Serial.flags |= ASYNC_LOW_LATENCY;
+        (void) ioctl(Fd, TIOCSSERIAL, &Serial);
+    }
+    if (Check_Ok == TRUE) {
+        (void) tcflush(Fd, TCIOFLUSH);
+    }
+    return Check_Ok;
+}
+
+//!-  RTU_Port_Gap_Record() adds one Gap to the Statistics.
+void RTU_Port_Gap_Record(
+        Modbus_RTU_Gap *const Gap,
+        uint64_t const Gap_ns) {
+
+    if ((Gap->Count == 0) || (Gap_ns < Gap->Min_ns)) {
+        Gap->Min_ns = Gap_ns;
+    }
+    if (Gap_ns > Gap->Max_ns) {
+        Gap->Max_ns = Gap_ns;
+    }
+    Gap->Total_ns += Gap_ns;
+    Gap->Count++;
+}
+
+/*
+ *!-  RTU_Port_Frame() is the Parser Callback: it times the Peer's
+ *!-  Reply to the last own Transmission and hands the Frame up.
+ *!-  Its last Byte came in at Last_ns, so it started Length
+ *!-  Character Times earlier. A Peer only talks once the own
+ *!-  Bytes are out, which corrects the estimated Tx End on
+ *!-  Lines faster than their Baud Rate (USB, pty).
+ */
+void RTU_Port_Frame(
+        void *const Context,
+        const Modbus_Frame *const Frame) {
+
+    Modbus_RTU_Port *const Port = Context;
+    uint64_t const End_ns = Port->Parser.Last_ns;
+    uint64_t const Span_ns = (uint64_t) Frame->Length * Port->Parser.Char_ns;
+    uint64_t const Start_ns = (End_ns > Span_ns) ? (End_ns - Span_ns) : 0;
+
+    if ((Port->Rx_Last == FALSE) && (Port->Tx_End_ns != 0)) {
+        RTU_Port_Gap_Record(&Port->Reply, (Start_ns > Port->Tx_End_ns) ?
+                                      (Start_ns - Port->Tx_End_ns) : 0);
+        if (Port->Tx_End_ns > End_ns) {
+            Port->Tx_End_ns = End_ns;
+        }
+    }
+    Port->Rx_Last = TRUE;
+    Port->Rx_End_ns = End_ns;
+    if (Port->Callback != NULL) {
+        Port->Callback(Port->Context, Frame);
+    }
+}
+
+//!-  RTU_Port_Quiet() is the earliest Time the Line may be driven again.
+uint64_t RTU_Port_Quiet(
+        const Modbus_RTU_Port *const Port) {
+
+    uint64_t const Busy_ns = (Port->Parser.Last_ns > Port->Tx_End_ns) ?
+                             Port->Parser.Last_ns : Port->Tx_End_ns;
+
+    return Busy_ns + Port->Parser.T35_ns;
+}
+
+/*
+ *!-  RTU_Port_Arm() sets the Timer to the earliest of the pending
+ *!-  Frame End, the Quiet Time for a queued Transmission and the
+ *!-  Wake Time. Absolute Times keep the Pacing exact, however
+ *!-  late the Loop gets round to it.
+ */
+void RTU_Port_Arm(
+        Modbus_RTU_Port *const Port) {
+
+    uint64_t Due_ns = Modbus_RTU_Deadline(&Port->Parser);
+    uint64_t Quiet_ns = 0;
+    struct itimerspec Timer;
+
+    if ((Port->Tx_Length > 0) && (Port->Tx_Started == FALSE)) {
+        Quiet_ns = RTU_Port_Quiet(Port);
+        if ((Due_ns == 0) || (Quiet_ns < Due_ns)) {
+            Due_ns = Quiet_ns;
+        }
+    }
+    if ((Port->Wake_ns != 0) && ((Due_ns == 0) || (Port->Wake_ns < Due_ns))) {
+        Due_ns = Port->Wake_ns;
+    }
+
+    if (Due_ns != Port->Timer_ns) {
+        memset(&Timer, 0, sizeof(Timer));
+        Timer.it_value.tv_sec = (time_t) (Due_ns / NS_PER_S);
+        Timer.it_value.tv_nsec = (long) (Due_ns % NS_PER_S);
+        if (timerfd_settime(Port->Timer_Fd, TFD_TIMER_ABSTIME,
+                            &Timer, NULL) == 0) {
+            Port->Timer_ns = Due_ns;
+        }
+    }
+}
+
+/*
+ *!-  RTU_Port_Flush() writes the rest of the ADU. A tty takes a whole
+ *!-  ADU at once; a short Write is finished on EPOLLOUT.
+ *!-  Returns FALSE if the Line failed.
+ */
+Bool RTU_Port_Flush(
+        Modbus_RTU_Port *const Port) {
+
+    Bool Check_Ok = TRUE;
+    ssize_t Written = 0;
+
+    while (Port->Tx_Head < Port->Tx_Length) {
+        Written = write(Port->Fd, &Port->Tx_Adu[Port->Tx_Head],
+                        (size_t) (Port->Tx_Length - Port->Tx_Head));
+        if (Written > 0) {
+            Port->Tx_Head += (uint16_t) Written;
+        }
+        else if ((Written < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+            break;
+        }
+        else if ((Written < 0) && (errno == EINTR)) {
+            continue;
+        }
+        else {
+            Check_Ok = FALSE;
+            break;
+        }
+    }
+    if ((Check_Ok == TRUE) && (Port->Tx_Head == Port->Tx_Length)) {
+        Port->Tx_Head = 0;
+        Port->Tx_Length = 0;
+        Port->Tx_Started = FALSE;
+        Port->Frames_Sent++;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  RTU_Port_Transmit() starts the queued ADU once the Line has been
+ *!-  quiet for t3.5 and no Frame is coming in.
+ */
+Bool RTU_Port_Transmit(
+        Modbus_RTU_Port *const Port,
+        uint64_t const Now_ns) {
+
+    Bool Check_Ok = TRUE;
+
+    if ((Port->Tx_Length > 0) && (Port->Tx_Started == FALSE) &&
+        (Port->Parser.Length == 0) && (Now_ns >= RTU_Port_Quiet(Port))) {
+        if (Port->Rx_Last == TRUE) {
+            RTU_Port_Gap_Record(&Port->Turnaround, Now_ns - Port->Rx_End_ns);
+        }
+        Port->Rx_Last = FALSE;
+        Port->Tx_Started = TRUE;
+        Port->Tx_End_ns = Now_ns +
+                          ((uint64_t) Port->Tx_Length * Port->Parser.Char_ns);
+        Check_Ok = RTU_Port_Flush(Port);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  RTU_Port_Receive() drains the tty (Edge-Triggered) into the
+ *!-  Parser, stamping every Chunk with its Arrival Time.
+ *!-  Returns FALSE if the Line failed.
+ */
+Bool RTU_Port_Receive(
+        Modbus_RTU_Port *const Port) {
+
+    Bool Check_Ok = TRUE;
+    ssize_t Received = 0;
+    uint8_t Chunk[RTU_PORT_RX_CHUNK];
+
+    for (;;) {
+        Received = read(Port->Fd, Chunk, sizeof(Chunk));
+        if (Received > 0) {
+            (void) Modbus_RTU_Feed(&Port->Parser, Chunk, (uint32_t) Received,
+                                   Modbus_Now_ns());
+        }
+        else if (Received == 0) {
+            break;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+            break;
+        }
+        else if (errno != EINTR) {
+            Check_Ok = FALSE;
+            break;
+        }
+    }
+    return Check_Ok;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_RTU_Port_Open() opens the tty of "Spec",
+ *!-  "Path[,Baud[,Format]]", and attaches the Port to it.
+ */
+Bool Modbus_RTU_Port_Open(
+        Modbus_RTU_Port *const Port,
+        const char *const Spec,
+        Modbus_RTU_Role const Role,
+        Modbus_RTU_Callback const Callback,
+        void *const Context) {
+
+    Bool Check_Ok = FALSE;
+    const char *const Line = strchr(Spec, ',');
+    size_t const Length = (Line != NULL) ? (size_t) (Line - Spec) : strlen(Spec);
+    char Path[PATH_MAX];
+    int Fd = -1;
+
+    memset(Port, 0, sizeof(*Port));
+    Port->Fd = -1;
+    Port->Epoll_Fd = -1;
+    Port->Timer_Fd = -1;
+    if (Length < sizeof(Path)) {
+        memcpy(Path, Spec, Length);
+        Path[Length] = '\0';
+        Fd = open(Path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    }
+    if (Fd >= 0) {
+        Check_Ok = Modbus_RTU_Port_Attach(Port, Fd,
+                                          (Line != NULL) ? (Line + 1) : NULL,
+                                          Role, Callback, Context);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_RTU_Port_Attach() takes over an open tty "Fd", e.g.
+ *!-  one Side of an openpty() Pair, configures it per "Line"
+ *!-  ("Baud[,Format]", NULL: Defaults) and sets up the Parser.
+ *!-  "Callback" receives every Frame received, CRC included.
+ *!-  The Port owns "Fd" from here on, also on Failure.
+ */
+Bool Modbus_RTU_Port_Attach(
+        Modbus_RTU_Port *const Port,
+        int const Fd,
+        const char *const Line,
+        Modbus_RTU_Role const Role,
+        Modbus_RTU_Callback const Callback,
+        void *const Context) {
+
+    Bool Check_Ok = FALSE;
+    struct epoll_event Event;
+
+    memset(Port, 0, sizeof(*Port));
+    Port->Fd = Fd;
+    Port->Callback = Callback;
+    Port->Context = Context;
+    Port->Epoll_Fd = epoll_create1(EPOLL_CLOEXEC);
+    Port->Timer_Fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    if ((Port->Epoll_Fd >= 0) && (Port->Timer_Fd >= 0) &&
+        (fcntl(Fd, F_SETFL, fcntl(Fd, F_GETFL) | O_NONBLOCK) == 0) &&
+        (RTU_Port_Configure(Fd, Line, &Port->Baud) == TRUE)) {
+        Modbus_RTU_Parser_Init(&Port->Parser, Port->Baud, Role,
+                               RTU_Port_Frame, Port);
+        Event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        Event.data.u64 = PORT_TAG_LINE;
+        Check_Ok = (Bool) (epoll_ctl(Port->Epoll_Fd, EPOLL_CTL_ADD,
+                                     Fd, &Event) == 0);
+        Event.events = EPOLLIN;
+        Event.data.u64 = PORT_TAG_TIMER;
+        if (Check_Ok == TRUE) {
+            Check_Ok = (Bool) (epoll_ctl(Port->Epoll_Fd, EPOLL_CTL_ADD,
+                                         Port->Timer_Fd, &Event) == 0);
+        }
+    }
+
+    if (Check_Ok == FALSE) {
+        Modbus_RTU_Port_Close(Port);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_RTU_Port_Send() queues a sealed ADU. It is written in
+ *!-  one Piece as soon as the Line allows: right away after t3.5
+ *!-  of Silence, else by the Timer at the exact Moment it does.
+ *!-  Returns FALSE while the last ADU is still going out.
+ */
+Bool Modbus_RTU_Port_Send(
+        Modbus_RTU_Port *const Port,
+        const Modbus_Frame *const Adu) {
+
+    Bool Check_Ok = FALSE;
+
+    if ((Port->Fd >= 0) && (Port->Tx_Length == 0) &&
+        (Adu->Length >= FRAME_MIN_LENGTH) &&
+        (Adu->Length <= MODBUS_MAX_ADU_LENGTH)) {
+        if (Adu->Adu != Port->Tx_Adu) {
+            memcpy(Port->Tx_Adu, Adu->Adu, Adu->Length);
+        }
+        Port->Tx_Head = 0;
+        Port->Tx_Length = Adu->Length;
+        Check_Ok = RTU_Port_Transmit(Port, Modbus_Now_ns());
+        RTU_Port_Arm(Port);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_RTU_Port_Poll() waits up to "TimeoutMs" (-1: forever)
+ *!-  for Bytes or the Timer, feeds the Parser (running the Frame
+ *!-  Callback) and starts a queued Transmission when due. The
+ *!-  Wake Time "Wake_ns" (0: none) of the Layer above also ends
+ *!-  the Wait. The Timer is left armed for the next Event, so a
+ *!-  Loop may as well wait on "Epoll_Fd" and poll with Timeout 0.
+ *!-  Returns the Number of Events, or -1 on Error.
+ */
+int Modbus_RTU_Port_Poll(
+        Modbus_RTU_Port *const Port,
+        int const TimeoutMs) {
+
+    Bool Check_Ok = TRUE;
+    struct epoll_event Events[RTU_PORT_MAX_EVENTS];
+    uint64_t Expirations = 0;
+    uint64_t Now_ns = 0;
+    int Count = 0;
+    int Index = 0;
+
+    Count = epoll_wait(Port->Epoll_Fd, Events, RTU_PORT_MAX_EVENTS, TimeoutMs);
+    if ((Count < 0) && (errno == EINTR)) {
+        Count = 0;
+    }
+    Check_Ok = (Bool) (Count >= 0);
+
+    for (Index = 0; (Check_Ok == TRUE) && (Index < Count); Index++) {
+        if (Events[Index].data.u64 == PORT_TAG_TIMER) {
+            (void) read(Port->Timer_Fd, &Expirations, sizeof(Expirations));
+            Port->Timer_ns = 0;
+            continue;
+        }
+        if (Events[Index].events & (EPOLLERR | EPOLLHUP)) {
+            Check_Ok = FALSE;
+            break;
+        }
+        if (Events[Index].events & EPOLLIN) {
+            Check_Ok = RTU_Port_Receive(Port);
+        }
+        if ((Check_Ok == TRUE) && (Events[Index].events & EPOLLOUT) &&
+            (Port->Tx_Started == TRUE)) {
+            Check_Ok = RTU_Port_Flush(Port);
+        }
+    }
+
+    if (Check_Ok == TRUE) {
+        Now_ns = Modbus_Now_ns();
+        (void) Modbus_RTU_Poll(&Port->Parser, Now_ns);
+        if ((Port->Wake_ns != 0) && (Now_ns >= Port->Wake_ns)) {
+            Port->Wake_ns = 0;
+        }
+        Check_Ok = RTU_Port_Transmit(Port, Now_ns);
+        RTU_Port_Arm(Port);
+    }
+    return (Check_Ok == TRUE) ? Count : -1;
+}
+
+//!-  Modbus_RTU_Port_Close() closes the tty, the Timer and the epoll Set.
+void Modbus_RTU_Port_Close(
+        Modbus_RTU_Port *const Port) {
+
+    if (Port->Fd >= 0) {
+        close(Port->Fd);
+        Port->Fd = -1;
+    }
+    if (Port->Timer_Fd >= 0) {
+        close(Port->Timer_Fd);
+        Port->Timer_Fd = -1;
+    }
+    if (Port->Epoll_Fd >= 0) {
+        close(Port->Epoll_Fd);
+        Port->Epoll_Fd = -1;
+    }
+    Port->Tx_Head = 0;
+    Port->Tx_Length = 0;
+    Port->Tx_Started = FALSE;
+}
@@ -0,0 +1,113 @@
+/*
+ * Modbus_RTU_Server.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_RTU_Server.c
+*****************************************************************************/
+
+//!-  Headers
+#include "Modbus_Frame.h"
+#include "Modbus_Clock.h"
+#include "Modbus_Dispatch.h"
+#include "Modbus_Metrics.h"
+#include "Modbus_RTU.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+void RTU_Server_Request(
+        void *const Context,
+        const Modbus_Frame *const Frame);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  RTU_Server_Request() serves one Request as the Parser completes
+ *!-  it. The Response is built straight into the Tx Buffer of the
+ *!-  Port, which sends it t3.5 after the Request ended. A Master
+ *!-  that does not wait for the Answer gets nothing for the
+ *!-  Request that overlaps it. Parsing is timed from the Start of
+ *!-  the Feed or Poll of the Parser that completed the Frame.
+ */
+void RTU_Server_Request(
+        void *const Context,
+        const Modbus_Frame *const Frame) {
+
+    Modbus_RTU_Server *const Server = Context;
+    Modbus_RTU_Port *const Port = &Server->Port;
+    uint64_t Parsed_ns = 0;
+    uint64_t Served_ns = 0;
+    Modbus_Frame Request;
+    Modbus_Frame Response;
+
+    if (Port->Tx_Length == 0) {
+        Frame_Attach(&Request, Frame->Adu, Frame->Length - FRAME_CRC_LENGTH);
+        Frame_Attach(&Response, Port->Tx_Adu, 0);
+        Parsed_ns = Modbus_Now_ns();
+        Modbus_Metrics_Stage_Time(METRICS_PARSE,
+                                  Parsed_ns - Port->Parser.Scan_ns);
+        if (Modbus_Response(&Request, &Response) == TRUE) {
+            Served_ns = Modbus_Now_ns();
+            Modbus_Metrics_Stage_Time(METRICS_DISPATCH, Served_ns - Parsed_ns);
+            if (Frame_Seal(&Response) == TRUE) {
+                (void) Modbus_RTU_Port_Send(Port, &Response);
+            }
+            Modbus_Metrics_Stage_Time(METRICS_ENCODE,
+                                      Modbus_Now_ns() - Served_ns);
+        }
+        Server->Requests_Served++;
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Modbus_RTU_Server_Open() serves on the tty of "Spec" (see Modbus_RTU.h).
+Bool Modbus_RTU_Server_Open(
+        Modbus_RTU_Server *const Server,
+        const char *const Spec) {
+
+    Server->Requests_Served = 0;
+    return Modbus_RTU_Port_Open(&Server->Port, Spec, RTU_PARSE_REQUESTS,
+                                RTU_Server_Request, Server);
+}
+
+/*
+ *!-  Modbus_RTU_Server_Attach() serves on an open tty "Fd" with the
+ *!-  Settings "Line" ("Baud[,Format]", NULL: Defaults).
+ */
+Bool Modbus_RTU_Server_Attach(
+        Modbus_RTU_Server *const Server,
+        int const Fd,
+        const char *const Line) {
+
+    Server->Requests_Served = 0;
+    return Modbus_RTU_Port_Attach(&Server->Port, Fd, Line, RTU_PARSE_REQUESTS,
+                                  RTU_Server_Request, Server);
+}
+
+/*
+ *!-  Modbus_RTU_Server_Poll() waits up to "TimeoutMs" (-1: forever)
+ *!-  and serves what came in. Returns -1 once the Line failed.
+ */
+int Modbus_RTU_Server_Poll(
+        Modbus_RTU_Server *const Server,
+        int const TimeoutMs) {
+
+    return Modbus_RTU_Port_Poll(&Server->Port, TimeoutMs);
+}
+
+//!-  Modbus_RTU_Server_Close() releases the Line.
+void Modbus_RTU_Server_Close(
+        Modbus_RTU_Server *const Server) {
+
+    Modbus_RTU_Port_Close(&Server->Port);
+}
@@ -10,24 +10,347 @@
  ****************************************************************************/
 
 //!-  Headers
+#include <ctype.h>
+#include <pty.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include "Modbus.h"
+#include "Modbus_Clock.h"
+#include "Modbus_File.h"
+#include "Modbus_Image.h"
+#include "Modbus_Metrics.h"
+#include "Modbus_RTU.h"
+#include "Modbus_TCP.h"
 
 /****************************************************************************
 !-  LOCAL DEFINITIONS
 *****************************************************************************/
 
+//!-  Table Sizes of every simulated Unit, the Default Unit too.
+#define SLAVE_UNIT_COILS        (2048)
+#define SLAVE_UNIT_DINPUTS      (2048)
+#define SLAVE_UNIT_IREGISTERS   (1024)
+#define SLAVE_UNIT_HREGISTERS   (1024)
+
+//!-  Poll Period while serving an Image, to pick up Layout Changes.
+#define SLAVE_IMAGE_POLL_MS     (100)
+
+//!-  Period of publishing the Metrics, when they are exported.
+#define SLAVE_METRICS_POLL_MS   (100)
+
+//!-  Files 1 .. SLAVE_UNIT_FILES mapped for every Unit, when asked.
+#define SLAVE_UNIT_FILES        (4)
+
+//!-  Line Name that makes the Slave serve on a new Pseudo-Terminal.
+#define SLAVE_PTY               "pty"
+
+Bool Slave_Map(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint32_t const Count);
+
+Bool Slave_Map_Profile(
+        Modbus_Data *const Unit,
+        const char *Profile);
+
+Bool Slave_Add_Unit(
+        uint8_t const Device_ID,
+        const char *const Profile);
+
+Bool Slave_Map_Files(
+        uint8_t const Device_ID,
+        const char *const Prefix);
+
+Bool Slave_Open_RTU(
+        const char *const Spec);
+
 /****************************************************************************
 !-  LOCAL VARIABLES
 *****************************************************************************/
 
+static Modbus_TCP_Server  Slave_Server;
+static Modbus_RTU_Server  Slave_RTU;
+static Modbus_Image       Slave_Image;
+static int                Slave_Pty = -1;
+static Modbus_Metrics_Export  Slave_Metrics = { -1, NULL };
+
 /****************************************************************************
 !-  LOCAL FUNCTIONS
 *****************************************************************************/
 
-int main() {
+//!-  Slave_Map() maps Registers in the Image or on the Heap.
+Bool Slave_Map(
+        Modbus_Data *const Unit,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint32_t const Count) {
 
-    Bool Ckeck_OK = FALSE;
+    Bool Check_Ok = FALSE;
+
+    if (Unit->Shared == TRUE) {
+        Check_Ok = Modbus_Image_Map_Registers(&Slave_Image, Unit->Device_ID,
+                                              Table, Start, Count);
+    }
+    else {
+        Check_Ok = Modbus_Map_Registers(Unit, Table, Start, Count);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Slave_Map_Profile() maps the Register Blocks of a Device
+ *!-  Profile, a Comma-separated List of "h<first>-<last>"
+ *!-  (Holding) and "i<first>-<last>" (Input) Ranges,
+ *!-  e.g. "h0-124,h40000-40999,i0-15".
+ */
+Bool Slave_Map_Profile(
+        Modbus_Data *const Unit,
+        const char *Profile) {
+
+    Bool Check_Ok = TRUE;
+    Modbus_Table Table = TABLE_HOLDING_REGISTERS;
+    unsigned long First = 0;
+    unsigned long Last = 0;
+    char *End = NULL;
+
+    while ((Check_Ok == TRUE) && (*Profile != '\0')) {
+        Table = (*Profile == 'i') ? TABLE_INPUT_REGISTERS :
+                                    TABLE_HOLDING_REGISTERS;
+        Check_Ok = (Bool) ((*Profile == 'h') || (*Profile == 'i'));
+        if (Check_Ok == TRUE) {
+            First = strtoul(Profile + 1, &End, 0);
+            Last = (*End == '-') ? strtoul(End + 1, &End, 0) : First;
+            Check_Ok = (Bool) ((First <= Last) && (Last < MAX_UNIT_ITEMS) &&
+                               ((*End == ',') || (*End == '\0')));
+        }
+        if (Check_Ok == TRUE) {
+            Check_Ok = Slave_Map(Unit, Table, (uint16_t) First,
+                                 (uint32_t) (Last - First + 1));
+            Profile = (*End == ',') ? End + 1 : End;
+        }
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Slave_Add_Unit() hosts a simulated Unit, in the Image when
+ *!-  one is open. A Unit the Image already holds keeps its Layout
+ *!-  and Values; a new one gets the Profile or the default Blocks.
+ *!-  The Default Unit Modbus_Init() made is replaced, so it gets
+ *!-  the same Layout as the others.
+ */
+Bool Slave_Add_Unit(
+        uint8_t const Device_ID,
+        const char *const Profile) {
 
-    return Ckeck_OK;
+    Bool Check_Ok = FALSE;
+    Modbus_Data *Unit = NULL;
+
+    if (Slave_Image.Base != NULL) {
+        Unit = Modbus_Image_Add_Unit(&Slave_Image, Device_ID,
+                                     SLAVE_UNIT_COILS, SLAVE_UNIT_DINPUTS);
+    }
+    else {
+        (void) Modbus_Remove_Unit(Device_ID);
+        Unit = Modbus_Add_Unit(Device_ID, SLAVE_UNIT_COILS,
+                               SLAVE_UNIT_DINPUTS, 0, 0);
+    }
+
+    if (Unit == NULL) {
+        Check_Ok = FALSE;
+    }
+    else if ((Unit->Numbers[TABLE_INPUT_REGISTERS] != 0) ||
+             (Unit->Numbers[TABLE_HOLDING_REGISTERS] != 0)) {
+        Check_Ok = TRUE;
+    }
+    else if (Profile != NULL) {
+        Check_Ok = Slave_Map_Profile(Unit, Profile);
+    }
+    else {
+        Check_Ok = (Bool) ((Slave_Map(Unit, TABLE_INPUT_REGISTERS, 0,
+                                      SLAVE_UNIT_IREGISTERS) == TRUE) &&
+                           (Slave_Map(Unit, TABLE_HOLDING_REGISTERS, 0,
+                                      SLAVE_UNIT_HREGISTERS) == TRUE));
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Slave_Map_Files() maps the Files 1 .. SLAVE_UNIT_FILES of a
+ *!-  Unit, FILE_MAX_RECORDS Records each, onto the Host Files
+ *!-  "Prefix.Unit.File", which keep them across Restarts.
+ */
+Bool Slave_Map_Files(
+        uint8_t const Device_ID,
+        const char *const Prefix) {
+
+    Bool Check_Ok = (Bool) (MODBUS_UNITS[Device_ID] != NULL);
+    uint16_t Number = 0;
+    char Path[256];
+
+    for (Number = 1; (Check_Ok == TRUE) && (Number <= SLAVE_UNIT_FILES);
+         Number++) {
+        (void) snprintf(Path, sizeof(Path), "%s.%u.%u", Prefix,
+                        Device_ID, Number);
+        Check_Ok = Modbus_Map_File(MODBUS_UNITS[Device_ID], Number, Path,
+                                   FILE_MAX_RECORDS);
+    }
+    return Check_Ok;
 }
 
+/*
+ *!-  Slave_Open_RTU() serves on the Serial Line of "Spec". For
+ *!-  "pty[,Baud[,Format]]" it opens a Pseudo-Terminal Pair, serves
+ *!-  on the Master Side and prints the Path of the other Side
+ *!-  for a Modbus RTU Master to open. The Slave Side stays open
+ *!-  here, so the Line survives Masters coming and going.
+ */
+Bool Slave_Open_RTU(
+        const char *const Spec) {
+
+    Bool Check_Ok = FALSE;
+    size_t const Length = strlen(SLAVE_PTY);
+    int Master_Fd = -1;
+    char Name[64];
+
+    if ((strncmp(Spec, SLAVE_PTY, Length) == 0) &&
+        ((Spec[Length] == '\0') || (Spec[Length] == ','))) {
+        if (openpty(&Master_Fd, &Slave_Pty, Name, NULL, NULL) == 0) {
+            Check_Ok = Modbus_RTU_Server_Attach(
+                           &Slave_RTU, Master_Fd,
+                           (Spec[Length] == ',') ? &Spec[Length + 1] : NULL);
+        }
+        if (Check_Ok == TRUE) {
+            printf("%s\n", Name);
+            fflush(stdout);
+        }
+    }
+    else {
+        Check_Ok = Modbus_RTU_Server_Open(&Slave_RTU, Spec);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Usage: Modbus_Slave [port|line] [units] [profile|-] [image|-]
+ *!-         [metrics|-] [files]
+ *!-  Serves Units 1 .. "units" over Modbus TCP (default Port 502)
+ *!-  to simulate a Rack, the Default Unit 1 laid out like the
+ *!-  others. With a "profile" (see Slave_Map_Profile()) the Units
+ *!-  map only the listed Register Blocks. With an "image" Path
+ *!-  they live in that Process Image (see Modbus_Image.h), shared
+ *!-  with other Processes and kept across Restarts.
+ *!-  A Serial "line" instead of a Port, "Path[,Baud[,Format]]"
+ *!-  or "pty[,Baud[,Format]]" (see Slave_Open_RTU()), serves the
+ *!-  Units over Modbus RTU. With a "metrics" Path (e.g. under
+ *!-  /dev/shm) the Runtime Metrics (see Modbus_Metrics.h) are
+ *!-  published there every SLAVE_METRICS_POLL_MS for Modbus_Top.
+ *!-  With a "files" Prefix every Unit serves FC20/FC21 from Files
+ *!-  mapped onto Host Files (see Slave_Map_Files()).
+ */
+int main(int argc, char *argv[]) {
+
+    Bool Ckeck_OK = FALSE;
+    uint16_t Port = MODBUS_TCP_PORT;
+    const char *Line = NULL;
+    uint16_t Units = MODBUS_DEFAULT_UNIT;
+    uint16_t Device_ID = 0;
+    const char *Profile = NULL;
+    const char *Image_Path = NULL;
+    const char *Metrics_Path = NULL;
+    const char *Files_Prefix = NULL;
+    int Timeout_Ms = -1;
+    uint64_t Published_ns = 0;
+
+    if ((argc > 1) && (isdigit((unsigned char) argv[1][0]) == 0)) {
+        Line = argv[1];
+    }
+    else if (argc > 1) {
+        Port = (uint16_t) atoi(argv[1]);
+    }
+    if (argc > 2) {
+        Units = (uint16_t) atoi(argv[2]);
+    }
+    if ((argc > 3) && (argv[3][0] != '-')) {
+        Profile = argv[3];
+    }
+    if ((argc > 4) && (argv[4][0] != '-')) {
+        Image_Path = argv[4];
+    }
+    if ((argc > 5) && (argv[5][0] != '-')) {
+        Metrics_Path = argv[5];
+    }
+    if (argc > 6) {
+        Files_Prefix = argv[6];
+    }
+
+    Ckeck_OK = Modbus_Init();
+    if ((Ckeck_OK == TRUE) && (Image_Path != NULL)) {
+        Ckeck_OK = Modbus_Image_Open(&Slave_Image, Image_Path,
+                                     MODBUS_IMAGE_DEFAULT_BYTES);
+        Timeout_Ms = SLAVE_IMAGE_POLL_MS;
+    }
+    if ((Ckeck_OK == TRUE) && (Metrics_Path != NULL)) {
+        Ckeck_OK = Modbus_Metrics_Export_Open(&Slave_Metrics, Metrics_Path);
+        Timeout_Ms = SLAVE_METRICS_POLL_MS;
+        if (Ckeck_OK == FALSE) {
+            fprintf(stderr, "Modbus_Slave: cannot export metrics to %s\n",
+                    Metrics_Path);
+            return 1;
+        }
+    }
+    for (Device_ID = MIN_DEVICE_ID;
+         (Ckeck_OK == TRUE) && (Device_ID <= Units) &&
+         (Device_ID <= MAX_DEVICE_ID); Device_ID++) {
+        Ckeck_OK = Slave_Add_Unit((uint8_t) Device_ID, Profile);
+        if ((Ckeck_OK == TRUE) && (Files_Prefix != NULL)) {
+            Ckeck_OK = Slave_Map_Files((uint8_t) Device_ID, Files_Prefix);
+        }
+    }
+    if ((Ckeck_OK == TRUE) && (Line != NULL)) {
+        Ckeck_OK = Slave_Open_RTU(Line);
+    }
+    else if (Ckeck_OK == TRUE) {
+        Ckeck_OK = Modbus_TCP_Server_Open(&Slave_Server, Port);
+    }
+    if ((Ckeck_OK == FALSE) && (Line != NULL)) {
+        fprintf(stderr, "Modbus_Slave: cannot serve on line %s\n", Line);
+        return 1;
+    }
+    if (Ckeck_OK == FALSE) {
+        fprintf(stderr, "Modbus_Slave: cannot serve on port %u\n", Port);
+        return 1;
+    }
+
+    while (((Line != NULL) ?
+            Modbus_RTU_Server_Poll(&Slave_RTU, Timeout_Ms) :
+            Modbus_TCP_Server_Poll(&Slave_Server, Timeout_Ms)) >= 0) {
+        if (Slave_Image.Base != NULL) {
+            (void) Modbus_Image_Refresh(&Slave_Image);
+        }
+        if ((Slave_Metrics.Base != NULL) &&
+            (Modbus_Now_ns() >= (Published_ns +
+                                 (SLAVE_METRICS_POLL_MS * NS_PER_MS)))) {
+            Modbus_Metrics_Publish(&Slave_Metrics);
+            Published_ns = Modbus_Now_ns();
+        }
+    }
+
+    if (Line != NULL) {
+        Modbus_RTU_Server_Close(&Slave_RTU);
+    }
+    else {
+        Modbus_TCP_Server_Close(&Slave_Server);
+    }
+    if (Slave_Pty >= 0) {
+        close(Slave_Pty);
+    }
+    if (Slave_Image.Base != NULL) {
+        Modbus_Image_Close(&Slave_Image);
+    }
+    Modbus_Metrics_Export_Close(&Slave_Metrics);
+    return 0;
+}
@@ -0,0 +1,245 @@
+/*
+ * Modbus_Snapshot_Bench.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Snapshot_Bench.c
+ ****************************************************************************/
+
+//!-  Headers
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Modbus.h"
+#include "Modbus_Clock.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  The Writer publishes BENCH_REGISTERS Holding Registers that
+ *!-  all carry the same Counter, e.g. a 64-bit Value or two Floats.
+ *!-  The Block straddles a Page Boundary, so a Snapshot spans two
+ *!-  Sequence Locks. A Reader that sees different Words saw a
+ *!-  torn Update.
+ */
+#define BENCH_UNIT          (1)
+#define BENCH_START         (REGISTER_PAGE_SIZE - 2)
+#define BENCH_REGISTERS     (4)
+#define BENCH_HREGISTERS    (2 * REGISTER_PAGE_SIZE)
+#define BENCH_MAX_READERS   (64)
+#define BENCH_READERS       (8)
+#define BENCH_MILLISECONDS  (500)
+
+//!-  "Bench_Reader" counts the Snapshots of one Reader Thread.
+typedef struct {
+    pthread_t  Thread;
+    uint32_t   Cpu;
+    Bool       Raw;
+    uint64_t   Reads;
+    uint64_t   Torn;
+} __attribute__((aligned(MODBUS_CACHE_LINE))) Bench_Reader;
+
+void Bench_Pin(
+        uint32_t const Cpu);
+
+void *Bench_Writer(
+        void *const Argument);
+
+void *Bench_Reader_Run(
+        void *const Argument);
+
+uint64_t Bench_Round(
+        uint32_t const Readers,
+        Bool const Raw);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Bench_Reader  Bench_Readers[BENCH_MAX_READERS];
+static uint64_t      Bench_Writes;
+static uint32_t      Bench_Milliseconds = BENCH_MILLISECONDS;
+static uint32_t      Bench_Cpus = 1;
+static Bool          Bench_Stop;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Bench_Pin() binds the calling Thread to one Cpu.
+void Bench_Pin(
+        uint32_t const Cpu) {
+
+    cpu_set_t Set;
+
+    CPU_ZERO(&Set);
+    CPU_SET(Cpu % Bench_Cpus, &Set);
+    (void) pthread_setaffinity_np(pthread_self(), sizeof(Set), &Set);
+}
+
+//!-  Bench_Writer() publishes the Counter back to back on Cpu 0.
+void *Bench_Writer(
+        void *const Argument) {
+
+    Modbus_Data *const Unit = MODBUS_UNITS[BENCH_UNIT];
+    uint16_t Values[BENCH_REGISTERS];
+    uint16_t Counter = 0;
+    uint32_t Index = 0;
+
+    (void) Argument;
+    Bench_Pin(0);
+    Bench_Writes = 0;
+    while (__atomic_load_n(&Bench_Stop, __ATOMIC_RELAXED) == FALSE) {
+        Counter++;
+        for (Index = 0; Index < BENCH_REGISTERS; Index++) {
+            Values[Index] = Counter;
+        }
+        (void) Modbus_Publish_Registers(Unit, TABLE_HOLDING_REGISTERS,
+                                        BENCH_START, BENCH_REGISTERS, Values);
+        Bench_Writes++;
+    }
+    return NULL;
+}
+
+/*
+ *!-  Bench_Reader_Run() takes Snapshots until stopped. A "Raw"
+ *!-  Reader copies the Registers without the Sequence Lock, to
+ *!-  show what the Lock protects against.
+ */
+void *Bench_Reader_Run(
+        void *const Argument) {
+
+    Bench_Reader *const Reader = Argument;
+    const Modbus_Data *const Unit = MODBUS_UNITS[BENCH_UNIT];
+    uint16_t Values[BENCH_REGISTERS];
+    uint32_t Index = 0;
+    uint32_t Address = 0;
+    uint64_t Reads = 0;
+    uint64_t Torn = 0;
+
+    Bench_Pin(Reader->Cpu);
+    while (__atomic_load_n(&Bench_Stop, __ATOMIC_RELAXED) == FALSE) {
+        if (Reader->Raw == TRUE) {
+            for (Index = 0; Index < BENCH_REGISTERS; Index++) {
+                Address = BENCH_START + Index;
+                Values[Index] = __atomic_load_n(
+                    &Unit->HPages[Address >> REGISTER_PAGE_SHIFT]->
+                        Registers[Address & REGISTER_PAGE_MASK],
+                    __ATOMIC_RELAXED);
+            }
+        }
+        else {
+            (void) Modbus_Snapshot_Registers(Unit, TABLE_HOLDING_REGISTERS,
+                                             BENCH_START, BENCH_REGISTERS,
+                                             Values);
+        }
+        for (Index = 1; Index < BENCH_REGISTERS; Index++) {
+            if (Values[Index] != Values[0]) {
+                Torn++;
+                break;
+            }
+        }
+        Reads++;
+    }
+    Reader->Reads = Reads;
+    Reader->Torn = Torn;
+    return NULL;
+}
+
+/*
+ *!-  Bench_Round() runs the Writer against "Readers" Readers and
+ *!-  returns how many torn Snapshots they saw.
+ */
+uint64_t Bench_Round(
+        uint32_t const Readers,
+        Bool const Raw) {
+
+    pthread_t Writer;
+    uint32_t Index = 0;
+    uint64_t Reads = 0;
+    uint64_t Torn = 0;
+    uint64_t Started = 0;
+    uint64_t Elapsed = 0;
+
+    __atomic_store_n(&Bench_Stop, FALSE, __ATOMIC_RELAXED);
+    Started = Modbus_Now_ns();
+    (void) pthread_create(&Writer, NULL, Bench_Writer, NULL);
+    for (Index = 0; Index < Readers; Index++) {
+        Bench_Readers[Index].Cpu = Index + 1;
+        Bench_Readers[Index].Raw = Raw;
+        (void) pthread_create(&Bench_Readers[Index].Thread, NULL,
+                              Bench_Reader_Run, &Bench_Readers[Index]);
+    }
+    (void) usleep(Bench_Milliseconds * 1000U);
+    __atomic_store_n(&Bench_Stop, TRUE, __ATOMIC_RELAXED);
+    for (Index = 0; Index < Readers; Index++) {
+        (void) pthread_join(Bench_Readers[Index].Thread, NULL);
+        Reads += Bench_Readers[Index].Reads;
+        Torn += Bench_Readers[Index].Torn;
+    }
+    (void) pthread_join(Writer, NULL);
+    Elapsed = Modbus_Now_ns() - Started;
+
+    printf("%-8s %3u readers  %10.2f Mreads/s  %8.2f Mreads/s/reader  "
+           "%8.2f Mwrites/s  torn %llu\n",
+           (Raw == TRUE) ? "raw" : "seqlock", Readers,
+           (double) Reads * 1e3 / (double) Elapsed,
+           (double) Reads * 1e3 / (double) Elapsed / Readers,
+           (double) Bench_Writes * 1e3 / (double) Elapsed,
+           (unsigned long long) Torn);
+    fflush(stdout);
+    return Torn;
+}
+
+/*
+ *!-  Usage: Modbus_Snapshot_Bench [readers] [milliseconds]
+ *!-  Runs one Writer publishing Multi-Register Updates against
+ *!-  1, 2, 4 .. "readers" Reader Threads taking Snapshots, and
+ *!-  prints the Read Throughput of every Round. Each Round is run
+ *!-  with Modbus_Snapshot_Registers() and with raw Copies. Exits
+ *!-  non-zero if any Snapshot was torn; raw Copies may well be.
+ */
+int main(int argc, char *argv[]) {
+
+    uint32_t Max_Readers = BENCH_READERS;
+    uint32_t Readers = 0;
+    uint64_t Torn = 0;
+    long Cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (argc > 1) {
+        Max_Readers = (uint32_t) atoi(argv[1]);
+    }
+    if (argc > 2) {
+        Bench_Milliseconds = (uint32_t) atoi(argv[2]);
+    }
+    if (Max_Readers > BENCH_MAX_READERS) {
+        Max_Readers = BENCH_MAX_READERS;
+    }
+    Bench_Cpus = (Cpus > 0) ? (uint32_t) Cpus : 1;
+
+    if (Modbus_Add_Unit(BENCH_UNIT, 0, 0, 0, BENCH_HREGISTERS) == NULL) {
+        fprintf(stderr, "Modbus_Snapshot_Bench: cannot add unit\n");
+        return EXIT_FAILURE;
+    }
+    printf("%u cpus, %u registers at %u, %u ms per round\n", Bench_Cpus,
+           BENCH_REGISTERS, BENCH_START, Bench_Milliseconds);
+
+    for (Readers = 1; Readers <= Max_Readers; Readers *= 2) {
+        Torn += Bench_Round(Readers, FALSE);
+        (void) Bench_Round(Readers, TRUE);
+    }
+    (void) Modbus_Remove_Unit(BENCH_UNIT);
+    if (Torn != 0) {
+        fprintf(stderr, "Modbus_Snapshot_Bench: %llu torn snapshots\n",
+                (unsigned long long) Torn);
+    }
+    return (Torn == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,326 @@
+/*
+ * Modbus_Swap.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Swap.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus.h"
+#include "Modbus_Swap.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SWAP16_HAVE_X86  1
+#else
+#define SWAP16_HAVE_X86  0
+#endif
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  On a Little-Endian Host both Directions are the same Operation:
+ *!-  swap the two Bytes of every 16Bit Lane.
+ */
+typedef void (*Swap16_Fn)(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Count);
+
+static void Swap16_Portable(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Count);
+
+/*
+ *!-  "Swap_Permute_Fn" reorders the Bytes of every Element by a
+ *!-  16-Byte Pattern, see Swap_Elements().
+ */
+typedef void (*Swap_Permute_Fn)(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Bytes,
+        const uint8_t *Pattern);
+
+static void Swap_Permute_Portable(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Bytes,
+        const uint8_t *Pattern);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Swap16_Fn        Swap16_Active_Fn = Swap16_Portable;
+static Swap_Permute_Fn  Swap_Permute_Active_Fn = Swap_Permute_Portable;
+static Swap16_Engine    Swap16_Active = SWAP16_ENGINE_PORTABLE;
+static Bool             Swap16_Ssse3_Supported = FALSE;
+static Bool             Swap16_Avx2_Supported = FALSE;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+static void Swap16_Portable(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Count) {
+
+    uint8_t Byte1 = 0;
+
+    while (Count--) {
+        //!-  Src and Dst may be the same Buffer.
+        Byte1 = Src[0];
+        Dst[0] = Src[1];
+        Dst[1] = Byte1;
+        Dst += 2;
+        Src += 2;
+    }
+}
+
+/*
+ *!-  Swap_Permute_Portable() moves Byte "i" of every 16-Byte Block
+ *!-  from "Pattern[i]" of the Block. Elements are whole within a
+ *!-  Block, so a short last Block works the same way.
+ */
+static void Swap_Permute_Portable(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Bytes,
+        const uint8_t *Pattern) {
+
+    uint8_t Block[16];
+    uint32_t Index = 0;
+    uint32_t Length = 0;
+
+    while (Bytes > 0) {
+        //!-  Src and Dst may be the same Buffer.
+        Length = (Bytes < 16) ? Bytes : 16;
+        memcpy(Block, Src, Length);
+        for (Index = 0; Index < Length; Index++) {
+            Dst[Index] = Block[Pattern[Index]];
+        }
+        Dst += Length;
+        Src += Length;
+        Bytes -= Length;
+    }
+}
+
+#if SWAP16_HAVE_X86
+
+__attribute__((target("ssse3")))
+static void Swap_Permute_Ssse3(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Bytes,
+        const uint8_t *Pattern) {
+
+    __m128i const Shuffle = _mm_loadu_si128((const __m128i *) Pattern);
+
+    while (Bytes >= 16) {
+        _mm_storeu_si128((__m128i *) Dst, _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *) Src), Shuffle));
+        Dst += 16;
+        Src += 16;
+        Bytes -= 16;
+    }
+    Swap_Permute_Portable(Dst, Src, Bytes, Pattern);
+}
+
+__attribute__((target("avx2")))
+static void Swap_Permute_Avx2(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Bytes,
+        const uint8_t *Pattern) {
+
+    __m256i const Shuffle = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *) Pattern));
+
+    while (Bytes >= 64) {
+        __m256i const Low = _mm256_loadu_si256((const __m256i *) Src);
+        __m256i const High = _mm256_loadu_si256((const __m256i *) (Src + 32));
+
+        _mm256_storeu_si256((__m256i *) Dst, _mm256_shuffle_epi8(Low, Shuffle));
+        _mm256_storeu_si256((__m256i *) (Dst + 32),
+                            _mm256_shuffle_epi8(High, Shuffle));
+        Dst += 64;
+        Src += 64;
+        Bytes -= 64;
+    }
+    Swap_Permute_Ssse3(Dst, Src, Bytes, Pattern);
+}
+
+__attribute__((target("ssse3")))
+static void Swap16_Ssse3(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Count) {
+
+    __m128i const Shuffle = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                          9, 8, 11, 10, 13, 12, 15, 14);
+
+    while (Count >= 8) {
+        _mm_storeu_si128((__m128i *) Dst, _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *) Src), Shuffle));
+        Dst += 16;
+        Src += 16;
+        Count -= 8;
+    }
+    Swap16_Portable(Dst, Src, Count);
+}
+
+__attribute__((target("avx2")))
+static void Swap16_Avx2(
+        uint8_t *Dst,
+        const uint8_t *Src,
+        uint32_t Count) {
+
+    __m256i const Shuffle = _mm256_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+    while (Count >= 16) {
+        _mm256_storeu_si256((__m256i *) Dst, _mm256_shuffle_epi8(
+            _mm256_loadu_si256((const __m256i *) Src), Shuffle));
+        Dst += 32;
+        Src += 32;
+        Count -= 16;
+    }
+    if (Count >= 8) {
+        _mm_storeu_si128((__m128i *) Dst, _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *) Src),
+            _mm256_castsi256_si128(Shuffle)));
+        Dst += 16;
+        Src += 16;
+        Count -= 8;
+    }
+    Swap16_Portable(Dst, Src, Count);
+}
+
+#endif /* SWAP16_HAVE_X86 */
+
+__attribute__((constructor))
+static void Swap16_Constructor(
+        void) {
+
+    Swap16_Init();
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Swap16_Init() selects the widest Kernel the CPU supports.
+void Swap16_Init(
+        void) {
+
+#if SWAP16_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3")) {
+        Swap16_Ssse3_Supported = TRUE;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        Swap16_Avx2_Supported = TRUE;
+    }
+#endif
+
+    if (Swap16_Select(SWAP16_ENGINE_AVX2) == FALSE) {
+        if (Swap16_Select(SWAP16_ENGINE_SSSE3) == FALSE) {
+            (void) Swap16_Select(SWAP16_ENGINE_PORTABLE);
+        }
+    }
+}
+
+/*
+ *!-  Swap16_Select() forces a Kernel, e.g. for Benchmarks.
+ *!-  Returns FALSE if the CPU does not support it.
+ */
+Bool Swap16_Select(
+        Swap16_Engine const Engine) {
+
+    Bool Check_Ok = TRUE;
+
+    switch (Engine) {
+        case SWAP16_ENGINE_PORTABLE:
+            Swap16_Active_Fn = Swap16_Portable;
+            Swap_Permute_Active_Fn = Swap_Permute_Portable;
+            break;
+#if SWAP16_HAVE_X86
+        case SWAP16_ENGINE_SSSE3:
+            if (Swap16_Ssse3_Supported == TRUE) {
+                Swap16_Active_Fn = Swap16_Ssse3;
+                Swap_Permute_Active_Fn = Swap_Permute_Ssse3;
+            }
+            else {
+                Check_Ok = FALSE;
+            }
+            break;
+        case SWAP16_ENGINE_AVX2:
+            if (Swap16_Avx2_Supported == TRUE) {
+                Swap16_Active_Fn = Swap16_Avx2;
+                Swap_Permute_Active_Fn = Swap_Permute_Avx2;
+            }
+            else {
+                Check_Ok = FALSE;
+            }
+            break;
+#endif
+        default:
+            Check_Ok = FALSE;
+            break;
+    }
+
+    if (Check_Ok == TRUE) {
+        Swap16_Active = Engine;
+    }
+    return Check_Ok;
+}
+
+//!-  Swap16_Active_Engine() reports the Kernel in use.
+Swap16_Engine Swap16_Active_Engine(
+        void) {
+
+    return Swap16_Active;
+}
+
+void Registers_To_Wire(
+        uint8_t *const BeOut,
+        const uint16_t *const Registers,
+        uint32_t const Count) {
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    memcpy(BeOut, Registers, Count * 2);
+#else
+    Swap16_Active_Fn(BeOut, (const uint8_t *) Registers, Count);
+#endif
+}
+
+void Registers_From_Wire(
+        uint16_t *const Registers,
+        const uint8_t *const BeIn,
+        uint32_t const Count) {
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    memcpy(Registers, BeIn, Count * 2);
+#else
+    Swap16_Active_Fn((uint8_t *) Registers, BeIn, Count);
+#endif
+}
+
+void Swap_Elements(
+        uint8_t *const Dst,
+        const uint8_t *const Src,
+        uint32_t const Bytes,
+        const uint8_t *const Pattern) {
+
+    Swap_Permute_Active_Fn(Dst, Src, Bytes, Pattern);
+}
@@ -0,0 +1,78 @@
+/*
+ * Modbus_Swap.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Swap.h
+*****************************************************************************/
+
+#ifndef __MODBUS_SWAP_H_
+#define __MODBUS_SWAP_H_
+
+//!-  Headers
+#include <stdint.h>
+#include <Modbus_Configuration.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  "Swap16_Engine" ENUM lists the Register Byte-Swap Kernels.
+ *!-  Swap16_Init() selects the widest one the CPU supports.
+ */
+typedef enum {
+    SWAP16_ENGINE_PORTABLE = 0,  //!-  Shifts, one Register per Step
+    SWAP16_ENGINE_SSSE3    = 1,  //!-  PSHUFB, 8 Registers per Step
+    SWAP16_ENGINE_AVX2     = 2,  //!-  VPSHUFB, 16 Registers per Step
+} Swap16_Engine;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+void Swap16_Init(
+        void);
+
+Bool Swap16_Select(
+        Swap16_Engine const Engine);
+
+Swap16_Engine Swap16_Active_Engine(
+        void);
+
+/*
+ *!-  Registers_To_Wire() converts "Count" Host-Order Registers
+ *!-  into Big-Endian Wire Bytes (2 * Count Bytes).
+ */
+void Registers_To_Wire(
+        uint8_t *const BeOut,
+        const uint16_t *const Registers,
+        uint32_t const Count);
+
+/*
+ *!-  Registers_From_Wire() converts "Count" Big-Endian Registers
+ *!-  from Wire Bytes into Host Order.
+ */
+void Registers_From_Wire(
+        uint16_t *const Registers,
+        const uint8_t *const BeIn,
+        uint32_t const Count);
+
+/*
+ *!-  Swap_Elements() reorders the Bytes of every 2-, 4- or 8-Byte
+ *!-  Element of "Src" (e.g. a Float spread over two Registers) in
+ *!-  one Pass with the Kernel in use. Byte "i" of every 16-Byte
+ *!-  Block of "Dst" is Byte "Pattern[i]" of the same Block of
+ *!-  "Src"; "Bytes" is a Multiple of the Element Size. "Dst" may
+ *!-  be "Src".
+ */
+void Swap_Elements(
+        uint8_t *const Dst,
+        const uint8_t *const Src,
+        uint32_t const Bytes,
+        const uint8_t *const Pattern);
+
+#endif /* __MODBUS_SWAP_H_ */
@@ -0,0 +1,195 @@
+/*
+ * Modbus_TCP.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_TCP.h
+*****************************************************************************/
+
+#ifndef __MODBUS_TCP_H_
+#define __MODBUS_TCP_H_
+
+//!-  Headers
+#include <Modbus.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+#define MODBUS_TCP_PORT  502
+
+/*
+ *!-  MBAP Header:
+ *!-  Transaction_ID (2 bytes), Protocol_ID (2 bytes, always 0),
+ *!-  Length (2 bytes, Unit ID + PDU), followed by the Unit ID.
+ *!-  The Modbus_Frame of a TCP ADU starts at the Unit ID, so
+ *!-  all Frame_* Views work unchanged behind the Header.
+ */
+#define MBAP_TRANSACTION_OFFSET  0
+#define MBAP_PROTOCOL_OFFSET     2
+#define MBAP_LENGTH_OFFSET       4
+#define MBAP_HEADER_LENGTH       6
+#define MBAP_PROTOCOL_MODBUS     0x0000
+
+//!-  Largest MBAP ADU: Header + Unit ID + PDU.
+#define MODBUS_TCP_MAX_ADU_LENGTH  \
+                (MBAP_HEADER_LENGTH + 1 + MODBUS_MAX_PDU_LENGTH)
+
+//!-  Connection Limits of the Server; Memory is reserved up front.
+#define TCP_SERVER_MAX_CONNECTIONS  (1024)
+#define TCP_SERVER_RX_BUFFER        (4 * MODBUS_TCP_MAX_ADU_LENGTH)
+#define TCP_SERVER_TX_BUFFER        (8 * MODBUS_TCP_MAX_ADU_LENGTH)
+#define TCP_SERVER_MAX_EVENTS       (256)
+
+/*
+ *!-  "TCP_Connection" holds the State of one Client.
+ *!-  Rx_Buffer:
+ *!-  Bytes received and not yet served (partial ADUs stay here).
+ *!-  Tx_Buffer:
+ *!-  Responses not yet accepted by the Socket. While it cannot
+ *!-  hold one more Response, Requests are left unread, so TCP
+ *!-  Flow Control pushes back on the Client.
+ *!-  Generation:
+ *!-  Number of the Accept that opened the Connection, so a late
+ *!-  forwarded Response cannot reach a new Client in its Place.
+ *!-  Pending:
+ *!-  Forwarded Requests not yet answered; Room for their
+ *!-  Responses is kept free in Tx_Buffer.
+ */
+typedef struct TCP_Connection {
+    int                     Fd;
+    uint16_t                Rx_Length;
+    uint16_t                Tx_Head;
+    uint16_t                Tx_Length;
+    uint16_t                Pending;
+    Bool                    Rx_Blocked;
+    uint32_t                Generation;
+    struct TCP_Connection  *Next_Free;
+    uint8_t                 Rx_Buffer[TCP_SERVER_RX_BUFFER];
+    uint8_t                 Tx_Buffer[TCP_SERVER_TX_BUFFER];
+} TCP_Connection;
+
+/*
+ *!-  "Modbus_TCP_Forward" takes over the Requests of a Server
+ *!-  that answers them later (a Gateway), instead of serving
+ *!-  them from MODBUS_UNITS. The Request (Unit ID + PDU) is only
+ *!-  valid during the Call; the Answer goes back through
+ *!-  Modbus_TCP_Server_Reply().
+ */
+typedef void (*Modbus_TCP_Forward)(
+        void *const Context,
+        TCP_Connection *const Conn,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Request);
+
+/*
+ *!-  "Modbus_TCP_Server" is an Edge-Triggered epoll Server.
+ *!-  Connections come from a fixed Pool, so Memory is bounded
+ *!-  by TCP_SERVER_MAX_CONNECTIONS.
+ *!-  Serving:
+ *!-  Connection whose Rx Buffer is being served right now.
+ */
+typedef struct {
+    int                  Listen_Fd;
+    int                  Epoll_Fd;
+    uint32_t             Active_Connections;
+    uint32_t             Accepted;
+    uint64_t             Requests_Served;
+    TCP_Connection      *Free_List;
+    TCP_Connection      *Pool;
+    TCP_Connection      *Serving;
+    Modbus_TCP_Forward   Forward;
+    void                *Forward_Context;
+} Modbus_TCP_Server;
+
+//!-  Pipelining Limits of the Client.
+#define TCP_CLIENT_MAX_WINDOW       (64)
+#define TCP_CLIENT_RX_BUFFER        (TCP_CLIENT_MAX_WINDOW * MODBUS_TCP_MAX_ADU_LENGTH)
+#define TCP_CLIENT_TX_BUFFER        (TCP_CLIENT_MAX_WINDOW * MODBUS_TCP_MAX_ADU_LENGTH)
+#define TCP_CLIENT_TIMEOUT_MS       (1000)
+
+/*
+ *!-  "TCP_Transaction" is one Request in Flight.
+ *!-  The Slot of Transaction ID "n" is n % TCP_CLIENT_MAX_WINDOW,
+ *!-  so Responses are matched in O(1) in whatever Order they come.
+ */
+typedef struct {
+    Bool                     In_Use;
+    uint16_t                 Transaction_ID;
+    uint8_t                  Unit_ID;
+    uint8_t                  Function_Code;
+    uint64_t                 Deadline_ns;
+    Modbus_Client_Callback   Callback;
+    void                    *Context;
+} TCP_Transaction;
+
+/*
+ *!-  "Modbus_TCP_Client" keeps up to "Window" Requests
+ *!-  outstanding on one Connection.
+ */
+typedef struct {
+    int               Fd;
+    uint16_t          Window;
+    uint16_t          In_Flight;
+    uint16_t          Next_Transaction;
+    uint16_t          Rx_Length;
+    uint16_t          Tx_Head;
+    uint16_t          Tx_Length;
+    uint64_t          Timeout_ns;
+    uint64_t          Completed;
+    uint64_t          Timeouts;
+    TCP_Transaction   Slots[TCP_CLIENT_MAX_WINDOW];
+    uint8_t           Rx_Buffer[TCP_CLIENT_RX_BUFFER];
+    uint8_t           Tx_Buffer[TCP_CLIENT_TX_BUFFER];
+} Modbus_TCP_Client;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+Bool Modbus_TCP_Server_Open(
+        Modbus_TCP_Server *const Server,
+        uint16_t const Port);
+
+int Modbus_TCP_Server_Poll(
+        Modbus_TCP_Server *const Server,
+        int const TimeoutMs);
+
+void Modbus_TCP_Server_Close(
+        Modbus_TCP_Server *const Server);
+
+void Modbus_TCP_Server_Forward(
+        Modbus_TCP_Server *const Server,
+        Modbus_TCP_Forward const Forward,
+        void *const Context);
+
+Bool Modbus_TCP_Server_Reply(
+        Modbus_TCP_Server *const Server,
+        TCP_Connection *const Conn,
+        uint32_t const Generation,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Response);
+
+Bool Modbus_TCP_Client_Connect(
+        Modbus_TCP_Client *const Client,
+        const char *const Host,
+        uint16_t const Port,
+        uint16_t const Window);
+
+Bool Modbus_TCP_Client_Submit(
+        Modbus_TCP_Client *const Client,
+        const Modbus_Frame *const Request,
+        Modbus_Client_Callback const Callback,
+        void *const Context);
+
+int Modbus_TCP_Client_Poll(
+        Modbus_TCP_Client *const Client,
+        int const TimeoutMs);
+
+void Modbus_TCP_Client_Close(
+        Modbus_TCP_Client *const Client);
+
+#endif /* __MODBUS_TCP_H_ */
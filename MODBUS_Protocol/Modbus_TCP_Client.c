@@ -0,0 +1,398 @@
+/*
+ * Modbus_TCP_Client.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_TCP_Client.c
+*****************************************************************************/
+
+//!-  Headers
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "Modbus_Clock.h"
+#include "Modbus_Frame.h"
+#include "Modbus_TCP.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define MBAP_MIN_LENGTH  (FRAME_HEADER_LENGTH)
+#define MBAP_MAX_LENGTH  (1 + MODBUS_MAX_PDU_LENGTH)
+
+void Client_Complete(
+        Modbus_TCP_Client *const Client,
+        TCP_Transaction *const Slot,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+Bool Client_Flush(
+        Modbus_TCP_Client *const Client);
+
+Bool Client_Receive(
+        Modbus_TCP_Client *const Client);
+
+void Client_Match_Responses(
+        Modbus_TCP_Client *const Client);
+
+void Client_Expire(
+        Modbus_TCP_Client *const Client,
+        uint64_t const Now_ns);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Client_Complete() frees a Slot and reports the Result.
+void Client_Complete(
+        Modbus_TCP_Client *const Client,
+        TCP_Transaction *const Slot,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    Slot->In_Use = FALSE;
+    Client->In_Flight--;
+    if (Status == TARGET_DEVICE_FAILED_TO_RESPOND) {
+        Client->Timeouts++;
+    }
+    else {
+        Client->Completed++;
+    }
+    if (Slot->Callback != NULL) {
+        Slot->Callback(Slot->Context, Response, Status);
+    }
+}
+
+//!-  Client_Flush() sends queued Requests until the Socket would block.
+Bool Client_Flush(
+        Modbus_TCP_Client *const Client) {
+
+    Bool Check_Ok = TRUE;
+    ssize_t Sent = 0;
+
+    while (Client->Tx_Length > 0) {
+        Sent = send(Client->Fd, &Client->Tx_Buffer[Client->Tx_Head],
+                    Client->Tx_Length, MSG_NOSIGNAL);
+        if (Sent > 0) {
+            Client->Tx_Head += (uint16_t) Sent;
+            Client->Tx_Length -= (uint16_t) Sent;
+        }
+        else if ((Sent < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+            break;
+        }
+        else if ((Sent < 0) && (errno == EINTR)) {
+            continue;
+        }
+        else {
+            Check_Ok = FALSE;
+            break;
+        }
+    }
+    if (Client->Tx_Length == 0) {
+        Client->Tx_Head = 0;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Client_Match_Responses() hands every complete Response in the
+ *!-  Rx Buffer to the Transaction with the same ID. Responses for
+ *!-  unknown (e.g. timed out) Transactions are dropped.
+ */
+void Client_Match_Responses(
+        Modbus_TCP_Client *const Client) {
+
+    uint16_t Offset = 0;
+    uint16_t Length = 0;
+    uint16_t Transaction_ID = 0;
+    uint8_t *Adu = NULL;
+    uint8_t Status = MODBUS_NO_EXCEPTION;
+    TCP_Transaction *Slot = NULL;
+    Modbus_Frame Response;
+
+    while ((Client->Rx_Length - Offset) >= (MBAP_HEADER_LENGTH + 1)) {
+        Adu = &Client->Rx_Buffer[Offset];
+        Length = Frame_Get_U16(&Adu[MBAP_LENGTH_OFFSET]);
+        if ((Length < MBAP_MIN_LENGTH) || (Length > MBAP_MAX_LENGTH)) {
+            //!-  Stream out of Sync: drop everything received.
+            Offset = Client->Rx_Length;
+            break;
+        }
+        if ((Client->Rx_Length - Offset) < (MBAP_HEADER_LENGTH + Length)) {
+            break;
+        }
+
+        Transaction_ID = Frame_Get_U16(&Adu[MBAP_TRANSACTION_OFFSET]);
+        Slot = &Client->Slots[Transaction_ID % TCP_CLIENT_MAX_WINDOW];
+        Frame_Attach(&Response, &Adu[MBAP_HEADER_LENGTH], Length);
+
+        if ((Slot->In_Use == TRUE) &&
+            (Slot->Transaction_ID == Transaction_ID) &&
+            (Slot->Unit_ID == Frame_Device_ID(&Response)) &&
+            (Slot->Function_Code ==
+             (Frame_Function_Code(&Response) & (uint8_t) ~MSB1))) {
+            Status = MODBUS_NO_EXCEPTION;
+            if ((Frame_Is_Exception(&Response) == TRUE) &&
+                (Length > FRAME_HEADER_LENGTH)) {
+                Status = Frame_Exception_Code(&Response);
+            }
+            Client_Complete(Client, Slot, &Response, Status);
+        }
+        Offset += MBAP_HEADER_LENGTH + Length;
+    }
+
+    if (Offset > 0) {
+        Client->Rx_Length -= Offset;
+        memmove(Client->Rx_Buffer, &Client->Rx_Buffer[Offset],
+                Client->Rx_Length);
+    }
+}
+
+//!-  Client_Receive() drains the Socket and matches the Responses.
+Bool Client_Receive(
+        Modbus_TCP_Client *const Client) {
+
+    Bool Check_Ok = TRUE;
+    ssize_t Received = 0;
+
+    for (;;) {
+        Received = read(Client->Fd, &Client->Rx_Buffer[Client->Rx_Length],
+                        TCP_CLIENT_RX_BUFFER - Client->Rx_Length);
+        if (Received > 0) {
+            Client->Rx_Length += (uint16_t) Received;
+            Client_Match_Responses(Client);
+        }
+        else if (Received == 0) {
+            Check_Ok = FALSE;
+            break;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+            break;
+        }
+        else if (errno != EINTR) {
+            Check_Ok = FALSE;
+            break;
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Client_Expire() fails every Transaction past its Deadline.
+void Client_Expire(
+        Modbus_TCP_Client *const Client,
+        uint64_t const Now_ns) {
+
+    uint16_t Index = 0;
+
+    for (Index = 0; (Index < TCP_CLIENT_MAX_WINDOW) &&
+                    (Client->In_Flight > 0); Index++) {
+        if ((Client->Slots[Index].In_Use == TRUE) &&
+            (Client->Slots[Index].Deadline_ns <= Now_ns)) {
+            Client_Complete(Client, &Client->Slots[Index], NULL,
+                            TARGET_DEVICE_FAILED_TO_RESPOND);
+        }
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_TCP_Client_Connect() connects to "Host:Port" and allows
+ *!-  up to "Window" (1..TCP_CLIENT_MAX_WINDOW) Requests in Flight.
+ */
+Bool Modbus_TCP_Client_Connect(
+        Modbus_TCP_Client *const Client,
+        const char *const Host,
+        uint16_t const Port,
+        uint16_t const Window) {
+
+    Bool Check_Ok = FALSE;
+    int One = 1;
+    char Service[8];
+    struct addrinfo Hints;
+    struct addrinfo *Result = NULL;
+    struct addrinfo *Entry = NULL;
+
+    memset(Client, 0, sizeof(*Client));
+    Client->Fd = -1;
+    Client->Window = Window;
+    if ((Client->Window == 0) || (Client->Window > TCP_CLIENT_MAX_WINDOW)) {
+        Client->Window = TCP_CLIENT_MAX_WINDOW;
+    }
+    Client->Timeout_ns = TCP_CLIENT_TIMEOUT_MS * NS_PER_MS;
+
+    memset(&Hints, 0, sizeof(Hints));
+    Hints.ai_family = AF_UNSPEC;
+    Hints.ai_socktype = SOCK_STREAM;
+    snprintf(Service, sizeof(Service), "%u", Port);
+
+    if (getaddrinfo(Host, Service, &Hints, &Result) == 0) {
+        for (Entry = Result; Entry != NULL; Entry = Entry->ai_next) {
+            Client->Fd = socket(Entry->ai_family,
+                                Entry->ai_socktype | SOCK_CLOEXEC,
+                                Entry->ai_protocol);
+            if (Client->Fd < 0) {
+                continue;
+            }
+            if (connect(Client->Fd, Entry->ai_addr, Entry->ai_addrlen) == 0) {
+                Check_Ok = TRUE;
+                break;
+            }
+            close(Client->Fd);
+            Client->Fd = -1;
+        }
+        freeaddrinfo(Result);
+    }
+
+    if (Check_Ok == TRUE) {
+        (void) setsockopt(Client->Fd, IPPROTO_TCP, TCP_NODELAY,
+                          &One, sizeof(One));
+        (void) fcntl(Client->Fd, F_SETFL,
+                     fcntl(Client->Fd, F_GETFL) | O_NONBLOCK);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_TCP_Client_Submit() queues a Request (Unit ID + PDU,
+ *!-  e.g. built with Frame_Build_Read_Request()) behind a fresh
+ *!-  MBAP Header. Returns FALSE while the Window or the Tx Buffer
+ *!-  is full; the Request goes out on the next
+ *!-  Modbus_TCP_Client_Poll().
+ */
+Bool Modbus_TCP_Client_Submit(
+        Modbus_TCP_Client *const Client,
+        const Modbus_Frame *const Request,
+        Modbus_Client_Callback const Callback,
+        void *const Context) {
+
+    Bool Check_Ok = FALSE;
+    uint16_t Tail = 0;
+    uint8_t *Adu = NULL;
+    TCP_Transaction *Slot = NULL;
+
+    if ((Client->Fd >= 0) &&
+        (Client->In_Flight < Client->Window) &&
+        (Request->Length >= FRAME_HEADER_LENGTH) &&
+        (Request->Length <= MBAP_MAX_LENGTH)) {
+
+        Tail = Client->Tx_Head + Client->Tx_Length;
+        if ((Tail + MBAP_HEADER_LENGTH + Request->Length) >
+             TCP_CLIENT_TX_BUFFER) {
+            memmove(Client->Tx_Buffer, &Client->Tx_Buffer[Client->Tx_Head],
+                    Client->Tx_Length);
+            Client->Tx_Head = 0;
+            Tail = Client->Tx_Length;
+        }
+        //!-  Timed out Requests stay queued; a Peer not reading fills up.
+        Check_Ok = (Bool) ((Tail + MBAP_HEADER_LENGTH + Request->Length) <=
+                           TCP_CLIENT_TX_BUFFER);
+    }
+
+    if (Check_Ok == TRUE) {
+        //!-  Skip IDs whose Slot still waits for an old Response.
+        while (Client->Slots[Client->Next_Transaction %
+                             TCP_CLIENT_MAX_WINDOW].In_Use == TRUE) {
+            Client->Next_Transaction++;
+        }
+
+        Adu = &Client->Tx_Buffer[Tail];
+        Frame_Put_U16(&Adu[MBAP_TRANSACTION_OFFSET], Client->Next_Transaction);
+        Frame_Put_U16(&Adu[MBAP_PROTOCOL_OFFSET], MBAP_PROTOCOL_MODBUS);
+        Frame_Put_U16(&Adu[MBAP_LENGTH_OFFSET], Request->Length);
+        memcpy(&Adu[MBAP_HEADER_LENGTH], Request->Adu, Request->Length);
+        Client->Tx_Length += MBAP_HEADER_LENGTH + Request->Length;
+
+        Slot = &Client->Slots[Client->Next_Transaction % TCP_CLIENT_MAX_WINDOW];
+        Slot->In_Use = TRUE;
+        Slot->Transaction_ID = Client->Next_Transaction;
+        Slot->Unit_ID = Frame_Device_ID(Request);
+        Slot->Function_Code = Frame_Function_Code(Request);
+        Slot->Deadline_ns = Modbus_Now_ns() + Client->Timeout_ns;
+        Slot->Callback = Callback;
+        Slot->Context = Context;
+
+        Client->In_Flight++;
+        Client->Next_Transaction++;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_TCP_Client_Poll() sends queued Requests, waits up to
+ *!-  "TimeoutMs" for Responses, runs the Callbacks and expires
+ *!-  overdue Transactions. Returns -1 once the Connection is lost
+ *!-  (all Transactions are then failed), else the In-Flight Count.
+ */
+int Modbus_TCP_Client_Poll(
+        Modbus_TCP_Client *const Client,
+        int const TimeoutMs) {
+
+    Bool Check_Ok = FALSE;
+    int Result = -1;
+    struct pollfd Poll_Fd;
+
+    if (Client->Fd >= 0) {
+        Check_Ok = Client_Flush(Client);
+    }
+    if (Check_Ok == TRUE) {
+        Poll_Fd.fd = Client->Fd;
+        Poll_Fd.events = POLLIN;
+        if (Client->Tx_Length > 0) {
+            Poll_Fd.events |= POLLOUT;
+        }
+        Poll_Fd.revents = 0;
+        if (poll(&Poll_Fd, 1, TimeoutMs) > 0) {
+            if (Poll_Fd.revents & (POLLIN | POLLHUP | POLLERR)) {
+                Check_Ok = Client_Receive(Client);
+            }
+            if ((Check_Ok == TRUE) && (Poll_Fd.revents & POLLOUT)) {
+                Check_Ok = Client_Flush(Client);
+            }
+        }
+    }
+
+    if (Check_Ok == TRUE) {
+        Client_Expire(Client, Modbus_Now_ns());
+        Result = (int) Client->In_Flight;
+    }
+    else {
+        Modbus_TCP_Client_Close(Client);
+    }
+    return Result;
+}
+
+//!-  Modbus_TCP_Client_Close() disconnects and fails pending Requests.
+void Modbus_TCP_Client_Close(
+        Modbus_TCP_Client *const Client) {
+
+    uint16_t Index = 0;
+
+    if (Client->Fd >= 0) {
+        close(Client->Fd);
+        Client->Fd = -1;
+    }
+    for (Index = 0; Index < TCP_CLIENT_MAX_WINDOW; Index++) {
+        if (Client->Slots[Index].In_Use == TRUE) {
+            Client_Complete(Client, &Client->Slots[Index], NULL,
+                            TARGET_DEVICE_FAILED_TO_RESPOND);
+        }
+    }
+    Client->Rx_Length = 0;
+    Client->Tx_Head = 0;
+    Client->Tx_Length = 0;
+}
@@ -0,0 +1,567 @@
+/*
+ * Modbus_TCP_Gateway.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_TCP_Gateway.c
+*****************************************************************************/
+
+//!-  Headers
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include "Modbus_Frame.h"
+#include "Modbus_Gateway.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  epoll Tag of the Server; Line "n" is tagged n + 1.
+#define GATEWAY_TAG_SERVER  (0)
+#define GATEWAY_MAX_EVENTS  (GATEWAY_MAX_LINES + 1)
+
+Gateway_Class Gateway_Classify(
+        const Modbus_Frame *const Request);
+
+void Gateway_Answer(
+        Modbus_Gateway *const Gateway,
+        const Gateway_Request *const Pending,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+void Gateway_Release(
+        Modbus_Gateway *const Gateway,
+        Gateway_Request *const Pending);
+
+void Gateway_Finish(
+        Modbus_Gateway *const Gateway,
+        Gateway_Request *const Pending,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+void Gateway_Refuse(
+        Modbus_Gateway *const Gateway,
+        TCP_Connection *const Conn,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Request);
+
+Gateway_Request *Gateway_Dequeue(
+        Gateway_Line *const Line);
+
+void Gateway_Line_Next(
+        Gateway_Line *const Line);
+
+void Gateway_Line_Done(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+void Gateway_Forward(
+        void *const Context,
+        TCP_Connection *const Conn,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Request);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Gateway_Classify() tells Writes from Reads by the Function Code.
+Gateway_Class Gateway_Classify(
+        const Modbus_Frame *const Request) {
+
+    Gateway_Class Class = GATEWAY_READS;
+
+    switch (Frame_Function_Code(Request)) {
+        case Fun_Code05:
+        case Fun_Code06:
+        case Fun_Code15:
+        case Fun_Code16:
+        case Fun_Code22:
+        case Fun_Code23:
+            Class = GATEWAY_WRITES;
+            break;
+        default:
+            Class = GATEWAY_READS;
+            break;
+    }
+    return Class;
+}
+
+/*
+ *!-  Gateway_Answer() sends the TCP Client the Response, or for a
+ *!-  "Status" other than MODBUS_NO_EXCEPTION without Response an
+ *!-  Exception Response in the Gateway's Name.
+ */
+void Gateway_Answer(
+        Modbus_Gateway *const Gateway,
+        const Gateway_Request *const Pending,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    uint8_t Buffer[FRAME_EXCEPTION_CODE_OFFSET + 1];
+    Modbus_Frame Exception;
+
+    if ((Response == NULL) && (Status != MODBUS_NO_EXCEPTION)) {
+        Frame_Attach(&Exception, Buffer, 0);
+        (void) Frame_Build_Exception(&Exception, Pending->Adu[FRAME_DEVICE_ID_OFFSET],
+                                     Pending->Adu[FRAME_FUNCTION_CODE_OFFSET],
+                                     Status);
+        (void) Modbus_TCP_Server_Reply(&Gateway->Server, Pending->Conn,
+                                       Pending->Generation,
+                                       Pending->Transaction_ID, &Exception);
+    }
+    else {
+        (void) Modbus_TCP_Server_Reply(&Gateway->Server, Pending->Conn,
+                                       Pending->Generation,
+                                       Pending->Transaction_ID, Response);
+    }
+}
+
+//!-  Gateway_Release() returns a Request to the Pool.
+void Gateway_Release(
+        Modbus_Gateway *const Gateway,
+        Gateway_Request *const Pending) {
+
+    Pending->Next = Gateway->Free_List;
+    Gateway->Free_List = Pending;
+}
+
+/*
+ *!-  Gateway_Finish() answers a forwarded Request and the Requests
+ *!-  coalesced onto it, hands the Response to the Cache and
+ *!-  returns them all to the Pool.
+ */
+void Gateway_Finish(
+        Modbus_Gateway *const Gateway,
+        Gateway_Request *const Pending,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    Modbus_Cache_Entry *const Entry = Pending->Entry;
+    Gateway_Request *Waiter = NULL;
+    Gateway_Request *Next = NULL;
+
+    Gateway_Answer(Gateway, Pending, Response, Status);
+    if (Entry != NULL) {
+        Waiter = Entry->Waiters;
+        Modbus_Cache_Complete(&Gateway->Cache, Entry, Response, Modbus_Now_ns());
+        while (Waiter != NULL) {
+            Next = Waiter->Next;
+            Gateway_Answer(Gateway, Waiter, Response, Status);
+            Gateway_Release(Gateway, Waiter);
+            Waiter = Next;
+        }
+    }
+    Gateway_Release(Gateway, Pending);
+}
+
+//!-  Gateway_Refuse() answers a Request it cannot forward.
+void Gateway_Refuse(
+        Modbus_Gateway *const Gateway,
+        TCP_Connection *const Conn,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Request) {
+
+    Gateway_Request Refused;
+
+    Refused.Conn = Conn;
+    Refused.Generation = Conn->Generation;
+    Refused.Transaction_ID = Transaction_ID;
+    Refused.Adu[FRAME_DEVICE_ID_OFFSET] = Frame_Device_ID(Request);
+    Refused.Adu[FRAME_FUNCTION_CODE_OFFSET] = Frame_Function_Code(Request);
+    Gateway->Unavailable++;
+    Gateway_Answer(Gateway, &Refused, NULL, GATEWAY_PATH_UNAVAILABLE);
+}
+
+/*
+ *!-  Gateway_Dequeue() takes the next Request of a Line: from the
+ *!-  Writes while the Burst allows, else from the Reads; within a
+ *!-  Class from the Client at the Front of the Ring, which then
+ *!-  goes to the Back if it has more.
+ */
+Gateway_Request *Gateway_Dequeue(
+        Gateway_Line *const Line) {
+
+    Gateway_Class Class = GATEWAY_READS;
+    Gateway_Ring *Ring = NULL;
+    Gateway_Queue *Queue = NULL;
+    Gateway_Request *Pending = NULL;
+    uint16_t Client = 0;
+
+    if ((Line->Ring[GATEWAY_WRITES].Count > 0) &&
+        ((Line->Ring[GATEWAY_READS].Count == 0) ||
+         (Line->Write_Burst < GATEWAY_WRITE_BURST))) {
+        Class = GATEWAY_WRITES;
+        Line->Write_Burst++;
+    }
+    else {
+        Class = GATEWAY_READS;
+        Line->Write_Burst = 0;
+    }
+
+    Ring = &Line->Ring[Class];
+    if (Ring->Count > 0) {
+        Client = Ring->Client[Ring->Head];
+        Ring->Head = (uint16_t) ((Ring->Head + 1) % TCP_SERVER_MAX_CONNECTIONS);
+        Ring->Count--;
+
+        Queue = &Line->Queue[Class][Client];
+        Pending = Queue->Head;
+        Queue->Head = Pending->Next;
+        if (Queue->Head == NULL) {
+            Queue->Tail = NULL;
+        }
+        else {
+            Ring->Client[(Ring->Head + Ring->Count) % TCP_SERVER_MAX_CONNECTIONS] =
+                Client;
+            Ring->Count++;
+        }
+        Line->Queued--;
+    }
+    return Pending;
+}
+
+/*
+ *!-  Gateway_Line_Next() puts the next Request on an idle Line.
+ *!-  Requests whose Client is gone are dropped; those that waited
+ *!-  longer than their Client does are refused, so the Line only
+ *!-  carries Requests somebody still waits for. Reads others are
+ *!-  coalesced onto go out regardless.
+ */
+void Gateway_Line_Next(
+        Gateway_Line *const Line) {
+
+    Modbus_Gateway *const Gateway = Line->Gateway;
+    Gateway_Request *Pending = NULL;
+    Bool Waited_For = FALSE;
+    uint64_t Now_ns = 0;
+    Modbus_Frame Request;
+
+    if (Line->Client.Port.Fd < 0) {
+        Line->Up = FALSE;
+    }
+    while ((Line->Active == NULL) && (Line->Queued > 0)) {
+        Pending = Gateway_Dequeue(Line);
+        Now_ns = Modbus_Now_ns();
+        Waited_For = (Bool) ((Pending->Entry != NULL) &&
+                             (Pending->Entry->Waiters != NULL));
+        if ((Waited_For == FALSE) &&
+            ((Pending->Conn->Fd < 0) ||
+             (Pending->Conn->Generation != Pending->Generation))) {
+            Gateway_Finish(Gateway, Pending, NULL, MODBUS_NO_EXCEPTION);
+            continue;
+        }
+        if ((Line->Up == FALSE) ||
+            ((Waited_For == FALSE) &&
+             ((Now_ns - Pending->Queued_ns) > (GATEWAY_QUEUE_MS * NS_PER_MS)))) {
+            Gateway->Unavailable++;
+            Gateway_Finish(Gateway, Pending, NULL, GATEWAY_PATH_UNAVAILABLE);
+            continue;
+        }
+
+        Frame_Attach(&Request, Pending->Adu, Pending->Length);
+        Line->Active = Pending;
+        Line->Started_ns = Now_ns;
+        Line->Queue_ns += Now_ns - Pending->Queued_ns;
+        if (Modbus_RTU_Client_Submit(&Line->Client, &Request,
+                                     Gateway_Line_Done, Line) == FALSE) {
+            Line->Active = NULL;
+            Line->Up = FALSE;
+            Gateway->Unavailable++;
+            Gateway_Finish(Gateway, Pending, NULL, GATEWAY_PATH_UNAVAILABLE);
+        }
+    }
+}
+
+/*
+ *!-  Gateway_Line_Done() is the Client Callback of a Line: the
+ *!-  RTU Response, with the CRC already stripped, goes back behind
+ *!-  an MBAP Header; a Slave that stayed silent is reported as
+ *!-  TARGET_DEVICE_FAILED_TO_RESPOND. A Write drops the cached
+ *!-  Reads it overlaps. The Line then takes the next Request at
+ *!-  once, so it never idles while Work waits.
+ */
+void Gateway_Line_Done(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    Gateway_Line *const Line = Context;
+    Modbus_Gateway *const Gateway = Line->Gateway;
+    Gateway_Request *const Pending = Line->Active;
+    Modbus_Frame Request;
+
+    if (Pending != NULL) {
+        Line->Active = NULL;
+        Line->Busy_ns += Modbus_Now_ns() - Line->Started_ns;
+        Line->Forwarded++;
+        if ((Response == NULL) && (Status == TARGET_DEVICE_FAILED_TO_RESPOND)) {
+            Line->Timeouts++;
+        }
+        Frame_Attach(&Request, Pending->Adu, Pending->Length);
+        if (Gateway_Classify(&Request) == GATEWAY_WRITES) {
+            (void) Modbus_Cache_Invalidate(&Gateway->Cache, &Request);
+        }
+        Gateway_Finish(Gateway, Pending, Response, Status);
+    }
+    Gateway_Line_Next(Line);
+}
+
+/*
+ *!-  Gateway_Forward() is the Forward Callback of the TCP Server.
+ *!-  Reads the Cache holds are answered from it, Reads already in
+ *!-  Flight wait for that Response; the rest is queued on the Line
+ *!-  of its Unit, for the Client it came from and by Class. A
+ *!-  queued Write drops the cached Reads it overlaps at once and
+ *!-  again when done, so no Read gets Data from before it.
+ *!-  Unrouted Units, dead Lines and full Queues get
+ *!-  GATEWAY_PATH_UNAVAILABLE right away.
+ */
+void Gateway_Forward(
+        void *const Context,
+        TCP_Connection *const Conn,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Request) {
+
+    Modbus_Gateway *const Gateway = Context;
+    uint8_t const Route = Gateway->Route[Frame_Device_ID(Request)];
+    uint16_t const Client = (uint16_t) (Conn - Gateway->Server.Pool);
+    Gateway_Class const Class = Gateway_Classify(Request);
+    Modbus_Cache_Result Result = CACHE_BYPASS;
+    Modbus_Cache_Entry *Entry = NULL;
+    Gateway_Line *Line = NULL;
+    Gateway_Request *Pending = Gateway->Free_List;
+    Gateway_Queue *Queue = NULL;
+    Gateway_Ring *Ring = NULL;
+    Bool Check_Ok = FALSE;
+    Modbus_Frame Cached;
+
+    if ((Route != GATEWAY_NO_LINE) && (Gateway->Line[Route].Up == TRUE) &&
+        ((Request->Length + FRAME_CRC_LENGTH) <= MODBUS_MAX_ADU_LENGTH)) {
+        Line = &Gateway->Line[Route];
+        Result = Modbus_Cache_Lookup(&Gateway->Cache, Request,
+                                     Modbus_Now_ns(), &Entry);
+        Check_Ok = (Bool) ((Result == CACHE_HIT) ||
+                           ((Pending != NULL) &&
+                            ((Result == CACHE_PENDING) ||
+                             (Line->Queued < GATEWAY_LINE_QUEUE))));
+        if ((Check_Ok == FALSE) && (Result == CACHE_MISS)) {
+            Modbus_Cache_Complete(&Gateway->Cache, Entry, NULL, 0);
+        }
+    }
+
+    if (Check_Ok == FALSE) {
+        Gateway_Refuse(Gateway, Conn, Transaction_ID, Request);
+    }
+    else if (Result == CACHE_HIT) {
+        Frame_Attach(&Cached, Entry->Response, Entry->Length);
+        (void) Modbus_TCP_Server_Reply(&Gateway->Server, Conn, Conn->Generation,
+                                       Transaction_ID, &Cached);
+    }
+    else {
+        Gateway->Free_List = Pending->Next;
+        Pending->Next = NULL;
+        Pending->Conn = Conn;
+        Pending->Generation = Conn->Generation;
+        Pending->Transaction_ID = Transaction_ID;
+        Pending->Length = Request->Length;
+        Pending->Queued_ns = Modbus_Now_ns();
+        Pending->Entry = (Result == CACHE_MISS) ? Entry : NULL;
+        memcpy(Pending->Adu, Request->Adu, Request->Length);
+
+        if (Result == CACHE_PENDING) {
+            Pending->Next = Entry->Waiters;
+            Entry->Waiters = Pending;
+        }
+        else {
+            //!-  Reads behind a queued Write must not see Data before it.
+            if (Class == GATEWAY_WRITES) {
+                (void) Modbus_Cache_Invalidate(&Gateway->Cache, Request);
+            }
+            Queue = &Line->Queue[Class][Client];
+            if (Queue->Tail == NULL) {
+                Queue->Head = Pending;
+                Ring = &Line->Ring[Class];
+                Ring->Client[(Ring->Head + Ring->Count) %
+                             TCP_SERVER_MAX_CONNECTIONS] = Client;
+                Ring->Count++;
+            }
+            else {
+                Queue->Tail->Next = Pending;
+            }
+            Queue->Tail = Pending;
+            Line->Queued++;
+
+            Gateway_Line_Next(Line);
+        }
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_Gateway_Open() listens for Modbus TCP Clients on "Port"
+ *!-  and reserves the Request Pool. Lines are added next, with
+ *!-  Modbus_Gateway_Add_Line() and Modbus_Gateway_Route(). The
+ *!-  Cache starts with no TTL: it only coalesces Reads in Flight.
+ */
+Bool Modbus_Gateway_Open(
+        Modbus_Gateway *const Gateway,
+        uint16_t const Port) {
+
+    Bool Check_Ok = FALSE;
+    uint32_t Index = 0;
+    struct epoll_event Event;
+
+    memset(Gateway, 0, sizeof(*Gateway));
+    memset(Gateway->Route, GATEWAY_NO_LINE, sizeof(Gateway->Route));
+    Modbus_Cache_Init(&Gateway->Cache, 0);
+    Gateway->Epoll_Fd = epoll_create1(EPOLL_CLOEXEC);
+    Gateway->Pool = calloc(GATEWAY_MAX_REQUESTS, sizeof(Gateway_Request));
+    Gateway->Line = calloc(GATEWAY_MAX_LINES, sizeof(Gateway_Line));
+
+    if ((Gateway->Epoll_Fd >= 0) && (Gateway->Pool != NULL) &&
+        (Gateway->Line != NULL)) {
+        for (Index = GATEWAY_MAX_REQUESTS; Index > 0; Index--) {
+            Gateway_Release(Gateway, &Gateway->Pool[Index - 1]);
+        }
+        Check_Ok = Modbus_TCP_Server_Open(&Gateway->Server, Port);
+    }
+    if (Check_Ok == TRUE) {
+        Modbus_TCP_Server_Forward(&Gateway->Server, Gateway_Forward, Gateway);
+        Event.events = EPOLLIN;
+        Event.data.u32 = GATEWAY_TAG_SERVER;
+        Check_Ok = (Bool) (epoll_ctl(Gateway->Epoll_Fd, EPOLL_CTL_ADD,
+                                     Gateway->Server.Epoll_Fd, &Event) == 0);
+    }
+
+    if (Check_Ok == FALSE) {
+        Modbus_Gateway_Close(Gateway);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Gateway_Add_Line() opens a Serial Line, "Spec" as for
+ *!-  Modbus_RTU_Port_Open(). Returns its Number, or -1.
+ */
+int Modbus_Gateway_Add_Line(
+        Modbus_Gateway *const Gateway,
+        const char *const Spec) {
+
+    int Number = -1;
+    Gateway_Line *Line = NULL;
+    struct epoll_event Event;
+
+    if (Gateway->Lines < GATEWAY_MAX_LINES) {
+        Line = &Gateway->Line[Gateway->Lines];
+        memset(Line, 0, sizeof(*Line));
+        Line->Gateway = Gateway;
+        if (Modbus_RTU_Client_Open(&Line->Client, Spec) == TRUE) {
+            Line->Client.Timeout_ns = GATEWAY_RESPONSE_MS * NS_PER_MS;
+            Event.events = EPOLLIN;
+            Event.data.u32 = Gateway->Lines + 1;
+            if (epoll_ctl(Gateway->Epoll_Fd, EPOLL_CTL_ADD,
+                          Line->Client.Port.Epoll_Fd, &Event) == 0) {
+                Line->Up = TRUE;
+                Number = (int) Gateway->Lines;
+                Gateway->Lines++;
+            }
+            else {
+                Modbus_RTU_Client_Close(&Line->Client);
+            }
+        }
+    }
+    return Number;
+}
+
+//!-  Modbus_Gateway_Route() sends Unit IDs "First_ID" .. "Last_ID" to "Line".
+Bool Modbus_Gateway_Route(
+        Modbus_Gateway *const Gateway,
+        uint8_t const First_ID,
+        uint8_t const Last_ID,
+        int const Line) {
+
+    Bool Check_Ok = FALSE;
+
+    if ((Line >= 0) && ((uint32_t) Line < Gateway->Lines) &&
+        (First_ID <= Last_ID)) {
+        memset(&Gateway->Route[First_ID], Line, (size_t) (Last_ID - First_ID) + 1);
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Gateway_Poll() waits up to "TimeoutMs" (-1: forever)
+ *!-  for the Server or any Line and runs what is ready. A Line
+ *!-  that fails stays down; its Units get GATEWAY_PATH_UNAVAILABLE.
+ *!-  Returns the Number of Events, or -1 on Error.
+ */
+int Modbus_Gateway_Poll(
+        Modbus_Gateway *const Gateway,
+        int const TimeoutMs) {
+
+    struct epoll_event Events[GATEWAY_MAX_EVENTS];
+    Gateway_Line *Line = NULL;
+    int Count = 0;
+    int Index = 0;
+
+    Count = epoll_wait(Gateway->Epoll_Fd, Events, GATEWAY_MAX_EVENTS,
+                       TimeoutMs);
+    if ((Count < 0) && (errno == EINTR)) {
+        Count = 0;
+    }
+
+    for (Index = 0; Index < Count; Index++) {
+        if (Events[Index].data.u32 == GATEWAY_TAG_SERVER) {
+            if (Modbus_TCP_Server_Poll(&Gateway->Server, 0) < 0) {
+                Count = -1;
+                break;
+            }
+            continue;
+        }
+        Line = &Gateway->Line[Events[Index].data.u32 - 1];
+        if ((Line->Up == TRUE) &&
+            (Modbus_RTU_Client_Poll(&Line->Client, 0) < 0)) {
+            Line->Up = FALSE;
+            Gateway_Line_Next(Line);
+        }
+    }
+    return Count;
+}
+
+//!-  Modbus_Gateway_Close() closes the Lines and the Server.
+void Modbus_Gateway_Close(
+        Modbus_Gateway *const Gateway) {
+
+    uint32_t Index = 0;
+
+    if (Gateway->Line != NULL) {
+        for (Index = 0; Index < Gateway->Lines; Index++) {
+            Gateway->Line[Index].Up = FALSE;
+            Modbus_RTU_Client_Close(&Gateway->Line[Index].Client);
+        }
+        free(Gateway->Line);
+        Gateway->Line = NULL;
+    }
+    Modbus_TCP_Server_Close(&Gateway->Server);
+    if (Gateway->Epoll_Fd >= 0) {
+        close(Gateway->Epoll_Fd);
+        Gateway->Epoll_Fd = -1;
+    }
+    free(Gateway->Pool);
+    Gateway->Pool = NULL;
+    Gateway->Free_List = NULL;
+    Gateway->Lines = 0;
+}
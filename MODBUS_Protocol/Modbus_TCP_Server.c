@@ -0,0 +1,536 @@
+/*
+ * Modbus_TCP_Server.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_TCP_Server.c
+*****************************************************************************/
+
+//!-  Headers
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "Modbus_Clock.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Dispatch.h"
+#include "Modbus_Metrics.h"
+#include "Modbus_TCP.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Smallest valid MBAP Length: Unit ID + Function Code.
+#define MBAP_MIN_LENGTH  (FRAME_HEADER_LENGTH)
+//!-  Largest valid MBAP Length: Unit ID + PDU.
+#define MBAP_MAX_LENGTH  (1 + MODBUS_MAX_PDU_LENGTH)
+
+typedef enum {
+    SERVE_DONE    = 0,  //!-  All complete Requests served
+    SERVE_BLOCKED = 1,  //!-  Tx Buffer full, Requests left
+    SERVE_ERROR   = 2,  //!-  Malformed MBAP Header
+} Serve_Result;
+
+void Server_Accept_All(
+        Modbus_TCP_Server *const Server);
+
+void Server_Close_Connection(
+        Modbus_TCP_Server *const Server,
+        TCP_Connection *const Conn);
+
+Serve_Result Connection_Serve(
+        Modbus_TCP_Server *const Server,
+        TCP_Connection *const Conn);
+
+Bool Connection_Has_Room(
+        const Modbus_TCP_Server *const Server,
+        const TCP_Connection *const Conn);
+
+Bool Connection_Flush(
+        TCP_Connection *const Conn);
+
+Bool Connection_Read(
+        Modbus_TCP_Server *const Server,
+        TCP_Connection *const Conn);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Server_Accept_All() accepts until the Backlog is empty (Edge-Triggered).
+void Server_Accept_All(
+        Modbus_TCP_Server *const Server) {
+
+    int Fd = -1;
+    int One = 1;
+    TCP_Connection *Conn = NULL;
+    struct epoll_event Event;
+
+    for (;;) {
+        Fd = accept4(Server->Listen_Fd, NULL, NULL,
+                     SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (Fd < 0) {
+            break;
+        }
+        //!-  Pool exhausted: refuse rather than grow.
+        if (Server->Free_List == NULL) {
+            close(Fd);
+            continue;
+        }
+        Conn = Server->Free_List;
+        Server->Free_List = Conn->Next_Free;
+
+        (void) setsockopt(Fd, IPPROTO_TCP, TCP_NODELAY, &One, sizeof(One));
+        Conn->Fd = Fd;
+        Conn->Rx_Length = 0;
+        Conn->Tx_Head = 0;
+        Conn->Tx_Length = 0;
+        Conn->Pending = 0;
+        Conn->Rx_Blocked = FALSE;
+        Conn->Generation = ++Server->Accepted;
+        Conn->Next_Free = NULL;
+
+        Server->Active_Connections++;
+
+        Event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        Event.data.ptr = Conn;
+        if (epoll_ctl(Server->Epoll_Fd, EPOLL_CTL_ADD, Fd, &Event) != 0) {
+            Server_Close_Connection(Server, Conn);
+        }
+    }
+}
+
+/*
+ *!-  Server_Close_Connection() returns a Connection to the Pool,
+ *!-  once: a closed one (Fd < 0) is already there.
+ */
+void Server_Close_Connection(
+        Modbus_TCP_Server *const Server,
+        TCP_Connection *const Conn) {
+
+    if (Conn->Fd >= 0) {
+        (void) epoll_ctl(Server->Epoll_Fd, EPOLL_CTL_DEL, Conn->Fd, NULL);
+        close(Conn->Fd);
+        Server->Active_Connections--;
+        Conn->Fd = -1;
+        Conn->Pending = 0;
+        Conn->Next_Free = Server->Free_List;
+        Server->Free_List = Conn;
+    }
+}
+
+/*
+ *!-  Connection_Has_Room() tells if Tx_Buffer can take one more
+ *!-  Response besides those owed for forwarded Requests.
+ */
+Bool Connection_Has_Room(
+        const Modbus_TCP_Server *const Server,
+        const TCP_Connection *const Conn) {
+
+    uint32_t const Owed = (Server->Forward != NULL) ? Conn->Pending : 0;
+
+    return (Bool) ((Conn->Tx_Length +
+                    ((Owed + 1) * MODBUS_TCP_MAX_ADU_LENGTH)) <=
+                   TCP_SERVER_TX_BUFFER);
+}
+
+/*
+ *!-  Connection_Serve() answers every complete ADU in the Rx Buffer.
+ *!-  Requests are read and Responses built in place: the Request
+ *!-  Frame points into Rx_Buffer, the Response Frame into Tx_Buffer.
+ *!-  With a Forward Callback the Requests are handed on instead.
+ *!-  Served Requests are timed Stage by Stage; the End of one
+ *!-  Stage is the Start of the next, and of the next Request's
+ *!-  Parse, so a Request costs three Clock Reads.
+ */
+Serve_Result Connection_Serve(
+        Modbus_TCP_Server *const Server,
+        TCP_Connection *const Conn) {
+
+    Serve_Result Result = SERVE_DONE;
+    uint16_t Offset = 0;
+    uint16_t Length = 0;
+    uint8_t *Request_Adu = NULL;
+    uint8_t *Response_Adu = NULL;
+    uint64_t Stamp_ns = (Server->Forward == NULL) ? Modbus_Now_ns() : 0;
+    uint64_t Now_ns = 0;
+    Modbus_Frame Request;
+    Modbus_Frame Response;
+
+    while ((Conn->Rx_Length - Offset) >= (MBAP_HEADER_LENGTH + 1)) {
+        Request_Adu = &Conn->Rx_Buffer[Offset];
+        Length = Frame_Get_U16(&Request_Adu[MBAP_LENGTH_OFFSET]);
+        if ((Frame_Get_U16(&Request_Adu[MBAP_PROTOCOL_OFFSET]) !=
+             MBAP_PROTOCOL_MODBUS) ||
+            (Length < MBAP_MIN_LENGTH) || (Length > MBAP_MAX_LENGTH)) {
+            Modbus_Metrics_Add(&Modbus_Metrics_Slot()->Frame_Errors, 1);
+            Result = SERVE_ERROR;
+            break;
+        }
+        if ((Conn->Rx_Length - Offset) < (MBAP_HEADER_LENGTH + Length)) {
+            break;
+        }
+        if (Connection_Has_Room(Server, Conn) == FALSE) {
+            Result = SERVE_BLOCKED;
+            break;
+        }
+
+        if (Server->Forward != NULL) {
+            Frame_Attach(&Request, &Request_Adu[MBAP_HEADER_LENGTH], Length);
+            Conn->Pending++;
+            Server->Serving = Conn;
+            Server->Forward(Server->Forward_Context, Conn,
+                            Frame_Get_U16(&Request_Adu[MBAP_TRANSACTION_OFFSET]),
+                            &Request);
+            Server->Serving = NULL;
+            Server->Requests_Served++;
+            Offset += MBAP_HEADER_LENGTH + Length;
+            continue;
+        }
+
+        //!-  Make room for one full Response at the Tail.
+        if ((Conn->Tx_Head + Conn->Tx_Length + MODBUS_TCP_MAX_ADU_LENGTH) >
+             TCP_SERVER_TX_BUFFER) {
+            memmove(Conn->Tx_Buffer, &Conn->Tx_Buffer[Conn->Tx_Head],
+                    Conn->Tx_Length);
+            Conn->Tx_Head = 0;
+        }
+        Response_Adu = &Conn->Tx_Buffer[Conn->Tx_Head + Conn->Tx_Length];
+
+        Frame_Attach(&Request, &Request_Adu[MBAP_HEADER_LENGTH], Length);
+        Frame_Attach(&Response, &Response_Adu[MBAP_HEADER_LENGTH], 0);
+        Now_ns = Modbus_Now_ns();
+        Modbus_Metrics_Stage_Time(METRICS_PARSE, Now_ns - Stamp_ns);
+        (void) Modbus_TCP_Response(&Request, &Response);
+        Stamp_ns = Modbus_Now_ns();
+        Modbus_Metrics_Stage_Time(METRICS_DISPATCH, Stamp_ns - Now_ns);
+
+        /*
+         *!-  TCP has no Broadcast: every Request gets its Answer. Unit
+         *!-  0 and 0xFF are the Default Unit, a Unit not hosted gets
+         *!-  GATEWAY_PATH_UNAVAILABLE (see Modbus_TCP_Response()).
+         */
+        if (Response.Length > 0) {
+            memcpy(&Response_Adu[MBAP_TRANSACTION_OFFSET],
+                   &Request_Adu[MBAP_TRANSACTION_OFFSET], 2);
+            Frame_Put_U16(&Response_Adu[MBAP_PROTOCOL_OFFSET],
+                          MBAP_PROTOCOL_MODBUS);
+            Frame_Put_U16(&Response_Adu[MBAP_LENGTH_OFFSET], Response.Length);
+            Conn->Tx_Length += MBAP_HEADER_LENGTH + Response.Length;
+        }
+        Now_ns = Modbus_Now_ns();
+        Modbus_Metrics_Stage_Time(METRICS_ENCODE, Now_ns - Stamp_ns);
+        Stamp_ns = Now_ns;
+        Server->Requests_Served++;
+        Offset += MBAP_HEADER_LENGTH + Length;
+    }
+
+    if (Offset > 0) {
+        Conn->Rx_Length -= Offset;
+        memmove(Conn->Rx_Buffer, &Conn->Rx_Buffer[Offset], Conn->Rx_Length);
+    }
+    return Result;
+}
+
+/*
+ *!-  Connection_Flush() writes pending Responses until the Socket
+ *!-  would block. Returns FALSE if the Connection failed.
+ */
+Bool Connection_Flush(
+        TCP_Connection *const Conn) {
+
+    Bool Check_Ok = TRUE;
+    ssize_t Sent = 0;
+
+    while (Conn->Tx_Length > 0) {
+        Sent = send(Conn->Fd, &Conn->Tx_Buffer[Conn->Tx_Head],
+                    Conn->Tx_Length, MSG_NOSIGNAL);
+        if (Sent > 0) {
+            Conn->Tx_Head += (uint16_t) Sent;
+            Conn->Tx_Length -= (uint16_t) Sent;
+        }
+        else if ((Sent < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+            break;
+        }
+        else if ((Sent < 0) && (errno == EINTR)) {
+            continue;
+        }
+        else {
+            Check_Ok = FALSE;
+            break;
+        }
+    }
+    if (Conn->Tx_Length == 0) {
+        Conn->Tx_Head = 0;
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Connection_Read() drains the Socket (Edge-Triggered) and
+ *!-  serves Requests as they complete. When the Tx Buffer stays
+ *!-  full it stops reading; the next EPOLLOUT resumes it.
+ *!-  Returns FALSE if the Connection has to be closed.
+ */
+Bool Connection_Read(
+        Modbus_TCP_Server *const Server,
+        TCP_Connection *const Conn) {
+
+    Bool Check_Ok = TRUE;
+    Serve_Result Result = SERVE_DONE;
+    ssize_t Received = 0;
+
+    Conn->Rx_Blocked = FALSE;
+    for (;;) {
+        Result = Connection_Serve(Server, Conn);
+        if (Result == SERVE_ERROR) {
+            Check_Ok = FALSE;
+            break;
+        }
+        if (Result == SERVE_BLOCKED) {
+            if (Connection_Flush(Conn) == FALSE) {
+                Check_Ok = FALSE;
+                break;
+            }
+            if (Connection_Has_Room(Server, Conn) == FALSE) {
+                Conn->Rx_Blocked = TRUE;
+                break;
+            }
+            continue;
+        }
+
+        Received = read(Conn->Fd, &Conn->Rx_Buffer[Conn->Rx_Length],
+                        TCP_SERVER_RX_BUFFER - Conn->Rx_Length);
+        if (Received > 0) {
+            Conn->Rx_Length += (uint16_t) Received;
+        }
+        else if (Received == 0) {
+            //!-  Peer closed: hand out what is already answered.
+            (void) Connection_Flush(Conn);
+            Check_Ok = FALSE;
+            break;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+            break;
+        }
+        else if (errno != EINTR) {
+            Check_Ok = FALSE;
+            break;
+        }
+    }
+
+    if (Check_Ok == TRUE) {
+        Check_Ok = Connection_Flush(Conn);
+    }
+    return Check_Ok;
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Modbus_TCP_Server_Open() reserves the Connection Pool and
+ *!-  starts listening on "Port" (all Interfaces).
+ */
+Bool Modbus_TCP_Server_Open(
+        Modbus_TCP_Server *const Server,
+        uint16_t const Port) {
+
+    Bool Check_Ok = FALSE;
+    int One = 1;
+    uint32_t Index = 0;
+    struct sockaddr_in Address;
+    struct epoll_event Event;
+
+    memset(Server, 0, sizeof(*Server));
+    Server->Listen_Fd = -1;
+    Server->Epoll_Fd = -1;
+
+    Server->Pool = calloc(TCP_SERVER_MAX_CONNECTIONS, sizeof(TCP_Connection));
+    if (Server->Pool != NULL) {
+        for (Index = TCP_SERVER_MAX_CONNECTIONS; Index > 0; Index--) {
+            Server->Pool[Index - 1].Fd = -1;
+            Server->Pool[Index - 1].Next_Free = Server->Free_List;
+            Server->Free_List = &Server->Pool[Index - 1];
+        }
+
+        memset(&Address, 0, sizeof(Address));
+        Address.sin_family = AF_INET;
+        Address.sin_addr.s_addr = htonl(INADDR_ANY);
+        Address.sin_port = htons(Port);
+
+        Server->Listen_Fd = socket(AF_INET,
+                                   SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        Server->Epoll_Fd = epoll_create1(EPOLL_CLOEXEC);
+        if ((Server->Listen_Fd >= 0) && (Server->Epoll_Fd >= 0)) {
+            (void) setsockopt(Server->Listen_Fd, SOL_SOCKET, SO_REUSEADDR,
+                              &One, sizeof(One));
+            Event.events = EPOLLIN | EPOLLET;
+            Event.data.ptr = NULL;
+            if ((bind(Server->Listen_Fd, (struct sockaddr *) &Address,
+                      sizeof(Address)) == 0) &&
+                (listen(Server->Listen_Fd, SOMAXCONN) == 0) &&
+                (epoll_ctl(Server->Epoll_Fd, EPOLL_CTL_ADD,
+                           Server->Listen_Fd, &Event) == 0)) {
+                Check_Ok = TRUE;
+            }
+        }
+    }
+
+    if (Check_Ok == FALSE) {
+        Modbus_TCP_Server_Close(Server);
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_TCP_Server_Poll() waits up to "TimeoutMs" (-1: forever)
+ *!-  and handles every ready Socket once.
+ *!-  Returns the Number of Events handled, or -1 on Error.
+ */
+int Modbus_TCP_Server_Poll(
+        Modbus_TCP_Server *const Server,
+        int const TimeoutMs) {
+
+    struct epoll_event Events[TCP_SERVER_MAX_EVENTS];
+    TCP_Connection *Conn = NULL;
+    Bool Keep = TRUE;
+    int Count = 0;
+    int Index = 0;
+
+    Count = epoll_wait(Server->Epoll_Fd, Events, TCP_SERVER_MAX_EVENTS,
+                       TimeoutMs);
+    if ((Count < 0) && (errno == EINTR)) {
+        Count = 0;
+    }
+
+    for (Index = 0; Index < Count; Index++) {
+        Conn = (TCP_Connection *) Events[Index].data.ptr;
+        if (Conn == NULL) {
+            Server_Accept_All(Server);
+        }
+        //!-  A Reply in this Batch may have closed it already.
+        else if (Conn->Fd >= 0) {
+            Keep = TRUE;
+            if (Events[Index].events & (EPOLLERR | EPOLLHUP)) {
+                Keep = FALSE;
+            }
+            if ((Keep == TRUE) && (Events[Index].events & EPOLLOUT)) {
+                Keep = Connection_Flush(Conn);
+            }
+            if ((Keep == TRUE) &&
+                ((Events[Index].events & (EPOLLIN | EPOLLRDHUP)) ||
+                 (Conn->Rx_Blocked == TRUE))) {
+                Keep = Connection_Read(Server, Conn);
+            }
+            if (Keep == FALSE) {
+                Server_Close_Connection(Server, Conn);
+            }
+        }
+    }
+    return Count;
+}
+
+/*
+ *!-  Modbus_TCP_Server_Forward() hands all Requests to "Forward"
+ *!-  from now on (see Modbus_TCP_Forward). Each Connection then
+ *!-  has at most as many Requests open as Tx_Buffer holds
+ *!-  Responses; beyond that its Requests are left unread.
+ */
+void Modbus_TCP_Server_Forward(
+        Modbus_TCP_Server *const Server,
+        Modbus_TCP_Forward const Forward,
+        void *const Context) {
+
+    Server->Forward = Forward;
+    Server->Forward_Context = Context;
+}
+
+/*
+ *!-  Modbus_TCP_Server_Reply() answers a forwarded Request of
+ *!-  "Conn" with "Response" (Unit ID + PDU; NULL: no Answer, as
+ *!-  for a Broadcast). Nothing is sent if the Connection was
+ *!-  closed, or reused ("Generation"), since. Returns FALSE then,
+ *!-  or if the Connection failed and was closed.
+ */
+Bool Modbus_TCP_Server_Reply(
+        Modbus_TCP_Server *const Server,
+        TCP_Connection *const Conn,
+        uint32_t const Generation,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Response) {
+
+    Bool Check_Ok = FALSE;
+    uint8_t *Adu = NULL;
+
+    if ((Conn->Fd >= 0) && (Conn->Generation == Generation) &&
+        (Conn->Pending > 0)) {
+        Conn->Pending--;
+        if ((Response != NULL) && (Response->Length > 0) &&
+            (Response->Length <= MBAP_MAX_LENGTH)) {
+            if ((Conn->Tx_Head + Conn->Tx_Length + MODBUS_TCP_MAX_ADU_LENGTH) >
+                 TCP_SERVER_TX_BUFFER) {
+                memmove(Conn->Tx_Buffer, &Conn->Tx_Buffer[Conn->Tx_Head],
+                        Conn->Tx_Length);
+                Conn->Tx_Head = 0;
+            }
+            Adu = &Conn->Tx_Buffer[Conn->Tx_Head + Conn->Tx_Length];
+            Frame_Put_U16(&Adu[MBAP_TRANSACTION_OFFSET], Transaction_ID);
+            Frame_Put_U16(&Adu[MBAP_PROTOCOL_OFFSET], MBAP_PROTOCOL_MODBUS);
+            Frame_Put_U16(&Adu[MBAP_LENGTH_OFFSET], Response->Length);
+            memcpy(&Adu[MBAP_HEADER_LENGTH], Response->Adu, Response->Length);
+            Conn->Tx_Length += MBAP_HEADER_LENGTH + Response->Length;
+        }
+
+        //!-  While its Requests are being served, the Caller flushes.
+        Check_Ok = TRUE;
+        if (Server->Serving != Conn) {
+            Check_Ok = Connection_Flush(Conn);
+            if ((Check_Ok == TRUE) && (Conn->Rx_Blocked == TRUE) &&
+                (Connection_Has_Room(Server, Conn) == TRUE)) {
+                Check_Ok = Connection_Read(Server, Conn);
+            }
+            if (Check_Ok == FALSE) {
+                Server_Close_Connection(Server, Conn);
+            }
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Modbus_TCP_Server_Close() closes every Socket and frees the Pool.
+void Modbus_TCP_Server_Close(
+        Modbus_TCP_Server *const Server) {
+
+    uint32_t Index = 0;
+
+    if (Server->Pool != NULL) {
+        for (Index = 0; Index < TCP_SERVER_MAX_CONNECTIONS; Index++) {
+            if (Server->Pool[Index].Fd >= 0) {
+                close(Server->Pool[Index].Fd);
+            }
+        }
+        free(Server->Pool);
+        Server->Pool = NULL;
+    }
+    if (Server->Listen_Fd >= 0) {
+        close(Server->Listen_Fd);
+        Server->Listen_Fd = -1;
+    }
+    if (Server->Epoll_Fd >= 0) {
+        close(Server->Epoll_Fd);
+        Server->Epoll_Fd = -1;
+    }
+    Server->Free_List = NULL;
+    Server->Active_Connections = 0;
+}
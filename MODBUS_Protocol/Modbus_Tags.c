@@ -0,0 +1,498 @@
+/*
+ * Modbus_Tags.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Tags.c
+*****************************************************************************/
+
+//!-  Headers
+#include <math.h>
+#include <string.h>
+#include "Modbus.h"
+#include "Modbus_Swap.h"
+#include "Modbus_Tags.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  Runs of Tags are converted through a Scratch Buffer of this
+ *!-  Size, a full Register Payload; longer Runs are split.
+ */
+#define TAGS_SCRATCH_BYTES  (256U)
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define TAGS_HOST_IS_LE  1
+#else
+#define TAGS_HOST_IS_LE  0
+#endif
+
+uint32_t Tags_Width(
+        Modbus_Tag_Type const Type);
+
+uint32_t Tags_Mask(
+        uint32_t const Width,
+        Modbus_Word_Order const Order);
+
+Bool Tags_Inside(
+        const Modbus_Typed_Tag *const Tag,
+        uint16_t const First,
+        uint16_t const Quantity);
+
+uint32_t Tags_Run(
+        const Modbus_Typed_Tag *const Tags,
+        uint32_t const Count,
+        uint16_t const First,
+        uint16_t const Quantity);
+
+double Tags_Raw(
+        Modbus_Tag_Type const Type,
+        const uint8_t *const Bytes);
+
+void Tags_Store(
+        Modbus_Tag_Type const Type,
+        double const Value,
+        uint8_t *const Bytes);
+
+void Tags_Convert(
+        uint8_t *const Dst,
+        const uint8_t *const Src,
+        uint32_t const Count,
+        Modbus_Tag_Type const Type,
+        Modbus_Word_Order const Order);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Tags_Width() gives the Bytes of one Value of a Type.
+uint32_t Tags_Width(
+        Modbus_Tag_Type const Type) {
+
+    uint32_t Width = 2;
+
+    switch (Type) {
+        case TAG_UINT32:
+        case TAG_INT32:
+        case TAG_FLOAT32:
+            Width = 4;
+            break;
+        case TAG_UINT64:
+        case TAG_INT64:
+        case TAG_FLOAT64:
+            Width = 8;
+            break;
+        default:
+            break;
+    }
+    return Width;
+}
+
+/*
+ *!-  Tags_Mask() gives the Permutation between Wire and Host Bytes
+ *!-  of a Value: Host Byte "i" is Wire Byte "i ^ Mask". Every Word
+ *!-  Order is such an XOR on the Big-Endian Layout (CDAB swaps the
+ *!-  Registers, BADC the Bytes in them, DCBA both), and so is the
+ *!-  Host Byte Order, so one Mask serves Decode and Encode.
+ */
+uint32_t Tags_Mask(
+        uint32_t const Width,
+        Modbus_Word_Order const Order) {
+
+    uint32_t Mask = 0;
+
+    switch (Order) {
+        case WORD_ORDER_CDAB:
+            Mask = Width - 2;
+            break;
+        case WORD_ORDER_BADC:
+            Mask = 1;
+            break;
+        case WORD_ORDER_DCBA:
+            Mask = Width - 1;
+            break;
+        default:
+            break;
+    }
+#if TAGS_HOST_IS_LE
+    Mask ^= Width - 1;
+#endif
+    return Mask;
+}
+
+//!-  Tags_Inside() tells if a Tag lies within a Payload.
+Bool Tags_Inside(
+        const Modbus_Typed_Tag *const Tag,
+        uint16_t const First,
+        uint16_t const Quantity) {
+
+    return (Bool) ((Tag->Address >= First) &&
+                   (((uint32_t) Tag->Address - First +
+                     Modbus_Tag_Registers(Tag)) <= Quantity));
+}
+
+/*
+ *!-  Tags_Run() gives how many Tags from the first one are adjacent,
+ *!-  of the same Type and Order and within the Payload, up to what
+ *!-  fits in the Scratch Buffer. The first Tag must be inside.
+ */
+uint32_t Tags_Run(
+        const Modbus_Typed_Tag *const Tags,
+        uint32_t const Count,
+        uint16_t const First,
+        uint16_t const Quantity) {
+
+    uint32_t const Registers = Modbus_Tag_Registers(&Tags[0]);
+    uint32_t const Limit = TAGS_SCRATCH_BYTES / Tags_Width(Tags[0].Type);
+    uint32_t Run = 1;
+
+    while ((Run < Count) && (Run < Limit) &&
+           (Tags[Run].Type == Tags[0].Type) &&
+           (Tags[Run].Order == Tags[0].Order) &&
+           ((uint32_t) Tags[Run].Address ==
+            (uint32_t) Tags[0].Address + Run * Registers) &&
+           (Tags_Inside(&Tags[Run], First, Quantity) == TRUE)) {
+        Run++;
+    }
+    return Run;
+}
+
+//!-  Tags_Raw() reads a Host-Order Value of a Type as a double.
+double Tags_Raw(
+        Modbus_Tag_Type const Type,
+        const uint8_t *const Bytes) {
+
+    uint16_t U16 = 0;
+    int16_t I16 = 0;
+    uint32_t U32 = 0;
+    int32_t I32 = 0;
+    float F32 = 0.0f;
+    uint64_t U64 = 0;
+    int64_t I64 = 0;
+    double Raw = NAN;
+
+    switch (Type) {
+        case TAG_UINT16:
+            memcpy(&U16, Bytes, sizeof(U16));
+            Raw = U16;
+            break;
+        case TAG_INT16:
+            memcpy(&I16, Bytes, sizeof(I16));
+            Raw = I16;
+            break;
+        case TAG_UINT32:
+            memcpy(&U32, Bytes, sizeof(U32));
+            Raw = U32;
+            break;
+        case TAG_INT32:
+            memcpy(&I32, Bytes, sizeof(I32));
+            Raw = I32;
+            break;
+        case TAG_FLOAT32:
+            memcpy(&F32, Bytes, sizeof(F32));
+            Raw = F32;
+            break;
+        case TAG_UINT64:
+            memcpy(&U64, Bytes, sizeof(U64));
+            Raw = (double) U64;
+            break;
+        case TAG_INT64:
+            memcpy(&I64, Bytes, sizeof(I64));
+            Raw = (double) I64;
+            break;
+        case TAG_FLOAT64:
+            memcpy(&Raw, Bytes, sizeof(Raw));
+            break;
+        default:
+            break;
+    }
+    return Raw;
+}
+
+/*
+ *!-  Tags_Store() writes a double as a Host-Order Value of a Type,
+ *!-  Integers rounded and saturated (NaN gives 0).
+ */
+void Tags_Store(
+        Modbus_Tag_Type const Type,
+        double const Value,
+        uint8_t *const Bytes) {
+
+    double const Rounded = isnan(Value) ? 0.0 : round(Value);
+    uint16_t U16 = 0;
+    int16_t I16 = 0;
+    uint32_t U32 = 0;
+    int32_t I32 = 0;
+    float F32 = 0.0f;
+    uint64_t U64 = 0;
+    int64_t I64 = 0;
+
+    switch (Type) {
+        case TAG_UINT16:
+            U16 = (Rounded <= 0.0) ? 0 : (Rounded >= UINT16_MAX) ?
+                  UINT16_MAX : (uint16_t) Rounded;
+            memcpy(Bytes, &U16, sizeof(U16));
+            break;
+        case TAG_INT16:
+            I16 = (Rounded <= INT16_MIN) ? INT16_MIN : (Rounded >= INT16_MAX) ?
+                  INT16_MAX : (int16_t) Rounded;
+            memcpy(Bytes, &I16, sizeof(I16));
+            break;
+        case TAG_UINT32:
+            U32 = (Rounded <= 0.0) ? 0 : (Rounded >= UINT32_MAX) ?
+                  UINT32_MAX : (uint32_t) Rounded;
+            memcpy(Bytes, &U32, sizeof(U32));
+            break;
+        case TAG_INT32:
+            I32 = (Rounded <= INT32_MIN) ? INT32_MIN : (Rounded >= INT32_MAX) ?
+                  INT32_MAX : (int32_t) Rounded;
+            memcpy(Bytes, &I32, sizeof(I32));
+            break;
+        case TAG_FLOAT32:
+            F32 = (float) Value;
+            memcpy(Bytes, &F32, sizeof(F32));
+            break;
+        case TAG_UINT64:
+            //!-  2^64 and 2^63 are exact Doubles, their Maxima are not.
+            U64 = (Rounded <= 0.0) ? 0 : (Rounded >= 18446744073709551616.0) ?
+                  UINT64_MAX : (uint64_t) Rounded;
+            memcpy(Bytes, &U64, sizeof(U64));
+            break;
+        case TAG_INT64:
+            I64 = (Rounded < -9223372036854775808.0) ? INT64_MIN :
+                  (Rounded >= 9223372036854775808.0) ?
+                  INT64_MAX : (int64_t) Rounded;
+            memcpy(Bytes, &I64, sizeof(I64));
+            break;
+        case TAG_FLOAT64:
+            memcpy(Bytes, &Value, sizeof(Value));
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ *!-  Tags_Convert() moves "Count" Values between Wire and Host
+ *!-  Order, either Way: a Copy when the Orders agree, else one
+ *!-  Swap_Elements() Pass.
+ */
+void Tags_Convert(
+        uint8_t *const Dst,
+        const uint8_t *const Src,
+        uint32_t const Count,
+        Modbus_Tag_Type const Type,
+        Modbus_Word_Order const Order) {
+
+    uint32_t const Width = Tags_Width(Type);
+    uint32_t const Mask = Tags_Mask(Width, Order);
+    uint8_t Pattern[16];
+    uint32_t Index = 0;
+
+    if (Mask == 0) {
+        memmove(Dst, Src, Count * Width);
+    }
+    else {
+        for (Index = 0; Index < sizeof(Pattern); Index++) {
+            Pattern[Index] = (uint8_t) (Index ^ Mask);
+        }
+        Swap_Elements(Dst, Src, Count * Width, Pattern);
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Modbus_Tag_Registers() gives how many Registers a Tag takes.
+uint16_t Modbus_Tag_Registers(
+        const Modbus_Typed_Tag *const Tag) {
+
+    uint16_t Registers = Tag->Length;
+
+    if (Tag->Type != TAG_STRING) {
+        Registers = (uint16_t) (Tags_Width(Tag->Type) / 2);
+    }
+    return Registers;
+}
+
+//!-  Modbus_Decode_Array() converts Wire Values into a Host Array.
+void Modbus_Decode_Array(
+        void *const Values,
+        const uint8_t *const Payload,
+        uint32_t const Count,
+        Modbus_Tag_Type const Type,
+        Modbus_Word_Order const Order) {
+
+    Tags_Convert(Values, Payload, Count, Type, Order);
+}
+
+//!-  Modbus_Encode_Array() converts a Host Array into Wire Values.
+void Modbus_Encode_Array(
+        uint8_t *const Payload,
+        const void *const Values,
+        uint32_t const Count,
+        Modbus_Tag_Type const Type,
+        Modbus_Word_Order const Order) {
+
+    Tags_Convert(Payload, Values, Count, Type, Order);
+}
+
+/*
+ *!-  Modbus_Tags_Decode() gives the Engineering Values of Tags, a
+ *!-  Run of adjacent Tags of one Type and Order at a Time.
+ */
+Bool Modbus_Tags_Decode(
+        const Modbus_Typed_Tag *const Tags,
+        uint32_t const Count,
+        uint16_t const First,
+        const uint8_t *const Payload,
+        uint16_t const Quantity,
+        double *const Values) {
+
+    uint64_t Scratch[TAGS_SCRATCH_BYTES / sizeof(uint64_t)];
+    const Modbus_Typed_Tag *Tag = NULL;
+    Bool Check_Ok = TRUE;
+    uint32_t Index = 0;
+    uint32_t Run = 0;
+    uint32_t Width = 0;
+    uint32_t Item = 0;
+    double Raw = 0.0;
+
+    while (Index < Count) {
+        Tag = &Tags[Index];
+        if (Tags_Inside(Tag, First, Quantity) == FALSE) {
+            Check_Ok = FALSE;
+            Values[Index++] = NAN;
+        }
+        else if (Tag->Type == TAG_STRING) {
+            Values[Index++] = NAN;
+        }
+        else {
+            Run = Tags_Run(Tag, Count - Index, First, Quantity);
+            Width = Tags_Width(Tag->Type);
+            Modbus_Decode_Array(Scratch, &Payload[2 * (Tag->Address - First)],
+                                Run, Tag->Type, Tag->Order);
+            for (Item = 0; Item < Run; Item++, Tag++) {
+                Raw = Tags_Raw(Tag->Type, (uint8_t *) Scratch + Item * Width);
+                Values[Index + Item] = Tag->Offset + Raw *
+                                       ((Tag->Scale != 0.0) ? Tag->Scale : 1.0);
+            }
+            Index += Run;
+        }
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Modbus_Tags_Encode() stores Engineering Values into a Payload,
+ *!-  a Run of adjacent Tags of one Type and Order at a Time.
+ */
+Bool Modbus_Tags_Encode(
+        const Modbus_Typed_Tag *const Tags,
+        uint32_t const Count,
+        const double *const Values,
+        uint16_t const First,
+        uint8_t *const Payload,
+        uint16_t const Quantity) {
+
+    uint64_t Scratch[TAGS_SCRATCH_BYTES / sizeof(uint64_t)];
+    const Modbus_Typed_Tag *Tag = NULL;
+    Bool Check_Ok = TRUE;
+    uint32_t Index = 0;
+    uint32_t Run = 0;
+    uint32_t Width = 0;
+    uint32_t Item = 0;
+    double Raw = 0.0;
+
+    while (Index < Count) {
+        Tag = &Tags[Index];
+        if ((Tag->Type == TAG_STRING) ||
+            (Tags_Inside(Tag, First, Quantity) == FALSE)) {
+            Check_Ok = FALSE;
+            Index++;
+        }
+        else {
+            Run = Tags_Run(Tag, Count - Index, First, Quantity);
+            Width = Tags_Width(Tag->Type);
+            for (Item = 0; Item < Run; Item++) {
+                Raw = (Values[Index + Item] - Tag[Item].Offset) /
+                      ((Tag[Item].Scale != 0.0) ? Tag[Item].Scale : 1.0);
+                Tags_Store(Tag->Type, Raw, (uint8_t *) Scratch + Item * Width);
+            }
+            Modbus_Encode_Array(&Payload[2 * (Tag->Address - First)], Scratch,
+                                Run, Tag->Type, Tag->Order);
+            Index += Run;
+        }
+    }
+    return Check_Ok;
+}
+
+//!-  Modbus_Tag_Get_String() copies a TAG_STRING into "Text".
+Bool Modbus_Tag_Get_String(
+        const Modbus_Typed_Tag *const Tag,
+        uint16_t const First,
+        const uint8_t *const Payload,
+        uint16_t const Quantity,
+        char *const Text,
+        uint32_t const Size) {
+
+    const uint8_t *Source = NULL;
+    uint32_t Swap = 0;
+    uint32_t Bytes = 0;
+    uint32_t Index = 0;
+
+    Bool Check_Ok = FALSE;
+
+    if ((Size > 0) && (Tag->Type == TAG_STRING) &&
+        (Tags_Inside(Tag, First, Quantity) == TRUE)) {
+        Source = &Payload[2 * (Tag->Address - First)];
+        Swap = ((Tag->Order == WORD_ORDER_BADC) ||
+                (Tag->Order == WORD_ORDER_DCBA)) ? 1 : 0;
+        Bytes = 2U * Tag->Length;
+        while ((Index < Bytes) && (Index < (Size - 1)) &&
+               (Source[Index ^ Swap] != '\0')) {
+            Text[Index] = (char) Source[Index ^ Swap];
+            Index++;
+        }
+        Text[Index] = '\0';
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
+
+//!-  Modbus_Tag_Put_String() stores "Text", NUL padded, in a TAG_STRING.
+Bool Modbus_Tag_Put_String(
+        const Modbus_Typed_Tag *const Tag,
+        const char *const Text,
+        uint16_t const First,
+        uint8_t *const Payload,
+        uint16_t const Quantity) {
+
+    uint8_t *Target = NULL;
+    uint32_t Swap = 0;
+    uint32_t Bytes = 0;
+    uint32_t Length = 0;
+    uint32_t Index = 0;
+
+    Bool Check_Ok = FALSE;
+
+    if ((Tag->Type == TAG_STRING) &&
+        (Tags_Inside(Tag, First, Quantity) == TRUE)) {
+        Target = &Payload[2 * (Tag->Address - First)];
+        Swap = ((Tag->Order == WORD_ORDER_BADC) ||
+                (Tag->Order == WORD_ORDER_DCBA)) ? 1 : 0;
+        Bytes = 2U * Tag->Length;
+        Length = (uint32_t) strnlen(Text, Bytes);
+        for (Index = 0; Index < Bytes; Index++) {
+            Target[Index ^ Swap] = (Index < Length) ? (uint8_t) Text[Index] : 0;
+        }
+        Check_Ok = TRUE;
+    }
+    return Check_Ok;
+}
@@ -0,0 +1,151 @@
+/*
+ * Modbus_Tags.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Tags.h
+*****************************************************************************/
+
+#ifndef __MODBUS_TAGS_H_
+#define __MODBUS_TAGS_H_
+
+//!-  Headers
+#include <stdint.h>
+#include <Modbus_Configuration.h>
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  "Modbus_Tag_Type" ENUM lists the Types a Tag spreads over one
+ *!-  or more consecutive Registers. TAG_STRING takes "Length"
+ *!-  Registers, two Characters each.
+ */
+typedef enum {
+    TAG_UINT16  = 0,
+    TAG_INT16   = 1,
+    TAG_UINT32  = 2,
+    TAG_INT32   = 3,
+    TAG_FLOAT32 = 4,
+    TAG_UINT64  = 5,
+    TAG_INT64   = 6,
+    TAG_FLOAT64 = 7,
+    TAG_STRING  = 8,
+} Modbus_Tag_Type;
+
+/*
+ *!-  "Modbus_Word_Order" ENUM is how a Device lays the Bytes of a
+ *!-  Value, "A" the most significant, on the Wire. For 32-bit Values:
+ *!-  WORD_ORDER_ABCD: Big-Endian, the Modbus Default.
+ *!-  WORD_ORDER_CDAB: Big-Endian Registers, low Register first.
+ *!-  WORD_ORDER_BADC: Bytes swapped in every Register.
+ *!-  WORD_ORDER_DCBA: Little-Endian.
+ *!-  64-bit Values follow the same Rule over four Registers; for
+ *!-  16-bit Values and Strings only the Byte Swap counts.
+ */
+typedef enum {
+    WORD_ORDER_ABCD = 0,
+    WORD_ORDER_CDAB = 1,
+    WORD_ORDER_BADC = 2,
+    WORD_ORDER_DCBA = 3,
+} Modbus_Word_Order;
+
+/*
+ *!-  "Modbus_Typed_Tag" maps a Value onto Registers: the Engineering
+ *!-  Value is Raw * Scale + Offset. "Length" is only used by
+ *!-  TAG_STRING; "Scale" 0 is taken as 1. The Planner's
+ *!-  "Modbus_Tag" only names the Register a Master polls.
+ */
+typedef struct {
+    uint16_t           Address;
+    Modbus_Tag_Type    Type;
+    Modbus_Word_Order  Order;
+    uint16_t           Length;
+    double             Scale;
+    double             Offset;
+} Modbus_Typed_Tag;
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Modbus_Tag_Registers() gives how many Registers a Tag takes.
+uint16_t Modbus_Tag_Registers(
+        const Modbus_Typed_Tag *const Tag);
+
+/*
+ *!-  Modbus_Decode_Array() converts "Count" Values of a Type (not
+ *!-  TAG_STRING) from Wire Bytes, e.g. a FC03/FC04 Response Payload,
+ *!-  into a Host Array of the Type (uint16_t ... double), in one
+ *!-  Pass with the Swap Kernel in use.
+ */
+void Modbus_Decode_Array(
+        void *const Values,
+        const uint8_t *const Payload,
+        uint32_t const Count,
+        Modbus_Tag_Type const Type,
+        Modbus_Word_Order const Order);
+
+//!-  Modbus_Encode_Array() is the Reverse, e.g. for a FC16 Payload.
+void Modbus_Encode_Array(
+        uint8_t *const Payload,
+        const void *const Values,
+        uint32_t const Count,
+        Modbus_Tag_Type const Type,
+        Modbus_Word_Order const Order);
+
+/*
+ *!-  Modbus_Tags_Decode() gives the Engineering Values of "Count"
+ *!-  Tags from a Payload of "Quantity" Registers read at "First".
+ *!-  Runs of adjacent Tags of the same Type and Order are decoded
+ *!-  together. Strings, and Tags outside the Payload, give NaN;
+ *!-  the latter also make it return FALSE.
+ */
+Bool Modbus_Tags_Decode(
+        const Modbus_Typed_Tag *const Tags,
+        uint32_t const Count,
+        uint16_t const First,
+        const uint8_t *const Payload,
+        uint16_t const Quantity,
+        double *const Values);
+
+/*
+ *!-  Modbus_Tags_Encode() stores Engineering Values into a Payload
+ *!-  of "Quantity" Registers written at "First", e.g. for FC16.
+ *!-  Integers are rounded and saturated to their Type. Registers
+ *!-  no Tag covers are left untouched. Returns FALSE if a Tag is a
+ *!-  String or outside the Payload; such Tags are skipped.
+ */
+Bool Modbus_Tags_Encode(
+        const Modbus_Typed_Tag *const Tags,
+        uint32_t const Count,
+        const double *const Values,
+        uint16_t const First,
+        uint8_t *const Payload,
+        uint16_t const Quantity);
+
+/*
+ *!-  Modbus_Tag_Get_String() copies a TAG_STRING into "Text" (up
+ *!-  to "Size" - 1 Characters, stopping at a NUL, NUL terminated).
+ */
+Bool Modbus_Tag_Get_String(
+        const Modbus_Typed_Tag *const Tag,
+        uint16_t const First,
+        const uint8_t *const Payload,
+        uint16_t const Quantity,
+        char *const Text,
+        uint32_t const Size);
+
+//!-  Modbus_Tag_Put_String() stores "Text", NUL padded, in a TAG_STRING.
+Bool Modbus_Tag_Put_String(
+        const Modbus_Typed_Tag *const Tag,
+        const char *const Text,
+        uint16_t const First,
+        uint8_t *const Payload,
+        uint16_t const Quantity);
+
+#endif /* __MODBUS_TAGS_H_ */
@@ -0,0 +1,111 @@
+/*
+ * Modbus_Top.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Top.c
+ ****************************************************************************/
+
+//!-  Headers
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Modbus.h"
+#include "Modbus_Clock.h"
+#include "Modbus_Metrics.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+void Top_Rates(
+        const Modbus_Metrics *const Now,
+        const Modbus_Metrics *const Before,
+        double const Seconds);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Metrics  Top_Now;
+static Modbus_Metrics  Top_Before;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Top_Rates() prints the Requests/s between two Snapshots.
+void Top_Rates(
+        const Modbus_Metrics *const Now,
+        const Modbus_Metrics *const Before,
+        double const Seconds) {
+
+    uint64_t Total = 0;
+    uint64_t Exceptions = 0;
+    uint32_t Index = 0;
+
+    printf("rates:");
+    for (Index = 0; Index < METRICS_FUNCTION_CODES; Index++) {
+        Total += Now->Requests[Index] - Before->Requests[Index];
+        if (Now->Requests[Index] != Before->Requests[Index]) {
+            printf(" fc%02u=%.0f/s", Index,
+                   (double) (Now->Requests[Index] - Before->Requests[Index]) /
+                   Seconds);
+        }
+    }
+    for (Index = 0; Index < METRICS_EXCEPTION_CODES; Index++) {
+        Exceptions += Now->Exceptions[Index] - Before->Exceptions[Index];
+    }
+    printf(" total=%.0f/s exceptions=%.0f/s\n", (double) Total / Seconds,
+           (double) Exceptions / Seconds);
+}
+
+/*
+ *!-  Usage: Modbus_Top metrics [seconds]
+ *!-  Prints the Metrics a Modbus_Slave publishes at "metrics"
+ *!-  (its fifth Argument). With "seconds", prints them again every
+ *!-  "seconds" with the Request Rates since the last Time.
+ */
+int main(int argc, char *argv[]) {
+
+    Bool Ckeck_OK = FALSE;
+    double Interval = 0.0;
+    uint64_t Published_ns = 0;
+    uint64_t Before_ns = 0;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: Modbus_Top metrics [seconds]\n");
+        return EXIT_FAILURE;
+    }
+    if (argc > 2) {
+        Interval = atof(argv[2]);
+    }
+
+    Ckeck_OK = Modbus_Metrics_Export_Read(argv[1], &Top_Now, &Published_ns);
+    while (Ckeck_OK == TRUE) {
+        printf("published %.1f s ago\n",
+               (double) (Modbus_Now_ns() - Published_ns) / NS_PER_S);
+        Modbus_Metrics_Print(&Top_Now, stdout);
+        if ((Before_ns != 0) && (Published_ns > Before_ns)) {
+            Top_Rates(&Top_Now, &Top_Before,
+                      (double) (Published_ns - Before_ns) / NS_PER_S);
+        }
+        printf("\n");
+        fflush(stdout);
+        if (Interval <= 0.0) {
+            break;
+        }
+        Top_Before = Top_Now;
+        Before_ns = Published_ns;
+        usleep((useconds_t) (Interval * 1e6));
+        Ckeck_OK = Modbus_Metrics_Export_Read(argv[1], &Top_Now, &Published_ns);
+    }
+    if (Ckeck_OK == FALSE) {
+        fprintf(stderr, "Modbus_Top: no metrics at %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/*
+ * Modbus_Test.h
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Modbus_Test.h
+*****************************************************************************/
+
+#ifndef __MODBUS_TEST_H_
+#define __MODBUS_TEST_H_
+
+//!-  Headers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Modbus.h"
+#include "Modbus_Frame.h"
+#include "Modbus_TCP.h"
+
+/****************************************************************************
+!-  GLOBAL DEFINITIONS
+*****************************************************************************/
+
+/*
+ *!-  TEST_CHECK() records a failed Condition with its Place and
+ *!-  goes on, so one Run reports every Failure. Test_Result()
+ *!-  gives the Exit Code ctest looks at.
+ */
+#define TEST_CHECK(Condition)                                               \
+    Test_Check((Bool) ((Condition) ? TRUE : FALSE), #Condition,             \
+               __FILE__, __LINE__)
+
+static uint32_t Test_Failures;
+
+/*
+ *!-  "Test_Client_Reply" is what a TCP Client reported for one
+ *!-  Request, see Test_Client_Read().
+ *!-  Calls:    Times the Callback ran; 1 once it completed.
+ *!-  Order:    Test_Reply_Order when it completed, so Tests can
+ *!-            check the Order Answers came in.
+ *!-  Answered: A Response came; FALSE for a Client Timeout.
+ *!-  Value:    The Register read, if it was answered without Exception.
+ */
+typedef struct {
+    uint32_t   Calls;
+    uint32_t   Order;
+    uint8_t    Status;
+    Bool       Answered;
+    uint16_t   Value;
+} Test_Client_Reply;
+
+static uint32_t Test_Reply_Order;
+
+/****************************************************************************
+!-  GLOBAL INLINE FUNCTIONS
+*****************************************************************************/
+
+static inline Bool Test_Check(
+        Bool const Passed,
+        const char *const Condition,
+        const char *const File,
+        int const Line) {
+
+    if (Passed == FALSE) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", File, Line, Condition);
+        Test_Failures++;
+    }
+    return Passed;
+}
+
+static inline int Test_Result(
+        const char *const Name) {
+
+    printf("%s: %u failure(s)\n", Name, Test_Failures);
+    return (Test_Failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//!-  Test_Client_Response() notes a Result and the Order it came in.
+static inline void Test_Client_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    Test_Client_Reply *const Reply = Context;
+
+    Reply->Calls++;
+    Reply->Order = Test_Reply_Order++;
+    Reply->Status = Status;
+    Reply->Answered = (Bool) (Response != NULL);
+    if ((Status == MODBUS_NO_EXCEPTION) && (Response != NULL) &&
+        (Frame_Function_Code(Response) == Fun_Code03)) {
+        Reply->Value = Frame_Register(Frame_Rsp_Payload(Response), 0);
+    }
+}
+
+/*
+ *!-  Test_Client_Read() submits an FC03 Read of one Register to
+ *!-  "Unit_ID", which may be any Unit ID, also 0xFF.
+ */
+static inline Bool Test_Client_Read(
+        Modbus_TCP_Client *const Client,
+        uint8_t const Unit_ID,
+        uint16_t const Address,
+        Test_Client_Reply *const Reply) {
+
+    uint8_t Buffer[MODBUS_MAX_PDU_LENGTH + 1];
+    Modbus_Frame Request;
+
+    memset(Reply, 0, sizeof(Test_Client_Reply));
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Read_Request(&Request, MODBUS_DEFAULT_UNIT,
+                                    Fun_Code03, Address, 1);
+    //!-  The Builders take Serial Addresses only; TCP also has 0xFF.
+    Request.Adu[FRAME_DEVICE_ID_OFFSET] = Unit_ID;
+    return Modbus_TCP_Client_Submit(Client, &Request, Test_Client_Response,
+                                    Reply);
+}
+
+#endif /* __MODBUS_TEST_H_ */
@@ -0,0 +1,275 @@
+/*
+ * Test_Cache.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Cache.c
+*****************************************************************************/
+
+//!-  Headers
+#include "Modbus_Cache.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define TEST_UNIT          (2)
+#define TEST_OTHER_UNIT    (3)
+#define TEST_TTL_NS        (1000)
+//!-  TTL a Rule gives Holding Registers 100 .. 199.
+#define TEST_RULE_TTL_NS   (100)
+
+Modbus_Cache_Result Test_Lookup(
+        uint8_t const Unit_ID,
+        uint8_t const Function_Code,
+        uint16_t const Address,
+        uint16_t const Quantity,
+        uint64_t const Now_ns,
+        Modbus_Cache_Entry **const Entry);
+
+void Test_Complete(
+        Modbus_Cache_Entry *const Entry,
+        uint8_t const Exception,
+        uint64_t const Now_ns);
+
+uint32_t Test_Write(
+        uint8_t const Unit_ID,
+        uint8_t const Function_Code,
+        uint16_t const Address);
+
+void Test_Expiry(
+        void);
+
+void Test_Coalescing(
+        void);
+
+void Test_Invalidation(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Cache Cache;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Lookup() looks up a Read of "Quantity" Items.
+Modbus_Cache_Result Test_Lookup(
+        uint8_t const Unit_ID,
+        uint8_t const Function_Code,
+        uint16_t const Address,
+        uint16_t const Quantity,
+        uint64_t const Now_ns,
+        Modbus_Cache_Entry **const Entry) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Request;
+
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Read_Request(&Request, Unit_ID, Function_Code,
+                                    Address, Quantity);
+    return Modbus_Cache_Lookup(&Cache, &Request, Now_ns, Entry);
+}
+
+/*
+ *!-  Test_Complete() ends the Fetch of an Entry with a one Register
+ *!-  Response, or with "Exception" if not MODBUS_NO_EXCEPTION.
+ */
+void Test_Complete(
+        Modbus_Cache_Entry *const Entry,
+        uint8_t const Exception,
+        uint64_t const Now_ns) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Response;
+
+    Frame_Attach(&Response, Buffer, 0);
+    if (Exception == MODBUS_NO_EXCEPTION) {
+        (void) Frame_Build_Read_Response(&Response, Entry->Unit_ID,
+                                         Entry->Function_Code, 2);
+        Frame_Set_Register(Frame_Rsp_Payload(&Response), 0, 0x1234);
+    }
+    else {
+        (void) Frame_Build_Exception(&Response, Entry->Unit_ID,
+                                     Entry->Function_Code, Exception);
+    }
+    Modbus_Cache_Complete(&Cache, Entry, &Response, Now_ns);
+}
+
+//!-  Test_Write() invalidates with an FC05/FC06 Write of one Item.
+uint32_t Test_Write(
+        uint8_t const Unit_ID,
+        uint8_t const Function_Code,
+        uint16_t const Address) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Request;
+
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Write_Single(&Request, Unit_ID, Function_Code,
+                                    Address, 0);
+    return Modbus_Cache_Invalidate(&Cache, &Request);
+}
+
+//!-  Test_Expiry() checks TTLs, Rules and what is never kept.
+void Test_Expiry(
+        void) {
+
+    Modbus_Cache_Entry *Entry = NULL;
+    Modbus_Cache_Entry *Again = NULL;
+    Modbus_Frame Cached;
+
+    //!-  A Response lives until its TTL, not a Nanosecond longer.
+    Modbus_Cache_Init(&Cache, TEST_TTL_NS);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 0, 4, 0,
+                           &Entry) == CACHE_MISS);
+    Test_Complete(Entry, MODBUS_NO_EXCEPTION, 0);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 0, 4, TEST_TTL_NS - 1,
+                           &Again) == CACHE_HIT);
+    Frame_Attach(&Cached, Again->Response, Again->Length);
+    TEST_CHECK(Again == Entry);
+    TEST_CHECK(Frame_Register(Frame_Rsp_Payload(&Cached), 0) == 0x1234);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 0, 4, TEST_TTL_NS,
+                           &Again) == CACHE_MISS);
+    Modbus_Cache_Complete(&Cache, Again, NULL, TEST_TTL_NS);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 0, 4, TEST_TTL_NS,
+                           &Again) == CACHE_MISS);
+
+    //!-  Exceptions are passed on, never kept.
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code04, 0, 1, 0,
+                           &Entry) == CACHE_MISS);
+    Test_Complete(Entry, ILLEGAL_DATA_ADDRESS, 0);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code04, 0, 1, 1,
+                           &Entry) == CACHE_MISS);
+
+    //!-  A Read touching a Rule lives as long as its shortest TTL.
+    TEST_CHECK(Modbus_Cache_Set_TTL(&Cache, BROADCAST,
+                                    TABLE_HOLDING_REGISTERS, 100, 199,
+                                    TEST_RULE_TTL_NS) == TRUE);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 90, 20, 0,
+                           &Entry) == CACHE_MISS);
+    Test_Complete(Entry, MODBUS_NO_EXCEPTION, 0);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 90, 20,
+                           TEST_RULE_TTL_NS - 1, &Entry) == CACHE_HIT);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 90, 20, TEST_RULE_TTL_NS,
+                           &Entry) == CACHE_MISS);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 200, 20, 0,
+                           &Entry) == CACHE_MISS);
+    TEST_CHECK(Entry->TTL_ns == TEST_TTL_NS);
+
+    //!-  TTL 0 only coalesces; Broadcast Reads pass by.
+    Modbus_Cache_Init(&Cache, 0);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 0, 4, 0,
+                           &Entry) == CACHE_MISS);
+    Test_Complete(Entry, MODBUS_NO_EXCEPTION, 0);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 0, 4, 1,
+                           &Entry) == CACHE_MISS);
+    TEST_CHECK(Test_Lookup(BROADCAST, Fun_Code03, 0, 4, 1,
+                           &Entry) == CACHE_BYPASS);
+    TEST_CHECK(Entry == NULL);
+    TEST_CHECK(Cache.Stats.Hits == 0);
+    TEST_CHECK(Cache.Stats.Bypassed == 1);
+}
+
+//!-  Test_Coalescing() checks that only identical Reads share a Fetch.
+void Test_Coalescing(
+        void) {
+
+    Modbus_Cache_Entry *Entry = NULL;
+    Modbus_Cache_Entry *Again = NULL;
+
+    Modbus_Cache_Init(&Cache, 0);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 2, 0,
+                           &Entry) == CACHE_MISS);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 2, 1,
+                           &Again) == CACHE_PENDING);
+    TEST_CHECK(Again == Entry);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 3, 1,
+                           &Again) == CACHE_MISS);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code04, 10, 2, 1,
+                           &Again) == CACHE_MISS);
+    TEST_CHECK(Test_Lookup(TEST_OTHER_UNIT, Fun_Code03, 10, 2, 1,
+                           &Again) == CACHE_MISS);
+    TEST_CHECK(Cache.Stats.Coalesced == 1);
+    TEST_CHECK(Cache.Stats.Misses == 4);
+
+    //!-  Once complete, the next Read fetches again.
+    Test_Complete(Entry, MODBUS_NO_EXCEPTION, 2);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 2, 3,
+                           &Again) == CACHE_MISS);
+}
+
+/*
+ *!-  Test_Invalidation() checks which Writes drop a kept Response
+ *!-  and that a Read in Flight a Write overlaps is neither joined
+ *!-  nor kept.
+ */
+void Test_Invalidation(
+        void) {
+
+    Modbus_Cache_Entry *Entry = NULL;
+    Modbus_Cache_Entry *Other = NULL;
+
+    Modbus_Cache_Init(&Cache, TEST_TTL_NS);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 5, 0,
+                           &Entry) == CACHE_MISS);
+    Test_Complete(Entry, MODBUS_NO_EXCEPTION, 0);
+    TEST_CHECK(Test_Lookup(TEST_OTHER_UNIT, Fun_Code03, 10, 5, 0,
+                           &Other) == CACHE_MISS);
+    Test_Complete(Other, MODBUS_NO_EXCEPTION, 0);
+
+    //!-  Adjacent Items, a Coil, another Unit: kept.
+    TEST_CHECK(Test_Write(TEST_UNIT, Fun_Code06, 9) == 0);
+    TEST_CHECK(Test_Write(TEST_UNIT, Fun_Code06, 15) == 0);
+    TEST_CHECK(Test_Write(TEST_UNIT, Fun_Code05, 12) == 0);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 5, 1,
+                           &Entry) == CACHE_HIT);
+
+    //!-  Its last Register: dropped, the other Unit's kept.
+    TEST_CHECK(Test_Write(TEST_UNIT, Fun_Code06, 14) == 1);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 5, 1,
+                           &Entry) == CACHE_MISS);
+    TEST_CHECK(Test_Lookup(TEST_OTHER_UNIT, Fun_Code03, 10, 5, 1,
+                           &Other) == CACHE_HIT);
+
+    //!-  In Flight: Stale, so neither joined nor kept.
+    TEST_CHECK(Test_Write(TEST_UNIT, Fun_Code06, 10) == 1);
+    TEST_CHECK(Entry->Stale == TRUE);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 5, 2,
+                           &Other) == CACHE_BYPASS);
+    Test_Complete(Entry, MODBUS_NO_EXCEPTION, 2);
+    TEST_CHECK(Test_Lookup(TEST_UNIT, Fun_Code03, 10, 5, 3,
+                           &Entry) == CACHE_MISS);
+    TEST_CHECK(Entry->Stale == FALSE);
+    Test_Complete(Entry, MODBUS_NO_EXCEPTION, 3);
+
+    //!-  A Broadcast reaches every Unit.
+    TEST_CHECK(Test_Write(BROADCAST, Fun_Code06, 12) == 2);
+    TEST_CHECK(Test_Lookup(TEST_OTHER_UNIT, Fun_Code03, 10, 5, 4,
+                           &Other) == CACHE_MISS);
+    TEST_CHECK(Cache.Stats.Invalidated == 4);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks the Response Cache: TTLs and Rules, coalescing of
+ *!-  identical Reads in Flight, and which Writes invalidate what.
+ */
+int main(void) {
+
+    Test_Expiry();
+    Test_Coalescing();
+    Test_Invalidation();
+    return Test_Result("Test_Cache");
+}
@@ -0,0 +1,304 @@
+/*
+ * Test_Changes.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Changes.c
+*****************************************************************************/
+
+//!-  Headers
+#include <pthread.h>
+#include <string.h>
+#include "Modbus_Changes.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define TEST_UNIT         (2)
+#define TEST_REGISTERS    (1024)
+//!-  The subscribed Range: Holding Registers 100 .. 199.
+#define TEST_FIRST        (100)
+#define TEST_RANGE        (100)
+//!-  Writes of the Writer Thread, and Runs kept by Test_Changed().
+#define TEST_WRITES       (100000)
+#define TEST_RUNS         (16)
+//!-  Changes one Modbus_Changes_Since() Call takes at most.
+#define TEST_BATCH        (64)
+
+//!-  "Test_Run" is a Run of changed Registers a Callback reported.
+typedef struct {
+    uint16_t   Start;
+    uint16_t   Count;
+} Test_Run;
+
+void Test_Changed(
+        void *const Context,
+        const Modbus_Data *const Source,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count);
+
+void Test_Write(
+        uint16_t const Start,
+        uint16_t const Count,
+        uint16_t const Value);
+
+void Test_Write_Range(
+        uint32_t const Write,
+        uint16_t *const Start,
+        uint16_t *const Count);
+
+void Test_Runs(
+        void);
+
+void *Test_Writer(
+        void *const Context);
+
+Bool Test_Consume(
+        uint64_t *const Generation,
+        uint64_t const First);
+
+void Test_Concurrent(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Data *Unit;
+static Test_Run Runs[TEST_RUNS];
+static uint32_t Run_Count;
+//!-  Last Value each Callback read from every Register it reported.
+static uint16_t Seen[TEST_REGISTERS];
+//!-  Generation the Consumer reached; the Writer stays within the Log.
+static uint64_t Consumed;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Test_Changed() keeps the Run it is called for and reads the
+ *!-  Registers in it, as a Subscriber would.
+ */
+void Test_Changed(
+        void *const Context,
+        const Modbus_Data *const Source,
+        Modbus_Table const Table,
+        uint16_t const Start,
+        uint16_t const Count) {
+
+    uint8_t BeOut[TEST_RANGE * 2];
+    uint16_t Index = 0;
+
+    (void) Context;
+    TEST_CHECK(Table == TABLE_HOLDING_REGISTERS);
+    if (Run_Count < TEST_RUNS) {
+        Runs[Run_Count].Start = Start;
+        Runs[Run_Count].Count = Count;
+    }
+    Run_Count++;
+    if ((TEST_CHECK(Count <= TEST_RANGE) == TRUE) &&
+        (TEST_CHECK(Read_Registers(Source, Table, Start, Count,
+                                   BeOut) == TRUE) == TRUE)) {
+        for (Index = 0; Index < Count; Index++) {
+            Seen[Start + Index] = Frame_Get_U16(&BeOut[Index * 2]);
+        }
+    }
+}
+
+//!-  Test_Write() writes "Value" to "Count" Holding Registers.
+void Test_Write(
+        uint16_t const Start,
+        uint16_t const Count,
+        uint16_t const Value) {
+
+    uint8_t BeIn[4 * 2];
+    uint16_t Index = 0;
+
+    for (Index = 0; Index < Count; Index++) {
+        Frame_Put_U16(&BeIn[Index * 2], Value);
+    }
+    (void) Write_Registers(Unit, TABLE_HOLDING_REGISTERS, Start, Count,
+                           BeIn);
+}
+
+/*
+ *!-  Test_Write_Range() gives the Range of Write "Write" of the
+ *!-  Writer Thread: 1 to 3 Registers of the subscribed Range,
+ *!-  some of them across a Word of the Dirty Bitmap.
+ */
+void Test_Write_Range(
+        uint32_t const Write,
+        uint16_t *const Start,
+        uint16_t *const Count) {
+
+    *Count = (uint16_t) (1 + (Write % 3));
+    *Start = (uint16_t) (TEST_FIRST + ((Write * 37U) % (TEST_RANGE - 2)));
+}
+
+/*
+ *!-  Test_Runs() checks the Runs one Drain reports: one per Run of
+ *!-  changed Registers however often they were written, merged
+ *!-  across Words, clipped to the Subscription, and none twice.
+ */
+void Test_Runs(
+        void) {
+
+    uint64_t Generation = Modbus_Changes_Generation(Unit);
+    Modbus_Change Changes[TEST_BATCH];
+    uint32_t Count = TEST_BATCH;
+
+    Test_Write(5, 1, 1);
+    Test_Write(120, 3, 2);
+    Test_Write(121, 1, 3);
+    Test_Write(126, 2, 4);
+    Test_Write(190, 4, 5);
+    Test_Write(194, 4, 6);
+    Test_Write(198, 4, 7);
+    Run_Count = 0;
+    TEST_CHECK(Modbus_Notify_Changes(Unit) == 4);
+    if (TEST_CHECK(Run_Count == 3) == TRUE) {
+        TEST_CHECK((Runs[0].Start == 120) && (Runs[0].Count == 3));
+        TEST_CHECK((Runs[1].Start == 126) && (Runs[1].Count == 2));
+        TEST_CHECK((Runs[2].Start == 190) && (Runs[2].Count == 10));
+    }
+    TEST_CHECK(Seen[121] == 3);
+    TEST_CHECK(Seen[199] == 7);
+    TEST_CHECK(Modbus_Notify_Changes(Unit) == 0);
+
+    //!-  The Log keeps every Write, in Order.
+    TEST_CHECK(Modbus_Changes_Since(Unit, &Generation, Changes,
+                                    &Count) == TRUE);
+    if (TEST_CHECK(Count == 7) == TRUE) {
+        TEST_CHECK((Changes[0].Start == 5) && (Changes[0].Count == 1));
+        TEST_CHECK((Changes[3].Start == 126) && (Changes[3].Count == 2));
+        TEST_CHECK(Changes[6].Generation == Generation);
+        TEST_CHECK(Changes[6].Table == TABLE_HOLDING_REGISTERS);
+    }
+    TEST_CHECK(Generation == Modbus_Changes_Generation(Unit));
+}
+
+//!-  Test_Writer() writes TEST_WRITES Ranges, the n-th with n + 1.
+void *Test_Writer(
+        void *const Context) {
+
+    uint64_t const First = *(const uint64_t *) Context;
+    uint16_t Start = 0;
+    uint16_t Count = 0;
+    uint32_t Write = 0;
+
+    for (Write = 0; Write < TEST_WRITES; Write++) {
+        while ((First + Write -
+                __atomic_load_n(&Consumed, __ATOMIC_ACQUIRE)) >=
+               (MODBUS_CHANGE_LOG / 2)) {
+            MODBUS_CPU_PAUSE();
+        }
+        Test_Write_Range(Write, &Start, &Count);
+        Test_Write(Start, Count, (uint16_t) (Write + 1));
+    }
+    return NULL;
+}
+
+/*
+ *!-  Test_Consume() takes what the Log has after "*Generation" and
+ *!-  checks it is exactly what the Writer Thread wrote, in Order.
+ *!-  "First" is the Generation before the Writer's first Write.
+ */
+Bool Test_Consume(
+        uint64_t *const Generation,
+        uint64_t const First) {
+
+    Modbus_Change Changes[TEST_BATCH];
+    uint32_t Count = TEST_BATCH;
+    uint32_t Index = 0;
+    uint16_t Start = 0;
+    uint16_t Length = 0;
+    Bool Check_Ok = TEST_CHECK(Modbus_Changes_Since(Unit, Generation,
+                                                    Changes, &Count) == TRUE);
+
+    for (Index = 0; (Check_Ok == TRUE) && (Index < Count); Index++) {
+        Test_Write_Range((uint32_t) (Changes[Index].Generation - First - 1),
+                         &Start, &Length);
+        Check_Ok = TEST_CHECK((Changes[Index].Start == Start) &&
+                              (Changes[Index].Count == Length));
+    }
+    __atomic_store_n(&Consumed, *Generation, __ATOMIC_RELEASE);
+    return Check_Ok;
+}
+
+/*
+ *!-  Test_Concurrent() drains the Bitmaps and the Log while a
+ *!-  Writer Thread writes. Once it is done, a last Drain must have
+ *!-  shown the Subscriber every Register's last Value: a Mark lost
+ *!-  to a racing Drain leaves an older one in Seen[].
+ */
+void Test_Concurrent(
+        void) {
+
+    uint64_t const First = Modbus_Changes_Generation(Unit);
+    uint64_t Generation = First;
+    uint16_t Expected[TEST_REGISTERS];
+    uint16_t Start = 0;
+    uint16_t Count = 0;
+    uint32_t Write = 0;
+    uint32_t Stale = 0;
+    uint32_t Index = 0;
+    Bool Check_Ok = TRUE;
+    pthread_t Thread;
+
+    memcpy(Expected, Seen, sizeof(Expected));
+    for (Write = 0; Write < TEST_WRITES; Write++) {
+        Test_Write_Range(Write, &Start, &Count);
+        for (Index = Start; Index < (uint32_t) (Start + Count); Index++) {
+            Expected[Index] = (uint16_t) (Write + 1);
+        }
+    }
+    __atomic_store_n(&Consumed, First, __ATOMIC_RELEASE);
+    if (TEST_CHECK(pthread_create(&Thread, NULL, Test_Writer,
+                                  (void *) &First) == 0) == TRUE) {
+        while ((Check_Ok == TRUE) && (Generation < (First + TEST_WRITES))) {
+            (void) Modbus_Notify_Changes(Unit);
+            Check_Ok = Test_Consume(&Generation, First);
+        }
+        (void) pthread_join(Thread, NULL);
+        (void) Modbus_Notify_Changes(Unit);
+        for (Index = 0; Index < TEST_REGISTERS; Index++) {
+            Stale += (Seen[Index] != Expected[Index]) ? 1 : 0;
+        }
+        TEST_CHECK(Stale == 0);
+        TEST_CHECK(Generation == (First + TEST_WRITES));
+        TEST_CHECK(Modbus_Notify_Changes(Unit) == 0);
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks the Change Tracking: the Runs a Drain reports to a
+ *!-  Subscription and the Log Modbus_Changes_Since() reads, first
+ *!-  alone, then while a Writer Thread writes the Registers.
+ */
+int main(void) {
+
+    TEST_CHECK(Modbus_Init() == TRUE);
+    Unit = Modbus_Add_Unit(TEST_UNIT, 16, 16, 16, TEST_REGISTERS);
+    if ((TEST_CHECK(Unit != NULL) == TRUE) &&
+        (TEST_CHECK(Modbus_Subscribe(Unit, TABLE_HOLDING_REGISTERS,
+                                     TEST_FIRST, TEST_RANGE, Test_Changed,
+                                     NULL) == TRUE) == TRUE)) {
+        Test_Runs();
+        Test_Concurrent();
+        TEST_CHECK(Modbus_Unsubscribe(Unit, Test_Changed, NULL) == TRUE);
+    }
+    Modbus_Untrack_Changes(Unit);
+    return Test_Result("Test_Changes");
+}
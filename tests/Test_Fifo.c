@@ -0,0 +1,308 @@
+/*
+ * Test_Fifo.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Fifo.c
+*****************************************************************************/
+
+//!-  Headers
+#include <pthread.h>
+#include <string.h>
+#include "Modbus_Dispatch.h"
+#include "Modbus_Fifo.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define TEST_UNIT            (2)
+//!-  Pointer Addresses of the FIFOs, and the Depth they ask for.
+#define TEST_RING_ADDRESS    (100)
+#define TEST_FC24_ADDRESS    (200)
+#define TEST_FC24_DEPTH      (64)
+#define TEST_SPSC_ADDRESS    (300)
+#define TEST_SPSC_DEPTH      (1024)
+//!-  Samples the Producer Thread pushes, in Batches of TEST_BATCH.
+#define TEST_SAMPLES         (200000)
+#define TEST_BATCH           (7)
+
+Bool Test_Drain(
+        Modbus_Fifo *const Fifo,
+        uint16_t const Max,
+        uint16_t const First,
+        uint16_t const Expected);
+
+uint16_t Test_Read_Fifo(
+        uint8_t const DevID,
+        uint16_t const Address,
+        Modbus_Frame *const Response);
+
+void Test_Ring(
+        Modbus_Data *const Unit);
+
+void Test_Response_Layout(
+        Modbus_Data *const Unit);
+
+void *Test_Producer(
+        void *const Context);
+
+void Test_Producer_Consumer(
+        Modbus_Data *const Unit);
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Test_Drain() drains up to "Max" Entries and checks there were
+ *!-  "Expected" of them, counting up from "First".
+ */
+Bool Test_Drain(
+        Modbus_Fifo *const Fifo,
+        uint16_t const Max,
+        uint16_t const First,
+        uint16_t const Expected) {
+
+    uint8_t BeOut[FIFO_MAX_COUNT * 2];
+    uint16_t const Count = Modbus_Fifo_Drain(Fifo, BeOut, Max);
+    Bool Check_Ok = TEST_CHECK(Count == Expected);
+    uint16_t Index = 0;
+
+    for (Index = 0; (Check_Ok == TRUE) && (Index < Count); Index++) {
+        Check_Ok = TEST_CHECK(Frame_Get_U16(&BeOut[Index * 2]) ==
+                              (uint16_t) (First + Index));
+    }
+    return Check_Ok;
+}
+
+/*
+ *!-  Test_Read_Fifo() serves an FC24 Request for the FIFO at
+ *!-  "Address" and returns the FIFO Count of the Response.
+ */
+uint16_t Test_Read_Fifo(
+        uint8_t const DevID,
+        uint16_t const Address,
+        Modbus_Frame *const Response) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Request;
+    uint16_t Count = 0;
+
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Read_Fifo(&Request, DevID, Address);
+    if ((Modbus_Response(&Request, Response) == TRUE) &&
+        (Frame_Is_Exception(Response) == FALSE)) {
+        Count = Frame_Get_U16(&Response->Adu[FIFO_COUNT_OFFSET]);
+    }
+    return Count;
+}
+
+/*
+ *!-  Test_Ring() checks the Ring of the smallest FIFO: Windows
+ *!-  across its End come out whole through the Mirror, and Pushes
+ *!-  that find it full are cut short and counted.
+ */
+void Test_Ring(
+        Modbus_Data *const Unit) {
+
+    Modbus_Fifo *const Fifo = Modbus_Find_Fifo(Unit, TEST_RING_ADDRESS);
+    uint16_t Values[2 * (FIFO_MAX_COUNT + 1)];
+    uint32_t Depth = 0;
+    uint32_t Index = 0;
+    Modbus_Fifo_Counters Counters;
+
+    if (TEST_CHECK(Fifo != NULL) == TRUE) {
+        //!-  Asked for one Entry, it holds one FC24 Window and a Slot.
+        Depth = Fifo->Mask + 1;
+        TEST_CHECK(Depth == (FIFO_MAX_COUNT + 1));
+        for (Index = 0; Index < (2 * Depth); Index++) {
+            Values[Index] = (uint16_t) Index;
+        }
+        TEST_CHECK(Modbus_Fifo_Push(Fifo, Values, 20) == 20);
+        TEST_CHECK(Test_Drain(Fifo, 10, 0, 10) == TRUE);
+
+        //!-  Slots 20 .. 31, then 0 .. 7: read back through the Mirror.
+        TEST_CHECK(Modbus_Fifo_Push(Fifo, &Values[20], 20) == 20);
+        TEST_CHECK(memcmp(&Fifo->Ring[Depth * 2], Fifo->Ring,
+                          FIFO_MAX_COUNT * 2) == 0);
+        TEST_CHECK(Test_Drain(Fifo, FIFO_MAX_COUNT + 1, 10, 30) == TRUE);
+        TEST_CHECK(Test_Drain(Fifo, FIFO_MAX_COUNT, 40, 0) == TRUE);
+        TEST_CHECK(Modbus_Fifo_Push(Fifo, &Values[40], 1) == 1);
+        TEST_CHECK(Test_Drain(Fifo, FIFO_MAX_COUNT, 40, 1) == TRUE);
+        Modbus_Fifo_Read_Counters(Fifo, &Counters);
+        TEST_CHECK(Counters.Overflows == 0);
+
+        //!-  Full: what does not fit is dropped, never waited for.
+        TEST_CHECK(Modbus_Fifo_Push(Fifo, Values, Depth + 8) == Depth);
+        TEST_CHECK(Modbus_Fifo_Push(Fifo, Values, 1) == 0);
+        Modbus_Fifo_Read_Counters(Fifo, &Counters);
+        TEST_CHECK(Counters.Pushed == (41 + Depth));
+        TEST_CHECK(Counters.Drained == 41);
+        TEST_CHECK(Counters.Queued == Depth);
+        TEST_CHECK(Counters.Overflows == 2);
+        TEST_CHECK(Counters.Dropped == 9);
+        TEST_CHECK(Test_Drain(Fifo, FIFO_MAX_COUNT, 0,
+                              FIFO_MAX_COUNT) == TRUE);
+        TEST_CHECK(Test_Drain(Fifo, FIFO_MAX_COUNT, FIFO_MAX_COUNT,
+                              1) == TRUE);
+    }
+}
+
+/*
+ *!-  Test_Response_Layout() checks the FC24 Response: Byte Count,
+ *!-  FIFO Count and at most FIFO_MAX_COUNT Entries, a Broadcast
+ *!-  that leaves the FIFO as it is, and the Exceptions.
+ */
+void Test_Response_Layout(
+        Modbus_Data *const Unit) {
+
+    Modbus_Fifo *const Fifo = Modbus_Find_Fifo(Unit, TEST_FC24_ADDRESS);
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    uint16_t Values[FIFO_MAX_COUNT + 9];
+    uint32_t Index = 0;
+    Modbus_Frame Response;
+    Modbus_Fifo_Counters Counters;
+
+    Frame_Attach(&Response, Buffer, 0);
+    if (TEST_CHECK(Fifo != NULL) == TRUE) {
+        for (Index = 0; Index < (FIFO_MAX_COUNT + 9); Index++) {
+            Values[Index] = (uint16_t) (0xA000 + Index);
+        }
+        TEST_CHECK(Modbus_Fifo_Push(Fifo, Values,
+                                    FIFO_MAX_COUNT + 9) ==
+                   (FIFO_MAX_COUNT + 9));
+
+        //!-  Executed on the Unit, but it drains nothing.
+        TEST_CHECK(Test_Read_Fifo(BROADCAST, TEST_FC24_ADDRESS,
+                                  &Response) == 0);
+        TEST_CHECK(Response.Length == 0);
+        Modbus_Fifo_Read_Counters(Fifo, &Counters);
+        TEST_CHECK(Counters.Queued == (FIFO_MAX_COUNT + 9));
+
+        TEST_CHECK(Test_Read_Fifo(TEST_UNIT, TEST_FC24_ADDRESS,
+                                  &Response) == FIFO_MAX_COUNT);
+        TEST_CHECK(Frame_Get_U16(&Response.Adu[FIFO_BYTE_COUNT_OFFSET]) ==
+                   (2 + (FIFO_MAX_COUNT * 2)));
+        TEST_CHECK(Response.Length ==
+                   (FIFO_PAYLOAD_OFFSET + (FIFO_MAX_COUNT * 2)));
+        TEST_CHECK(Frame_Get_U16(&Response.Adu[FIFO_PAYLOAD_OFFSET]) ==
+                   0xA000);
+        TEST_CHECK(Frame_Get_U16(&Response.Adu[Response.Length - 2]) ==
+                   (0xA000 + FIFO_MAX_COUNT - 1));
+        TEST_CHECK(Test_Read_Fifo(TEST_UNIT, TEST_FC24_ADDRESS,
+                                  &Response) == 9);
+        TEST_CHECK(Frame_Get_U16(&Response.Adu[FIFO_PAYLOAD_OFFSET]) ==
+                   (0xA000 + FIFO_MAX_COUNT));
+
+        //!-  Empty: the Byte Count covers the FIFO Count alone.
+        TEST_CHECK(Test_Read_Fifo(TEST_UNIT, TEST_FC24_ADDRESS,
+                                  &Response) == 0);
+        TEST_CHECK(Frame_Get_U16(&Response.Adu[FIFO_BYTE_COUNT_OFFSET]) ==
+                   2);
+        TEST_CHECK(Response.Length == FIFO_PAYLOAD_OFFSET);
+    }
+    TEST_CHECK(Test_Read_Fifo(TEST_UNIT, TEST_FC24_ADDRESS + 1,
+                              &Response) == 0);
+    TEST_CHECK(Frame_Is_Exception(&Response) == TRUE);
+    TEST_CHECK(Frame_Exception_Code(&Response) == ILLEGAL_DATA_ADDRESS);
+}
+
+//!-  Test_Producer() pushes TEST_SAMPLES counting Values, lossless.
+void *Test_Producer(
+        void *const Context) {
+
+    Modbus_Fifo *const Fifo = Context;
+    uint16_t Values[TEST_BATCH];
+    uint32_t Sent = 0;
+    uint32_t Batch = 0;
+    uint32_t Index = 0;
+
+    while (Sent < TEST_SAMPLES) {
+        Batch = ((TEST_SAMPLES - Sent) < TEST_BATCH) ?
+                (TEST_SAMPLES - Sent) : TEST_BATCH;
+        for (Index = 0; Index < Batch; Index++) {
+            Values[Index] = (uint16_t) (Sent + Index);
+        }
+        //!-  What was dropped is sent again with the next Batch.
+        Sent += Modbus_Fifo_Push(Fifo, Values, Batch);
+    }
+    return NULL;
+}
+
+/*
+ *!-  Test_Producer_Consumer() runs a Producer Thread against FC24
+ *!-  Requests draining the same FIFO, and checks every Value came
+ *!-  out once and in Order.
+ */
+void Test_Producer_Consumer(
+        Modbus_Data *const Unit) {
+
+    Modbus_Fifo *const Fifo = Modbus_Find_Fifo(Unit, TEST_SPSC_ADDRESS);
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    uint32_t Received = 0;
+    uint16_t Count = 0;
+    uint16_t Index = 0;
+    Bool In_Order = TRUE;
+    pthread_t Thread;
+    Modbus_Frame Response;
+    Modbus_Fifo_Counters Counters;
+
+    Frame_Attach(&Response, Buffer, 0);
+    if ((TEST_CHECK(Fifo != NULL) == TRUE) &&
+        (TEST_CHECK(pthread_create(&Thread, NULL, Test_Producer,
+                                   Fifo) == 0) == TRUE)) {
+        while ((Received < TEST_SAMPLES) && (In_Order == TRUE)) {
+            Count = Test_Read_Fifo(TEST_UNIT, TEST_SPSC_ADDRESS, &Response);
+            for (Index = 0; (In_Order == TRUE) && (Index < Count); Index++) {
+                In_Order = TEST_CHECK(
+                    Frame_Get_U16(&Response.Adu[FIFO_PAYLOAD_OFFSET +
+                                                (Index * 2)]) ==
+                    (uint16_t) (Received + Index));
+            }
+            Received += Count;
+        }
+        (void) pthread_join(Thread, NULL);
+        TEST_CHECK(Received == TEST_SAMPLES);
+        Modbus_Fifo_Read_Counters(Fifo, &Counters);
+        TEST_CHECK(Counters.Pushed == TEST_SAMPLES);
+        TEST_CHECK(Counters.Drained == TEST_SAMPLES);
+        TEST_CHECK(Counters.Queued == 0);
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks the FC24 FIFOs: the SPSC Ring with its Mirror and
+ *!-  Overflow Counters, the FC24 Response, and a Producer Thread
+ *!-  against a Consumer draining with FC24 Requests.
+ */
+int main(void) {
+
+    Modbus_Data *Unit = NULL;
+
+    TEST_CHECK(Modbus_Init() == TRUE);
+    Unit = Modbus_Add_Unit(TEST_UNIT, 16, 16, 16, 16);
+    if ((TEST_CHECK(Unit != NULL) == TRUE) &&
+        (TEST_CHECK(Modbus_Add_Fifo(Unit, TEST_SPSC_ADDRESS,
+                                    TEST_SPSC_DEPTH) == TRUE) == TRUE) &&
+        (TEST_CHECK(Modbus_Add_Fifo(Unit, TEST_RING_ADDRESS,
+                                    1) == TRUE) == TRUE) &&
+        (TEST_CHECK(Modbus_Add_Fifo(Unit, TEST_FC24_ADDRESS,
+                                    TEST_FC24_DEPTH) == TRUE) == TRUE)) {
+        TEST_CHECK(Modbus_Add_Fifo(Unit, TEST_RING_ADDRESS, 1) == FALSE);
+        Test_Ring(Unit);
+        Test_Response_Layout(Unit);
+        Test_Producer_Consumer(Unit);
+    }
+    Modbus_Remove_Fifos(Unit);
+    return Test_Result("Test_Fifo");
+}
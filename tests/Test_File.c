@@ -0,0 +1,353 @@
+/*
+ * Test_File.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_File.c
+*****************************************************************************/
+
+//!-  Headers
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "Modbus_Dispatch.h"
+#include "Modbus_File.h"
+#include "Modbus_Frame.h"
+#include "Modbus_TCP.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define TEST_UNIT         (2)
+#define TEST_FILE         (4)
+//!-  Enough Records for a Download of many pipelined FC20 Reads.
+#define TEST_RECORDS      (1000)
+#define TEST_WINDOW       (4)
+#define TEST_POLL_MS      (10)
+//!-  Value of Record "n" before the Download: n + TEST_VALUE_BASE.
+#define TEST_VALUE_BASE   (0x4000)
+
+void Test_Sub(
+        uint8_t *const Sub,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count);
+
+uint8_t Test_Serve(
+        uint8_t *const Adu,
+        uint16_t const Length,
+        Modbus_Frame *const Response);
+
+void Test_Write_Reopen(
+        Modbus_Data *const Unit,
+        const char *const Path);
+
+void Test_Multi_Read(
+        void);
+
+void Test_Byte_Counts(
+        void);
+
+void *Test_Server_Run(
+        void *const Context);
+
+void Test_Download(
+        Modbus_Data *const Unit);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_TCP_Server Server;
+static Modbus_TCP_Client Client;
+static Bool Server_Stop;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Sub() fills the Header of a Sub-Request at "Sub".
+void Test_Sub(
+        uint8_t *const Sub,
+        uint16_t const Number,
+        uint16_t const Record,
+        uint16_t const Count) {
+
+    Sub[0] = FILE_REFERENCE_TYPE;
+    Frame_Put_U16(&Sub[1], Number);
+    Frame_Put_U16(&Sub[3], Record);
+    Frame_Put_U16(&Sub[5], Count);
+}
+
+/*
+ *!-  Test_Serve() dispatches the Request of "Length" Bytes in
+ *!-  "Adu" and returns its Exception Code, or MODBUS_NO_EXCEPTION.
+ */
+uint8_t Test_Serve(
+        uint8_t *const Adu,
+        uint16_t const Length,
+        Modbus_Frame *const Response) {
+
+    Modbus_Frame Request;
+    uint8_t Exception = MODBUS_NO_EXCEPTION;
+
+    Adu[FRAME_DEVICE_ID_OFFSET] = TEST_UNIT;
+    Frame_Attach(&Request, Adu, Length);
+    TEST_CHECK(Modbus_Response(&Request, Response) == TRUE);
+    if (Frame_Is_Exception(Response) == TRUE) {
+        Exception = Frame_Exception_Code(Response);
+    }
+    return Exception;
+}
+
+/*
+ *!-  Test_Write_Reopen() writes two Runs of Records with one FC21
+ *!-  Request, then checks they are still there once the File was
+ *!-  unmapped and mapped again, and that an FC21 Request with one
+ *!-  invalid Sub-Request writes nothing at all.
+ */
+void Test_Write_Reopen(
+        Modbus_Data *const Unit,
+        const char *const Path) {
+
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    uint8_t Records[6];
+    uint8_t const Expected[6] = { 0x11, 0x11, 0x22, 0x22, 0x33, 0x33 };
+    Modbus_Frame Response;
+
+    Frame_Attach(&Response, Buffer, 0);
+    Adu[FRAME_FUNCTION_CODE_OFFSET] = Fun_Code21;
+    Adu[FRAME_HEADER_LENGTH] = (FILE_SUB_REQUEST_LENGTH + 6) +
+                               (FILE_SUB_REQUEST_LENGTH + 4);
+    Test_Sub(&Adu[3], TEST_FILE, 10, 3);
+    memcpy(&Adu[10], Expected, 6);
+    Test_Sub(&Adu[16], TEST_FILE, 500, 2);
+    memcpy(&Adu[23], "\xAB\xCD\xEF\x01", 4);
+    TEST_CHECK(Test_Serve(Adu, 27, &Response) == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Response.Length == 27);
+    TEST_CHECK(memcmp(Response.Adu, Adu, 27) == 0);
+
+    //!-  The Records survive the Mapping.
+    Modbus_Unmap_Files(Unit);
+    TEST_CHECK(Modbus_File_Valid(Unit, TEST_FILE, 10, 3) == FALSE);
+    TEST_CHECK(Modbus_Map_File(Unit, TEST_FILE, Path,
+                               TEST_RECORDS) == TRUE);
+    TEST_CHECK(Read_File_Records(Unit, TEST_FILE, 10, 3, Records) == TRUE);
+    TEST_CHECK(memcmp(Records, Expected, 6) == 0);
+    TEST_CHECK(Read_File_Records(Unit, TEST_FILE, 500, 2, Records) == TRUE);
+    TEST_CHECK(memcmp(Records, "\xAB\xCD\xEF\x01", 4) == 0);
+
+    //!-  The second Sub-Request runs past the File: nothing written.
+    Adu[FRAME_HEADER_LENGTH] = (FILE_SUB_REQUEST_LENGTH + 2) +
+                               (FILE_SUB_REQUEST_LENGTH + 4);
+    Test_Sub(&Adu[3], TEST_FILE, 20, 1);
+    memcpy(&Adu[10], "\x55\x55", 2);
+    Test_Sub(&Adu[12], TEST_FILE, TEST_RECORDS - 1, 2);
+    memcpy(&Adu[19], "\x66\x66\x66\x66", 4);
+    TEST_CHECK(Test_Serve(Adu, 23, &Response) == ILLEGAL_DATA_ADDRESS);
+    TEST_CHECK(Read_File_Records(Unit, TEST_FILE, 20, 1, Records) == TRUE);
+    TEST_CHECK(memcmp(Records, "\x00\x00", 2) == 0);
+}
+
+//!-  Test_Multi_Read() reads three Runs with one FC20 Request.
+void Test_Multi_Read(
+        void) {
+
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Response;
+    const uint8_t *Out = NULL;
+
+    Frame_Attach(&Response, Buffer, 0);
+    Adu[FRAME_FUNCTION_CODE_OFFSET] = Fun_Code20;
+    Adu[FRAME_HEADER_LENGTH] = 3 * FILE_SUB_REQUEST_LENGTH;
+    Test_Sub(&Adu[3], TEST_FILE, 10, 3);
+    Test_Sub(&Adu[10], TEST_FILE, 500, 2);
+    Test_Sub(&Adu[17], TEST_FILE, 11, 1);
+    TEST_CHECK(Test_Serve(Adu, 24, &Response) == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Frame_Rsp_Byte_Count(&Response) ==
+               (3 * FILE_SUB_RESPONSE_LENGTH) + 12);
+    TEST_CHECK(Response.Length == (FRAME_RSP_PAYLOAD_OFFSET +
+                                   (3 * FILE_SUB_RESPONSE_LENGTH) + 12));
+
+    //!-  Each Run: its Length (Type and Data), Type 6, the Records.
+    Out = Frame_Rsp_Payload(&Response);
+    TEST_CHECK(memcmp(Out, "\x07\x06\x11\x11\x22\x22\x33\x33", 8) == 0);
+    Out += 8;
+    TEST_CHECK(memcmp(Out, "\x05\x06\xAB\xCD\xEF\x01", 6) == 0);
+    Out += 6;
+    TEST_CHECK(memcmp(Out, "\x03\x06\x22\x22", 4) == 0);
+}
+
+/*
+ *!-  Test_Byte_Counts() checks the Byte Counts and Sub-Requests
+ *!-  FC20/FC21 refuse: truncated, oversized, not a whole Number
+ *!-  of Sub-Requests, and Runs outside the File.
+ */
+void Test_Byte_Counts(
+        void) {
+
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Response;
+    uint32_t Offset = 0;
+
+    Frame_Attach(&Response, Buffer, 0);
+    memset(Adu, 0, sizeof(Adu));
+
+    //!-  FC20: Byte Count past the Request, one too many Sub-Requests.
+    Adu[FRAME_FUNCTION_CODE_OFFSET] = Fun_Code20;
+    Adu[FRAME_HEADER_LENGTH] = 2 * FILE_SUB_REQUEST_LENGTH;
+    Test_Sub(&Adu[3], TEST_FILE, 0, 1);
+    TEST_CHECK(Test_Serve(Adu, 10, &Response) == ILLEGAL_DATA_VALUE);
+    for (Offset = 3; (Offset + FILE_SUB_REQUEST_LENGTH) <= sizeof(Adu);
+         Offset += FILE_SUB_REQUEST_LENGTH) {
+        Test_Sub(&Adu[Offset], TEST_FILE, 0, 1);
+    }
+    Adu[FRAME_HEADER_LENGTH] = FILE_MAX_READ_LENGTH +
+                               FILE_SUB_REQUEST_LENGTH;
+    TEST_CHECK(Test_Serve(Adu, 3 + FILE_MAX_READ_LENGTH +
+                          FILE_SUB_REQUEST_LENGTH,
+                          &Response) == ILLEGAL_DATA_VALUE);
+    Adu[FRAME_HEADER_LENGTH] = FILE_MAX_READ_LENGTH;
+    TEST_CHECK(Test_Serve(Adu, 3 + FILE_MAX_READ_LENGTH,
+                          &Response) == MODBUS_NO_EXCEPTION);
+    Adu[FRAME_HEADER_LENGTH] = FILE_SUB_REQUEST_LENGTH + 1;
+    TEST_CHECK(Test_Serve(Adu, 3 + FILE_SUB_REQUEST_LENGTH + 1,
+                          &Response) == ILLEGAL_DATA_VALUE);
+
+    //!-  FC20: Runs too long for one Response, of Type 7, off the File.
+    Adu[FRAME_HEADER_LENGTH] = 2 * FILE_SUB_REQUEST_LENGTH;
+    Test_Sub(&Adu[3], TEST_FILE, 0, FILE_MAX_READ_RECORDS);
+    TEST_CHECK(Test_Serve(Adu, 17, &Response) == ILLEGAL_DATA_VALUE);
+    Adu[FRAME_HEADER_LENGTH] = FILE_SUB_REQUEST_LENGTH;
+    TEST_CHECK(Test_Serve(Adu, 10, &Response) == MODBUS_NO_EXCEPTION);
+    Adu[3] = FILE_REFERENCE_TYPE + 1;
+    TEST_CHECK(Test_Serve(Adu, 10, &Response) == ILLEGAL_DATA_VALUE);
+    Test_Sub(&Adu[3], TEST_FILE, TEST_RECORDS - 1, 2);
+    TEST_CHECK(Test_Serve(Adu, 10, &Response) == ILLEGAL_DATA_ADDRESS);
+    Test_Sub(&Adu[3], TEST_FILE + 1, 0, 1);
+    TEST_CHECK(Test_Serve(Adu, 10, &Response) == ILLEGAL_DATA_ADDRESS);
+
+    //!-  FC21: Byte Count past the Request, or past its Maximum.
+    Adu[FRAME_FUNCTION_CODE_OFFSET] = Fun_Code21;
+    Adu[FRAME_HEADER_LENGTH] = FILE_SUB_REQUEST_LENGTH + 2;
+    Test_Sub(&Adu[3], TEST_FILE, 30, 1);
+    TEST_CHECK(Test_Serve(Adu, 11, &Response) == ILLEGAL_DATA_VALUE);
+    TEST_CHECK(Test_Serve(Adu, 12, &Response) == MODBUS_NO_EXCEPTION);
+    Adu[FRAME_HEADER_LENGTH] = FILE_MAX_WRITE_LENGTH + 1;
+    TEST_CHECK(Test_Serve(Adu, 3 + FILE_MAX_WRITE_LENGTH + 1,
+                          &Response) == ILLEGAL_DATA_VALUE);
+
+    //!-  FC21: Sub-Requests that do not fill the Byte Count exactly.
+    Adu[FRAME_HEADER_LENGTH] = FILE_SUB_REQUEST_LENGTH + 3;
+    TEST_CHECK(Test_Serve(Adu, 13, &Response) == ILLEGAL_DATA_VALUE);
+    Adu[FRAME_HEADER_LENGTH] = FILE_SUB_REQUEST_LENGTH + 2;
+    Test_Sub(&Adu[3], TEST_FILE, 30, 2);
+    TEST_CHECK(Test_Serve(Adu, 13, &Response) == ILLEGAL_DATA_VALUE);
+}
+
+//!-  Test_Server_Run() serves the Test Server until told to stop.
+void *Test_Server_Run(
+        void *const Context) {
+
+    (void) Context;
+    while (__atomic_load_n(&Server_Stop, __ATOMIC_ACQUIRE) == FALSE) {
+        (void) Modbus_TCP_Server_Poll(&Server, TEST_POLL_MS);
+    }
+    return NULL;
+}
+
+/*
+ *!-  Test_Download() downloads the whole File over the TCP Client
+ *!-  from a Server on an ephemeral Loopback Port, then one Record
+ *!-  more than the File has, which must stop with its Exception.
+ */
+void Test_Download(
+        Modbus_Data *const Unit) {
+
+    static uint8_t Expected[TEST_RECORDS * 2];
+    static uint8_t Records[(TEST_RECORDS + 1) * 2];
+    struct sockaddr_in Address;
+    socklen_t Length = sizeof(Address);
+    pthread_t Thread;
+    uint8_t Status = MODBUS_NO_EXCEPTION;
+    uint32_t Index = 0;
+
+    for (Index = 0; Index < TEST_RECORDS; Index++) {
+        Frame_Put_U16(&Expected[Index * 2],
+                      (uint16_t) (Index + TEST_VALUE_BASE));
+    }
+    TEST_CHECK(Write_File_Records(Unit, TEST_FILE, 0, TEST_RECORDS,
+                                  Expected) == TRUE);
+    if ((TEST_CHECK(Modbus_TCP_Server_Open(&Server, 0) == TRUE) == TRUE) &&
+        (TEST_CHECK(getsockname(Server.Listen_Fd, (struct sockaddr *) &Address,
+                                &Length) == 0) == TRUE) &&
+        (TEST_CHECK(pthread_create(&Thread, NULL, Test_Server_Run,
+                                   NULL) == 0) == TRUE)) {
+        if (TEST_CHECK(Modbus_TCP_Client_Connect(
+                           &Client, "127.0.0.1", ntohs(Address.sin_port),
+                           TEST_WINDOW) == TRUE) == TRUE) {
+            TEST_CHECK(Modbus_File_Download(&Client, TEST_UNIT, TEST_FILE,
+                                            TEST_RECORDS, Records,
+                                            &Status) == TRUE);
+            TEST_CHECK(Status == MODBUS_NO_EXCEPTION);
+            TEST_CHECK(memcmp(Records, Expected, sizeof(Expected)) == 0);
+            TEST_CHECK(Client.Completed ==
+                       ((TEST_RECORDS + FILE_MAX_READ_RECORDS - 1) /
+                        FILE_MAX_READ_RECORDS));
+
+            TEST_CHECK(Modbus_File_Download(&Client, TEST_UNIT, TEST_FILE,
+                                            TEST_RECORDS + 1, Records,
+                                            &Status) == FALSE);
+            TEST_CHECK(Status == ILLEGAL_DATA_ADDRESS);
+            TEST_CHECK(Client.In_Flight == 0);
+            Modbus_TCP_Client_Close(&Client);
+        }
+        __atomic_store_n(&Server_Stop, TRUE, __ATOMIC_RELEASE);
+        (void) pthread_join(Thread, NULL);
+    }
+    Modbus_TCP_Server_Close(&Server);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks File Records (FC20/FC21) on a File mapped onto a
+ *!-  temporary Host File: Writes that persist across a new
+ *!-  Mapping, Reads of several Runs, the Byte Counts refused,
+ *!-  and a pipelined Download over Modbus TCP.
+ */
+int main(void) {
+
+    char Path[] = "/tmp/Test_File_XXXXXX";
+    Modbus_Data *Unit = NULL;
+    int Fd = mkstemp(Path);
+
+    TEST_CHECK(Modbus_Init() == TRUE);
+    Unit = Modbus_Add_Unit(TEST_UNIT, 16, 16, 16, 16);
+    if ((TEST_CHECK(Fd >= 0) == TRUE) && (TEST_CHECK(Unit != NULL) == TRUE) &&
+        (TEST_CHECK(Modbus_Map_File(Unit, TEST_FILE, Path,
+                                    TEST_RECORDS) == TRUE) == TRUE)) {
+        Test_Write_Reopen(Unit, Path);
+        Test_Multi_Read();
+        Test_Byte_Counts();
+        Test_Download(Unit);
+        Modbus_Unmap_Files(Unit);
+    }
+    if (Fd >= 0) {
+        (void) close(Fd);
+        (void) unlink(Path);
+    }
+    return Test_Result("Test_File");
+}
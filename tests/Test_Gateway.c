@@ -0,0 +1,242 @@
+/*
+ * Test_Gateway.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Gateway.c
+*****************************************************************************/
+
+//!-  Headers
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pty.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "Modbus_Clock.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Gateway.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define TEST_LINE          "115200,8E1"
+//!-  Unit on the Line, Unit routed there that stays silent, Unit
+//!-  on no Line.
+#define TEST_UNIT          (2)
+#define TEST_SILENT        (3)
+#define TEST_UNROUTED      (9)
+#define TEST_REGISTERS     (16)
+//!-  Reads the busy Client queues before the other one sends.
+#define TEST_BURST         (8)
+#define TEST_QUIET         (2)
+#define TEST_WINDOW        (TEST_BURST + 2)
+#define TEST_DEADLINE_MS   (3000)
+//!-  Value of Register "n" on the Line: n + TEST_VALUE_BASE.
+#define TEST_VALUE_BASE    (0x100)
+
+void Test_Pump(
+        uint64_t const Completed,
+        uint32_t const Received);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Gateway Gateway;
+static Modbus_RTU_Server Slave;
+static Modbus_TCP_Client Busy;
+static Modbus_TCP_Client Quiet;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Test_Pump() runs Gateway, Slave and both Clients until the
+ *!-  Clients have "Completed" Results (Answers and Timeouts) and
+ *!-  the Line has "Received" Requests (queued, on the Line or
+ *!-  forwarded), or TEST_DEADLINE_MS passed.
+ */
+void Test_Pump(
+        uint64_t const Completed,
+        uint32_t const Received) {
+
+    uint64_t const Deadline_ns = Modbus_Now_ns() +
+                                 (TEST_DEADLINE_MS * NS_PER_MS);
+    const Gateway_Line *const Line = &Gateway.Line[0];
+
+    while ((((Busy.Completed + Quiet.Completed + Quiet.Timeouts) <
+             Completed) ||
+            ((Line->Queued + Line->Forwarded +
+              ((Line->Active != NULL) ? 1 : 0)) < Received)) &&
+           (Modbus_Now_ns() < Deadline_ns)) {
+        (void) Modbus_TCP_Client_Poll(&Busy, 0);
+        (void) Modbus_TCP_Client_Poll(&Quiet, 0);
+        (void) Modbus_RTU_Server_Poll(&Slave, 0);
+        (void) Modbus_Gateway_Poll(&Gateway, 1);
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Serves two Modbus TCP Clients from an RTU Slave on a
+ *!-  Pseudo-Terminal through the Gateway and checks a Read and a
+ *!-  Write round trip, that a Client queueing a Burst does not
+ *!-  hold back the other one, that a Unit on no Line gets
+ *!-  GATEWAY_PATH_UNAVAILABLE at once, a silent one
+ *!-  TARGET_DEVICE_FAILED_TO_RESPOND, and that a queued Write
+ *!-  keeps the Cache from answering the Reads behind it.
+ */
+int main(void) {
+
+    uint8_t Buffer[MODBUS_MAX_PDU_LENGTH + 1];
+    uint16_t Values[TEST_REGISTERS];
+    char Name[64];
+    char Spec[128];
+    struct sockaddr_in Address;
+    socklen_t Length = sizeof(Address);
+    Modbus_Frame Request;
+    Modbus_Data *Unit = NULL;
+    Test_Client_Reply Burst[TEST_BURST];
+    Test_Client_Reply Others[TEST_QUIET];
+    Test_Client_Reply Reply;
+    uint16_t Port = 0;
+    uint32_t Index = 0;
+    int Master_Fd = -1;
+    int Slave_Fd = -1;
+    int Line = -1;
+
+    TEST_CHECK(Modbus_Init() == TRUE);
+    Unit = Modbus_Add_Unit(TEST_UNIT, 16, 16, TEST_REGISTERS, TEST_REGISTERS);
+    for (Index = 0; Index < TEST_REGISTERS; Index++) {
+        Values[Index] = (uint16_t) (Index + TEST_VALUE_BASE);
+    }
+    TEST_CHECK((Unit != NULL) &&
+               (Modbus_Publish_Registers(Unit, TABLE_HOLDING_REGISTERS, 0,
+                                         TEST_REGISTERS, Values) == TRUE));
+
+    //!-  The Slave End of the pty stays open, the Gateway opens it.
+    if ((TEST_CHECK(openpty(&Master_Fd, &Slave_Fd, Name, NULL,
+                            NULL) == 0) == FALSE) ||
+        (TEST_CHECK(Modbus_RTU_Server_Attach(&Slave, Master_Fd,
+                                             TEST_LINE) == TRUE) == FALSE) ||
+        (TEST_CHECK(Modbus_Gateway_Open(&Gateway, 0) == TRUE) == FALSE) ||
+        (TEST_CHECK(getsockname(Gateway.Server.Listen_Fd,
+                                (struct sockaddr *) &Address,
+                                &Length) == 0) == FALSE)) {
+        return Test_Result("Test_Gateway");
+    }
+    (void) snprintf(Spec, sizeof(Spec), "%s,%s", Name, TEST_LINE);
+    Line = Modbus_Gateway_Add_Line(&Gateway, Spec);
+    TEST_CHECK(Line == 0);
+    TEST_CHECK(Modbus_Gateway_Route(&Gateway, TEST_UNIT, TEST_SILENT,
+                                    Line) == TRUE);
+    Port = ntohs(Address.sin_port);
+    if ((TEST_CHECK(Modbus_TCP_Client_Connect(&Busy, "127.0.0.1", Port,
+                                              TEST_WINDOW) == TRUE) == FALSE) ||
+        (TEST_CHECK(Modbus_TCP_Client_Connect(&Quiet, "127.0.0.1", Port,
+                                              TEST_WINDOW) == TRUE) == FALSE)) {
+        return Test_Result("Test_Gateway");
+    }
+
+    //!-  Round Trips: a Read, then a Write the Slave executes.
+    TEST_CHECK(Test_Client_Read(&Quiet, TEST_UNIT, 5, &Reply) == TRUE);
+    Test_Pump(1, 0);
+    TEST_CHECK(Reply.Calls == 1);
+    TEST_CHECK(Reply.Status == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Reply.Value == (5 + TEST_VALUE_BASE));
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Write_Single(&Request, TEST_UNIT, Fun_Code06,
+                                    TEST_REGISTERS - 1, 0xBEEF);
+    memset(&Reply, 0, sizeof(Reply));
+    TEST_CHECK(Modbus_TCP_Client_Submit(&Quiet, &Request, Test_Client_Response,
+                                        &Reply) == TRUE);
+    Test_Pump(2, 0);
+    TEST_CHECK(Reply.Status == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Modbus_Snapshot_Registers(Unit, TABLE_HOLDING_REGISTERS,
+                                         TEST_REGISTERS - 1, 1,
+                                         Values) == TRUE);
+    TEST_CHECK(Values[0] == 0xBEEF);
+
+    //!-  A Unit on no Line is refused without touching the Line.
+    TEST_CHECK(Test_Client_Read(&Quiet, TEST_UNROUTED, 0, &Reply) == TRUE);
+    Test_Pump(3, 0);
+    TEST_CHECK(Reply.Status == GATEWAY_PATH_UNAVAILABLE);
+    TEST_CHECK(Gateway.Unavailable == 1);
+    TEST_CHECK(Gateway.Line[0].Forwarded == 2);
+
+    //!-  A routed Unit that stays silent times out on the Line.
+    TEST_CHECK(Test_Client_Read(&Quiet, TEST_SILENT, 0, &Reply) == TRUE);
+    Test_Pump(4, 0);
+    TEST_CHECK(Reply.Status == TARGET_DEVICE_FAILED_TO_RESPOND);
+    TEST_CHECK(Quiet.Timeouts == 1);
+    TEST_CHECK(Gateway.Line[0].Timeouts == 1);
+
+    /*
+     *!-  Fairness: once the Burst of one Client is in, the other
+     *!-  Client's Reads are served between its Requests, not after.
+     */
+    Test_Reply_Order = 0;
+    for (Index = 0; Index < TEST_BURST; Index++) {
+        TEST_CHECK(Test_Client_Read(&Busy, TEST_UNIT, (uint16_t) Index,
+                             &Burst[Index]) == TRUE);
+    }
+    Test_Pump(0, 3 + TEST_BURST);
+    for (Index = 0; Index < TEST_QUIET; Index++) {
+        TEST_CHECK(Test_Client_Read(&Quiet, TEST_UNIT,
+                             (uint16_t) (TEST_BURST + Index),
+                             &Others[Index]) == TRUE);
+    }
+    Test_Pump(4 + TEST_BURST + TEST_QUIET, 0);
+    for (Index = 0; Index < TEST_BURST; Index++) {
+        TEST_CHECK(Burst[Index].Calls == 1);
+        TEST_CHECK(Burst[Index].Value == (Index + TEST_VALUE_BASE));
+    }
+    for (Index = 0; Index < TEST_QUIET; Index++) {
+        TEST_CHECK(Others[Index].Calls == 1);
+        TEST_CHECK(Others[Index].Value ==
+                   (TEST_BURST + Index + TEST_VALUE_BASE));
+    }
+    TEST_CHECK(Others[TEST_QUIET - 1].Order < (TEST_BURST / 2 + TEST_QUIET));
+    TEST_CHECK(Burst[TEST_BURST - 1].Order == (TEST_BURST + TEST_QUIET - 1));
+
+    /*
+     *!-  A Read cached, then a Write and the same Read pipelined:
+     *!-  the Read must not be answered from before the Write.
+     */
+    Gateway.Cache.Default_TTL_ns = TEST_DEADLINE_MS * NS_PER_MS;
+    TEST_CHECK(Test_Client_Read(&Quiet, TEST_UNIT, 5, &Reply) == TRUE);
+    Test_Pump(5 + TEST_BURST + TEST_QUIET, 0);
+    TEST_CHECK(Reply.Value == (5 + TEST_VALUE_BASE));
+    TEST_CHECK(Test_Client_Read(&Quiet, TEST_UNIT, 5, &Reply) == TRUE);
+    Test_Pump(6 + TEST_BURST + TEST_QUIET, 0);
+    TEST_CHECK(Gateway.Cache.Stats.Hits == 1);
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Write_Single(&Request, TEST_UNIT, Fun_Code06, 5,
+                                    0xCAFE);
+    memset(&Others[0], 0, sizeof(Test_Client_Reply));
+    TEST_CHECK(Modbus_TCP_Client_Submit(&Quiet, &Request, Test_Client_Response,
+                                        &Others[0]) == TRUE);
+    TEST_CHECK(Test_Client_Read(&Quiet, TEST_UNIT, 5, &Reply) == TRUE);
+    Test_Pump(8 + TEST_BURST + TEST_QUIET, 0);
+    TEST_CHECK(Others[0].Status == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Reply.Calls == 1);
+    TEST_CHECK(Reply.Value == 0xCAFE);
+    TEST_CHECK(Slave.Port.Parser.Stats.CRC_Errors == 0);
+
+    Modbus_TCP_Client_Close(&Busy);
+    Modbus_TCP_Client_Close(&Quiet);
+    Modbus_Gateway_Close(&Gateway);
+    Modbus_RTU_Server_Close(&Slave);
+    (void) close(Slave_Fd);
+    return Test_Result("Test_Gateway");
+}
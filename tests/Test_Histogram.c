@@ -0,0 +1,165 @@
+/*
+ * Test_Histogram.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Histogram.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus_Histogram.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Values 1 .. TEST_VALUES are recorded for the Percentiles.
+#define TEST_VALUES   (10000)
+
+uint64_t Test_Top(
+        uint64_t const Value);
+
+void Test_Bounds(
+        void);
+
+void Test_Percentiles(
+        void);
+
+void Test_Merge(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Histogram Histogram;
+static Modbus_Histogram Other;
+static Modbus_Histogram Merged;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Test_Top() gives the Top of the Bucket "Value" falls in: the
+ *!-  Median of "Value" and a larger one, which is not capped.
+ */
+uint64_t Test_Top(
+        uint64_t const Value) {
+
+    Modbus_Histogram_Reset(&Histogram);
+    Modbus_Histogram_Record(&Histogram, Value);
+    Modbus_Histogram_Record(&Histogram, HISTOGRAM_MAX_VALUE);
+    return Modbus_Histogram_Percentile(&Histogram, 50.0);
+}
+
+/*
+ *!-  Test_Bounds() checks the Buckets around every Power of 2:
+ *!-  exact below 2^HISTOGRAM_SUB_BITS, within 1/128 above, and
+ *!-  adjacent Values in the same or the next Bucket.
+ */
+void Test_Bounds(
+        void) {
+
+    uint64_t Value = 0;
+    uint64_t Top = 0;
+    uint32_t Bits = 0;
+    uint32_t Exact = 0;
+    uint32_t Wide = 0;
+    int32_t Offset = 0;
+
+    for (Value = 0; Value < (2 * HISTOGRAM_HALF); Value++) {
+        Exact += (Test_Top(Value) != Value) ? 1 : 0;
+    }
+    TEST_CHECK(Exact == 0);
+    TEST_CHECK(Test_Top(256) == 257);
+    TEST_CHECK(Test_Top(257) == 257);
+    TEST_CHECK(Test_Top(258) == 259);
+    TEST_CHECK(Test_Top(1000) == 1003);
+    TEST_CHECK(Test_Top(1003) == 1003);
+    TEST_CHECK(Test_Top(1004) == 1007);
+
+    for (Bits = HISTOGRAM_SUB_BITS; Bits < HISTOGRAM_MAX_BITS; Bits++) {
+        for (Offset = -1; Offset <= 1; Offset++) {
+            Value = (uint64_t) ((int64_t) (1ULL << Bits) + Offset);
+            Top = Test_Top(Value);
+            Wide += ((Top < Value) || ((Top - Value) > (Value >> 7))) ? 1 : 0;
+        }
+        //!-  A Power of 2 starts a Bucket; the Value below ends one.
+        TEST_CHECK(Test_Top((1ULL << Bits) - 1) == ((1ULL << Bits) - 1));
+    }
+    TEST_CHECK(Wide == 0);
+
+    //!-  Larger Values are counted as HISTOGRAM_MAX_VALUE.
+    Modbus_Histogram_Reset(&Histogram);
+    Modbus_Histogram_Record(&Histogram, 1ULL << 40);
+    TEST_CHECK(Histogram.Max == HISTOGRAM_MAX_VALUE);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 100.0) ==
+               HISTOGRAM_MAX_VALUE);
+    TEST_CHECK(Histogram.Buckets[HISTOGRAM_BUCKETS - 1] == 1);
+}
+
+/*
+ *!-  Test_Percentiles() records 1 .. TEST_VALUES: each Percentile
+ *!-  is the Top of the Bucket of its exact Value, capped at the Max.
+ */
+void Test_Percentiles(
+        void) {
+
+    uint64_t Value = 0;
+
+    Modbus_Histogram_Reset(&Histogram);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 50.0) == 0);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 0.0) == 0);
+    for (Value = 1; Value <= TEST_VALUES; Value++) {
+        Modbus_Histogram_Record(&Histogram, Value);
+    }
+    TEST_CHECK(Histogram.Count == TEST_VALUES);
+    TEST_CHECK(Histogram.Min == 1);
+    TEST_CHECK(Histogram.Max == TEST_VALUES);
+    TEST_CHECK(Histogram.Total ==
+               ((uint64_t) TEST_VALUES * (TEST_VALUES + 1)) / 2);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 0.0) == 1);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 0.01) == 1);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 1.0) == 100);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 50.0) == 5023);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 99.0) == 9919);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 100.0) == TEST_VALUES);
+    TEST_CHECK(Modbus_Histogram_Percentile(&Histogram, 150.0) == TEST_VALUES);
+}
+
+//!-  Test_Merge() checks two merged Halves equal the whole.
+void Test_Merge(
+        void) {
+
+    uint64_t Value = 0;
+
+    Modbus_Histogram_Reset(&Merged);
+    Modbus_Histogram_Reset(&Other);
+    for (Value = 1; Value <= TEST_VALUES; Value++) {
+        Modbus_Histogram_Record(((Value % 3) == 0) ? &Merged : &Other, Value);
+    }
+    Modbus_Histogram_Merge(&Merged, &Other);
+    TEST_CHECK(memcmp(&Merged, &Histogram, sizeof(Merged)) == 0);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks the Latency Histogram: Bucket Bounds and Precision,
+ *!-  Percentiles of a known Distribution, and Merging.
+ */
+int main(void) {
+
+    Test_Bounds();
+    Test_Percentiles();
+    Test_Merge();
+    return Test_Result("Test_Histogram");
+}
@@ -0,0 +1,205 @@
+/*
+ * Test_Image.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Image.c
+*****************************************************************************/
+
+//!-  Headers
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "Modbus_Frame.h"
+#include "Modbus_Image.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define TEST_UNIT          (2)
+#define TEST_IMAGE_BYTES   (1024UL * 1024)
+//!-  Bytes of a File too short to hold the Image Header.
+#define TEST_SHORT_BYTES   (16)
+//!-  Holding Registers the Creator maps; the other Process maps
+//!-  TEST_LATE_COUNT more on a new Page from TEST_LATE_START.
+#define TEST_REGISTERS     (16)
+#define TEST_LATE_START    (1000)
+#define TEST_LATE_COUNT    (4)
+
+uint16_t Test_Register(
+        uint16_t const Address);
+
+void Test_Set_Register(
+        uint16_t const Address,
+        uint16_t const Value);
+
+void Test_Short_File(
+        const char *const Path);
+
+void Test_Other_Process(
+        const char *const Path);
+
+void Test_Reopen(
+        const char *const Path);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Image Image;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Register() reads a Holding Register of the Image Unit.
+uint16_t Test_Register(
+        uint16_t const Address) {
+
+    uint8_t BeOut[2] = { 0, 0 };
+
+    TEST_CHECK(Read_Registers(MODBUS_UNITS[TEST_UNIT],
+                              TABLE_HOLDING_REGISTERS, Address, 1,
+                              BeOut) == TRUE);
+    return Frame_Get_U16(BeOut);
+}
+
+//!-  Test_Set_Register() writes a Holding Register of the Image Unit.
+void Test_Set_Register(
+        uint16_t const Address,
+        uint16_t const Value) {
+
+    uint8_t BeIn[2];
+
+    Frame_Put_U16(BeIn, Value);
+    TEST_CHECK(Write_Registers(MODBUS_UNITS[TEST_UNIT],
+                               TABLE_HOLDING_REGISTERS, Address, 1,
+                               BeIn) == TRUE);
+}
+
+//!-  Test_Short_File() checks a File shorter than the Header is refused.
+void Test_Short_File(
+        const char *const Path) {
+
+    Modbus_Image Short;
+    struct stat Status;
+
+    TEST_CHECK(truncate(Path, TEST_SHORT_BYTES) == 0);
+    TEST_CHECK(Modbus_Image_Open(&Short, Path, TEST_IMAGE_BYTES) == FALSE);
+    TEST_CHECK(Short.Base == NULL);
+    TEST_CHECK((stat(Path, &Status) == 0) &&
+               (Status.st_size == TEST_SHORT_BYTES));
+    TEST_CHECK(truncate(Path, 0) == 0);
+}
+
+/*
+ *!-  Test_Other_Process() lets a Child Process open the existing
+ *!-  Image on its own: it must see the Values, and its Writes and
+ *!-  new Page must reach this Process, the Page after a Refresh.
+ */
+void Test_Other_Process(
+        const char *const Path) {
+
+    Modbus_Image Other;
+    pid_t Child = fork();
+    int Status = 0;
+
+    if (Child == 0) {
+        if ((TEST_CHECK(Modbus_Image_Open(&Other, Path, 0) == TRUE) == TRUE) &&
+            (TEST_CHECK(Other.Bytes == TEST_IMAGE_BYTES) == TRUE)) {
+            TEST_CHECK(Test_Register(3) == 0x1234);
+            Test_Set_Register(4, 0x5555);
+            TEST_CHECK(Modbus_Image_Map_Registers(&Other, TEST_UNIT,
+                                                  TABLE_HOLDING_REGISTERS,
+                                                  TEST_LATE_START,
+                                                  TEST_LATE_COUNT) == TRUE);
+            Test_Set_Register(TEST_LATE_START, 0xBEEF);
+            Modbus_Image_Close(&Other);
+        }
+        _exit((Test_Failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    if ((TEST_CHECK(Child > 0) == TRUE) &&
+        (TEST_CHECK(waitpid(Child, &Status, 0) == Child) == TRUE)) {
+        TEST_CHECK(WIFEXITED(Status) && (WEXITSTATUS(Status) == 0));
+        TEST_CHECK(Test_Register(4) == 0x5555);
+        TEST_CHECK(Modbus_Valid_Range(MODBUS_UNITS[TEST_UNIT],
+                                      TABLE_HOLDING_REGISTERS,
+                                      TEST_LATE_START, 1) == FALSE);
+        TEST_CHECK(Modbus_Image_Refresh(&Image) == TRUE);
+        TEST_CHECK(Modbus_Image_Refresh(&Image) == FALSE);
+        TEST_CHECK(Modbus_Valid_Range(MODBUS_UNITS[TEST_UNIT],
+                                      TABLE_HOLDING_REGISTERS,
+                                      TEST_LATE_START,
+                                      TEST_LATE_COUNT) == TRUE);
+        TEST_CHECK(Test_Register(TEST_LATE_START) == 0xBEEF);
+    }
+}
+
+/*
+ *!-  Test_Reopen() closes the Image and opens it again: it keeps
+ *!-  its Size, Layout and Values, whatever Size is asked for.
+ */
+void Test_Reopen(
+        const char *const Path) {
+
+    uint8_t Coils = 0;
+
+    Modbus_Image_Close(&Image);
+    TEST_CHECK(MODBUS_UNITS[TEST_UNIT] == NULL);
+    if (TEST_CHECK(Modbus_Image_Open(&Image, Path,
+                                     2 * TEST_IMAGE_BYTES) == TRUE) == TRUE) {
+        TEST_CHECK(Image.Bytes == TEST_IMAGE_BYTES);
+        if (TEST_CHECK(MODBUS_UNITS[TEST_UNIT] != NULL) == TRUE) {
+            TEST_CHECK(Test_Register(3) == 0x1234);
+            TEST_CHECK(Test_Register(4) == 0x5555);
+            TEST_CHECK(Test_Register(TEST_LATE_START) == 0xBEEF);
+            TEST_CHECK((Read_Bits(MODBUS_UNITS[TEST_UNIT], TABLE_COILS, 0,
+                                  8, &Coils) == TRUE) && (Coils == 0x80));
+        }
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks the Process Image: a truncated File is refused, another
+ *!-  Process opening the Image shares its Values and Layout, and
+ *!-  the Values survive closing and opening it again.
+ */
+int main(void) {
+
+    char Path[] = "/tmp/Test_Image_XXXXXX";
+    int Fd = mkstemp(Path);
+
+    TEST_CHECK(Modbus_Init() == TRUE);
+    if (TEST_CHECK(Fd >= 0) == TRUE) {
+        (void) close(Fd);
+        Test_Short_File(Path);
+    }
+    if ((Fd >= 0) &&
+        (TEST_CHECK(Modbus_Image_Open(&Image, Path,
+                                      TEST_IMAGE_BYTES) == TRUE) == TRUE) &&
+        (TEST_CHECK(Modbus_Image_Add_Unit(&Image, TEST_UNIT, 16,
+                                          16) != NULL) == TRUE) &&
+        (TEST_CHECK(Modbus_Image_Map_Registers(
+                        &Image, TEST_UNIT, TABLE_HOLDING_REGISTERS, 0,
+                        TEST_REGISTERS) == TRUE) == TRUE)) {
+        Test_Set_Register(3, 0x1234);
+        TEST_CHECK(Write_Bits(MODBUS_UNITS[TEST_UNIT], TABLE_COILS, 7, 1,
+                              (const uint8_t *) "\x01") == TRUE);
+        Test_Other_Process(Path);
+        Test_Reopen(Path);
+    }
+    if (Fd >= 0) {
+        Modbus_Image_Close(&Image);
+        (void) unlink(Path);
+    }
+    return Test_Result("Test_Image");
+}
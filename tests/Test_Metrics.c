@@ -0,0 +1,296 @@
+/*
+ * Test_Metrics.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Metrics.c
+*****************************************************************************/
+
+//!-  Headers
+#include <pthread.h>
+#include <unistd.h>
+#include "Modbus_Metrics.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Counting Threads, and the Requests each of them counts.
+#define TEST_THREADS     (4)
+#define TEST_REQUESTS    (100000)
+//!-  Rounds of the Publisher Thread, and Reads the Reader makes.
+#define TEST_ROUNDS      (20000)
+#define TEST_READS       (2000)
+//!-  Bytes of a File too short to hold an Export.
+#define TEST_SHORT_BYTES (16)
+
+/*
+ *!-  "Test_Counter" is a Counting Thread: the Function Code it
+ *!-  counts, and the Slot it counted into.
+ */
+typedef struct {
+    uint8_t          Function_Code;
+    Modbus_Metrics  *Slot;
+} Test_Counter;
+
+void *Test_Count(
+        void *const Context);
+
+void *Test_Publisher(
+        void *const Context);
+
+void Test_Slots(
+        void);
+
+void Test_Percentile(
+        void);
+
+void Test_Bad_Files(
+        const char *const Path);
+
+void Test_Export(
+        const char *const Path);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Test_Counter Counters[TEST_THREADS];
+//!-  Set once the Publisher Thread has published its last Round.
+static Bool Published;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Count() counts TEST_REQUESTS Requests into its own Slot.
+void *Test_Count(
+        void *const Context) {
+
+    Test_Counter *const Counter = (Test_Counter *) Context;
+    uint32_t Request = 0;
+
+    for (Request = 0; Request < TEST_REQUESTS; Request++) {
+        Modbus_Metrics_Request(Counter->Function_Code,
+                               ((Request % 10) == 0) ?
+                               ILLEGAL_DATA_ADDRESS :
+                               MODBUS_NO_EXCEPTION);
+    }
+    Counter->Slot = Modbus_Metrics_Local;
+    return NULL;
+}
+
+/*
+ *!-  Test_Publisher() counts one FC03 and one FC04 Request per
+ *!-  Round and publishes them, so every Snapshot a Reader gets
+ *!-  whole holds as many of both.
+ */
+void *Test_Publisher(
+        void *const Context) {
+
+    Modbus_Metrics_Export *const Export = (Modbus_Metrics_Export *) Context;
+    uint32_t Round = 0;
+
+    for (Round = 0; Round < TEST_ROUNDS; Round++) {
+        Modbus_Metrics_Request(Fun_Code03,
+                               MODBUS_NO_EXCEPTION);
+        Modbus_Metrics_Request(Fun_Code04,
+                               MODBUS_NO_EXCEPTION);
+        Modbus_Metrics_Publish(Export);
+    }
+    __atomic_store_n(&Published, TRUE, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/*
+ *!-  Test_Slots() lets Threads count at once: each gets a Slot of
+ *!-  its own, and a Snapshot sums them without losing a Count.
+ */
+void Test_Slots(
+        void) {
+
+    Modbus_Metrics Before;
+    Modbus_Metrics After;
+    pthread_t Threads[TEST_THREADS];
+    uint32_t Started = 0;
+    uint32_t Index = 0;
+    uint32_t Other = 0;
+
+    Modbus_Metrics_Snapshot(&Before);
+    for (Index = 0; Index < TEST_THREADS; Index++) {
+        Counters[Index].Function_Code = (uint8_t) (Index + 1);
+    }
+    while ((Started < TEST_THREADS) &&
+           (TEST_CHECK(pthread_create(&Threads[Started], NULL, Test_Count,
+                                      &Counters[Started]) == 0) == TRUE)) {
+        Started++;
+    }
+    for (Index = 0; Index < Started; Index++) {
+        (void) pthread_join(Threads[Index], NULL);
+    }
+    Modbus_Metrics_Snapshot(&After);
+    for (Index = 0; Index < Started; Index++) {
+        TEST_CHECK(Counters[Index].Slot != NULL);
+        TEST_CHECK(Counters[Index].Slot != Modbus_Metrics_Local);
+        for (Other = 0; Other < Index; Other++) {
+            TEST_CHECK(Counters[Index].Slot != Counters[Other].Slot);
+        }
+        TEST_CHECK(Counters[Index].Slot->Requests[Index + 1] == TEST_REQUESTS);
+        TEST_CHECK((After.Requests[Index + 1] - Before.Requests[Index + 1]) ==
+                   TEST_REQUESTS);
+    }
+    TEST_CHECK((After.Exceptions[ILLEGAL_DATA_ADDRESS] -
+                Before.Exceptions[ILLEGAL_DATA_ADDRESS]) ==
+               ((uint64_t) Started * (TEST_REQUESTS / 10)));
+}
+
+/*
+ *!-  Test_Percentile() checks the Bucket Bounds: a Latency is
+ *!-  reported as the Top of its log2 Bucket, 0 only for 0 ns.
+ */
+void Test_Percentile(
+        void) {
+
+    Modbus_Metrics_Latency *const Latency =
+            &Modbus_Metrics_Slot()->Latency[METRICS_DISPATCH];
+    uint32_t Index = 0;
+
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 50.0) == 0);
+    Modbus_Metrics_Stage_Time(METRICS_DISPATCH, 0);
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 100.0) == 0);
+    Modbus_Metrics_Stage_Time(METRICS_DISPATCH, 1);
+    TEST_CHECK(Latency->Buckets[1] == 1);
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 100.0) == 1);
+    Modbus_Metrics_Stage_Time(METRICS_DISPATCH, 1024);
+    Modbus_Metrics_Stage_Time(METRICS_DISPATCH, 2047);
+    TEST_CHECK(Latency->Buckets[11] == 2);
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 100.0) == 2047);
+
+    //!-  96 more at 100 ns: p50 and p99 are in their Bucket, [64, 128).
+    for (Index = 0; Index < 96; Index++) {
+        Modbus_Metrics_Stage_Time(METRICS_DISPATCH, 100);
+    }
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 50.0) == 127);
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 98.0) == 127);
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 99.0) == 2047);
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 0.0) == 0);
+    TEST_CHECK(Latency->Count == 100);
+    TEST_CHECK(Latency->Total_ns == (1 + 1024 + 2047 + (96 * 100)));
+
+    //!-  Whatever is beyond the last Bucket counts into it.
+    Modbus_Metrics_Stage_Time(METRICS_DISPATCH, UINT64_MAX);
+    TEST_CHECK(Latency->Buckets[METRICS_LATENCY_BUCKETS - 1] == 1);
+    TEST_CHECK(Modbus_Metrics_Percentile(Latency, 100.0) ==
+               ((1ULL << (METRICS_LATENCY_BUCKETS - 1)) - 1));
+}
+
+//!-  Test_Bad_Files() checks Files that hold no Export are refused.
+void Test_Bad_Files(
+        const char *const Path) {
+
+    Modbus_Metrics Snapshot;
+    uint64_t Published_ns = 0;
+
+    TEST_CHECK(Modbus_Metrics_Export_Read("/tmp/Test_Metrics_None",
+                                          &Snapshot, &Published_ns) == FALSE);
+    TEST_CHECK(truncate(Path, TEST_SHORT_BYTES) == 0);
+    TEST_CHECK(Modbus_Metrics_Export_Read(Path, &Snapshot,
+                                          &Published_ns) == FALSE);
+    //!-  Long enough, but no Magic.
+    TEST_CHECK(truncate(Path, 64 * 1024) == 0);
+    TEST_CHECK(Modbus_Metrics_Export_Read(Path, &Snapshot,
+                                          &Published_ns) == FALSE);
+}
+
+/*
+ *!-  Test_Export() reads the Export while a Publisher Thread
+ *!-  publishes into it: every Read must give a whole Snapshot,
+ *!-  never older than the one before.
+ */
+void Test_Export(
+        const char *const Path) {
+
+    Modbus_Metrics_Export Export;
+    Modbus_Metrics Snapshot;
+    uint64_t Published_ns = 0;
+    uint64_t Last_ns = 0;
+    uint64_t Last = 0;
+    uint64_t Base = 0;
+    uint32_t Reads = 0;
+    uint32_t Torn = 0;
+    uint32_t Stale = 0;
+    pthread_t Thread;
+
+    if ((TEST_CHECK(Modbus_Metrics_Export_Open(&Export, Path) == TRUE) ==
+         TRUE) &&
+        (TEST_CHECK(Modbus_Metrics_Export_Read(Path, &Snapshot,
+                                               &Published_ns) == TRUE) ==
+         TRUE)) {
+        Base = Snapshot.Requests[Fun_Code03];
+        Last = Base;
+        Last_ns = Published_ns;
+        TEST_CHECK(Snapshot.Requests[Fun_Code03] ==
+                   Snapshot.Requests[Fun_Code04]);
+        if (TEST_CHECK(pthread_create(&Thread, NULL, Test_Publisher,
+                                      &Export) == 0) == TRUE) {
+            while ((Reads < TEST_READS) ||
+                   (__atomic_load_n(&Published, __ATOMIC_ACQUIRE) == FALSE)) {
+                if (Modbus_Metrics_Export_Read(Path, &Snapshot,
+                                               &Published_ns) == TRUE) {
+                    Torn += (Snapshot.Requests[
+                                     Fun_Code03] !=
+                             Snapshot.Requests[
+                                     Fun_Code04]) ? 1 : 0;
+                    Stale += ((Snapshot.Requests[
+                                       Fun_Code03] <
+                               Last) || (Published_ns < Last_ns)) ? 1 : 0;
+                    Last = Snapshot.Requests[Fun_Code03];
+                    Last_ns = Published_ns;
+                    Reads++;
+                }
+            }
+            (void) pthread_join(Thread, NULL);
+            TEST_CHECK(Torn == 0);
+            TEST_CHECK(Stale == 0);
+            TEST_CHECK(Modbus_Metrics_Export_Read(Path, &Snapshot,
+                                                  &Published_ns) == TRUE);
+            TEST_CHECK((Snapshot.Requests[Fun_Code03] -
+                        Base) == TEST_ROUNDS);
+        }
+    }
+    Modbus_Metrics_Export_Close(&Export);
+
+    //!-  A valid Header without all of the Metrics behind it.
+    TEST_CHECK(truncate(Path, MODBUS_CACHE_LINE) == 0);
+    TEST_CHECK(Modbus_Metrics_Export_Read(Path, &Snapshot,
+                                          &Published_ns) == FALSE);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks the Runtime Metrics: the per-Thread Slots a Snapshot
+ *!-  sums, the Latency Buckets and Percentiles, and the Export
+ *!-  other Processes read under its Sequence Lock.
+ */
+int main(void) {
+
+    char Path[] = "/tmp/Test_Metrics_XXXXXX";
+    int Fd = mkstemp(Path);
+
+    Test_Slots();
+    Test_Percentile();
+    if (TEST_CHECK(Fd >= 0) == TRUE) {
+        (void) close(Fd);
+        Test_Bad_Files(Path);
+        Test_Export(Path);
+        (void) unlink(Path);
+    }
+    return Test_Result("Test_Metrics");
+}
@@ -0,0 +1,254 @@
+/*
+ * Test_Planner.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Planner.c
+*****************************************************************************/
+
+//!-  Headers
+#include "Modbus_Planner.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Polls a Test lets the Planner take to settle.
+#define TEST_MAX_POLLS  (32)
+
+void Test_Expect_Block(
+        const Modbus_Planner *const Planner,
+        uint16_t const Index,
+        uint8_t const Function_Code,
+        uint16_t const Start,
+        uint16_t const Quantity);
+
+uint32_t Test_Poll(
+        Modbus_Planner *const Planner,
+        const uint16_t *const Bad,
+        uint32_t const Bad_Count);
+
+void Test_Gaps(
+        void);
+
+void Test_Limits(
+        void);
+
+void Test_Holes(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Planner Planner;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Expect_Block() checks one Block of the current Plan.
+void Test_Expect_Block(
+        const Modbus_Planner *const Planner,
+        uint16_t const Index,
+        uint8_t const Function_Code,
+        uint16_t const Start,
+        uint16_t const Quantity) {
+
+    const Modbus_Read_Block *const Block = &Planner->Blocks[Index];
+
+    if (TEST_CHECK(Index < Planner->Block_Count) == TRUE) {
+        TEST_CHECK(Block->Function_Code == Function_Code);
+        TEST_CHECK(Block->Start == Start);
+        TEST_CHECK(Block->Quantity == Quantity);
+    }
+}
+
+/*
+ *!-  Test_Poll() polls Holding Registers of a Device on which the
+ *!-  "Bad" Addresses answer ILLEGAL_DATA_ADDRESS, until a Cycle
+ *!-  sees no Exception. Returns how many Cycles it took.
+ */
+uint32_t Test_Poll(
+        Modbus_Planner *const Planner,
+        const uint16_t *const Bad,
+        uint32_t const Bad_Count) {
+
+    uint32_t Polls = 0;
+    uint32_t Index = 0;
+    uint32_t Hit = 0;
+    uint16_t Blocks = 0;
+    const Modbus_Read_Block *Block = NULL;
+    Bool Failed = TRUE;
+
+    while ((Failed == TRUE) && (Polls < TEST_MAX_POLLS)) {
+        Failed = FALSE;
+        Polls++;
+        Blocks = Planner_Plan(Planner);
+        for (Index = 0; (Index < Blocks) && (Failed == FALSE); Index++) {
+            Block = &Planner->Blocks[Index];
+            for (Hit = 0; Hit < Bad_Count; Hit++) {
+                if ((Bad[Hit] >= Block->Start) &&
+                    (Bad[Hit] < (Block->Start + Block->Quantity))) {
+                    Failed = TRUE;
+                }
+            }
+            if (Failed == TRUE) {
+                TEST_CHECK(Planner_Report_Exception(
+                               Planner, (uint16_t) Index,
+                               ILLEGAL_DATA_ADDRESS) == TRUE);
+            }
+        }
+    }
+    TEST_CHECK(Failed == FALSE);
+    return Polls;
+}
+
+//!-  Test_Gaps() checks which Tags share a Block.
+void Test_Gaps(
+        void) {
+
+    Planner_Init(&Planner, PLANNER_GAP_REGISTERS, PLANNER_GAP_BITS);
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 30));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 10));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 19));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 10));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_INPUT_REGISTERS, 11));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 2, TABLE_HOLDING_REGISTERS, 12));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_COILS, 0));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_COILS, 129));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_COILS, 259));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_DISCRETE_INPUTS, 5));
+
+    //!-  Gaps up to the Fill are read; Tables and Units never mix.
+    TEST_CHECK(Planner_Plan(&Planner) == 7);
+    Test_Expect_Block(&Planner, 0, Fun_Code01, 0, 130);
+    Test_Expect_Block(&Planner, 1, Fun_Code01, 259, 1);
+    Test_Expect_Block(&Planner, 2, Fun_Code02, 5, 1);
+    Test_Expect_Block(&Planner, 3, Fun_Code04, 11, 1);
+    Test_Expect_Block(&Planner, 4, Fun_Code03, 10, 10);
+    Test_Expect_Block(&Planner, 5, Fun_Code03, 30, 1);
+    Test_Expect_Block(&Planner, 6, Fun_Code03, 12, 1);
+    TEST_CHECK(Planner.Plans == 1);
+    TEST_CHECK(Planner_Plan(&Planner) == 7);
+    TEST_CHECK(Planner.Plans == 1);
+
+    //!-  One more Register of Gap, and the Tags part.
+    TEST_CHECK(Planner_Remove_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 19));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 20));
+    TEST_CHECK(Planner_Plan(&Planner) == 8);
+    Test_Expect_Block(&Planner, 4, Fun_Code03, 10, 1);
+    Test_Expect_Block(&Planner, 5, Fun_Code03, 20, 1);
+}
+
+//!-  Test_Limits() checks the Protocol Limits per Request.
+void Test_Limits(
+        void) {
+
+    uint32_t Address = 0;
+
+    Planner_Init(&Planner, 0, 0);
+    for (Address = 0; Address < 300; Address++) {
+        TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS,
+                                   (uint16_t) Address));
+    }
+    for (Address = 0; Address < 4500; Address += 2) {
+        TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_COILS,
+                                   (uint16_t) Address));
+    }
+
+    //!-  Coil Tags every 2nd Bit: the Gap of one is not filled.
+    TEST_CHECK(Planner_Plan(&Planner) == (2250 + 3));
+    Planner_Init(&Planner, 0, 1);
+    for (Address = 0; Address < 300; Address++) {
+        TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS,
+                                   (uint16_t) Address));
+    }
+    for (Address = 0; Address < 4500; Address += 2) {
+        TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_COILS,
+                                   (uint16_t) Address));
+    }
+    TEST_CHECK(Planner_Plan(&Planner) == 6);
+    Test_Expect_Block(&Planner, 0, Fun_Code01, 0, MAXREGISTERQUANTITY - 1);
+    Test_Expect_Block(&Planner, 1, Fun_Code01, 2000, MAXREGISTERQUANTITY - 1);
+    Test_Expect_Block(&Planner, 2, Fun_Code01, 4000, 499);
+    Test_Expect_Block(&Planner, 3, Fun_Code03, 0, MAXREADREGQUANTITY);
+    Test_Expect_Block(&Planner, 4, Fun_Code03, 125, MAXREADREGQUANTITY);
+    Test_Expect_Block(&Planner, 5, Fun_Code03, 250, 50);
+}
+
+/*
+ *!-  Test_Holes() checks that bad Registers are isolated and that
+ *!-  the Blocks join again around them afterwards.
+ */
+void Test_Holes(
+        void) {
+
+    static const uint16_t One[] = { 303 };
+    static const uint16_t Two[] = { 303, 307 };
+    static const uint16_t Gap[] = { 101, 102, 103, 104, 106 };
+    uint32_t Address = 0;
+
+    //!-  One Hole: 11 Tags take at most log2(11) + 2 Polls.
+    Planner_Init(&Planner, PLANNER_GAP_REGISTERS, PLANNER_GAP_BITS);
+    for (Address = 300; Address <= 310; Address++) {
+        TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS,
+                                   (uint16_t) Address));
+    }
+    TEST_CHECK(Test_Poll(&Planner, One, 1) <= 6);
+    TEST_CHECK(Planner_Plan(&Planner) == 2);
+    Test_Expect_Block(&Planner, 0, Fun_Code03, 300, 3);
+    Test_Expect_Block(&Planner, 1, Fun_Code03, 304, 7);
+    TEST_CHECK(Planner.Skipped_Tags == 1);
+    TEST_CHECK(Planner.Break_Count == 1);
+
+    //!-  Two Holes in one Block.
+    Planner_Init(&Planner, PLANNER_GAP_REGISTERS, PLANNER_GAP_BITS);
+    for (Address = 300; Address <= 310; Address++) {
+        TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS,
+                                   (uint16_t) Address));
+    }
+    TEST_CHECK(Test_Poll(&Planner, Two, 2) < TEST_MAX_POLLS);
+    TEST_CHECK(Planner_Plan(&Planner) == 3);
+    Test_Expect_Block(&Planner, 0, Fun_Code03, 300, 3);
+    Test_Expect_Block(&Planner, 1, Fun_Code03, 304, 3);
+    Test_Expect_Block(&Planner, 2, Fun_Code03, 308, 3);
+    TEST_CHECK(Planner.Skipped_Tags == 2);
+
+    //!-  A Split that keeps unmapped Gap Registers out stays.
+    Planner_Init(&Planner, PLANNER_GAP_REGISTERS, PLANNER_GAP_BITS);
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 100));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 105));
+    TEST_CHECK(Planner_Add_Tag(&Planner, 1, TABLE_HOLDING_REGISTERS, 106));
+    TEST_CHECK(Test_Poll(&Planner, Gap, 5) < TEST_MAX_POLLS);
+    TEST_CHECK(Planner_Plan(&Planner) == 2);
+    Test_Expect_Block(&Planner, 0, Fun_Code03, 100, 1);
+    Test_Expect_Block(&Planner, 1, Fun_Code03, 105, 1);
+    TEST_CHECK(Planner.Skipped_Tags == 1);
+
+    //!-  Other Exceptions teach nothing.
+    TEST_CHECK(Planner_Report_Exception(&Planner, 0,
+                                        SLAVE_DEVICE_FAILURE) == FALSE);
+    TEST_CHECK(Planner_Report_Exception(&Planner, 9,
+                                        ILLEGAL_DATA_ADDRESS) == FALSE);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks how the Planner joins Tags into Blocks, keeps to the
+ *!-  125 Register and 2000 Bit Limits, and learns bad Registers.
+ */
+int main(void) {
+
+    Test_Gaps();
+    Test_Limits();
+    Test_Holes();
+    return Test_Result("Test_Planner");
+}
@@ -0,0 +1,461 @@
+/*
+ * Test_RTU_Parser.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_RTU_Parser.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus_Frame.h"
+#include "Modbus_RTU.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Slow enough for Timeouts from the Character Time.
+#define TEST_BAUD       (9600)
+#define TEST_FAST_BAUD  (115200)
+//!-  Arrival Time of the first Byte of every Script.
+#define TEST_START_NS   (NS_PER_S)
+
+/*
+ *!-  "Test_Sink" keeps what the Parser delivered: the Number of
+ *!-  Frames and a Copy of the last one.
+ */
+typedef struct {
+    uint32_t  Frames;
+    uint16_t  Length;
+    uint8_t   Adu[MODBUS_MAX_ADU_LENGTH];
+} Test_Sink;
+
+void Test_Deliver(
+        void *const Context,
+        const Modbus_Frame *const Frame);
+
+uint16_t Test_Read_Request(
+        uint8_t *const Adu,
+        uint8_t const Unit_ID);
+
+uint16_t Test_Write_Request(
+        uint8_t *const Adu,
+        uint16_t const Quantity);
+
+uint16_t Test_Read_Response(
+        uint8_t *const Adu,
+        uint8_t const Registers);
+
+uint64_t Test_Trickle(
+        const uint8_t *const Adu,
+        uint16_t const Length,
+        uint64_t const First_ns);
+
+Bool Test_Delivered(
+        const uint8_t *const Adu,
+        uint16_t const Length);
+
+void Test_Timing(
+        void);
+
+void Test_Lengths(
+        void);
+
+void Test_Prediction(
+        void);
+
+void Test_Gaps(
+        void);
+
+void Test_Silence(
+        void);
+
+void Test_Resync(
+        void);
+
+void Test_Monitor(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_RTU_Parser Parser;
+static Test_Sink Sink;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Deliver() is the Parser Callback.
+void Test_Deliver(
+        void *const Context,
+        const Modbus_Frame *const Frame) {
+
+    Test_Sink *const Target = Context;
+
+    Target->Frames++;
+    Target->Length = Frame->Length;
+    memcpy(Target->Adu, Frame->Adu, Frame->Length);
+}
+
+//!-  Test_Read_Request() builds a sealed FC03 Request.
+uint16_t Test_Read_Request(
+        uint8_t *const Adu,
+        uint8_t const Unit_ID) {
+
+    Modbus_Frame Frame;
+
+    Frame_Attach(&Frame, Adu, 0);
+    TEST_CHECK(Frame_Build_Read_Request(&Frame, Unit_ID, Fun_Code03,
+                                        0x0010, 2) == TRUE);
+    TEST_CHECK(Frame_Seal(&Frame) == TRUE);
+    return Frame.Length;
+}
+
+//!-  Test_Write_Request() builds a sealed FC16 Request.
+uint16_t Test_Write_Request(
+        uint8_t *const Adu,
+        uint16_t const Quantity) {
+
+    Modbus_Frame Frame;
+
+    memset(Adu, 0x5A, MODBUS_MAX_ADU_LENGTH);
+    Frame_Attach(&Frame, Adu, 0);
+    TEST_CHECK(Frame_Build_Write_Multiple(&Frame, 1, Fun_Code16,
+                                          0x0020, Quantity) == TRUE);
+    TEST_CHECK(Frame_Seal(&Frame) == TRUE);
+    return Frame.Length;
+}
+
+//!-  Test_Read_Response() builds a sealed FC03 Response.
+uint16_t Test_Read_Response(
+        uint8_t *const Adu,
+        uint8_t const Registers) {
+
+    Modbus_Frame Frame;
+    uint8_t Index = 0;
+
+    Frame_Attach(&Frame, Adu, 0);
+    TEST_CHECK(Frame_Build_Read_Response(&Frame, 1, Fun_Code03,
+                                         (uint8_t) (Registers * 2)) == TRUE);
+    for (Index = 0; Index < Registers; Index++) {
+        Frame_Set_Register(Frame_Rsp_Payload(&Frame), Index,
+                           (uint16_t) (0x1100 + Index));
+    }
+    TEST_CHECK(Frame_Seal(&Frame) == TRUE);
+    return Frame.Length;
+}
+
+/*
+ *!-  Test_Trickle() feeds an ADU one Byte per Character Time from
+ *!-  "First_ns" on, checking no Frame is delivered before its last
+ *!-  Byte. Returns when the last Byte arrived.
+ */
+uint64_t Test_Trickle(
+        const uint8_t *const Adu,
+        uint16_t const Length,
+        uint64_t const First_ns) {
+
+    uint32_t const Frames = Sink.Frames;
+    uint64_t Stamp_ns = First_ns;
+    uint16_t Index = 0;
+
+    for (Index = 0; Index < Length; Index++) {
+        Stamp_ns = First_ns + (Index * Parser.Char_ns);
+        if (Index + 1 < Length) {
+            TEST_CHECK(Modbus_RTU_Feed(&Parser, &Adu[Index], 1,
+                                       Stamp_ns) == 0);
+            TEST_CHECK(Sink.Frames == Frames);
+        }
+    }
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, &Adu[Length - 1], 1, Stamp_ns) == 1);
+    return Stamp_ns;
+}
+
+//!-  Test_Delivered() tells if the last Frame delivered was "Adu".
+Bool Test_Delivered(
+        const uint8_t *const Adu,
+        uint16_t const Length) {
+
+    return (Bool) ((Sink.Length == Length) &&
+                   (memcmp(Sink.Adu, Adu, Length) == 0));
+}
+
+//!-  Test_Timing() checks t1.5 and t3.5 for slow and fast Lines.
+void Test_Timing(
+        void) {
+
+    Modbus_RTU_Parser_Init(&Parser, TEST_BAUD, RTU_PARSE_REQUESTS,
+                           Test_Deliver, &Sink);
+    TEST_CHECK(Parser.Char_ns == ((RTU_BITS_PER_CHAR * NS_PER_S) / TEST_BAUD));
+    TEST_CHECK(Parser.T15_ns == ((Parser.Char_ns * 3) / 2));
+    TEST_CHECK(Parser.T35_ns == ((Parser.Char_ns * 7) / 2));
+
+    Modbus_RTU_Parser_Init(&Parser, TEST_FAST_BAUD, RTU_PARSE_REQUESTS,
+                           Test_Deliver, &Sink);
+    TEST_CHECK(Parser.T15_ns == RTU_FIXED_T15_NS);
+    TEST_CHECK(Parser.T35_ns == RTU_FIXED_T35_NS);
+}
+
+//!-  Test_Lengths() checks the Length Prediction from Headers.
+void Test_Lengths(
+        void) {
+
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint16_t Length = Test_Write_Request(Adu, 4);
+
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_REQUESTS, Adu, 1) ==
+               (RTU_LENGTH_NEED | FRAME_HEADER_LENGTH));
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_REQUESTS, Adu, 6) ==
+               (RTU_LENGTH_NEED | (FRAME_REQ_BYTE_COUNT_OFFSET + 1)));
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_REQUESTS, Adu, 7) == Length);
+    TEST_CHECK(Length == (9 + 8));
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_ANY, Adu, Length) ==
+               RTU_LENGTH_UNKNOWN);
+
+    Length = Test_Read_Request(Adu, 1);
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_REQUESTS, Adu, 2) == 8);
+
+    Length = Test_Read_Response(Adu, 3);
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_RESPONSES, Adu, 2) ==
+               (RTU_LENGTH_NEED | (FRAME_RSP_BYTE_COUNT_OFFSET + 1)));
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_RESPONSES, Adu, 3) ==
+               Length);
+    Adu[FRAME_FUNCTION_CODE_OFFSET] |= MSB1;
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_RESPONSES, Adu, 2) == 5);
+    Adu[FRAME_FUNCTION_CODE_OFFSET] = 0x2B;
+    TEST_CHECK(Modbus_RTU_Frame_Length(RTU_PARSE_REQUESTS, Adu, 2) ==
+               RTU_LENGTH_UNKNOWN);
+}
+
+/*
+ *!-  Test_Prediction() checks Frames are delivered on their last
+ *!-  Byte, without waiting for t3.5, in both Directions.
+ */
+void Test_Prediction(
+        void) {
+
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint16_t Length = 0;
+    uint64_t Last_ns = 0;
+
+    memset(&Sink, 0, sizeof(Sink));
+    Modbus_RTU_Parser_Init(&Parser, TEST_BAUD, RTU_PARSE_REQUESTS,
+                           Test_Deliver, &Sink);
+    Length = Test_Write_Request(Adu, 4);
+    Last_ns = Test_Trickle(Adu, Length, TEST_START_NS);
+    TEST_CHECK(Test_Delivered(Adu, Length) == TRUE);
+    TEST_CHECK(Modbus_RTU_Deadline(&Parser) == 0);
+
+    //!-  Back to back: one Chunk holding two Frames.
+    Length = Test_Read_Request(Adu, 7);
+    (void) Test_Read_Request(&Adu[Length], 8);
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Adu, 2 * Length,
+                               Last_ns + (10 * Parser.T35_ns)) == 2);
+    TEST_CHECK(Test_Delivered(&Adu[Length], Length) == TRUE);
+
+    memset(&Sink, 0, sizeof(Sink));
+    Modbus_RTU_Parser_Init(&Parser, TEST_BAUD, RTU_PARSE_RESPONSES,
+                           Test_Deliver, &Sink);
+    Length = Test_Read_Response(Adu, 3);
+    (void) Test_Trickle(Adu, Length, TEST_START_NS);
+    TEST_CHECK(Test_Delivered(Adu, Length) == TRUE);
+    TEST_CHECK(Parser.Stats.Frames == 1);
+    TEST_CHECK(Parser.Stats.CRC_Errors == 0);
+}
+
+/*
+ *!-  Test_Gaps() checks a Silence between t1.5 and t3.5 inside a
+ *!-  Frame: counted, and dropping the Frame when Strict.
+ */
+void Test_Gaps(
+        void) {
+
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint16_t const Length = Test_Read_Request(Adu, 1);
+    uint64_t Gap_ns = 0;
+
+    memset(&Sink, 0, sizeof(Sink));
+    Modbus_RTU_Parser_Init(&Parser, TEST_BAUD, RTU_PARSE_REQUESTS,
+                           Test_Deliver, &Sink);
+    Gap_ns = (Parser.T15_ns + Parser.T35_ns) / 2;
+
+    //!-  A Gap of up to t1.5 is fine.
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Adu, 3, TEST_START_NS) == 0);
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, &Adu[3], Length - 3,
+                               TEST_START_NS + Parser.T15_ns +
+                               ((Length - 3) * Parser.Char_ns)) == 1);
+    TEST_CHECK(Parser.Stats.Gap_Errors == 0);
+
+    //!-  Longer: counted, the Frame is still taken.
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Adu, 3, 2 * TEST_START_NS) == 0);
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, &Adu[3], Length - 3,
+                               (2 * TEST_START_NS) + Gap_ns +
+                               ((Length - 3) * Parser.Char_ns)) == 1);
+    TEST_CHECK(Parser.Stats.Gap_Errors == 1);
+    TEST_CHECK(Sink.Frames == 2);
+
+    //!-  Strict: the Frame is dropped as Noise at t3.5.
+    Parser.Strict = TRUE;
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Adu, 3, 3 * TEST_START_NS) == 0);
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, &Adu[3], Length - 3,
+                               (3 * TEST_START_NS) + Gap_ns +
+                               ((Length - 3) * Parser.Char_ns)) == 0);
+    TEST_CHECK(Parser.Stats.Gap_Errors == 2);
+    TEST_CHECK(Modbus_RTU_Poll(&Parser, Modbus_RTU_Deadline(&Parser)) == 0);
+    TEST_CHECK(Sink.Frames == 2);
+    TEST_CHECK(Parser.Stats.Noise_Bytes == Length);
+    TEST_CHECK(Modbus_RTU_Deadline(&Parser) == 0);
+}
+
+/*
+ *!-  Test_Silence() checks t3.5 ends a Frame: a Fragment followed
+ *!-  by Silence is dropped, and Frames of unknown Length are
+ *!-  delivered by Modbus_RTU_Poll() exactly at their Deadline.
+ */
+void Test_Silence(
+        void) {
+
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint16_t Length = Test_Read_Request(Adu, 1);
+    uint64_t Deadline_ns = 0;
+    Modbus_Frame Frame;
+
+    memset(&Sink, 0, sizeof(Sink));
+    Modbus_RTU_Parser_Init(&Parser, TEST_BAUD, RTU_PARSE_REQUESTS,
+                           Test_Deliver, &Sink);
+
+    //!-  The Fragment ends at t3.5, the next Frame starts clean.
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Adu, 3, TEST_START_NS) == 0);
+    TEST_CHECK(Modbus_RTU_Deadline(&Parser) ==
+               (TEST_START_NS + Parser.T35_ns));
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Adu, Length,
+                               TEST_START_NS + Parser.T35_ns +
+                               (Length * Parser.Char_ns)) == 1);
+    TEST_CHECK(Test_Delivered(Adu, Length) == TRUE);
+    TEST_CHECK(Parser.Stats.Noise_Bytes == 3);
+    TEST_CHECK(Parser.Stats.Gap_Errors == 0);
+
+    //!-  FC43 has no predictable Length: the Silence delivers it.
+    Adu[FRAME_FUNCTION_CODE_OFFSET] = 0x2B;
+    Adu[2] = 0x0E;
+    Adu[3] = 0x01;
+    Frame_Attach(&Frame, Adu, 4);
+    TEST_CHECK(Frame_Seal(&Frame) == TRUE);
+    Length = Frame.Length;
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Adu, Length, 2 * TEST_START_NS) == 0);
+    Deadline_ns = Modbus_RTU_Deadline(&Parser);
+    TEST_CHECK(Deadline_ns == ((2 * TEST_START_NS) + Parser.T35_ns));
+    TEST_CHECK(Modbus_RTU_Poll(&Parser, Deadline_ns - 1) == 0);
+    TEST_CHECK(Modbus_RTU_Poll(&Parser, Deadline_ns) == 1);
+    TEST_CHECK(Test_Delivered(Adu, Length) == TRUE);
+    TEST_CHECK(Sink.Frames == 2);
+}
+
+/*
+ *!-  Test_Resync() checks Noise in front of a Frame costs one CRC
+ *!-  Error and the Noise Bytes, and the Frame behind it is still
+ *!-  delivered on its last Byte; an endless Stream overruns.
+ */
+void Test_Resync(
+        void) {
+
+    uint8_t Stream[MODBUS_MAX_ADU_LENGTH + 64];
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint16_t const Length = Test_Read_Request(Adu, 1);
+
+    memset(&Sink, 0, sizeof(Sink));
+    Modbus_RTU_Parser_Init(&Parser, TEST_BAUD, RTU_PARSE_REQUESTS,
+                           Test_Deliver, &Sink);
+
+    //!-  One Byte of Noise: the first Header guess is wrong.
+    Stream[0] = 0x37;
+    memcpy(&Stream[1], Adu, Length);
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Stream, 1 + Length,
+                               TEST_START_NS) == 1);
+    TEST_CHECK(Test_Delivered(Adu, Length) == TRUE);
+    TEST_CHECK(Parser.Stats.CRC_Errors == 1);
+    TEST_CHECK(Parser.Stats.Resyncs == 1);
+    TEST_CHECK(Parser.Stats.Noise_Bytes == 1);
+    TEST_CHECK(Modbus_RTU_Deadline(&Parser) == 0);
+
+    //!-  A corrupted Frame, then a good one, without Silence.
+    memcpy(Stream, Adu, Length);
+    Stream[4] ^= 0x40;
+    memcpy(&Stream[Length], Adu, Length);
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Stream, 2 * Length,
+                               2 * TEST_START_NS) == 1);
+    TEST_CHECK(Test_Delivered(Adu, Length) == TRUE);
+    TEST_CHECK(Parser.Stats.CRC_Errors == 2);
+    TEST_CHECK(Sink.Frames == 2);
+
+    //!-  No Frame Start anywhere: the Buffer overruns.
+    memset(&Sink, 0, sizeof(Sink));
+    Modbus_RTU_Parser_Init(&Parser, TEST_BAUD, RTU_PARSE_REQUESTS,
+                           Test_Deliver, &Sink);
+    memset(Stream, 0, sizeof(Stream));
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Stream, sizeof(Stream),
+                               TEST_START_NS) == 0);
+    TEST_CHECK(Parser.Stats.Overruns == 1);
+    TEST_CHECK(Parser.Length < MODBUS_MAX_ADU_LENGTH);
+    TEST_CHECK(Sink.Frames == 0);
+}
+
+/*
+ *!-  Test_Monitor() checks a Bus Monitor, which frames by Silence
+ *!-  alone, and finds a Frame hidden behind Noise at t3.5.
+ */
+void Test_Monitor(
+        void) {
+
+    uint8_t Stream[MODBUS_MAX_ADU_LENGTH];
+    uint8_t Adu[MODBUS_MAX_ADU_LENGTH];
+    uint16_t const Length = Test_Read_Request(Adu, 1);
+
+    memset(&Sink, 0, sizeof(Sink));
+    Modbus_RTU_Parser_Init(&Parser, TEST_BAUD, RTU_PARSE_ANY,
+                           Test_Deliver, &Sink);
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Adu, Length, TEST_START_NS) == 0);
+    TEST_CHECK(Modbus_RTU_Poll(&Parser,
+                               TEST_START_NS + Parser.T35_ns) == 1);
+    TEST_CHECK(Test_Delivered(Adu, Length) == TRUE);
+
+    Stream[0] = 0xF8;
+    Stream[1] = 0x00;
+    memcpy(&Stream[2], Adu, Length);
+    TEST_CHECK(Modbus_RTU_Feed(&Parser, Stream, Length + 2,
+                               2 * TEST_START_NS) == 0);
+    TEST_CHECK(Modbus_RTU_Poll(&Parser,
+                               (2 * TEST_START_NS) + Parser.T35_ns) == 1);
+    TEST_CHECK(Test_Delivered(Adu, Length) == TRUE);
+    TEST_CHECK(Parser.Stats.CRC_Errors == 1);
+    TEST_CHECK(Parser.Stats.Resyncs == 1);
+    TEST_CHECK(Parser.Stats.Noise_Bytes == 2);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Feeds scripted Byte Streams with Arrival Times into the RTU
+ *!-  Parser and checks the Frames and Errors it reports: t1.5 and
+ *!-  t3.5 Silences, Length Prediction and Resynchronization.
+ */
+int main(void) {
+
+    Test_Timing();
+    Test_Lengths();
+    Test_Prediction();
+    Test_Gaps();
+    Test_Silence();
+    Test_Resync();
+    Test_Monitor();
+    return Test_Result("Test_RTU_Parser");
+}
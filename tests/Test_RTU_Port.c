@@ -0,0 +1,227 @@
+/*
+ * Test_RTU_Port.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_RTU_Port.c
+*****************************************************************************/
+
+//!-  Headers
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pty.h>
+#include "Modbus_Clock.h"
+#include "Modbus_Frame.h"
+#include "Modbus_RTU.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Line Settings of both Sides: fixed t1.5 / t3.5 above 19200.
+#define TEST_LINE          "115200,8E1"
+#define TEST_UNIT          (2)
+#define TEST_UNHOSTED      (9)
+#define TEST_REGISTERS     (16)
+#define TEST_TIMEOUT_MS    (100)
+#define TEST_DEADLINE_MS   (2000)
+
+//!-  "Test_Reply" is what the Client reported for one Request.
+typedef struct {
+    uint32_t   Calls;
+    uint8_t    Status;
+    Bool       Answered;
+    uint16_t   Values[TEST_REGISTERS];
+} Test_Reply;
+
+void Test_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status);
+
+Bool Test_Transact(
+        const Modbus_Frame *const Request,
+        Test_Reply *const Reply);
+
+Bool Test_Read(
+        uint8_t const Unit_ID,
+        uint16_t const Address,
+        uint16_t const Quantity,
+        Test_Reply *const Reply);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_RTU_Server Server;
+static Modbus_RTU_Client Client;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Response() notes the Result of a Transaction.
+void Test_Response(
+        void *const Context,
+        const Modbus_Frame *const Response,
+        uint8_t const Status) {
+
+    Test_Reply *const Reply = Context;
+    uint16_t Index = 0;
+
+    Reply->Calls++;
+    Reply->Status = Status;
+    Reply->Answered = (Bool) (Response != NULL);
+    if ((Status == MODBUS_NO_EXCEPTION) && (Response != NULL) &&
+        (Frame_Function_Code(Response) == Fun_Code03)) {
+        for (Index = 0;
+             (Index < TEST_REGISTERS) &&
+             ((Index * 2) < Frame_Rsp_Byte_Count(Response)); Index++) {
+            Reply->Values[Index] =
+                Frame_Register(Frame_Rsp_Payload(Response), Index);
+        }
+    }
+}
+
+/*
+ *!-  Test_Transact() sends a Request and runs both Ends of the
+ *!-  Line until the Client reported its Result.
+ */
+Bool Test_Transact(
+        const Modbus_Frame *const Request,
+        Test_Reply *const Reply) {
+
+    uint64_t const Deadline_ns = Modbus_Now_ns() +
+                                 (TEST_DEADLINE_MS * NS_PER_MS);
+    Bool Check_Ok = FALSE;
+
+    memset(Reply, 0, sizeof(Test_Reply));
+    Check_Ok = Modbus_RTU_Client_Submit(&Client, Request, Test_Response,
+                                        Reply);
+    while ((Check_Ok == TRUE) && (Reply->Calls == 0) &&
+           (Modbus_Now_ns() < Deadline_ns)) {
+        Check_Ok = (Bool) ((Modbus_RTU_Server_Poll(&Server, 0) >= 0) &&
+                           (Modbus_RTU_Client_Poll(&Client, 1) >= 0));
+    }
+    return (Bool) ((Check_Ok == TRUE) && (Reply->Calls == 1));
+}
+
+//!-  Test_Read() reads Holding Registers over the Line.
+Bool Test_Read(
+        uint8_t const Unit_ID,
+        uint16_t const Address,
+        uint16_t const Quantity,
+        Test_Reply *const Reply) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Request;
+
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Read_Request(&Request, Unit_ID, Fun_Code03,
+                                    Address, Quantity);
+    return Test_Transact(&Request, Reply);
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Runs an RTU Server and an RTU Client on the two Ends of a
+ *!-  Pseudo-Terminal, through termios, epoll and the timerfd
+ *!-  Pacing, and checks Round Trips, Exceptions, Broadcasts, the
+ *!-  Silence towards Units nobody hosts and the Line Statistics.
+ */
+int main(void) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    uint16_t Values[TEST_REGISTERS];
+    char Name[64];
+    char Spec[128];
+    Modbus_Frame Request;
+    Test_Reply Reply;
+    int Master_Fd = -1;
+    int Slave_Fd = -1;
+    uint16_t Index = 0;
+
+    TEST_CHECK(Modbus_Init() == TRUE);
+    TEST_CHECK(Modbus_Add_Unit(TEST_UNIT, 16, 16, TEST_REGISTERS,
+                               TEST_REGISTERS) != NULL);
+    //!-  The Slave End stays open, or the Master End reads EIO.
+    if ((TEST_CHECK(openpty(&Master_Fd, &Slave_Fd, Name, NULL,
+                            NULL) == 0) == FALSE) ||
+        (TEST_CHECK(Modbus_RTU_Server_Attach(&Server, Master_Fd,
+                                             TEST_LINE) == TRUE) == FALSE)) {
+        return Test_Result("Test_RTU_Port");
+    }
+    (void) snprintf(Spec, sizeof(Spec), "%s,%s", Name, TEST_LINE);
+    if (TEST_CHECK(Modbus_RTU_Client_Open(&Client, Spec) == TRUE) == FALSE) {
+        return Test_Result("Test_RTU_Port");
+    }
+    Client.Timeout_ns = TEST_TIMEOUT_MS * NS_PER_MS;
+    TEST_CHECK(Client.Port.Baud == 115200);
+    TEST_CHECK(Client.Port.Parser.T35_ns == RTU_FIXED_T35_NS);
+
+    //!-  FC16 Write, then the FC03 Read gives the Values back.
+    Frame_Attach(&Request, Buffer, 0);
+    TEST_CHECK(Frame_Build_Write_Multiple(&Request, TEST_UNIT, Fun_Code16,
+                                          4, 3) == TRUE);
+    for (Index = 0; Index < 3; Index++) {
+        Frame_Set_Register(Frame_Req_Payload(&Request), Index,
+                           (uint16_t) (0xA000 + Index));
+    }
+    TEST_CHECK(Test_Transact(&Request, &Reply) == TRUE);
+    TEST_CHECK(Reply.Status == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Modbus_Snapshot_Registers(MODBUS_UNITS[TEST_UNIT],
+                                         TABLE_HOLDING_REGISTERS, 4, 3,
+                                         Values) == TRUE);
+    TEST_CHECK(Values[0] == 0xA000);
+    TEST_CHECK(Values[2] == 0xA002);
+    TEST_CHECK(Test_Read(TEST_UNIT, 3, 5, &Reply) == TRUE);
+    TEST_CHECK(Reply.Status == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Reply.Values[0] == 0);
+    TEST_CHECK(Reply.Values[1] == 0xA000);
+    TEST_CHECK(Reply.Values[3] == 0xA002);
+    TEST_CHECK(Reply.Values[4] == 0);
+
+    //!-  An Exception comes back as its Status.
+    TEST_CHECK(Test_Read(TEST_UNIT, TEST_REGISTERS, 1, &Reply) == TRUE);
+    TEST_CHECK(Reply.Status == ILLEGAL_DATA_ADDRESS);
+    TEST_CHECK(Reply.Answered == TRUE);
+
+    //!-  Units nobody hosts stay silent on a Serial Line.
+    TEST_CHECK(Test_Read(TEST_UNHOSTED, 0, 1, &Reply) == TRUE);
+    TEST_CHECK(Reply.Status == TARGET_DEVICE_FAILED_TO_RESPOND);
+    TEST_CHECK(Reply.Answered == FALSE);
+    TEST_CHECK(Client.Timeouts == 1);
+
+    //!-  A Broadcast completes on the Wire and is executed.
+    Frame_Attach(&Request, Buffer, 0);
+    TEST_CHECK(Frame_Build_Write_Single(&Request, BROADCAST, Fun_Code06,
+                                        0, 0x1234) == TRUE);
+    TEST_CHECK(Test_Transact(&Request, &Reply) == TRUE);
+    TEST_CHECK(Reply.Status == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Reply.Answered == FALSE);
+    TEST_CHECK(Test_Read(TEST_UNIT, 0, 1, &Reply) == TRUE);
+    TEST_CHECK(Reply.Values[0] == 0x1234);
+    TEST_CHECK(Get_Single_Holding_Register(1) == 0x1234);
+
+    //!-  Every Frame was clean and every Turnaround was timed.
+    TEST_CHECK(Server.Requests_Served == 6);
+    TEST_CHECK(Server.Port.Parser.Stats.Frames == 6);
+    TEST_CHECK(Server.Port.Parser.Stats.CRC_Errors == 0);
+    TEST_CHECK(Client.Port.Parser.Stats.CRC_Errors == 0);
+    TEST_CHECK(Client.Completed == 5);
+    TEST_CHECK(Server.Port.Turnaround.Count == 4);
+    TEST_CHECK(Client.Port.Reply.Count == 4);
+
+    Modbus_RTU_Client_Close(&Client);
+    Modbus_RTU_Server_Close(&Server);
+    (void) close(Slave_Fd);
+    return Test_Result("Test_RTU_Port");
+}
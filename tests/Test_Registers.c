@@ -0,0 +1,361 @@
+/*
+ * Test_Registers.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Registers.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include "Modbus_Dispatch.h"
+#include "Modbus_Frame.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define TEST_UNIT         (2)
+//!-  Holding Registers 0 .. 1023 hold their Address at first; then
+//!-  a Hole, and TEST_FAR_COUNT more from TEST_FAR_START on.
+#define TEST_REGISTERS    (1024)
+#define TEST_FAR_START    (2048)
+#define TEST_FAR_COUNT    (16)
+//!-  Value FC23 writes to the "n"th Register of its Write Range.
+#define TEST_WRITE_BASE   (0x5000)
+
+uint8_t Test_Serve(
+        Modbus_Frame *const Request,
+        Modbus_Frame *const Response);
+
+uint16_t Test_Register(
+        uint16_t const Address);
+
+uint16_t Test_Mask(
+        uint16_t const Address,
+        uint16_t const Current,
+        uint16_t const And_Mask,
+        uint16_t const Or_Mask);
+
+uint8_t Test_Read_Write(
+        uint16_t const Read_Address,
+        uint16_t const Read_Quantity,
+        uint16_t const Write_Address,
+        uint16_t const Write_Quantity,
+        Modbus_Frame *const Response);
+
+Bool Test_Read_Back(
+        const Modbus_Frame *const Response,
+        uint16_t const Read_Address,
+        uint16_t const Write_Address,
+        uint16_t const Write_Quantity);
+
+void Test_Mask_Write(
+        void);
+
+void Test_Spans(
+        void);
+
+void Test_Exceptions(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_Data *Unit;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Serve() serves a Request and returns its Exception Code.
+uint8_t Test_Serve(
+        Modbus_Frame *const Request,
+        Modbus_Frame *const Response) {
+
+    uint8_t Exception = MODBUS_NO_EXCEPTION;
+
+    TEST_CHECK(Modbus_Response(Request, Response) == TRUE);
+    if (Frame_Is_Exception(Response) == TRUE) {
+        Exception = Frame_Exception_Code(Response);
+    }
+    return Exception;
+}
+
+//!-  Test_Register() reads one Holding Register from the Database.
+uint16_t Test_Register(
+        uint16_t const Address) {
+
+    uint8_t BeOut[2] = { 0, 0 };
+
+    TEST_CHECK(Read_Registers(Unit, TABLE_HOLDING_REGISTERS, Address, 1,
+                              BeOut) == TRUE);
+    return Frame_Get_U16(BeOut);
+}
+
+/*
+ *!-  Test_Mask() writes "Current" with FC06, masks it with FC22,
+ *!-  checks the Echo and returns what the Register holds then.
+ */
+uint16_t Test_Mask(
+        uint16_t const Address,
+        uint16_t const Current,
+        uint16_t const And_Mask,
+        uint16_t const Or_Mask) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    uint8_t Answer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Request;
+    Modbus_Frame Response;
+
+    Frame_Attach(&Request, Buffer, 0);
+    Frame_Attach(&Response, Answer, 0);
+    (void) Frame_Build_Write_Single(&Request, TEST_UNIT, Fun_Code06,
+                                    Address, Current);
+    TEST_CHECK(Test_Serve(&Request, &Response) == MODBUS_NO_EXCEPTION);
+    (void) Frame_Build_Mask_Write(&Request, TEST_UNIT, Address, And_Mask,
+                                  Or_Mask);
+    TEST_CHECK(Test_Serve(&Request, &Response) == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Response.Length == FRAME_MASK_WRITE_LENGTH);
+    TEST_CHECK(memcmp(Response.Adu, Request.Adu,
+                      FRAME_MASK_WRITE_LENGTH) == 0);
+    return Test_Register(Address);
+}
+
+/*
+ *!-  Test_Read_Write() serves an FC23 Request that writes
+ *!-  TEST_WRITE_BASE + n to the "n"th Register of its Write Range.
+ */
+uint8_t Test_Read_Write(
+        uint16_t const Read_Address,
+        uint16_t const Read_Quantity,
+        uint16_t const Write_Address,
+        uint16_t const Write_Quantity,
+        Modbus_Frame *const Response) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Request;
+    uint16_t Index = 0;
+
+    Frame_Attach(&Request, Buffer, 0);
+    TEST_CHECK(Frame_Build_Read_Write(&Request, TEST_UNIT, Read_Address,
+                                      Read_Quantity, Write_Address,
+                                      Write_Quantity) == TRUE);
+    for (Index = 0; Index < Write_Quantity; Index++) {
+        Frame_Set_Register(Frame_RW_Payload(&Request), Index,
+                           (uint16_t) (TEST_WRITE_BASE + Index));
+    }
+    return Test_Serve(&Request, Response);
+}
+
+/*
+ *!-  Test_Read_Back() checks an FC23 Response read the Values the
+ *!-  same Request wrote where the Ranges overlap, and the first
+ *!-  Values (the Addresses) elsewhere.
+ */
+Bool Test_Read_Back(
+        const Modbus_Frame *const Response,
+        uint16_t const Read_Address,
+        uint16_t const Write_Address,
+        uint16_t const Write_Quantity) {
+
+    uint16_t const Count = (uint16_t) (Frame_Rsp_Byte_Count(Response) / 2);
+    Bool Check_Ok = TRUE;
+    uint16_t Address = 0;
+    uint16_t Expected = 0;
+    uint16_t Index = 0;
+
+    for (Index = 0; (Check_Ok == TRUE) && (Index < Count); Index++) {
+        Address = (uint16_t) (Read_Address + Index);
+        Expected = Address;
+        if ((Address >= Write_Address) &&
+            (Address < (Write_Address + Write_Quantity))) {
+            Expected = (uint16_t) (TEST_WRITE_BASE + Address - Write_Address);
+        }
+        Check_Ok = TEST_CHECK(
+            Frame_Register(Frame_Rsp_Payload(Response), Index) == Expected);
+    }
+    return Check_Ok;
+}
+
+//!-  Test_Mask_Write() checks (Current AND And) OR (Or AND NOT And).
+void Test_Mask_Write(
+        void) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    uint8_t Answer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Request;
+    Modbus_Frame Response;
+
+    //!-  The Example of the Specification, then the Extremes.
+    TEST_CHECK(Test_Mask(4, 0x0012, 0x00F2, 0x0025) == 0x0017);
+    TEST_CHECK(Test_Mask(4, 0xABCD, 0xFFFF, 0x1234) == 0xABCD);
+    TEST_CHECK(Test_Mask(4, 0xABCD, 0x0000, 0xBEEF) == 0xBEEF);
+    TEST_CHECK(Test_Mask(4, 0xABCD, 0xFF00, 0x00FF) == 0xABFF);
+    TEST_CHECK(Test_Mask(4, 0xABCD, 0x0F0F, 0xFFFF) == 0xFBFD);
+    TEST_CHECK(Test_Mask(TEST_FAR_START + 1, 0x8001, 0x8000, 0x0000) ==
+               0x8000);
+    TEST_CHECK(Test_Register(5) == 5);
+
+    //!-  Outside the Registers, or without the Or Mask.
+    Frame_Attach(&Request, Buffer, 0);
+    Frame_Attach(&Response, Answer, 0);
+    (void) Frame_Build_Mask_Write(&Request, TEST_UNIT, TEST_REGISTERS,
+                                  0, 0);
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_ADDRESS);
+    (void) Frame_Build_Mask_Write(&Request, TEST_UNIT, 4, 0, 0);
+    Request.Length = FRAME_MASK_WRITE_LENGTH - 1;
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_VALUE);
+    TEST_CHECK(Test_Register(4) == 0xFBFD);
+}
+
+/*
+ *!-  Test_Spans() checks that FC23 writes before it reads, for
+ *!-  Ranges overlapping in a Page and across Pages, on adjacent
+ *!-  Pages, on distant Pages in either Order, and across the Hole.
+ */
+void Test_Spans(
+        void) {
+
+    uint8_t Answer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Response;
+
+    Frame_Attach(&Response, Answer, 0);
+    TEST_CHECK(Test_Read_Write(8, 8, 10, 5, &Response) ==
+               MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Frame_Rsp_Byte_Count(&Response) == 16);
+    TEST_CHECK(Test_Read_Back(&Response, 8, 10, 5) == TRUE);
+
+    TEST_CHECK(Test_Read_Write(REGISTER_PAGE_SIZE - 6, 12,
+                               REGISTER_PAGE_SIZE - 2, 5, &Response) ==
+               MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Test_Read_Back(&Response, REGISTER_PAGE_SIZE - 6,
+                              REGISTER_PAGE_SIZE - 2, 5) == TRUE);
+
+    //!-  Pages 1 and 2 touch, so they are locked as one Span.
+    TEST_CHECK(Test_Read_Write(2 * REGISTER_PAGE_SIZE, 4,
+                               (2 * REGISTER_PAGE_SIZE) - 12, 12,
+                               &Response) == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Test_Read_Back(&Response, 2 * REGISTER_PAGE_SIZE,
+                              (2 * REGISTER_PAGE_SIZE) - 12, 12) == TRUE);
+    TEST_CHECK(Test_Register((2 * REGISTER_PAGE_SIZE) - 1) ==
+               (TEST_WRITE_BASE + 11));
+
+    //!-  The Read Range below the Write Range, Pages apart.
+    TEST_CHECK(Test_Read_Write(0, 3, 3 * REGISTER_PAGE_SIZE, 3,
+                               &Response) == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Test_Read_Back(&Response, 0, 3 * REGISTER_PAGE_SIZE,
+                              3) == TRUE);
+    TEST_CHECK(Test_Register((3 * REGISTER_PAGE_SIZE) + 2) ==
+               (TEST_WRITE_BASE + 2));
+    TEST_CHECK(Test_Register((3 * REGISTER_PAGE_SIZE) + 3) ==
+               ((3 * REGISTER_PAGE_SIZE) + 3));
+
+    TEST_CHECK(Test_Read_Write(TEST_FAR_START, 2, 20, 2, &Response) ==
+               MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Frame_Register(Frame_Rsp_Payload(&Response), 0) == 0);
+    TEST_CHECK(Frame_Register(Frame_Rsp_Payload(&Response), 1) ==
+               0x8000);
+    TEST_CHECK(Test_Register(21) == (TEST_WRITE_BASE + 1));
+}
+
+/*
+ *!-  Test_Exceptions() checks FC23 refuses bad Quantities and Byte
+ *!-  Counts with ILLEGAL_DATA_VALUE before it looks at either Range,
+ *!-  refuses Ranges outside the Registers with ILLEGAL_DATA_ADDRESS,
+ *!-  and writes nothing when it refuses.
+ */
+void Test_Exceptions(
+        void) {
+
+    uint8_t Buffer[MODBUS_MAX_ADU_LENGTH];
+    uint8_t Answer[MODBUS_MAX_ADU_LENGTH];
+    Modbus_Frame Request;
+    Modbus_Frame Response;
+
+    Frame_Attach(&Request, Buffer, 0);
+    Frame_Attach(&Response, Answer, 0);
+
+    //!-  Write Quantity 0, one too many, and not twice the Byte Count.
+    (void) Frame_Build_Read_Write(&Request, TEST_UNIT, 0, 1, 30, 1);
+    Frame_Put_U16(&Request.Adu[FRAME_RW_QUANTITY_OFFSET], 0);
+    Request.Adu[FRAME_RW_BYTE_COUNT_OFFSET] = 0;
+    Request.Length = FRAME_RW_PAYLOAD_OFFSET;
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_VALUE);
+    (void) Frame_Build_Read_Write(&Request, TEST_UNIT, 0, 1, 30,
+                                  MAXRWWRITEREGQUANTITY);
+    Frame_Put_U16(&Request.Adu[FRAME_RW_QUANTITY_OFFSET],
+                  MAXRWWRITEREGQUANTITY + 1);
+    Request.Adu[FRAME_RW_BYTE_COUNT_OFFSET] =
+        (uint8_t) ((MAXRWWRITEREGQUANTITY + 1) * 2);
+    Request.Length = FRAME_RW_PAYLOAD_OFFSET +
+                     ((MAXRWWRITEREGQUANTITY + 1) * 2);
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_VALUE);
+    (void) Frame_Build_Read_Write(&Request, TEST_UNIT, 0, 1, 30, 2);
+    Request.Adu[FRAME_RW_BYTE_COUNT_OFFSET] = 2;
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_VALUE);
+
+    //!-  A Byte Count past the End of the Request.
+    (void) Frame_Build_Read_Write(&Request, TEST_UNIT, 0, 1, 30, 2);
+    Request.Length--;
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_VALUE);
+
+    //!-  Read Quantity 0 and one too many, and before the Range.
+    (void) Frame_Build_Read_Write(&Request, TEST_UNIT, 0, 1, 30, 1);
+    Frame_Put_U16(&Request.Adu[FRAME_QUANTITY_OFFSET], 0);
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_VALUE);
+    Frame_Put_U16(&Request.Adu[FRAME_QUANTITY_OFFSET],
+                  MAXREADREGQUANTITY + 1);
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_VALUE);
+    (void) Frame_Build_Read_Write(&Request, TEST_UNIT, TEST_REGISTERS, 1,
+                                  TEST_REGISTERS, 1);
+    Frame_Put_U16(&Request.Adu[FRAME_RW_QUANTITY_OFFSET], 0);
+    TEST_CHECK(Test_Serve(&Request, &Response) == ILLEGAL_DATA_VALUE);
+
+    //!-  Either Range in the Hole: nothing is written.
+    TEST_CHECK(Test_Read_Write(TEST_REGISTERS - 4, 8, 30, 2, &Response) ==
+               ILLEGAL_DATA_ADDRESS);
+    TEST_CHECK(Test_Read_Write(0, 1, TEST_FAR_START - 1, 2, &Response) ==
+               ILLEGAL_DATA_ADDRESS);
+    TEST_CHECK(Test_Read_Write(0, 1, TEST_REGISTERS - 1, 2, &Response) ==
+               ILLEGAL_DATA_ADDRESS);
+    TEST_CHECK(Test_Register(30) == 30);
+    TEST_CHECK(Test_Register(TEST_REGISTERS - 1) == (TEST_REGISTERS - 1));
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks FC22 and FC23 through the Dispatcher: the Mask Formula,
+ *!-  FC23 Spans that overlap or touch across Pages, and the Order
+ *!-  and Kind of the Exceptions both refuse Requests with.
+ */
+int main(void) {
+
+    static uint8_t BeIn[TEST_REGISTERS * 2];
+    uint32_t Index = 0;
+
+    TEST_CHECK(Modbus_Init() == TRUE);
+    Unit = Modbus_Add_Unit(TEST_UNIT, 16, 16, 16, TEST_REGISTERS);
+    for (Index = 0; Index < TEST_REGISTERS; Index++) {
+        Frame_Put_U16(&BeIn[Index * 2], (uint16_t) Index);
+    }
+    if ((TEST_CHECK(Unit != NULL) == TRUE) &&
+        (TEST_CHECK(Modbus_Map_Registers(Unit, TABLE_HOLDING_REGISTERS,
+                                         TEST_FAR_START,
+                                         TEST_FAR_COUNT) == TRUE) == TRUE) &&
+        (TEST_CHECK(Write_Registers(Unit, TABLE_HOLDING_REGISTERS, 0,
+                                    TEST_REGISTERS, BeIn) == TRUE) == TRUE)) {
+        Test_Mask_Write();
+        Test_Spans();
+        Test_Exceptions();
+    }
+    return Test_Result("Test_Registers");
+}
@@ -0,0 +1,318 @@
+/*
+ * Test_TCP_Client.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_TCP_Client.c
+*****************************************************************************/
+
+//!-  Headers
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "Modbus_Clock.h"
+#include "Modbus_Frame.h"
+#include "Modbus_TCP.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+//!-  Requests kept in Flight; the Server holds them all open.
+#define TEST_WINDOW          (6)
+//!-  Address of the Request the Server never answers in Time.
+#define TEST_LOST_ADDRESS    (3)
+#define TEST_TIMEOUT_MS      (200)
+#define TEST_DEADLINE_MS     (3000)
+//!-  Value the Server answers for Register "n": n + TEST_VALUE_BASE.
+#define TEST_VALUE_BASE      (0x100)
+//!-  Socket Buffers of the stalled Peer, so the Tx Buffer fills soon.
+#define TEST_SOCKET_BUFFER   (4096)
+//!-  Submits after which the Tx Buffer must have refused one.
+#define TEST_STALL_SUBMITS   (100000)
+
+//!-  "Test_Forwarded" is a Request the Server holds to answer later.
+typedef struct {
+    TCP_Connection  *Conn;
+    uint32_t         Generation;
+    uint16_t         Transaction_ID;
+    uint8_t          Unit_ID;
+    uint16_t         Address;
+} Test_Forwarded;
+
+void Test_Forward(
+        void *const Context,
+        TCP_Connection *const Conn,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Request);
+
+void Test_Answer(
+        const Test_Forwarded *const Forwarded);
+
+void Test_Pump(
+        uint64_t const Completed,
+        uint32_t const Forwarded,
+        uint32_t const Wait_Ms);
+
+void Test_Stalled_Peer(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+static Modbus_TCP_Server Server;
+static Modbus_TCP_Client Client;
+static Modbus_TCP_Client Stalled;
+static Test_Forwarded Forwarded[TEST_WINDOW + 1];
+static uint32_t Forwarded_Count;
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+//!-  Test_Forward() holds every forwarded Request for Test_Answer().
+void Test_Forward(
+        void *const Context,
+        TCP_Connection *const Conn,
+        uint16_t const Transaction_ID,
+        const Modbus_Frame *const Request) {
+
+    (void) Context;
+    if (TEST_CHECK(Forwarded_Count < (TEST_WINDOW + 1)) == TRUE) {
+        Forwarded[Forwarded_Count].Conn = Conn;
+        Forwarded[Forwarded_Count].Generation = Conn->Generation;
+        Forwarded[Forwarded_Count].Transaction_ID = Transaction_ID;
+        Forwarded[Forwarded_Count].Unit_ID = Frame_Device_ID(Request);
+        Forwarded[Forwarded_Count].Address = Frame_Address(Request);
+        Forwarded_Count++;
+    }
+}
+
+//!-  Test_Answer() answers a held Request with one Register.
+void Test_Answer(
+        const Test_Forwarded *const Forwarded) {
+
+    uint8_t Buffer[MODBUS_MAX_PDU_LENGTH + 1];
+    Modbus_Frame Response;
+
+    Frame_Attach(&Response, Buffer, 0);
+    (void) Frame_Build_Read_Response(&Response, Forwarded->Unit_ID,
+                                     Fun_Code03, 2);
+    Frame_Set_Register(Frame_Rsp_Payload(&Response), 0,
+                       (uint16_t) (Forwarded->Address + TEST_VALUE_BASE));
+    TEST_CHECK(Modbus_TCP_Server_Reply(&Server, Forwarded->Conn,
+                                       Forwarded->Generation,
+                                       Forwarded->Transaction_ID,
+                                       &Response) == TRUE);
+}
+
+/*
+ *!-  Test_Pump() runs Server and Client until the Client has
+ *!-  "Completed" Results (Answers and Timeouts) and the Server
+ *!-  holds "Forwarded" Requests, or "Wait_Ms" passed. With
+ *!-  neither given it runs them for "Wait_Ms".
+ */
+void Test_Pump(
+        uint64_t const Completed,
+        uint32_t const Forwarded,
+        uint32_t const Wait_Ms) {
+
+    uint64_t const Deadline_ns = Modbus_Now_ns() + (Wait_Ms * NS_PER_MS);
+
+    while (((Client.Completed + Client.Timeouts) < Completed) ||
+           (Forwarded_Count < Forwarded) ||
+           ((Completed == 0) && (Forwarded == 0))) {
+        if (Modbus_Now_ns() >= Deadline_ns) {
+            break;
+        }
+        (void) Modbus_TCP_Server_Poll(&Server, 0);
+        (void) Modbus_TCP_Client_Poll(&Client, 1);
+    }
+}
+
+/*
+ *!-  Test_Stalled_Peer() submits to a Peer that never reads, with
+ *!-  every Request timed out at once, so only the Tx Buffer holds
+ *!-  them back: Submit must refuse once it is full, not overrun it.
+ */
+void Test_Stalled_Peer(
+        void) {
+
+    uint8_t Buffer[MODBUS_MAX_PDU_LENGTH + 1];
+    int Size = TEST_SOCKET_BUFFER;
+    int Listen_Fd = -1;
+    struct sockaddr_in Address;
+    socklen_t Length = sizeof(Address);
+    Modbus_Frame Request;
+    uint32_t Submits = 0;
+    Bool Refused = FALSE;
+
+    memset(&Address, 0, sizeof(Address));
+    Address.sin_family = AF_INET;
+    Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    Listen_Fd = socket(AF_INET, SOCK_STREAM, 0);
+    //!-  Never accepted: the Kernel completes the Connection alone.
+    if ((TEST_CHECK(Listen_Fd >= 0) == FALSE) ||
+        (TEST_CHECK(setsockopt(Listen_Fd, SOL_SOCKET, SO_RCVBUF, &Size,
+                               sizeof(Size)) == 0) == FALSE) ||
+        (TEST_CHECK(bind(Listen_Fd, (struct sockaddr *) &Address,
+                         sizeof(Address)) == 0) == FALSE) ||
+        (TEST_CHECK(listen(Listen_Fd, 1) == 0) == FALSE) ||
+        (TEST_CHECK(getsockname(Listen_Fd, (struct sockaddr *) &Address,
+                                &Length) == 0) == FALSE) ||
+        (TEST_CHECK(Modbus_TCP_Client_Connect(
+                        &Stalled, "127.0.0.1", ntohs(Address.sin_port),
+                        TCP_CLIENT_MAX_WINDOW) == TRUE) == FALSE)) {
+        Submits = TEST_STALL_SUBMITS;
+    }
+    else {
+        (void) setsockopt(Stalled.Fd, SOL_SOCKET, SO_SNDBUF, &Size,
+                          sizeof(Size));
+        Stalled.Timeout_ns = 0;
+    }
+
+    Frame_Attach(&Request, Buffer, 0);
+    (void) Frame_Build_Read_Request(&Request, 1, Fun_Code03, 0, 1);
+    //!-  Stops at the first Overrun, before it corrupts more.
+    while ((Refused == FALSE) && (Submits < TEST_STALL_SUBMITS) &&
+           (TEST_CHECK((Stalled.Tx_Head + Stalled.Tx_Length) <=
+                       TCP_CLIENT_TX_BUFFER) == TRUE)) {
+        if (Modbus_TCP_Client_Submit(&Stalled, &Request, NULL,
+                                     NULL) == TRUE) {
+            Submits++;
+        }
+        else if (Stalled.In_Flight < Stalled.Window) {
+            Refused = TRUE;
+        }
+        else {
+            (void) Modbus_TCP_Client_Poll(&Stalled, 0);
+        }
+    }
+    TEST_CHECK(Refused == TRUE);
+    TEST_CHECK(Stalled.Fd >= 0);
+    TEST_CHECK((Stalled.Tx_Length + MBAP_HEADER_LENGTH + Request.Length) >
+               TCP_CLIENT_TX_BUFFER);
+
+    Modbus_TCP_Client_Close(&Stalled);
+    if (Listen_Fd >= 0) {
+        (void) close(Listen_Fd);
+    }
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Pipelines Requests to an epoll Server on an ephemeral Loopback
+ *!-  Port that answers them in reverse Order and lets one time
+ *!-  out, then checks the Client matched every Answer by its
+ *!-  Transaction ID, kept to its Window, failed the lost Request
+ *!-  once and ignored its late Answer. Last it checks the Unit
+ *!-  ID Rules of a Server answering from MODBUS_UNITS.
+ */
+int main(void) {
+
+    struct sockaddr_in Address;
+    socklen_t Length = sizeof(Address);
+    Test_Client_Reply Replies[TEST_WINDOW + 1];
+    Test_Client_Reply Extra;
+    uint16_t Port = 0;
+    int32_t Index = 0;
+
+    TEST_CHECK(Modbus_Init() == TRUE);
+    TEST_CHECK(Modbus_Add_Unit(2, 16, 16, 16, 16) != NULL);
+    if ((TEST_CHECK(Modbus_TCP_Server_Open(&Server, 0) == TRUE) == FALSE) ||
+        (TEST_CHECK(getsockname(Server.Listen_Fd, (struct sockaddr *) &Address,
+                                &Length) == 0) == FALSE)) {
+        return Test_Result("Test_TCP_Client");
+    }
+    Port = ntohs(Address.sin_port);
+    Modbus_TCP_Server_Forward(&Server, Test_Forward, NULL);
+    if (TEST_CHECK(Modbus_TCP_Client_Connect(&Client, "127.0.0.1", Port,
+                                             TEST_WINDOW) == TRUE) == FALSE) {
+        return Test_Result("Test_TCP_Client");
+    }
+    Client.Timeout_ns = TEST_TIMEOUT_MS * NS_PER_MS;
+
+    //!-  A full Window, then no more.
+    for (Index = 0; Index < TEST_WINDOW; Index++) {
+        TEST_CHECK(Test_Client_Read(&Client, 1, (uint16_t) Index,
+                                    &Replies[Index]) == TRUE);
+    }
+    TEST_CHECK(Test_Client_Read(&Client, 1, TEST_WINDOW, &Extra) == FALSE);
+    TEST_CHECK(Client.In_Flight == TEST_WINDOW);
+    Test_Pump(0, TEST_WINDOW, TEST_DEADLINE_MS);
+    TEST_CHECK(Forwarded_Count == TEST_WINDOW);
+
+    //!-  Answer in reverse Order, all but the lost Request.
+    for (Index = (int32_t) Forwarded_Count - 1; Index >= 0; Index--) {
+        if (Forwarded[Index].Address != TEST_LOST_ADDRESS) {
+            Test_Answer(&Forwarded[Index]);
+        }
+    }
+    Test_Pump(TEST_WINDOW, TEST_WINDOW, TEST_DEADLINE_MS);
+    TEST_CHECK(Client.Completed == (TEST_WINDOW - 1));
+    TEST_CHECK(Client.Timeouts == 1);
+    TEST_CHECK(Client.In_Flight == 0);
+    for (Index = 0; Index < TEST_WINDOW; Index++) {
+        TEST_CHECK(Replies[Index].Calls == 1);
+        TEST_CHECK(Replies[Index].Answered == (Index != TEST_LOST_ADDRESS));
+        if (Index == TEST_LOST_ADDRESS) {
+            TEST_CHECK(Replies[Index].Status ==
+                       TARGET_DEVICE_FAILED_TO_RESPOND);
+            TEST_CHECK(Replies[Index].Order == (TEST_WINDOW - 1));
+        }
+        else {
+            TEST_CHECK(Replies[Index].Status == MODBUS_NO_EXCEPTION);
+            TEST_CHECK(Replies[Index].Value == (Index + TEST_VALUE_BASE));
+            TEST_CHECK(Replies[Index].Order ==
+                       (uint32_t) (TEST_WINDOW - 1 - Index -
+                                   ((Index < TEST_LOST_ADDRESS) ? 1 : 0)));
+        }
+    }
+
+    //!-  The late Answer matches no Transaction any more.
+    Test_Answer(&Forwarded[TEST_LOST_ADDRESS]);
+    Test_Pump(0, 0, TEST_TIMEOUT_MS / 2);
+    TEST_CHECK(Replies[TEST_LOST_ADDRESS].Calls == 1);
+    TEST_CHECK(Client.Completed == (TEST_WINDOW - 1));
+
+    //!-  The Connection keeps working after it.
+    TEST_CHECK(Test_Client_Read(&Client, 1, TEST_WINDOW,
+                                &Replies[TEST_WINDOW]) == TRUE);
+    Test_Pump(0, TEST_WINDOW + 1, TEST_DEADLINE_MS);
+    if (TEST_CHECK(Forwarded_Count == (TEST_WINDOW + 1)) == TRUE) {
+        Test_Answer(&Forwarded[TEST_WINDOW]);
+    }
+    Test_Pump(TEST_WINDOW + 1, 0, TEST_DEADLINE_MS);
+    TEST_CHECK(Replies[TEST_WINDOW].Calls == 1);
+    TEST_CHECK(Replies[TEST_WINDOW].Value ==
+               (TEST_WINDOW + TEST_VALUE_BASE));
+
+    //!-  From MODBUS_UNITS: 0xFF is the Default Unit, 9 is not hosted.
+    Modbus_TCP_Server_Forward(&Server, NULL, NULL);
+    TEST_CHECK(Test_Client_Read(&Client, TCP_SERVER_UNIT, 0,
+                                &Replies[0]) == TRUE);
+    TEST_CHECK(Test_Client_Read(&Client, 2, 1, &Replies[1]) == TRUE);
+    TEST_CHECK(Test_Client_Read(&Client, 9, 0, &Replies[2]) == TRUE);
+    Test_Pump(TEST_WINDOW + 4, 0, TEST_DEADLINE_MS);
+    TEST_CHECK(Replies[0].Status == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Replies[1].Status == MODBUS_NO_EXCEPTION);
+    TEST_CHECK(Replies[2].Status == GATEWAY_PATH_UNAVAILABLE);
+    TEST_CHECK(Replies[2].Answered == TRUE);
+    TEST_CHECK(Client.Timeouts == 1);
+
+    //!-  A Peer that never reads gets no more than the Tx Buffer.
+    Test_Stalled_Peer();
+
+    Modbus_TCP_Client_Close(&Client);
+    Modbus_TCP_Server_Close(&Server);
+    return Test_Result("Test_TCP_Client");
+}
@@ -0,0 +1,320 @@
+/*
+ * Test_Tags.c
+ *
+ *  Created on: 18-Oct-2026
+ *      Author: root
+ */
+
+/****************************************************************************
+!-  File Name: Test_Tags.c
+*****************************************************************************/
+
+//!-  Headers
+#include <math.h>
+#include <string.h>
+#include "Modbus_Swap.h"
+#include "Modbus_Tags.h"
+#include "Modbus_Test.h"
+
+/****************************************************************************
+!-  LOCAL DEFINITIONS
+*****************************************************************************/
+
+#define TEST_ORDERS        (4)
+#define TEST_ENGINES       (3)
+//!-  Bytes Swap_Elements() is checked on: below, at and past the
+//!-  16- and 64-Byte Steps of the Kernels.
+#define TEST_SWAP_BYTES    (200)
+//!-  Registers of the Payload Tags are decoded from, read at TEST_FIRST.
+#define TEST_FIRST         (100)
+#define TEST_QUANTITY      (20)
+
+void Test_Orders(
+        void);
+
+void Test_Tags(
+        void);
+
+void Test_Saturation(
+        void);
+
+Bool Test_Engine(
+        void);
+
+void Test_Kernels(
+        void);
+
+/****************************************************************************
+!-  LOCAL VARIABLES
+*****************************************************************************/
+
+/*
+ *!-  Wire Bytes of 0x1234, 0x11223344 and 0x1122334455667788 in
+ *!-  every Word Order, by Modbus_Word_Order.
+ */
+static const uint8_t Wire16[TEST_ORDERS][2] = {
+    { 0x12, 0x34 }, { 0x12, 0x34 }, { 0x34, 0x12 }, { 0x34, 0x12 },
+};
+static const uint8_t Wire32[TEST_ORDERS][4] = {
+    { 0x11, 0x22, 0x33, 0x44 }, { 0x33, 0x44, 0x11, 0x22 },
+    { 0x22, 0x11, 0x44, 0x33 }, { 0x44, 0x33, 0x22, 0x11 },
+};
+static const uint8_t Wire64[TEST_ORDERS][8] = {
+    { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 },
+    { 0x77, 0x88, 0x55, 0x66, 0x33, 0x44, 0x11, 0x22 },
+    { 0x22, 0x11, 0x44, 0x33, 0x66, 0x55, 0x88, 0x77 },
+    { 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 },
+};
+
+static uint8_t Source[TEST_SWAP_BYTES];
+static uint8_t Expected[TEST_SWAP_BYTES];
+static uint8_t Result[TEST_SWAP_BYTES];
+
+/****************************************************************************
+!-  LOCAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Test_Orders() decodes and encodes a known Value of every Width
+ *!-  in every Word Order, three at a Time.
+ */
+void Test_Orders(
+        void) {
+
+    uint8_t Payload[3 * 8];
+    uint8_t Encoded[3 * 8];
+    uint16_t U16[3];
+    uint32_t U32[3];
+    uint64_t U64[3];
+    Modbus_Word_Order Order = WORD_ORDER_ABCD;
+    uint32_t Item = 0;
+
+    for (Order = WORD_ORDER_ABCD; Order <= WORD_ORDER_DCBA; Order++) {
+        for (Item = 0; Item < 3; Item++) {
+            memcpy(&Payload[Item * 2], Wire16[Order], 2);
+        }
+        Modbus_Decode_Array(U16, Payload, 3, TAG_UINT16, Order);
+        Modbus_Encode_Array(Encoded, U16, 3, TAG_UINT16, Order);
+        TEST_CHECK((U16[0] == 0x1234) && (U16[2] == 0x1234));
+        TEST_CHECK(memcmp(Encoded, Payload, 3 * 2) == 0);
+
+        for (Item = 0; Item < 3; Item++) {
+            memcpy(&Payload[Item * 4], Wire32[Order], 4);
+        }
+        Modbus_Decode_Array(U32, Payload, 3, TAG_UINT32, Order);
+        Modbus_Encode_Array(Encoded, U32, 3, TAG_UINT32, Order);
+        TEST_CHECK((U32[0] == 0x11223344UL) && (U32[2] == 0x11223344UL));
+        TEST_CHECK(memcmp(Encoded, Payload, 3 * 4) == 0);
+
+        for (Item = 0; Item < 3; Item++) {
+            memcpy(&Payload[Item * 8], Wire64[Order], 8);
+        }
+        Modbus_Decode_Array(U64, Payload, 3, TAG_UINT64, Order);
+        Modbus_Encode_Array(Encoded, U64, 3, TAG_UINT64, Order);
+        TEST_CHECK((U64[0] == 0x1122334455667788ULL) &&
+                   (U64[2] == 0x1122334455667788ULL));
+        TEST_CHECK(memcmp(Encoded, Payload, 3 * 8) == 0);
+    }
+}
+
+/*
+ *!-  Test_Tags() round-trips Engineering Values through a Payload:
+ *!-  Runs of adjacent Tags, Scale and Offset, signed and floating
+ *!-  Types, and Tags a Payload does not hold.
+ */
+void Test_Tags(
+        void) {
+
+    static const Modbus_Typed_Tag Tags[] = {
+        { 100, TAG_INT16,   WORD_ORDER_ABCD, 0, 0.1,  0.0 },
+        { 101, TAG_INT16,   WORD_ORDER_ABCD, 0, 0.1,  0.0 },
+        { 102, TAG_FLOAT32, WORD_ORDER_CDAB, 0, 0.0,  0.0 },
+        { 104, TAG_FLOAT32, WORD_ORDER_CDAB, 0, 0.0,  0.0 },
+        { 106, TAG_UINT32,  WORD_ORDER_DCBA, 0, 1.0,  -1000.0 },
+        { 108, TAG_FLOAT64, WORD_ORDER_BADC, 0, 0.0,  0.0 },
+        { 112, TAG_INT64,   WORD_ORDER_ABCD, 0, 0.0,  0.0 },
+        { 116, TAG_STRING,  WORD_ORDER_ABCD, 4, 0.0,  0.0 },
+        { 118, TAG_UINT64,  WORD_ORDER_ABCD, 0, 0.0,  0.0 },
+    };
+    static const double Values[] = {
+        -12.3, 3276.7, 1.5f, -0.25f, 4000.0, 3.141592653589793,
+        -1234567890123.0, 0.0, 0.0,
+    };
+    uint32_t const Count = sizeof(Tags) / sizeof(Tags[0]);
+    uint8_t Payload[TEST_QUANTITY * 2];
+    double Decoded[sizeof(Tags) / sizeof(Tags[0])];
+    uint32_t Index = 0;
+
+    memset(Payload, 0xA5, sizeof(Payload));
+    //!-  The String Tag and the last one, past the Payload, fail.
+    TEST_CHECK(Modbus_Tags_Encode(Tags, Count, Values, TEST_FIRST, Payload,
+                                  TEST_QUANTITY) == FALSE);
+    TEST_CHECK((Payload[0] == 0xFF) && (Payload[1] == 0x85));
+    TEST_CHECK((Payload[2] == 0x7F) && (Payload[3] == 0xFF));
+    //!-  1.5f is 0x3FC00000, low Register first.
+    TEST_CHECK((Payload[4] == 0x00) && (Payload[5] == 0x00) &&
+               (Payload[6] == 0x3F) && (Payload[7] == 0xC0));
+    //!-  5000 Little-Endian.
+    TEST_CHECK((Payload[12] == 0x88) && (Payload[13] == 0x13) &&
+               (Payload[14] == 0x00) && (Payload[15] == 0x00));
+    TEST_CHECK((Payload[32] == 0xA5) && (Payload[39] == 0xA5));
+
+    TEST_CHECK(Modbus_Tags_Decode(Tags, Count, TEST_FIRST, Payload,
+                                  TEST_QUANTITY, Decoded) == FALSE);
+    for (Index = 0; Index < (Count - 2); Index++) {
+        TEST_CHECK(fabs(Decoded[Index] - Values[Index]) < 1e-9);
+    }
+    TEST_CHECK(isnan(Decoded[Count - 2]));
+    TEST_CHECK(isnan(Decoded[Count - 1]));
+
+    //!-  All inside: Decode succeeds.
+    TEST_CHECK(Modbus_Tags_Decode(Tags, 7, TEST_FIRST, Payload,
+                                  TEST_QUANTITY, Decoded) == TRUE);
+    TEST_CHECK(Modbus_Tags_Decode(Tags, 1, TEST_FIRST + 1, &Payload[2],
+                                  TEST_QUANTITY - 1, Decoded) == FALSE);
+}
+
+/*
+ *!-  Test_Saturation() checks Integers are rounded and saturated
+ *!-  to their Type, NaN stored as 0, and 64-bit Extremes kept.
+ */
+void Test_Saturation(
+        void) {
+
+    static const Modbus_Typed_Tag Tags[] = {
+        { 0,  TAG_UINT16, WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 1,  TAG_UINT16, WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 2,  TAG_INT16,  WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 3,  TAG_INT16,  WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 4,  TAG_UINT32, WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 6,  TAG_INT32,  WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 8,  TAG_UINT64, WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 12, TAG_INT64,  WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 16, TAG_INT64,  WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 20, TAG_UINT16, WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 21, TAG_INT16,  WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+        { 22, TAG_UINT16, WORD_ORDER_ABCD, 0, 0.0, 0.0 },
+    };
+    static const double Values[] = {
+        70000.0, -5.0, 40000.0, -40000.0, 1e12, -1e12, 1e20, 1e20, -1e20,
+        NAN, -2.5, 2.5,
+    };
+    static const uint8_t Wire[] = {
+        0xFF, 0xFF, 0x00, 0x00, 0x7F, 0xFF, 0x80, 0x00,
+        0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0xFF, 0xFD, 0x00, 0x03,
+    };
+    uint32_t const Count = sizeof(Tags) / sizeof(Tags[0]);
+    uint8_t Payload[sizeof(Wire)];
+    double Decoded[sizeof(Tags) / sizeof(Tags[0])];
+
+    TEST_CHECK(Modbus_Tags_Encode(Tags, Count, Values, 0, Payload,
+                                  sizeof(Payload) / 2) == TRUE);
+    TEST_CHECK(memcmp(Payload, Wire, sizeof(Wire)) == 0);
+    TEST_CHECK(Modbus_Tags_Decode(Tags, Count, 0, Payload,
+                                  sizeof(Payload) / 2, Decoded) == TRUE);
+    TEST_CHECK(Decoded[0] == UINT16_MAX);
+    TEST_CHECK(Decoded[3] == INT16_MIN);
+    TEST_CHECK(Decoded[6] == 18446744073709551615.0);
+    TEST_CHECK(Decoded[7] == 9223372036854775807.0);
+    TEST_CHECK(Decoded[8] == -9223372036854775808.0);
+    TEST_CHECK(Decoded[10] == -3.0);
+}
+
+//!-  Test_Engine() runs every Pattern through the Kernel in use.
+Bool Test_Engine(
+        void) {
+
+    static const uint32_t Widths[] = { 2, 4, 8 };
+    uint8_t Pattern[16];
+    uint16_t Registers[TEST_SWAP_BYTES / 2];
+    uint32_t Width = 0;
+    uint32_t Mask = 0;
+    uint32_t Bytes = 0;
+    uint32_t Index = 0;
+    uint32_t Wrong = 0;
+
+    for (Width = 0; Width < 3; Width++) {
+        for (Mask = 1; Mask < Widths[Width]; Mask++) {
+            for (Index = 0; Index < sizeof(Pattern); Index++) {
+                Pattern[Index] = (uint8_t) (Index ^ Mask);
+            }
+            for (Bytes = 0; Bytes <= TEST_SWAP_BYTES;
+                 Bytes += Widths[Width]) {
+                for (Index = 0; Index < Bytes; Index++) {
+                    Expected[Index] = Source[(Index & ~15U) +
+                                             Pattern[Index & 15U]];
+                }
+                Swap_Elements(Result, Source, Bytes, Pattern);
+                Wrong += (memcmp(Result, Expected, Bytes) != 0) ? 1 : 0;
+                //!-  In Place.
+                memcpy(Result, Source, Bytes);
+                Swap_Elements(Result, Result, Bytes, Pattern);
+                Wrong += (memcmp(Result, Expected, Bytes) != 0) ? 1 : 0;
+            }
+        }
+    }
+    Registers_From_Wire(Registers, Source, TEST_SWAP_BYTES / 2 - 1);
+    for (Index = 0; Index < (TEST_SWAP_BYTES / 2 - 1); Index++) {
+        Wrong += (Registers[Index] !=
+                  (uint16_t) ((Source[2 * Index] << 8) |
+                              Source[2 * Index + 1])) ? 1 : 0;
+    }
+    Registers_To_Wire(Result, Registers, TEST_SWAP_BYTES / 2 - 1);
+    Wrong += (memcmp(Result, Source, TEST_SWAP_BYTES - 2) != 0) ? 1 : 0;
+    return (Bool) (Wrong == 0);
+}
+
+/*
+ *!-  Test_Kernels() checks the Portable, SSSE3 and AVX2 Kernels the
+ *!-  CPU supports give the same Bytes, and the Tags decode alike
+ *!-  with each of them.
+ */
+void Test_Kernels(
+        void) {
+
+    static const char *const Names[TEST_ENGINES] = {
+        "portable", "ssse3", "avx2",
+    };
+    uint32_t Engine = 0;
+    uint32_t Index = 0;
+    uint32_t Tested = 0;
+
+    for (Index = 0; Index < TEST_SWAP_BYTES; Index++) {
+        Source[Index] = (uint8_t) ((Index * 131U) + 7U);
+    }
+    for (Engine = 0; Engine < TEST_ENGINES; Engine++) {
+        if (Swap16_Select((Swap16_Engine) Engine) == TRUE) {
+            Tested++;
+            if (TEST_CHECK(Test_Engine() == TRUE) == FALSE) {
+                fprintf(stderr, "%s kernel\n", Names[Engine]);
+            }
+            Test_Orders();
+            Test_Tags();
+        }
+        else {
+            printf("%s kernel not supported, skipped\n", Names[Engine]);
+        }
+    }
+    TEST_CHECK(Tested >= 1);
+    Swap16_Init();
+}
+
+/****************************************************************************
+!-  GLOBAL FUNCTIONS
+*****************************************************************************/
+
+/*
+ *!-  Checks the Typed Tags and the Swap Kernels under them: every
+ *!-  Word Order, 64-bit Values and Saturation, and the Portable,
+ *!-  SSSE3 and AVX2 Kernels giving the same Results.
+ */
+int main(void) {
+
+    Test_Saturation();
+    Test_Kernels();
+    return Test_Result("Test_Tags");
+}